@@ -0,0 +1,712 @@
+/**
+ *  @file 		safeQueue.c
+ *  @brief 		src file for API functions for manging lock free multithreads safeQueue
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while multithreads operate on it as reader threads and/or as writer threads.
+ *				The memory space implemented as a ring of a power of 2 cells, every cell
+ *				has a sequence number (bounded MPMC queue of D. Vyukov).
+ *				m_enqueuePos and m_dequeuePos count inserts and removes from the start and
+ *				are never wrapped, position p uses cell p & m_mask.
+ *				A cell of position p is free for the writer of p when it's sequence is p,
+ *				and full for the reader of p when it's sequence is p + 1. The writer claims p
+ *				by compare and swap of m_enqueuePos, writes the data and stores sequence p + 1.
+ *				The reader claims p by compare and swap of m_dequeuePos, reads the data and
+ *				stores sequence p + num of cells, the sequence of the next writer of the cell.
+ *				Blocking: a thread that found the queue full (empty) takes the mutex, counts
+ *				itself as a sleeper and tries again before it waits on the condition.
+ *				A thread that inserted (removed) signals only when the sleepers count is not 0.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning The capacity is rounded up to a power of 2.
+ *  @warning QueueDestroy: The safe queue can't protect destroy thread from consumer/producer thread
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"	/* header file */
+#include <stdlib.h> 	/* for size_t  & malloc */
+#include <stddef.h> 	/* for ptrdiff_t */
+#include <pthread.h> 	/* for pthread API */
+#include <time.h> 		/* for clock_gettime */
+
+#define CACHE_LINE (64)
+#define MUTEX_INIT_FAILED 	(-1)
+#define MUTEX_INIT_SUCCESS 	(0)
+#define LOAD_RELAXED(ptr)			__atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(ptr)			__atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(ptr, val)		__atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define CLAIM(ptr, pExpected)		__atomic_compare_exchange_n((ptr), (pExpected), *(pExpected) + 1, 1, \
+												__ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define DISTANCE(seq, pos)			( (ptrdiff_t)((seq) - (pos)) )
+#define NOINLINE					__attribute__((noinline))	/* For the sample, the inserts that don't take it stay small */
+#define STATS_SAMPLE_RATE			(64)	/* The high-water mark is sampled at one of every 64 positions */
+#define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Cell
+{
+	size_t m_sequence; 			/* Position of the writer OR reader the cell waits for (see above) */
+	void* m_data;
+} Cell;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Queue
+{
+	Cell* m_cells;				/* m_mask + 1 cells */
+	size_t m_mask; 				/* Num of cells - 1, the num of cells is a power of 2 */
+	char m_pad1[CACHE_LINE];	/* Every hot index on it's own cache line */
+	size_t m_enqueuePos; 		/* Num of claimed inserts */
+	char m_pad2[CACHE_LINE];
+	size_t m_dequeuePos; 		/* Num of claimed removes */
+	char m_pad3[CACHE_LINE];
+	size_t m_nSleepOnFull; 		/* Num of writers that sleep on m_cvNotFull now */
+	size_t m_nSleepOnEmpty; 	/* Num of readers that sleep on m_cvNotEmpty now */
+	size_t m_numOfWaitOnEmpty; 	/* The number of times thread wait for remove on empty queue, under m_mutex */
+	size_t m_numOfWaitOnFull; 	/* The number of times thread wait for insert on full queue, under m_mutex */
+	size_t m_blockedNs; 		/* Total time of the waits, under m_mutex */
+	size_t m_maxBlockedNs; 		/* The longest wait, under m_mutex */
+	size_t m_highWaterMark; 	/* The max sampled num of elements, changed by compare and swap */
+	pthread_mutex_t m_mutex;	/* Guards the sleeping only */
+	pthread_cond_t m_cvNotFull;	/* Writers sleep on it */
+	pthread_cond_t m_cvNotEmpty;/* Readers sleep on it */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int InitMutex(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Signal one thread that sleeps on _cond, only if _nSleepers is not 0
+ */
+static void WakeOne(Queue* _myQueue, size_t* _nSleepers, pthread_cond_t* _cond);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called by the writer of _pos, raise the high-water mark to the num of
+ *			elements up to _pos if it is higher
+ */
+static NOINLINE void SampleHighWaterMark(Queue* _myQueue, size_t _pos);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return the monotonic clock in nano seconds
+ */
+static size_t NowNs(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called under m_mutex, add the wait that started at _waitStart to the blocked time
+ */
+static void RecordBlocked(Queue* _myQueue, size_t _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function create a new queue and return the memory
+ * @details     The function create a new queue in capacity the user sent as size and return the pointer to it.
+ *
+ * @param       _initialCapacity        =   Number of elements that can be stored initially
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL					= 	On error when initalize
+ * @retval 		_myQueue				=	On success
+ */
+Queue* QueueCreate(size_t _initialCapacity)
+{
+	Queue* myQueue;
+	size_t nCells = 1;
+	size_t i;
+
+	if( 0 == _initialCapacity || ((size_t)-1 / 2) / sizeof(Cell) < _initialCapacity )
+	{
+		return NULL;
+	}
+
+	while( nCells < _initialCapacity )
+	{
+		nCells <<= 1;
+	}
+
+	myQueue = (Queue*)calloc( 1, sizeof(Queue) );
+	CHECK_NULL(myQueue);
+
+	myQueue->m_cells = (Cell*)malloc( nCells * sizeof(Cell) );
+	if( NULL == myQueue->m_cells)
+	{
+		free(myQueue);
+		return NULL;
+	}
+
+	for(i = 0; i < nCells; ++i)
+	{
+		myQueue->m_cells[i].m_sequence = i;
+	}
+	myQueue->m_mask = nCells - 1;
+
+	if(MUTEX_INIT_FAILED == InitMutex(myQueue))
+	{
+		free(myQueue->m_cells);
+		free(myQueue);
+		return NULL;
+	}
+
+	return myQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Dynamically deallocate a previously allocated safeQueue
+ *
+ * @param 		_Queue					= 	Queue to be deallocated.
+ * @param 		_elementDestroy			= 	A function pointer to be used to destroy all elements in the vector
+ *             or a null if no such destroy is required
+ *
+ * @return void
+ */
+void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
+{
+	size_t i;
+
+    if(NULL == _myQueue || NULL == *_myQueue)
+    {
+        return;
+    }
+
+    if( NULL != _elementDestroy )
+    {
+        for(i = (*_myQueue)->m_dequeuePos; i != (*_myQueue)->m_enqueuePos; ++i)
+        {
+            (*_elementDestroy)( (*_myQueue)->m_cells[i & (*_myQueue)->m_mask].m_data );
+        }
+    }
+
+	pthread_cond_destroy( &((*_myQueue)->m_cvNotFull) );
+	pthread_cond_destroy( &((*_myQueue)->m_cvNotEmpty) );
+	pthread_mutex_destroy( &((*_myQueue)->m_mutex) );
+
+    free((*_myQueue)->m_cells);
+    free(*_myQueue);
+    *_myQueue = NULL;
+
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue, wait while the queue is full
+ * @details     This function write a new msg (pointer) in the join queue when success,
+ *				and return to the user status that indicate in which state the function ended.
+ * *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		MUTEX_ERROR				=	When sleeping on the full queue failed
+ */
+QueueResult QueueInsert(Queue* const _myQueue, void* _data)
+{
+	QueueResult status = QueueTryInsert(_myQueue, _data);
+	size_t waitStart;
+
+	if( QUEUE_OVERFLOW == status )
+	{
+		waitStart = NowNs();
+		if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+		{
+			return MUTEX_ERROR;
+		}
+
+		++(_myQueue->m_numOfWaitOnFull);
+
+		/* Count as a sleeper before the last try, a reader that removes after the
+		 * try sees the count and signals, and it can't signal before the wait */
+		__atomic_add_fetch(&_myQueue->m_nSleepOnFull, 1, __ATOMIC_SEQ_CST);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		while( QUEUE_OVERFLOW == (status = QueueTryInsert(_myQueue, _data)) )
+		{
+			if(0 != pthread_cond_wait( &(_myQueue->m_cvNotFull),  &(_myQueue->m_mutex) ) )
+			{
+				status = MUTEX_ERROR;
+				break;
+			}
+		}
+		__atomic_sub_fetch(&_myQueue->m_nSleepOnFull, 1, __ATOMIC_SEQ_CST);
+		RecordBlocked(_myQueue, waitStart);
+
+		if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+		{
+			return MUTEX_ERROR;
+		}
+	}
+
+	if( QUEUE_SUCCESS == status )
+	{
+		WakeOne(_myQueue, &_myQueue->m_nSleepOnEmpty, &_myQueue->m_cvNotEmpty);
+	}
+
+	return status;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue, wait while the queue is empty
+ * @details     This function read from the join queue the pointer to the msg,
+ *				and return to the user the pointer when success, otherwise
+ *				return status error.
+ * *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		MUTEX_ERROR				=	When sleeping on the empty queue failed
+ */
+QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
+{
+	QueueResult status = QueueTryRemove(_myQueue, _pValue);
+	size_t waitStart;
+
+	if( QUEUE_UNDERFLOW == status )
+	{
+		waitStart = NowNs();
+		if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+		{
+			return MUTEX_ERROR;
+		}
+
+		++(_myQueue->m_numOfWaitOnEmpty);
+
+		__atomic_add_fetch(&_myQueue->m_nSleepOnEmpty, 1, __ATOMIC_SEQ_CST);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		while( QUEUE_UNDERFLOW == (status = QueueTryRemove(_myQueue, _pValue)) )
+		{
+			if(0 != pthread_cond_wait( &(_myQueue->m_cvNotEmpty),  &(_myQueue->m_mutex) ) )
+			{
+				status = MUTEX_ERROR;
+				break;
+			}
+		}
+		__atomic_sub_fetch(&_myQueue->m_nSleepOnEmpty, 1, __ATOMIC_SEQ_CST);
+		RecordBlocked(_myQueue, waitStart);
+
+		if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+		{
+			return MUTEX_ERROR;
+		}
+	}
+
+	if( QUEUE_SUCCESS == status )
+	{
+		WakeOne(_myQueue, &_myQueue->m_nSleepOnFull, &_myQueue->m_cvNotFull);
+	}
+
+	return status;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue if there is room, never wait
+ * @details     Lock free, a failed compare and swap means another writer inserted.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_OVERFLOW			=	When the queue is full
+ */
+QueueResult QueueTryInsert(Queue* const _myQueue, void* _data)
+{
+	Cell* cell;
+	size_t pos;
+	ptrdiff_t distance;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _data )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	pos = LOAD_RELAXED(&_myQueue->m_enqueuePos);
+	for(;;)
+	{
+		cell = &_myQueue->m_cells[pos & _myQueue->m_mask];
+		distance = DISTANCE(LOAD_ACQUIRE(&cell->m_sequence), pos);
+
+		if( 0 == distance )
+		{
+			/* The cell is free, on a failure pos is the new m_enqueuePos */
+			if( CLAIM(&_myQueue->m_enqueuePos, &pos) )
+			{
+				break;
+			}
+		}
+		else if( distance < 0 )
+		{
+			/* The reader of the previous round did not free the cell yet */
+			return QUEUE_OVERFLOW;
+		}
+		else
+		{
+			/* Another writer claimed pos */
+			pos = LOAD_RELAXED(&_myQueue->m_enqueuePos);
+		}
+	}
+
+	cell->m_data = _data;
+	STORE_RELEASE(&cell->m_sequence, pos + 1);
+
+	if( 0 == pos % STATS_SAMPLE_RATE )
+	{
+		SampleHighWaterMark(_myQueue, pos);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue if there is one, never wait
+ * @details     Lock free, a failed compare and swap means another reader removed.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW			=	When the queue is empty
+ */
+QueueResult QueueTryRemove(Queue* const _myQueue, void** _pValue)
+{
+	Cell* cell;
+	size_t pos;
+	ptrdiff_t distance;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _pValue )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	pos = LOAD_RELAXED(&_myQueue->m_dequeuePos);
+	for(;;)
+	{
+		cell = &_myQueue->m_cells[pos & _myQueue->m_mask];
+		distance = DISTANCE(LOAD_ACQUIRE(&cell->m_sequence), pos + 1);
+
+		if( 0 == distance )
+		{
+			/* The cell is full, on a failure pos is the new m_dequeuePos */
+			if( CLAIM(&_myQueue->m_dequeuePos, &pos) )
+			{
+				break;
+			}
+		}
+		else if( distance < 0 )
+		{
+			/* The writer of pos did not fill the cell yet */
+			return QUEUE_UNDERFLOW;
+		}
+		else
+		{
+			/* Another reader claimed pos */
+			pos = LOAD_RELAXED(&_myQueue->m_dequeuePos);
+		}
+	}
+
+	*_pValue = cell->m_data;
+	STORE_RELEASE(&cell->m_sequence, pos + _myQueue->m_mask + 1);
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the orignal memory buffer capacity in the queue
+ * @details     The function return the orignal memory buffer capacity in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The orignal memory buffer capacity OR error
+ *
+ * @retval		0						= 	On error when initalize OR when capacity is 0
+ * @retval 		capacity				=	On success, the capacity given to QueueCreate rounded up to a power of 2
+ */
+size_t QueueCapacity(Queue* const _myQueue)
+{
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	return _myQueue->m_mask + 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return The number of elements in the queue
+ * @details     The function return the number of elements in the queue from a given queue.
+ *				A snapshot, writers and readers may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The number of elements in the queue OR error
+ *
+ * @retval		0						= 	On error when initalize OR when size is 0
+ * @retval 		size					=	On success
+ */
+size_t QueueSize(Queue* const _myQueue)
+{
+	size_t dequeuePos;
+	size_t size;
+
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	/* The removes first, so the inserts read after them are not behind them */
+	dequeuePos = LOAD_ACQUIRE(&_myQueue->m_dequeuePos);
+	size = LOAD_ACQUIRE(&_myQueue->m_enqueuePos) - dequeuePos;
+
+	return (size <= _myQueue->m_mask) ? size : _myQueue->m_mask + 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The inserts and removes are the claimed positions of the queue, an
+ *				element that is claimed but not written (read) yet is counted.
+ *				A wait is counted when QueueInsert finds the queue full OR QueueRemove
+ *				finds it empty and goes to sleep, and its blocked time is from the
+ *				failed try until the try succeeds, the try functions never wait.
+ *				The waits are changed under the mutex of the sleeping only, so the
+ *				inserts and removes that don't wait don't touch them.
+ *				The high-water mark is sampled by the writer of one of every 64
+ *				positions, so a short peak between the samples may be missed.
+ *				The inserts and removes hold no lock, the lock hold fields are always 0.
+ *				A snapshot, writers and readers may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ * @retval 		MUTEX_ERROR				=	Error on the mutex part of the code
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _stats )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+
+	_stats->m_nInserts = LOAD_RELAXED(&_myQueue->m_enqueuePos);
+	_stats->m_nRemoves = LOAD_RELAXED(&_myQueue->m_dequeuePos);
+	_stats->m_nWaitsOnFull = _myQueue->m_numOfWaitOnFull;
+	_stats->m_nWaitsOnEmpty = _myQueue->m_numOfWaitOnEmpty;
+	_stats->m_blockedNs = _myQueue->m_blockedNs;
+	_stats->m_maxBlockedNs = _myQueue->m_maxBlockedNs;
+	/* The inserts and removes hold no lock */
+	_stats->m_nLockHoldSamples = 0;
+	_stats->m_lockHoldNs = 0;
+	_stats->m_maxLockHoldNs = 0;
+	_stats->m_highWaterMark = LOAD_RELAXED(&_myQueue->m_highWaterMark);
+
+	pthread_mutex_unlock( &(_myQueue->m_mutex) );
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int InitMutex(Queue* _myQueue)
+{
+    if(0 != pthread_mutex_init( &(_myQueue->m_mutex), NULL) )
+	{
+		return MUTEX_INIT_FAILED;
+	}
+
+	if(0 != pthread_cond_init( &(_myQueue->m_cvNotFull), NULL) )
+	{
+		pthread_mutex_destroy( &(_myQueue->m_mutex) );
+		return MUTEX_INIT_FAILED;
+	}
+
+	if(0 != pthread_cond_init( &(_myQueue->m_cvNotEmpty), NULL) )
+	{
+		pthread_mutex_destroy( &(_myQueue->m_mutex) );
+		pthread_cond_destroy( &(_myQueue->m_cvNotFull) );
+		return MUTEX_INIT_FAILED;
+	}
+
+	return MUTEX_INIT_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void WakeOne(Queue* _myQueue, size_t* _nSleepers, pthread_cond_t* _cond)
+{
+	/* Pairs with the fence of the sleeper, the cell change is seen OR the sleeper is */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if( 0 == LOAD_RELAXED(_nSleepers) )
+	{
+		return;
+	}
+
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return;
+	}
+	pthread_cond_signal(_cond);
+	pthread_mutex_unlock( &(_myQueue->m_mutex) );
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static NOINLINE void SampleHighWaterMark(Queue* _myQueue, size_t _pos)
+{
+	ptrdiff_t nElements = DISTANCE(_pos + 1, LOAD_RELAXED(&_myQueue->m_dequeuePos));
+	size_t mark = LOAD_RELAXED(&_myQueue->m_highWaterMark);
+
+	/* The readers may be past _pos already, a stale m_dequeuePos may count more than there is room for */
+	if( nElements <= 0 )
+	{
+		return;
+	}
+
+	if( (size_t)nElements > _myQueue->m_mask + 1 )
+	{
+		nElements = (ptrdiff_t)(_myQueue->m_mask + 1);
+	}
+
+	while( (size_t)nElements > mark )
+	{
+		/* On a failure mark is the new m_highWaterMark */
+		if( __atomic_compare_exchange_n(&_myQueue->m_highWaterMark, &mark, (size_t)nElements, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+		{
+			break;
+		}
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NowNs(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (size_t)now.tv_sec * 1000000000 + (size_t)now.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RecordBlocked(Queue* _myQueue, size_t _waitStart)
+{
+	size_t blockedNs = NowNs() - _waitStart;
+
+	_myQueue->m_blockedNs += blockedNs;
+	if( blockedNs > _myQueue->m_maxBlockedNs )
+	{
+		_myQueue->m_maxBlockedNs = blockedNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
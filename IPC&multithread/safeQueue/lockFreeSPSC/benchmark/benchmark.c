@@ -0,0 +1,138 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		One producer one consumer throughput benchmark for the safeQueue API
+ *
+ *  @details 	A writer thread inserts AMOUNT_OF_MSG messages with QueueInsert and a
+ *  			reader thread removes them with QueueRemove, the messages per second are
+ *  			printed. Only the common safeQueue API is used, so the makefile builds
+ *  			it with this queue and with the condition mutex queue.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"  /* header file */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & atol */
+#include <time.h> 		/* for clock_gettime */
+#include <pthread.h> 	/* for pthread API */
+
+#define AMOUNT_OF_MSG (10000000) 	/* Num of messages, can be changed from the command line */
+#define QUEUE_SIZE (1024) 			/* The size of the Queue (num of element) */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct StreamArgs
+{
+	Queue* m_queue;
+	size_t m_nMessages;
+	size_t m_sum;			/* Keep the removes from being optimized away */
+} StreamArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	StreamArgs args;
+	pthread_t writerID;
+	pthread_t readerID;
+	struct timespec start;
+	struct timespec end;
+	double seconds;
+
+	args.m_nMessages = AMOUNT_OF_MSG;
+	if( 1 < argc )
+	{
+		args.m_nMessages = (size_t)atol(argv[1]);
+	}
+
+	args.m_queue = QueueCreate(QUEUE_SIZE);
+	args.m_sum = 0;
+	if( NULL == args.m_queue )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pthread_create(&readerID, NULL, Reader, &args);
+	pthread_create(&writerID, NULL, Writer, &args);
+	pthread_join(writerID, NULL);
+	pthread_join(readerID, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("%s: %lu messages, queue of %d, %.2f M messages/sec\n", argv[0],
+			(unsigned long)args.m_nMessages, QUEUE_SIZE, (double)args.m_nMessages / seconds / 1e6);
+
+	QueueDestroy(&args.m_queue, NULL);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		QueueInsert(args->m_queue, args);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	void* value = NULL;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		QueueRemove(args->m_queue, &value);
+		args->m_sum += (NULL != value);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
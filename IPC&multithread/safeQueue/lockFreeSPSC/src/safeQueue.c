@@ -0,0 +1,655 @@
+/**
+ *  @file 		safeQueue.c
+ *  @brief 		src file for API functions for manging lock free single producer single consumer safeQueue
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while one writer thread and one reader thread operate on it.
+ *				The memory space implemented as a ring of a power of 2 slots.
+ *				m_head and m_tail count removes and inserts from the start and are never
+ *				wrapped, the slot of index i is i & m_mask and the size is m_tail - m_head.
+ *				Only the reader writes m_head and only the writer writes m_tail, so there
+ *				are no locks: an index is published by a release store after the slot is
+ *				written OR read, and the other side reads it by an acquire load.
+ *				Every side keeps the last index it read of the other side (the cache) and
+ *				reads the shared index again only when the cache says full OR empty,
+ *				so most operations touch no cache line of the other side.
+ *				The reader fields, the writer fields and the fixed fields are a cache line apart.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning Only one thread may insert and only one thread may remove at the same time.
+ *  @warning QueueDestroy: The safe queue can't protect destroy thread from consumer/producer thread
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"	/* header file */
+#include <stdlib.h> 	/* for size_t  & malloc */
+#include <sched.h> 		/* for sched_yield */
+#include <time.h> 		/* for clock_gettime */
+
+#define CACHE_LINE (64)
+#define SPIN_LIMIT (1024)	/* Num of tries before the waiting thread yields the cpu */
+#define LOAD_RELAXED(ptr)			__atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(ptr)			__atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STORE_RELAXED(ptr, val)		__atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#define STORE_RELEASE(ptr, val)		__atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define NOINLINE					__attribute__((noinline))	/* For the wait paths, the inserts and removes that don't wait stay small */
+#define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+/* Written by the reader only, the pad keeps the writer fields off this cache line */
+typedef struct ReaderSide
+{
+    size_t m_head; 				/* Num of removed messages, the next to remove is in slot m_head & m_mask */
+    size_t m_cachedTail; 		/* The last m_tail the reader read */
+    size_t m_numOfWaitOnEmpty; 	/* The number of times thread wait for remove on empty queue, read by QueueGetStats */
+    size_t m_blockedNs; 		/* Total time of the waits on empty queue, read by QueueGetStats */
+    size_t m_maxBlockedNs; 		/* The longest wait on empty queue, read by QueueGetStats */
+    char m_pad[CACHE_LINE];
+} ReaderSide;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Written by the writer only */
+typedef struct WriterSide
+{
+    size_t m_tail; 				/* Num of inserted messages, the next is inserted to slot m_tail & m_mask */
+    size_t m_cachedHead; 		/* The last m_head the writer read */
+    size_t m_numOfWaitOnFull; 	/* The number of times thread wait for insert on full queue, read by QueueGetStats */
+    size_t m_blockedNs; 		/* Total time of the waits on full queue, read by QueueGetStats */
+    size_t m_maxBlockedNs; 		/* The longest wait on full queue, read by QueueGetStats */
+    size_t m_highWaterMark; 	/* The max num of elements the writer saw in the queue, read by QueueGetStats */
+    char m_pad[CACHE_LINE];
+} WriterSide;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Queue
+{
+    void** m_items;				/* Pointer to the actual items, m_mask + 1 slots */
+    size_t m_mask; 				/* Num of slots - 1, the num of slots is a power of 2 */
+    size_t m_capacity; 			/* The size of the structuer, at most m_mask + 1 */
+    char m_pad[CACHE_LINE];		/* The fixed fields are read by both sides, never written */
+    ReaderSide m_reader;
+    WriterSide m_writer;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Spin and then yield the cpu, _nTries is the num of times the caller waited
+ */
+static void Backoff(size_t _nTries);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert _data if there is room, return 1 if it was inserted, otherwise 0
+ */
+static __inline__ int TryPut(Queue* _myQueue, void* _data);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Remove an element to *_pValue if there is one, return 1 if it was removed, otherwise 0
+ */
+static __inline__ int TryTake(Queue* _myQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called by QueueInsert when the queue was full, spin until the insert succeeds
+ *			and count the wait
+ */
+static NOINLINE void WaitToInsert(Queue* _myQueue, void* _data);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called by QueueRemove when the queue was empty, spin until the remove succeeds
+ *			and count the wait
+ */
+static NOINLINE void WaitToRemove(Queue* _myQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called by the writer when the cache says _tail elements may be a new mark,
+ *			see what the reader removed since, so a stale head doesn't make the mark
+ */
+static NOINLINE void NewHighWaterMark(Queue* _myQueue, size_t _tail);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return the monotonic clock in nano seconds
+ */
+static size_t NowNs(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Add the wait that started at _waitStart to the blocked time of one side
+ * @details Called by the side that owns the fields only, QueueGetStats reads them.
+ */
+static void RecordBlocked(size_t* _blockedNs, size_t* _maxBlockedNs, size_t _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function create a new queue and return the memory
+ * @details     The function create a new queue in capacity the user sent as size and return the pointer to it.
+ *
+ * @param       _initialCapacity        =   Number of elements that can be stored initially
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL					= 	On error when initalize
+ * @retval 		_myQueue				=	On success
+ */
+Queue* QueueCreate(size_t _initialCapacity)
+{
+	Queue* myQueue;
+	size_t nSlots = 1;
+
+	if( 0 == _initialCapacity || ((size_t)-1 / 2) / sizeof(void*) < _initialCapacity )
+	{
+		return NULL;
+	}
+
+	while( nSlots < _initialCapacity )
+	{
+		nSlots <<= 1;
+	}
+
+	myQueue = (Queue*)calloc( 1, sizeof(Queue) );
+	CHECK_NULL(myQueue);
+
+	myQueue->m_items = (void**)malloc( nSlots * sizeof(void*) );
+	if( NULL == myQueue->m_items)
+	{
+		free(myQueue);
+		return NULL;
+	}
+
+	myQueue->m_mask = nSlots - 1;
+	myQueue->m_capacity = _initialCapacity;
+
+	return myQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Dynamically deallocate a previously allocated safeQueue
+ *
+ * @param 		_Queue					= 	Queue to be deallocated.
+ * @param 		_elementDestroy			= 	A function pointer to be used to destroy all elements in the vector
+ *             or a null if no such destroy is required
+ *
+ * @return void
+ */
+void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
+{
+	size_t i;
+
+    if(NULL == _myQueue || NULL == *_myQueue)
+    {
+        return;
+    }
+
+    if( NULL != _elementDestroy )
+    {
+        for(i = (*_myQueue)->m_reader.m_head; i != (*_myQueue)->m_writer.m_tail; ++i)
+        {
+            (*_elementDestroy)( (*_myQueue)->m_items[i & (*_myQueue)->m_mask] );
+        }
+    }
+
+    free((*_myQueue)->m_items);
+    free(*_myQueue);
+    *_myQueue = NULL;
+
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue, wait while the queue is full
+ * @details     This function write a new msg (pointer) in the join queue when success,
+ *				and return to the user status that indicate in which state the function ended.
+ *				Called by the writer thread only.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ */
+QueueResult QueueInsert(Queue* const _myQueue, void* _data)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _data )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	if( !TryPut(_myQueue, _data) )
+	{
+		WaitToInsert(_myQueue, _data);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue, wait while the queue is empty
+ * @details     This function read from the join queue the pointer to the msg,
+ *				and return to the user the pointer when success, otherwise
+ *				return status error.
+ *				Called by the reader thread only.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ */
+QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _pValue )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	if( !TryTake(_myQueue, _pValue) )
+	{
+		WaitToRemove(_myQueue, _pValue);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue if there is room, never wait
+ * @details     Wait free, called by the writer thread only.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_OVERFLOW			=	When the queue is full
+ */
+QueueResult QueueTryInsert(Queue* const _myQueue, void* _data)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _data )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	return TryPut(_myQueue, _data) ? QUEUE_SUCCESS : QUEUE_OVERFLOW;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue if there is one, never wait
+ * @details     Wait free, called by the reader thread only.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW			=	When the queue is empty
+ */
+QueueResult QueueTryRemove(Queue* const _myQueue, void** _pValue)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _pValue )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	return TryTake(_myQueue, _pValue) ? QUEUE_SUCCESS : QUEUE_UNDERFLOW;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the orignal memory buffer capacity in the queue
+ * @details     The function return the orignal memory buffer capacity in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The orignal memory buffer capacity OR error
+ *
+ * @retval		0						= 	On error when initalize OR when capacity is 0
+ * @retval 		capacity				=	On success
+ */
+size_t QueueCapacity(Queue* const _myQueue)
+{
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	return _myQueue->m_capacity;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return The number of elements in the queue
+ * @details     The function return the number of elements in the queue from a given queue.
+ *				A snapshot, the writer and the reader may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The number of elements in the queue OR error
+ *
+ * @retval		0						= 	On error when initalize OR when size is 0
+ * @retval 		size					=	On success
+ */
+size_t QueueSize(Queue* const _myQueue)
+{
+	size_t head;
+	size_t size;
+
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	/* The head first, so the tail read after it is not behind it */
+	head = LOAD_ACQUIRE(&_myQueue->m_reader.m_head);
+	size = LOAD_ACQUIRE(&_myQueue->m_writer.m_tail) - head;
+
+	return (size < _myQueue->m_capacity) ? size : _myQueue->m_capacity;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     Every side counts on its own cache line with relaxed atomics, no lock.
+ *				The inserts and removes are the tail and head counters of the queue.
+ *				A wait is counted when QueueInsert finds the queue full OR QueueRemove
+ *				finds it empty, and its blocked time is the spin and yield until the
+ *				try succeeds, the try functions never wait.
+ *				The high-water mark is kept by the writer, it reads the head of the
+ *				reader only when an insert may make a new mark.
+ *				There is no lock, the lock hold fields are always 0.
+ *				A snapshot, the writer and the reader may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _stats )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	_stats->m_nInserts = LOAD_RELAXED(&_myQueue->m_writer.m_tail);
+	_stats->m_nRemoves = LOAD_RELAXED(&_myQueue->m_reader.m_head);
+	_stats->m_nWaitsOnFull = LOAD_RELAXED(&_myQueue->m_writer.m_numOfWaitOnFull);
+	_stats->m_nWaitsOnEmpty = LOAD_RELAXED(&_myQueue->m_reader.m_numOfWaitOnEmpty);
+	_stats->m_blockedNs = LOAD_RELAXED(&_myQueue->m_writer.m_blockedNs) + LOAD_RELAXED(&_myQueue->m_reader.m_blockedNs);
+	_stats->m_maxBlockedNs = LOAD_RELAXED(&_myQueue->m_writer.m_maxBlockedNs);
+	if( LOAD_RELAXED(&_myQueue->m_reader.m_maxBlockedNs) > _stats->m_maxBlockedNs )
+	{
+		_stats->m_maxBlockedNs = LOAD_RELAXED(&_myQueue->m_reader.m_maxBlockedNs);
+	}
+	/* No lock to hold */
+	_stats->m_nLockHoldSamples = 0;
+	_stats->m_lockHoldNs = 0;
+	_stats->m_maxLockHoldNs = 0;
+	_stats->m_highWaterMark = LOAD_RELAXED(&_myQueue->m_writer.m_highWaterMark);
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void Backoff(size_t _nTries)
+{
+	if( SPIN_LIMIT <= _nTries )
+	{
+		sched_yield();
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static __inline__ int TryPut(Queue* _myQueue, void* _data)
+{
+	WriterSide* writer;
+	size_t tail;
+
+	writer = &_myQueue->m_writer;
+	tail = writer->m_tail;
+
+	if( tail - writer->m_cachedHead == _myQueue->m_capacity )
+	{
+		/* Full by the cache, see what the reader removed since */
+		writer->m_cachedHead = LOAD_ACQUIRE(&_myQueue->m_reader.m_head);
+		if( tail - writer->m_cachedHead == _myQueue->m_capacity )
+		{
+			return 0;
+		}
+	}
+
+	_myQueue->m_items[tail & _myQueue->m_mask] = _data;
+	STORE_RELEASE(&writer->m_tail, tail + 1);
+
+	if( tail + 1 - writer->m_cachedHead > writer->m_highWaterMark )
+	{
+		NewHighWaterMark(_myQueue, tail + 1);
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static __inline__ int TryTake(Queue* _myQueue, void** _pValue)
+{
+	ReaderSide* reader;
+	size_t head;
+
+	reader = &_myQueue->m_reader;
+	head = reader->m_head;
+
+	if( head == reader->m_cachedTail )
+	{
+		/* Empty by the cache, see what the writer inserted since */
+		reader->m_cachedTail = LOAD_ACQUIRE(&_myQueue->m_writer.m_tail);
+		if( head == reader->m_cachedTail )
+		{
+			return 0;
+		}
+	}
+
+	*_pValue = _myQueue->m_items[head & _myQueue->m_mask];
+	STORE_RELEASE(&reader->m_head, head + 1);
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static NOINLINE void WaitToInsert(Queue* _myQueue, void* _data)
+{
+	size_t nTries = 0;
+	size_t waitStart;
+
+	STORE_RELAXED(&_myQueue->m_writer.m_numOfWaitOnFull, _myQueue->m_writer.m_numOfWaitOnFull + 1);
+	waitStart = NowNs();
+
+	do
+	{
+		Backoff(nTries++);
+	}
+	while( !TryPut(_myQueue, _data) );
+
+	RecordBlocked(&_myQueue->m_writer.m_blockedNs, &_myQueue->m_writer.m_maxBlockedNs, waitStart);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static NOINLINE void WaitToRemove(Queue* _myQueue, void** _pValue)
+{
+	size_t nTries = 0;
+	size_t waitStart;
+
+	STORE_RELAXED(&_myQueue->m_reader.m_numOfWaitOnEmpty, _myQueue->m_reader.m_numOfWaitOnEmpty + 1);
+	waitStart = NowNs();
+
+	do
+	{
+		Backoff(nTries++);
+	}
+	while( !TryTake(_myQueue, _pValue) );
+
+	RecordBlocked(&_myQueue->m_reader.m_blockedNs, &_myQueue->m_reader.m_maxBlockedNs, waitStart);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static NOINLINE void NewHighWaterMark(Queue* _myQueue, size_t _tail)
+{
+	WriterSide* writer = &_myQueue->m_writer;
+
+	writer->m_cachedHead = LOAD_ACQUIRE(&_myQueue->m_reader.m_head);
+	if( _tail - writer->m_cachedHead > writer->m_highWaterMark )
+	{
+		STORE_RELAXED(&writer->m_highWaterMark, _tail - writer->m_cachedHead);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NowNs(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (size_t)now.tv_sec * 1000000000 + (size_t)now.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RecordBlocked(size_t* _blockedNs, size_t* _maxBlockedNs, size_t _waitStart)
+{
+	size_t blockedNs = NowNs() - _waitStart;
+
+	STORE_RELAXED(_blockedNs, *_blockedNs + blockedNs);
+	if( blockedNs > *_maxBlockedNs )
+	{
+		STORE_RELAXED(_maxBlockedNs, blockedNs);
+	}
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,434 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Set of tests for src lock free single producer single consumer safeQueue API functions
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while one writer thread and one reader thread operate on it.
+ *				The memory space implemented as a generic queue.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+
+#include "safeQueue.h"  /* header file */
+#include "matan_test.h" /* define test macros file */
+#include <stdlib.h> 	/* for size_t & malloc */
+#include <stdio.h>      /* for printf */
+#include <pthread.h> 	/* for pthread API */
+#include <sched.h> 		/* for sched_yield */
+
+#define QUEUE_SIZE (10) 		/* The size of the Queue (num of element), not a power of 2 */
+#define SMALL_QUEUE_SIZE (3) 	/* The size of the Queue in the blocking test, the writer waits a lot */
+#define AMOUNT_OF_MSG (1000000) /* Num of messages the writer sends in the threads tests */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct StreamArgs
+{
+	Queue* m_queue;
+	char* m_messages;		/* The messages are the addresses m_messages + i, in order */
+	int m_isBlocking;		/* Use QueueInsert/QueueRemove OR the try functions */
+	int m_failed;			/* Set by the reader if a message is out of order */
+} StreamArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int RunStream(size_t _capacity, int _isBlocking);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+static size_t g_nDestroyed = 0;
+
+
+
+
+/******************************* Tests functions ******************************/
+/*----------------------------------------------------------------------------*/
+TEST(Test001_CreateAndNullArguments)
+	Queue* ip;
+	void* value;
+	int item;
+
+	ASSERT_THAT( NULL == QueueCreate(0) );
+	ASSERT_THAT( NULL == QueueCreate((size_t)-1) );
+
+	ip = QueueCreate(QUEUE_SIZE);
+	ASSERT_THAT( NULL != ip && QUEUE_SIZE == QueueCapacity(ip) && 0 == QueueSize(ip) );
+	ASSERT_THAT( QUEUE_UNINITIALIZED_ERROR == QueueInsert(NULL, &item) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueInsert(ip, NULL) );
+	ASSERT_THAT( QUEUE_UNINITIALIZED_ERROR == QueueRemove(NULL, &value) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueRemove(ip, NULL) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueTryRemove(ip, NULL) );
+	ASSERT_THAT( 0 == QueueCapacity(NULL) && 0 == QueueSize(NULL) );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( NULL == ip );
+	QueueDestroy(&ip, NULL);
+	QueueDestroy(NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test002_TryFunctions_FullAndEmpty)
+	Queue* ip;
+	int items[QUEUE_SIZE + 1];
+	void* value;
+	size_t i;
+	int result = 1;
+
+	ip = QueueCreate(QUEUE_SIZE);
+	result = ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) );
+
+	/* The capacity is kept even though the ring has 16 slots */
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueTryInsert(ip, &items[i]) );
+	}
+	result = result && ( QUEUE_OVERFLOW == QueueTryInsert(ip, &items[QUEUE_SIZE]) );
+	result = result && ( QUEUE_SIZE == QueueSize(ip) );
+
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueTryRemove(ip, &value) && &items[i] == value );
+	}
+	result = result && ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) && 0 == QueueSize(ip) );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test003_WrapAroundKeepOrder)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* value;
+	size_t round;
+	size_t i;
+	int result = 1;
+
+	ip = QueueCreate(QUEUE_SIZE);
+
+	/* 7 in and 7 out, the indexes go around the ring many times */
+	for(round = 0; round < 1000; ++round)
+	{
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[(round + i) % QUEUE_SIZE]) );
+		}
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+			result = result && ( &items[(round + i) % QUEUE_SIZE] == value );
+		}
+	}
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test004_1Consumer_1Producer_TryFunctionsInOrder)
+	ASSERT_THAT( RunStream(QUEUE_SIZE, 0) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test005_1Consumer_1Producer_BlockingInOrder)
+	ASSERT_THAT( RunStream(SMALL_QUEUE_SIZE, 1) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test006_DestroyWithElements)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* value;
+	size_t i;
+
+	ip = QueueCreate(QUEUE_SIZE);
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		QueueInsert(ip, &items[i]);
+	}
+	QueueRemove(ip, &value);
+	QueueRemove(ip, &value);
+	QueueInsert(ip, &items[0]);
+
+	g_nDestroyed = 0;
+	QueueDestroy(&ip, CountDestroy);
+	ASSERT_THAT( QUEUE_SIZE - 1 == g_nDestroyed );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test007_Stats_NullArgumentsAndTryFunctions)
+	Queue* ip;
+	QueueStats stats;
+	int items[2];
+	void* value;
+	int result;
+
+	ip = QueueCreate(2);
+	result = ( QUEUE_UNINITIALIZED_ERROR == QueueGetStats(NULL, &stats) );
+	result = result && ( ITEM_UNINITIALIZED_ERROR == QueueGetStats(ip, NULL) );
+
+	/* The try functions never wait, a full OR empty queue is not counted */
+	result = result && ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) );
+	result = result && ( QUEUE_SUCCESS == QueueTryInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[1]) );
+	result = result && ( QUEUE_OVERFLOW == QueueTryInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 2 == stats.m_nInserts && 1 == stats.m_nRemoves && 2 == stats.m_highWaterMark );
+	result = result && ( 0 == stats.m_nWaitsOnFull && 0 == stats.m_nWaitsOnEmpty && 0 == stats.m_blockedNs );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test008_Stats_WaitOnEmptyAndFull)
+	Queue* ip;
+	QueueStats stats;
+	pthread_t threadID;
+	int items[2];
+	void* value;
+	int result;
+
+	ip = QueueCreate(2);
+
+	/* The reader finds the queue empty, it is counted before it spins */
+	pthread_create(&threadID, NULL, RemoveOne, ip);
+	while( QUEUE_SUCCESS == QueueGetStats(ip, &stats) && 0 == stats.m_nWaitsOnEmpty )
+	{
+		sched_yield();
+	}
+	result = ( QUEUE_SUCCESS == QueueInsert(ip, &items[0]) );
+	pthread_join(threadID, NULL);
+
+	/* The writer finds the queue full */
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[1]) );
+	pthread_create(&threadID, NULL, InsertOne, ip);
+	while( QUEUE_SUCCESS == QueueGetStats(ip, &stats) && 0 == stats.m_nWaitsOnFull )
+	{
+		sched_yield();
+	}
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	pthread_join(threadID, NULL);
+
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 1 == stats.m_nWaitsOnEmpty && 1 == stats.m_nWaitsOnFull );
+	result = result && ( 0 < stats.m_maxBlockedNs && stats.m_maxBlockedNs < stats.m_blockedNs );
+	result = result && ( 4 == stats.m_nInserts && 2 == stats.m_nRemoves && 2 == stats.m_highWaterMark );
+	/* No lock, no lock hold */
+	result = result && ( 0 == stats.m_nLockHoldSamples && 0 == stats.m_lockHoldNs && 0 == stats.m_maxLockHoldNs );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/********************************* Test Suite *********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test lock free SPSC safeQueue Module)
+	PRINT(Test001_CreateAndNullArguments)
+	PRINT(Test002_TryFunctions_FullAndEmpty)
+	PRINT(Test003_WrapAroundKeepOrder)
+	PRINT(Test004_1Consumer_1Producer_TryFunctionsInOrder)
+	PRINT(Test005_1Consumer_1Producer_BlockingInOrder)
+	PRINT(Test006_DestroyWithElements)
+	PRINT(Test007_Stats_NullArgumentsAndTryFunctions)
+	PRINT(Test008_Stats_WaitOnEmptyAndFull)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	size_t i;
+
+	for(i = 0; i < AMOUNT_OF_MSG; ++i)
+	{
+		if( args->m_isBlocking )
+		{
+			QueueInsert(args->m_queue, args->m_messages + i);
+		}
+		else
+		{
+			while( QUEUE_OVERFLOW == QueueTryInsert(args->m_queue, args->m_messages + i) )
+			{
+				sched_yield();
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	void* value = NULL;
+	size_t i;
+
+	for(i = 0; i < AMOUNT_OF_MSG; ++i)
+	{
+		if( args->m_isBlocking )
+		{
+			QueueRemove(args->m_queue, &value);
+		}
+		else
+		{
+			while( QUEUE_UNDERFLOW == QueueTryRemove(args->m_queue, &value) )
+			{
+				sched_yield();
+			}
+		}
+
+		if( args->m_messages + i != value )
+		{
+			args->m_failed = 1;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int RunStream(size_t _capacity, int _isBlocking)
+{
+	StreamArgs args;
+	pthread_t writerID;
+	pthread_t readerID;
+	int result;
+
+	args.m_queue = QueueCreate(_capacity);
+	args.m_messages = (char*)malloc(AMOUNT_OF_MSG);
+	args.m_isBlocking = _isBlocking;
+	args.m_failed = 0;
+	if( NULL == args.m_queue || NULL == args.m_messages )
+	{
+		QueueDestroy(&args.m_queue, NULL);
+		free(args.m_messages);
+		return 0;
+	}
+
+	if( 0 != pthread_create(&readerID, NULL, Reader, &args) )
+	{
+		QueueDestroy(&args.m_queue, NULL);
+		free(args.m_messages);
+		return 0;
+	}
+	if( 0 != pthread_create(&writerID, NULL, Writer, &args) )
+	{
+		/* The reader waits forever, the queue can't be destroyed */
+		return 0;
+	}
+	pthread_join(writerID, NULL);
+	pthread_join(readerID, NULL);
+
+	result = !args.m_failed && 0 == QueueSize(args.m_queue);
+	QueueDestroy(&args.m_queue, NULL);
+	free(args.m_messages);
+
+	return result;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _item)
+{
+	if( NULL != _item )
+	{
+		++g_nDestroyed;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue)
+{
+	static int item;
+
+	QueueInsert(_queue, &item);
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue)
+{
+	void* value;
+
+	QueueRemove(_queue, &value);
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,252 @@
+/**
+ *  @file 		latency.c
+ *  @brief 		Insert to remove latency histograms of the safeQueue wait policies
+ *
+ *  @details 	A writer thread stamps every message with the time and inserts it,
+ *  			then busy waits GAP_NS, so the reader is usually just a little behind
+ *  			and finds the queue empty. The reader measures the time from the stamp
+ *  			to the remove. The same stream runs with every policy of g_policies and
+ *  			a histogram of powers of 2 micro seconds is printed for each one.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"  /* header file */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & malloc & atol */
+#include <time.h> 		/* for clock_gettime */
+#include <pthread.h> 	/* for pthread API */
+
+#define AMOUNT_OF_MSG (200000) 		/* Num of messages, can be changed from the command line */
+#define QUEUE_SIZE (1024) 			/* The size of the Queue (num of element) */
+#define GAP_NS (2000) 				/* The writer waits that long after every message */
+#define N_BUCKETS (12) 				/* <= 1us, <= 2us, ... <= 1024us, more */
+#define N_POLICIES (4)
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct StreamArgs
+{
+	Queue* m_queue;
+	size_t m_nMessages;
+	struct timespec* m_stamps;		/* Message i is &m_stamps[i], the time it was inserted */
+	size_t m_histogram[N_BUCKETS];
+	long m_maxNs;
+} StreamArgs;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct NamedPolicy
+{
+	const char* m_name;
+	QueueWaitPolicy m_policy;
+} NamedPolicy;
+/*----------------------------------------------------------------------------*/
+
+
+static const NamedPolicy g_policies[N_POLICIES] = {
+	{"park at once", {0, 0}},
+	{"spin 2000", {2000, 0}},
+	{"yield 20", {0, 20}},
+	{"spin 2000 + yield 20", {2000, 20}}
+};
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int RunStream(StreamArgs* _args, const QueueWaitPolicy* _policy);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void PrintHistogram(const char* _name, const StreamArgs* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static long DiffNs(const struct timespec* _start, const struct timespec* _end);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	StreamArgs args;
+	size_t i;
+
+	args.m_nMessages = AMOUNT_OF_MSG;
+	if( 1 < argc )
+	{
+		args.m_nMessages = (size_t)atol(argv[1]);
+	}
+
+	args.m_stamps = (struct timespec*)malloc(args.m_nMessages * sizeof(struct timespec));
+	if( NULL == args.m_stamps )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	printf("%s: %lu messages, a message every %d ns, queue of %d\n", argv[0],
+			(unsigned long)args.m_nMessages, GAP_NS, QUEUE_SIZE);
+	printf("%-22s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %10s\n", "us:", "<=1", "<=2",
+			"<=4", "<=8", "<=16", "<=32", "<=64", "<=128", "<=256", "<=512", "<=1024", "more", "max us");
+
+	for(i = 0; i < N_POLICIES; ++i)
+	{
+		if( !RunStream(&args, &g_policies[i].m_policy) )
+		{
+			printf("allocation failed\n");
+			free(args.m_stamps);
+			return 1;
+		}
+		PrintHistogram(g_policies[i].m_name, &args);
+	}
+
+	free(args.m_stamps);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int RunStream(StreamArgs* _args, const QueueWaitPolicy* _policy)
+{
+	pthread_t writerID;
+	pthread_t readerID;
+	size_t i;
+
+	_args->m_queue = QueueCreateWithWaitPolicy(QUEUE_SIZE, _policy);
+	if( NULL == _args->m_queue )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < N_BUCKETS; ++i)
+	{
+		_args->m_histogram[i] = 0;
+	}
+	_args->m_maxNs = 0;
+
+	pthread_create(&readerID, NULL, Reader, _args);
+	pthread_create(&writerID, NULL, Writer, _args);
+	pthread_join(writerID, NULL);
+	pthread_join(readerID, NULL);
+
+	QueueDestroy(&_args->m_queue, NULL);
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void PrintHistogram(const char* _name, const StreamArgs* _args)
+{
+	size_t i;
+
+	printf("%-22s", _name);
+	for(i = 0; i < N_BUCKETS; ++i)
+	{
+		printf(" %8lu", (unsigned long)_args->m_histogram[i]);
+	}
+	printf(" %10.1f\n", (double)_args->m_maxNs / 1e3);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	struct timespec now;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &args->m_stamps[i]);
+		QueueInsert(args->m_queue, &args->m_stamps[i]);
+
+		do
+		{
+			clock_gettime(CLOCK_MONOTONIC, &now);
+		} while(DiffNs(&args->m_stamps[i], &now) < GAP_NS);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	struct timespec now;
+	void* value;
+	long latency;
+	long bucketEnd;
+	size_t bucket;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		QueueRemove(args->m_queue, &value);
+		clock_gettime(CLOCK_MONOTONIC, &now);
+
+		latency = DiffNs((struct timespec*)value, &now);
+		if(latency > args->m_maxNs)
+		{
+			args->m_maxNs = latency;
+		}
+
+		for(bucket = 0, bucketEnd = 1000; bucket < N_BUCKETS - 1 && latency > bucketEnd; ++bucket)
+		{
+			bucketEnd *= 2;
+		}
+		++(args->m_histogram[bucket]);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static long DiffNs(const struct timespec* _start, const struct timespec* _end)
+{
+	return (long)(_end->tv_sec - _start->tv_sec) * 1000000000L + (_end->tv_nsec - _start->tv_nsec);
+}
+/*----------------------------------------------------------------------------*/
@@ -18,21 +18,35 @@
  *	If you found any bug in my code OR just want to send me an email for any reason,
  *  feel free to do so, I will do my best to send you a respond as soon as possible
  */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
  
 #include "safeQueue.h"	/* header file */
 #include <stdlib.h> 	/* for size_t  & malloc */
 #include <fcntl.h> 		/* for semaphore o_flag define */
 #include <sys/stat.h> 	/* for O_CREAT mode parameters in semaphore API */
 #include <semaphore.h> 	/* for semaphore API */
-#include <time.h> 		/* for mutex */
+#include <time.h> 		/* for mutex & clock_gettime */
 #include <stdio.h>      /* for perror */
 #include <pthread.h> 	/* for pthread API */
 #include <unistd.h>		/* for sleep */
+#include <sched.h> 		/* for sched_yield */
 
 #define DEBUG	(1)
 #define MUTEX_INIT_FAILED 	(-1)
 #define MUTEX_INIT_SUCCESS 	(0)
 #define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define IS_WRITER			(1)
+#define IS_READER			(0)
+/* m_numOfElements is changed under the mutex only, the spinning threads read it without the mutex */
+#define LOAD_RELAXED(ptr)			__atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define STORE_RELAXED(ptr, val)		__atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#if defined(__i386__) || defined(__x86_64__)
+#define CPU_PAUSE()					__asm__ __volatile__("pause" ::: "memory")
+#else
+#define CPU_PAUSE()					__asm__ __volatile__("" ::: "memory")
+#endif
+#define STATS_SAMPLE_RATE			(64)	/* Time one of every 64 lock holds */
 
 
 
@@ -46,11 +60,14 @@ struct Queue
     size_t m_head; 				/* Index to the first message to remove from the structuer */
     size_t m_tail; 				/* Index to the last message that insert to the structuer */
     size_t m_numOfElements; 	/* The current number of message in the structuer */
-    size_t m_numOfWaitOnEmpty; 	/* The number of times thread wait for remove on empty queue */
-    size_t m_numOfWaitOnFull; 	/* The number of times thread wait for remove on full queue */
     pthread_mutex_t m_mutex;	/* Pointer to mutex */
     pthread_cond_t m_cvEmpty;	/* Pointer to mutex condition for producer */
     pthread_cond_t m_cvFull;	/* Pointer to mutex condition for consumer */
+    size_t m_nSleepOnEmpty; 	/* Num of producers that sleep on m_cvEmpty now */
+    size_t m_nSleepOnFull; 		/* Num of consumers that sleep on m_cvFull now */
+    QueueWaitPolicy m_waitPolicy;	/* Spin and yield before sleeping */
+    QueueStats m_stats;			/* Changed and read under the mutex, that the thread holds anyway */
+    size_t m_nLockHolds; 		/* Num of lock holds, picks the timed ones */
 };
 /*----------------------------------------------------------------------------*/
 
@@ -64,6 +81,83 @@ static int InitMutex(Queue* _myQueue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return 1 if one of the _nItems elements of _items is NULL, otherwise 0
+ */
+static int IsAnyNull(void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Wake the readers for _nNew new elements, signal for one and broadcast for more
+ */
+static int WakeReaders(Queue* _myQueue, size_t _nNew);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Wake the writers for _nFree free places, signal for one and broadcast for more
+ */
+static int WakeWriters(Queue* _myQueue, size_t _nFree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Spin and then yield by the wait policy, without the mutex, until the queue
+ *			has room (_isWriter) OR elements (!_isWriter) OR the policy is used up.
+ *			Set *_waitStart to the time the wait started if the queue was not ready
+ */
+static void SpinThenYield(Queue* _myQueue, int _isWriter, size_t* _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return 1 if the queue has room (_isWriter) OR elements (!_isWriter), read without the mutex
+ */
+static int IsReady(Queue* _myQueue, int _isWriter);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return the monotonic clock in nano seconds
+ */
+static size_t NowNs(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Count the wait that started at *_waitStart (0 for no wait) and zero it
+ */
+static void RecordWait(Queue* _myQueue, int _isWriter, size_t* _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called when the lock is taken for work, return the time to time the
+ *			hold with OR 0 if this hold is not sampled
+ */
+static size_t StartOp(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called before the unlock, count _nItems elements and the hold from _holdStart
+ */
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _nItems, size_t _holdStart);
+/*----------------------------------------------------------------------------*/
+
+
+
+
 
 /******************************** API functions *******************************/
 /*----------------------------------------------------------------------------*/
@@ -80,9 +174,36 @@ static int InitMutex(Queue* _myQueue);
  */
 Queue* QueueCreate(size_t _initialCapacity)
 {
+	QueueWaitPolicy parkAtOnce = {0, 0};
+	
+	return QueueCreateWithWaitPolicy(_initialCapacity, &parkAtOnce);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function create a new queue with a wait policy and return the memory
+ * @details     A thread that finds the queue full (insert) OR empty (remove) checks it
+ *				again _policy->m_nSpins times with a cpu pause, then _policy->m_nYields
+ *				times with sched_yield, without the lock. Only then it parks on the condition.
+ *				Spinning pays off when the other side is a few micro seconds behind and
+ *				has a cpu of it's own, QueueCreate parks at once ({0, 0}).
+ *
+ * @param       _initialCapacity        =   Number of elements that can be stored initially
+ * @param       _policy        			=   The wait policy, copied into the queue
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL					= 	On error when initalize OR when _policy is NULL
+ * @retval 		_myQueue				=	On success
+ */
+Queue* QueueCreateWithWaitPolicy(size_t _initialCapacity, const QueueWaitPolicy* _policy)
+{
+	QueueStats emptyStats = {0};
 	Queue* myQueue;
 	
-	if( 0 == _initialCapacity)
+	if( 0 == _initialCapacity || NULL == _policy )
 	{
 		return NULL;
 	}
@@ -101,6 +222,11 @@ Queue* QueueCreate(size_t _initialCapacity)
 	myQueue->m_head = 0;
 	myQueue->m_tail = 0;
 	myQueue->m_numOfElements = 0;
+	myQueue->m_nSleepOnEmpty = 0;
+	myQueue->m_nSleepOnFull = 0;
+	myQueue->m_waitPolicy = *_policy;
+	myQueue->m_stats = emptyStats;
+	myQueue->m_nLockHolds = 0;
 	
 	if(MUTEX_INIT_FAILED == InitMutex(myQueue))
 	{
@@ -111,7 +237,6 @@ Queue* QueueCreate(size_t _initialCapacity)
 	
 	return myQueue;
 }
-/*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
@@ -129,20 +254,17 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
 
 	size_t i;
     size_t elementCounter;
-	pthread_mutex_t tempMutex;
-	
-	if(0 != pthread_mutex_lock( &((*_myQueue)->m_mutex) ) )
-	{
-		return;
-	}
-	
-	tempMutex = (*_myQueue)->m_mutex;
 	
     if(NULL == _myQueue || NULL == *_myQueue)  
     {
         return;
     }
     
+	if(0 != pthread_mutex_lock( &((*_myQueue)->m_mutex) ) )
+	{
+		return;
+	}
+	
     if( NULL != (*_elementDestroy) )
     {
         elementCounter = (*_myQueue)->m_numOfElements;
@@ -154,6 +276,10 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
         }
     }
     
+	/* Unlock the mutex itself, not a copy of it, before it is destroyed with the queue */
+	pthread_mutex_unlock( &((*_myQueue)->m_mutex) );
+	
+	pthread_mutex_destroy( &((*_myQueue)->m_mutex) );
 	pthread_cond_destroy( &((*_myQueue)->m_cvEmpty) );
 	pthread_cond_destroy( &((*_myQueue)->m_cvFull) );
 	
@@ -161,13 +287,6 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
     free(*_myQueue);
     *_myQueue = NULL;
 	
-	if(0 != pthread_mutex_unlock( &(tempMutex) ) )
-	{
-		return;
-	}
-	
-	pthread_mutex_destroy( &(tempMutex) );
-	
     return;
 }
 /*----------------------------------------------------------------------------*/
@@ -191,6 +310,9 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
  */
 QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 {
+	size_t waitStart = 0;
+	size_t holdStart;
+	
 	if( NULL == _myQueue )
 	{
 		return QUEUE_UNITIALIZED_ERROR;
@@ -200,7 +322,9 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 	{
 		return ITEM_UNITIALIZED_ERROR;
 	}
-		
+	
+	SpinThenYield(_myQueue, IS_WRITER, &waitStart);
+	
 	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
 	{
 		return MUTEX_ERROR;
@@ -208,20 +332,36 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 	
 	while(_myQueue->m_capacity == _myQueue->m_numOfElements)
 	{
-		if(-1 == pthread_cond_wait( &(_myQueue->m_cvEmpty),  &(_myQueue->m_mutex) ) )
+		if(0 == waitStart)
+		{
+			waitStart = NowNs();
+		}
+		++(_myQueue->m_nSleepOnEmpty);
+		if(0 != pthread_cond_wait( &(_myQueue->m_cvEmpty),  &(_myQueue->m_mutex) ) )
 		{
-			return MUTEX_ERROR	;
+			--(_myQueue->m_nSleepOnEmpty);
+			pthread_mutex_unlock( &(_myQueue->m_mutex) );
+			return MUTEX_ERROR;
 		}
+		--(_myQueue->m_nSleepOnEmpty);
 	}
+	RecordWait(_myQueue, IS_WRITER, &waitStart);
+	holdStart = StartOp(_myQueue);
 	
 	_myQueue->m_items[_myQueue->m_tail] = _data;
 	(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) % (_myQueue->m_capacity)  );
-	++(_myQueue->m_numOfElements);
+	STORE_RELAXED(&_myQueue->m_numOfElements, _myQueue->m_numOfElements + 1);
+	if(_myQueue->m_numOfElements > _myQueue->m_stats.m_highWaterMark)
+	{
+		_myQueue->m_stats.m_highWaterMark = _myQueue->m_numOfElements;
+	}
 	
-	if(-1 == pthread_cond_signal( &(_myQueue->m_cvFull) ) )
+	if(0 != WakeReaders(_myQueue, 1) )
 	{
-		return MUTEX_ERROR	;
+		pthread_mutex_unlock( &(_myQueue->m_mutex) );
+		return MUTEX_ERROR;
 	}
+	EndOp(_myQueue, IS_WRITER, 1, holdStart);
 	
 	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
 	{
@@ -251,6 +391,9 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
  */
 QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 {
+	size_t waitStart = 0;
+	size_t holdStart;
+	
 	if( NULL == _myQueue )
 	{
 		return QUEUE_UNITIALIZED_ERROR;
@@ -261,6 +404,8 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 		return ITEM_UNITIALIZED_ERROR;
 	}
 	
+	SpinThenYield(_myQueue, IS_READER, &waitStart);
+	
 	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
 	{
 		return MUTEX_ERROR;
@@ -268,21 +413,227 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 	
 	while(0 == _myQueue->m_numOfElements)
 	{
-		if(-1 == pthread_cond_wait( &(_myQueue->m_cvFull),  &(_myQueue->m_mutex) ) )
+		if(0 == waitStart)
 		{
-			return MUTEX_ERROR	;
+			waitStart = NowNs();
 		}
-	
+		++(_myQueue->m_nSleepOnFull);
+		if(0 != pthread_cond_wait( &(_myQueue->m_cvFull),  &(_myQueue->m_mutex) ) )
+		{
+			--(_myQueue->m_nSleepOnFull);
+			pthread_mutex_unlock( &(_myQueue->m_mutex) );
+			return MUTEX_ERROR;
+		}
+		--(_myQueue->m_nSleepOnFull);
 	}
+	RecordWait(_myQueue, IS_READER, &waitStart);
+	holdStart = StartOp(_myQueue);
 	
 	*_pValue = (_myQueue->m_items)[_myQueue->m_head];
 	(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) % (_myQueue->m_capacity)  ) ;
-	--(_myQueue->m_numOfElements);
+	STORE_RELAXED(&_myQueue->m_numOfElements, _myQueue->m_numOfElements - 1);
 	
-	if(-1 == pthread_cond_signal( &(_myQueue->m_cvEmpty) ) )
+	if(0 != WakeWriters(_myQueue, 1) )
 	{
-		return MUTEX_ERROR	;
+		pthread_mutex_unlock( &(_myQueue->m_mutex) );
+		return MUTEX_ERROR;
 	}
+	EndOp(_myQueue, IS_READER, 1, holdStart);
+	
+	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function put _nItems elements into queue, wait while the queue is full
+ * @details     Every time the function takes the lock it writes as many elements as
+ *				there is room for and wakes the readers once with a broadcast, so
+ *				a batch costs one lock hand off per pass instead of one per element.
+ *				The elements are inserted in the order of _items, the function returns
+ *				after all of them are in the queue.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _items    				=   Array of _nItems pointers to memory messages
+ * @param       _nItems    				=   Num of elements in _items
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _items OR one of the elements is NULL, nothing is inserted
+ * @retval 		MUTEX_ERROR			=	Error on the mutex part of the code
+ */
+QueueResult QueueInsertBatch(Queue* const _myQueue, void** _items, size_t _nItems)
+{
+	size_t waitStart = 0;
+	size_t holdStart;
+	size_t nInserted = 0;
+	size_t nMove;
+	size_t i;
+	
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNITIALIZED_ERROR;
+	}
+	
+	if( NULL == _items || IsAnyNull(_items, _nItems) )
+	{
+		return ITEM_UNITIALIZED_ERROR;
+	}
+	
+	SpinThenYield(_myQueue, IS_WRITER, &waitStart);
+	
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	while(nInserted < _nItems)
+	{
+		while(_myQueue->m_capacity == _myQueue->m_numOfElements)
+		{
+			if(0 == waitStart)
+			{
+				waitStart = NowNs();
+			}
+			++(_myQueue->m_nSleepOnEmpty);
+			if(0 != pthread_cond_wait( &(_myQueue->m_cvEmpty),  &(_myQueue->m_mutex) ) )
+			{
+				--(_myQueue->m_nSleepOnEmpty);
+				pthread_mutex_unlock( &(_myQueue->m_mutex) );
+				return MUTEX_ERROR;
+			}
+			--(_myQueue->m_nSleepOnEmpty);
+		}
+		RecordWait(_myQueue, IS_WRITER, &waitStart);
+		holdStart = StartOp(_myQueue);
+		
+		nMove = _myQueue->m_capacity - _myQueue->m_numOfElements;
+		if(nMove > _nItems - nInserted)
+		{
+			nMove = _nItems - nInserted;
+		}
+		
+		for(i = 0; i < nMove; ++i)
+		{
+			_myQueue->m_items[_myQueue->m_tail] = _items[nInserted + i];
+			(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) % (_myQueue->m_capacity)  );
+		}
+		STORE_RELAXED(&_myQueue->m_numOfElements, _myQueue->m_numOfElements + nMove);
+		nInserted += nMove;
+		if(_myQueue->m_numOfElements > _myQueue->m_stats.m_highWaterMark)
+		{
+			_myQueue->m_stats.m_highWaterMark = _myQueue->m_numOfElements;
+		}
+		
+		/* One wakeup for all the new elements */
+		if(0 != WakeReaders(_myQueue, nMove) )
+		{
+			pthread_mutex_unlock( &(_myQueue->m_mutex) );
+			return MUTEX_ERROR;
+		}
+		EndOp(_myQueue, IS_WRITER, nMove, holdStart);
+	}
+	
+	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get up to _maxItems elements from the queue, wait while the queue is empty
+ * @details     The function takes the lock once, reads all the elements there are
+ *				(up to _maxItems) in the queue order and wakes the writers once with a broadcast.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValues    			=   Array of _maxItems pointers to get messages from memory
+ * @param       _maxItems    			=   Num of places in _pValues
+ * @param       _nRemoved    			=   Pointer to get the num of elements that removed
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success, 1 to _maxItems elements removed (0 if _maxItems is 0)
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValues OR _nRemoved is NULL
+ * @retval 		MUTEX_ERROR			=	Error on the mutex part of the code
+ */
+QueueResult QueueRemoveBatch(Queue* const _myQueue, void** _pValues, size_t _maxItems, size_t* _nRemoved)
+{
+	size_t waitStart = 0;
+	size_t holdStart;
+	size_t nMove;
+	size_t i;
+	
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNITIALIZED_ERROR;
+	}
+	
+	if( NULL == _pValues || NULL == _nRemoved )
+	{
+		return ITEM_UNITIALIZED_ERROR;
+	}
+	
+	*_nRemoved = 0;
+	if( 0 == _maxItems )
+	{
+		return QUEUE_SUCCESS;
+	}
+	
+	SpinThenYield(_myQueue, IS_READER, &waitStart);
+	
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	while(0 == _myQueue->m_numOfElements)
+	{
+		if(0 == waitStart)
+		{
+			waitStart = NowNs();
+		}
+		++(_myQueue->m_nSleepOnFull);
+		if(0 != pthread_cond_wait( &(_myQueue->m_cvFull),  &(_myQueue->m_mutex) ) )
+		{
+			--(_myQueue->m_nSleepOnFull);
+			pthread_mutex_unlock( &(_myQueue->m_mutex) );
+			return MUTEX_ERROR;
+		}
+		--(_myQueue->m_nSleepOnFull);
+	}
+	RecordWait(_myQueue, IS_READER, &waitStart);
+	holdStart = StartOp(_myQueue);
+	
+	nMove = (_myQueue->m_numOfElements < _maxItems) ? _myQueue->m_numOfElements : _maxItems;
+	for(i = 0; i < nMove; ++i)
+	{
+		_pValues[i] = (_myQueue->m_items)[_myQueue->m_head];
+		(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) % (_myQueue->m_capacity)  );
+	}
+	STORE_RELAXED(&_myQueue->m_numOfElements, _myQueue->m_numOfElements - nMove);
+	*_nRemoved = nMove;
+	
+	/* One wakeup for all the free places */
+	if(0 != WakeWriters(_myQueue, nMove) )
+	{
+		pthread_mutex_unlock( &(_myQueue->m_mutex) );
+		return MUTEX_ERROR;
+	}
+	EndOp(_myQueue, IS_READER, nMove, holdStart);
 	
 	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
 	{
@@ -370,6 +721,56 @@ size_t QueueSize(Queue* const _myQueue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The counters are changed under the mutex that insert and remove hold
+ *				anyway, so the counting adds no contention and no memory per thread.
+ *				A wait starts when an insert finds the queue full OR a remove finds it
+ *				empty, and ends when the thread can go on, the spin and yield of the wait
+ *				policy included. A batch that waits a few times counts a few waits.
+ *				A snapshot, the other threads may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ * @retval 		MUTEX_ERROR			=	Error on the mutex part of the code
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats)
+{
+	
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNITIALIZED_ERROR;
+	}
+	
+	if( NULL == _stats )
+	{
+		return ITEM_UNITIALIZED_ERROR;
+	}
+	
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	*_stats = _myQueue->m_stats;
+	
+	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -399,3 +800,173 @@ static int InitMutex(Queue* _myQueue)
 	return MUTEX_INIT_SUCCESS;
 }
 /*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsAnyNull(void** _items, size_t _nItems)
+{
+	size_t i;
+	
+	for(i = 0; i < _nItems; ++i)
+	{
+		if( NULL == _items[i] )
+		{
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int WakeReaders(Queue* _myQueue, size_t _nNew)
+{
+	/* Under the mutex, no reader can start to sleep now */
+	if(0 == _myQueue->m_nSleepOnFull)
+	{
+		return 0;
+	}
+	
+	if(1 == _nNew)
+	{
+		return pthread_cond_signal( &(_myQueue->m_cvFull) );
+	}
+	
+	return pthread_cond_broadcast( &(_myQueue->m_cvFull) );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int WakeWriters(Queue* _myQueue, size_t _nFree)
+{
+	/* Under the mutex, no writer can start to sleep now */
+	if(0 == _myQueue->m_nSleepOnEmpty)
+	{
+		return 0;
+	}
+	
+	if(1 == _nFree)
+	{
+		return pthread_cond_signal( &(_myQueue->m_cvEmpty) );
+	}
+	
+	return pthread_cond_broadcast( &(_myQueue->m_cvEmpty) );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void SpinThenYield(Queue* _myQueue, int _isWriter, size_t* _waitStart)
+{
+	size_t i;
+	
+	if( (0 == _myQueue->m_waitPolicy.m_nSpins && 0 == _myQueue->m_waitPolicy.m_nYields)
+		|| IsReady(_myQueue, _isWriter) )
+	{
+		return;
+	}
+	*_waitStart = NowNs();
+	
+	for(i = 0; i < _myQueue->m_waitPolicy.m_nSpins; ++i)
+	{
+		if( IsReady(_myQueue, _isWriter) )
+		{
+			return;
+		}
+		CPU_PAUSE();
+	}
+	
+	for(i = 0; i < _myQueue->m_waitPolicy.m_nYields; ++i)
+	{
+		if( IsReady(_myQueue, _isWriter) )
+		{
+			return;
+		}
+		sched_yield();
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsReady(Queue* _myQueue, int _isWriter)
+{
+	size_t numOfElements = LOAD_RELAXED(&_myQueue->m_numOfElements);
+	
+	return _isWriter ? numOfElements < _myQueue->m_capacity : 0 != numOfElements;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NowNs(void)
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return (size_t)now.tv_sec * 1000000000 + (size_t)now.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RecordWait(Queue* _myQueue, int _isWriter, size_t* _waitStart)
+{
+	size_t blockedNs;
+	
+	if(0 == *_waitStart)
+	{
+		return;
+	}
+	
+	blockedNs = NowNs() - *_waitStart;
+	*_waitStart = 0;
+	
+	++(*(_isWriter ? &_myQueue->m_stats.m_nWaitsOnFull : &_myQueue->m_stats.m_nWaitsOnEmpty));
+	_myQueue->m_stats.m_blockedNs += blockedNs;
+	if(blockedNs > _myQueue->m_stats.m_maxBlockedNs)
+	{
+		_myQueue->m_stats.m_maxBlockedNs = blockedNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t StartOp(Queue* _myQueue)
+{
+	if(0 != (_myQueue->m_nLockHolds)++ % STATS_SAMPLE_RATE)
+	{
+		return 0;
+	}
+	
+	return NowNs();
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _nItems, size_t _holdStart)
+{
+	size_t holdNs;
+	
+	*(_isWriter ? &_myQueue->m_stats.m_nInserts : &_myQueue->m_stats.m_nRemoves) += _nItems;
+	if(0 == _holdStart)
+	{
+		return;
+	}
+	
+	holdNs = NowNs() - _holdStart;
+	++(_myQueue->m_stats.m_nLockHoldSamples);
+	_myQueue->m_stats.m_lockHoldNs += holdNs;
+	if(holdNs > _myQueue->m_stats.m_maxLockHoldNs)
+	{
+		_myQueue->m_stats.m_maxLockHoldNs = holdNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
@@ -0,0 +1,170 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Multi producer multi consumer throughput benchmark for the safeQueue API
+ *
+ *  @details 	N_WRITERS writer threads insert AMOUNT_OF_MSG messages together with
+ *  			QueueInsert and N_READERS reader threads remove them with QueueRemove,
+ *  			the messages per second are printed. Only the common safeQueue API is
+ *  			used, so the makefile builds it with this queue and with the condition
+ *  			mutex queue.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"  /* header file */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & atol */
+#include <time.h> 		/* for clock_gettime */
+#include <pthread.h> 	/* for pthread API */
+
+#define AMOUNT_OF_MSG (4000000) 	/* Num of messages, can be changed from the command line */
+#define QUEUE_SIZE (1024) 			/* The size of the Queue (num of element) */
+#define N_WRITERS (4) 				/* Num of writer threads */
+#define N_READERS (4) 				/* Num of reader threads */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct StreamArgs
+{
+	Queue* m_queue;
+	size_t m_nMessages;		/* Num of messages of this thread */
+	size_t m_sum;			/* Keep the removes from being optimized away */
+} StreamArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	Queue* queue;
+	StreamArgs writers[N_WRITERS];
+	StreamArgs readers[N_READERS];
+	pthread_t writerIDs[N_WRITERS];
+	pthread_t readerIDs[N_READERS];
+	size_t nMessages = AMOUNT_OF_MSG;
+	struct timespec start;
+	struct timespec end;
+	double seconds;
+	size_t i;
+
+	if( 1 < argc )
+	{
+		nMessages = (size_t)atol(argv[1]);
+	}
+	/* Every thread gets the same share, so all the messages go through */
+	nMessages -= nMessages % (N_WRITERS * N_READERS);
+
+	queue = QueueCreate(QUEUE_SIZE);
+	if( NULL == queue )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	for(i = 0; i < N_WRITERS; ++i)
+	{
+		writers[i].m_queue = queue;
+		writers[i].m_nMessages = nMessages / N_WRITERS;
+		writers[i].m_sum = 0;
+	}
+	for(i = 0; i < N_READERS; ++i)
+	{
+		readers[i].m_queue = queue;
+		readers[i].m_nMessages = nMessages / N_READERS;
+		readers[i].m_sum = 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i = 0; i < N_READERS; ++i)
+	{
+		pthread_create(&readerIDs[i], NULL, Reader, &readers[i]);
+	}
+	for(i = 0; i < N_WRITERS; ++i)
+	{
+		pthread_create(&writerIDs[i], NULL, Writer, &writers[i]);
+	}
+	for(i = 0; i < N_WRITERS; ++i)
+	{
+		pthread_join(writerIDs[i], NULL);
+	}
+	for(i = 0; i < N_READERS; ++i)
+	{
+		pthread_join(readerIDs[i], NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("%s: %lu messages, %d writers, %d readers, queue of %d, %.2f M messages/sec\n", argv[0],
+			(unsigned long)nMessages, N_WRITERS, N_READERS, QUEUE_SIZE, (double)nMessages / seconds / 1e6);
+
+	QueueDestroy(&queue, NULL);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		QueueInsert(args->m_queue, args);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	void* value = NULL;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; ++i)
+	{
+		QueueRemove(args->m_queue, &value);
+		args->m_sum += (NULL != value);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
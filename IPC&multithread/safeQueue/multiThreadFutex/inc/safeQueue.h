@@ -0,0 +1,240 @@
+/**
+ *  @file 		safeQueue.h
+ *  @brief 		header file for API functions for manging futex multithreads safeQueue
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while multithreads operate on it as reader threads and/or as writer threads.
+ *				The memory space implemented as a generic queue.
+ *				The multithreads implemented with Linux futexes: the lock and the waits
+ *				are atomic operations on words of the queue, a system call is made only
+ *				when a thread has to sleep OR another thread really sleeps.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning Linux only.
+ *  @warning QueueDestroy: The safe queue can't protect destroy thread from consumer/producer thread
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __SAFE_QUEUE_H__
+#define __SAFE_QUEUE_H__
+
+#include <stdlib.h>		/* for define size_t */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Queue Queue;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef int	(*QueueElementAction)(void* _element, size_t _index, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum Queue_Result {
+	QUEUE_SUCCESS,
+	QUEUE_UNINITIALIZED_ERROR,	/* Uninitialized Queue error */
+	ITEM_UNINITIALIZED_ERROR,	/* Uninitialized item error */
+	SEMAPHORE_ERROR,			/* Error on the semaphore part of the code */
+	MUTEX_ERROR,				/* Error on the mutex part of the code */
+	QUEUE_OVERFLOW,				/* Try insert to a full queue */
+	QUEUE_UNDERFLOW				/* Try remove from an empty queue */
+} QueueResult;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* What the threads of the queue did and how long they waited, see QueueGetStats */
+typedef struct QueueStats {
+	size_t m_nInserts;			/* Num of elements inserted */
+	size_t m_nRemoves;			/* Num of elements removed */
+	size_t m_nWaitsOnFull;		/* Num of times a writer found the queue full and waited */
+	size_t m_nWaitsOnEmpty;		/* Num of times a reader found the queue empty and waited */
+	size_t m_blockedNs;			/* Total time of all the waits, in nano seconds */
+	size_t m_maxBlockedNs;		/* The longest wait, in nano seconds */
+	size_t m_nLockHoldSamples;	/* Num of lock holds that were timed, about one of every 64 */
+	size_t m_lockHoldNs;		/* Total time of the timed lock holds, in nano seconds */
+	size_t m_maxLockHoldNs;		/* The longest timed lock hold, in nano seconds */
+	size_t m_highWaterMark;		/* The max num of elements that were in the queue at once */
+} QueueStats;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function create a new queue and return the memory
+ * @details     The function create a new queue in capacity the user sent as size and return the pointer to it.
+ *
+ * @param       _initialCapacity        =   Number of elements that can be stored initially
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL					= 	On error when initalize
+ * @retval 		_myQueue				=	On success
+ */
+Queue* QueueCreate(size_t _initialCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Dynamically deallocate a previously allocated safeQueue
+ *
+ * @param 		_Queue					= 	Queue to be deallocated.
+ * @param 		_elementDestroy			= 	A function pointer to be used to destroy all elements in the vector
+ *             or a null if no such destroy is required
+ *
+ * @return void
+ */
+void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) );
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue, wait while the queue is full
+ * @details     This function write a new msg (pointer) in the join queue when success,
+ *				and return to the user status that indicate in which state the function ended.
+ *				No system call when the lock is free and no reader sleeps.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ */
+QueueResult QueueInsert(Queue* const _myQueue, void* _data);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue, wait while the queue is empty
+ * @details     This function read from the join queue the pointer to the msg,
+ *				and return to the user the pointer when success, otherwise
+ *				return status error.
+ *				No system call when the lock is free and no writer sleeps.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ */
+QueueResult QueueRemove(Queue* const _myQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue if there is room, never wait for room
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_OVERFLOW			=	When the queue is full
+ */
+QueueResult QueueTryInsert(Queue* const _myQueue, void* _data);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue if there is one, never wait for one
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW			=	When the queue is empty
+ */
+QueueResult QueueTryRemove(Queue* const _myQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the orignal memory buffer capacity in the queue
+ * @details     The function return the orignal memory buffer capacity in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The orignal memory buffer capacity OR error
+ *
+ * @retval		0						= 	On error when initalize OR when capacity is 0
+ * @retval 		capacity				=	On success
+ */
+size_t QueueCapacity(Queue* const _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return The number of elements in the queue
+ * @details     The function return the number of elements in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The number of elements in the queue OR error
+ *
+ * @retval		0						= 	On error when initalize OR when size is 0
+ * @retval 		size					=	On success
+ */
+size_t QueueSize(Queue* const _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The counters are changed under the lock that insert and remove hold
+ *				anyway, so the counting adds no contention and no memory per thread.
+ *				A wait is counted when QueueInsert finds the queue full OR QueueRemove
+ *				finds it empty, before it sleeps, and its time is added when the thread
+ *				has the lock again with room (an element), the try functions never wait. The try functions that succeed
+ *				are counted as inserts (removes) and lock holds like the others.
+ *				A snapshot, writers and readers may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __SAFE_QUEUE_H__ */
@@ -0,0 +1,742 @@
+/**
+ *  @file 		safeQueue.c
+ *  @brief 		src file for API functions for manging futex multithreads safeQueue
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while multithreads operate on it as reader threads and/or as writer threads.
+ *				The memory space implemented as a generic queue.
+ *				m_lock is a futex mutex (U. Drepper, "Futexes Are Tricky"): UNLOCKED, LOCKED
+ *				OR LOCKED_WITH_SLEEPERS, only the last one costs a FUTEX_WAKE on unlock.
+ *				A thread that finds the queue full (empty) counts itself in m_nSleepOnFull
+ *				(m_nSleepOnEmpty) and reads m_notFullSeq (m_notEmptySeq) under the lock,
+ *				then unlocks and sleeps on the sequence word. The other side changes the
+ *				sequence and wakes one thread only when the count is not 0, a change after
+ *				the read makes FUTEX_WAIT return at once, so no wake is lost.
+ *				All the fields insert and remove touch are on the first cache line.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning Linux only.
+ *  @warning QueueDestroy: The safe queue can't protect destroy thread from consumer/producer thread
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _DEFAULT_SOURCE			/* for syscall & posix_memalign & clock_gettime */
+
+#include "safeQueue.h"			/* header file */
+#include <stdlib.h> 			/* for size_t & posix_memalign & malloc */
+#include <unistd.h> 			/* for syscall */
+#include <sys/syscall.h> 		/* for SYS_futex */
+#include <linux/futex.h> 		/* for FUTEX_WAIT_PRIVATE & FUTEX_WAKE_PRIVATE */
+#include <time.h> 				/* for clock_gettime */
+
+#define CACHE_LINE (64)
+#define UNLOCKED				(0)
+#define LOCKED					(1)
+#define LOCKED_WITH_SLEEPERS	(2)
+#define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define IS_WRITER				(1)
+#define IS_READER				(0)
+#define STATS_SAMPLE_RATE		(64)	/* Time one of every 64 lock holds */
+
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+struct Queue
+{
+	/* The first cache line, everything insert and remove touch */
+	int m_lock;					/* Futex word: UNLOCKED, LOCKED OR LOCKED_WITH_SLEEPERS */
+	int m_notEmptySeq;			/* Futex word of the readers, changed for every wake */
+	int m_notFullSeq;			/* Futex word of the writers, changed for every wake */
+	unsigned int m_nSleepOnEmpty;	/* Num of readers that sleep on m_notEmptySeq now */
+	unsigned int m_nSleepOnFull;	/* Num of writers that sleep on m_notFullSeq now */
+	size_t m_head; 				/* Index to the first message to remove from the structuer */
+	size_t m_tail; 				/* Index to the place of the next message to insert */
+	size_t m_numOfElements; 	/* The current number of message in the structuer */
+	size_t m_capacity; 			/* The size of the structuer */
+	void** m_items;				/* Pointer to the actual items */
+	char m_pad[CACHE_LINE];		/* Nothing else on the cache line of the fields */
+	QueueStats m_stats;			/* Changed and read under the lock, that the thread holds anyway */
+	size_t m_nLockHolds; 		/* Num of lock holds, picks the timed ones */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void Lock(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void Unlock(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called with the lock, sleep on _seq until the other side changes it, return with the lock
+ */
+static void Sleep(Queue* _myQueue, int* _seq, unsigned int* _nSleepers);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called with the lock, change _seq and take one off _nSleepers if a thread sleeps on it
+ * @return 	1 if Unlock should be followed by WakeOne, otherwise 0
+ */
+static int PrepareWake(int* _seq, unsigned int* _nSleepers);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void WakeOne(int* _futexWord);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void PutItem(Queue* _myQueue, void* _data);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* TakeItem(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return the monotonic clock in nano seconds
+ */
+static size_t NowNs(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Add the wait that started at _waitStart to the blocked time
+ */
+static void RecordBlocked(Queue* _myQueue, size_t _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called when the lock is taken for work, return the time to time the
+ *			hold with OR 0 if this hold is not sampled
+ */
+static size_t StartOp(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called before the unlock, count one element and the hold from _holdStart
+ */
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _holdStart);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function create a new queue and return the memory
+ * @details     The function create a new queue in capacity the user sent as size and return the pointer to it.
+ *
+ * @param       _initialCapacity        =   Number of elements that can be stored initially
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL					= 	On error when initalize
+ * @retval 		_myQueue				=	On success
+ */
+Queue* QueueCreate(size_t _initialCapacity)
+{
+	Queue* myQueue;
+	void* memory;
+	QueueStats emptyStats = {0};
+
+	if( 0 == _initialCapacity || ((size_t)-1) / sizeof(void*) < _initialCapacity )
+	{
+		return NULL;
+	}
+
+	/* The hot fields are the first cache line of the queue */
+	if( 0 != posix_memalign(&memory, CACHE_LINE, sizeof(Queue)) )
+	{
+		return NULL;
+	}
+	myQueue = (Queue*)memory;
+
+	myQueue->m_items = (void**)malloc( _initialCapacity * sizeof(void*) );
+	if( NULL == myQueue->m_items)
+	{
+		free(myQueue);
+		return NULL;
+	}
+
+	myQueue->m_lock = UNLOCKED;
+	myQueue->m_notEmptySeq = 0;
+	myQueue->m_notFullSeq = 0;
+	myQueue->m_nSleepOnEmpty = 0;
+	myQueue->m_nSleepOnFull = 0;
+	myQueue->m_head = 0;
+	myQueue->m_tail = 0;
+	myQueue->m_numOfElements = 0;
+	myQueue->m_capacity = _initialCapacity;
+	myQueue->m_stats = emptyStats;
+	myQueue->m_nLockHolds = 0;
+
+	return myQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Dynamically deallocate a previously allocated safeQueue
+ *
+ * @param 		_Queue					= 	Queue to be deallocated.
+ * @param 		_elementDestroy			= 	A function pointer to be used to destroy all elements in the vector
+ *             or a null if no such destroy is required
+ *
+ * @return void
+ */
+void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
+{
+	if(NULL == _myQueue || NULL == *_myQueue)
+	{
+		return;
+	}
+
+	if( NULL != _elementDestroy )
+	{
+		while( 0 != (*_myQueue)->m_numOfElements )
+		{
+			(*_elementDestroy)( TakeItem(*_myQueue) );
+		}
+	}
+
+	free((*_myQueue)->m_items);
+	free(*_myQueue);
+	*_myQueue = NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue, wait while the queue is full
+ * @details     This function write a new msg (pointer) in the join queue when success,
+ *				and return to the user status that indicate in which state the function ended.
+ *				No system call when the lock is free and no reader sleeps.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ */
+QueueResult QueueInsert(Queue* const _myQueue, void* _data)
+{
+	int isWake;
+	size_t waitStart;
+	size_t holdStart;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _data )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	Lock(_myQueue);
+
+	if(_myQueue->m_capacity == _myQueue->m_numOfElements)
+	{
+		++(_myQueue->m_stats.m_nWaitsOnFull);
+		waitStart = NowNs();
+		while(_myQueue->m_capacity == _myQueue->m_numOfElements)
+		{
+			Sleep(_myQueue, &_myQueue->m_notFullSeq, &_myQueue->m_nSleepOnFull);
+		}
+		RecordBlocked(_myQueue, waitStart);
+	}
+	holdStart = StartOp(_myQueue);
+
+	PutItem(_myQueue, _data);
+	isWake = PrepareWake(&_myQueue->m_notEmptySeq, &_myQueue->m_nSleepOnEmpty);
+
+	EndOp(_myQueue, IS_WRITER, holdStart);
+	Unlock(_myQueue);
+
+	if( isWake )
+	{
+		WakeOne(&_myQueue->m_notEmptySeq);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue, wait while the queue is empty
+ * @details     This function read from the join queue the pointer to the msg,
+ *				and return to the user the pointer when success, otherwise
+ *				return status error.
+ *				No system call when the lock is free and no writer sleeps.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ */
+QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
+{
+	int isWake;
+	size_t waitStart;
+	size_t holdStart;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _pValue )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	Lock(_myQueue);
+
+	if(0 == _myQueue->m_numOfElements)
+	{
+		++(_myQueue->m_stats.m_nWaitsOnEmpty);
+		waitStart = NowNs();
+		while(0 == _myQueue->m_numOfElements)
+		{
+			Sleep(_myQueue, &_myQueue->m_notEmptySeq, &_myQueue->m_nSleepOnEmpty);
+		}
+		RecordBlocked(_myQueue, waitStart);
+	}
+	holdStart = StartOp(_myQueue);
+
+	*_pValue = TakeItem(_myQueue);
+	isWake = PrepareWake(&_myQueue->m_notFullSeq, &_myQueue->m_nSleepOnFull);
+
+	EndOp(_myQueue, IS_READER, holdStart);
+	Unlock(_myQueue);
+
+	if( isWake )
+	{
+		WakeOne(&_myQueue->m_notFullSeq);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function put a new element into queue if there is room, never wait for room
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _data    				=   Pointer to memory message
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_OVERFLOW			=	When the queue is full
+ */
+QueueResult QueueTryInsert(Queue* const _myQueue, void* _data)
+{
+	int isWake;
+	size_t holdStart;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _data )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	Lock(_myQueue);
+
+	if(_myQueue->m_capacity == _myQueue->m_numOfElements)
+	{
+		Unlock(_myQueue);
+		return QUEUE_OVERFLOW;
+	}
+	holdStart = StartOp(_myQueue);
+
+	PutItem(_myQueue, _data);
+	isWake = PrepareWake(&_myQueue->m_notEmptySeq, &_myQueue->m_nSleepOnEmpty);
+
+	EndOp(_myQueue, IS_WRITER, holdStart);
+	Unlock(_myQueue);
+
+	if( isWake )
+	{
+		WakeOne(&_myQueue->m_notEmptySeq);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function get the element from the queue if there is one, never wait for one
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValue    				=   Pointer to get message from memory
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW			=	When the queue is empty
+ */
+QueueResult QueueTryRemove(Queue* const _myQueue, void** _pValue)
+{
+	int isWake;
+	size_t holdStart;
+
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _pValue )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	Lock(_myQueue);
+
+	if(0 == _myQueue->m_numOfElements)
+	{
+		Unlock(_myQueue);
+		return QUEUE_UNDERFLOW;
+	}
+	holdStart = StartOp(_myQueue);
+
+	*_pValue = TakeItem(_myQueue);
+	isWake = PrepareWake(&_myQueue->m_notFullSeq, &_myQueue->m_nSleepOnFull);
+
+	EndOp(_myQueue, IS_READER, holdStart);
+	Unlock(_myQueue);
+
+	if( isWake )
+	{
+		WakeOne(&_myQueue->m_notFullSeq);
+	}
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the orignal memory buffer capacity in the queue
+ * @details     The function return the orignal memory buffer capacity in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The orignal memory buffer capacity OR error
+ *
+ * @retval		0						= 	On error when initalize OR when capacity is 0
+ * @retval 		capacity				=	On success
+ */
+size_t QueueCapacity(Queue* const _myQueue)
+{
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	return _myQueue->m_capacity;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return The number of elements in the queue
+ * @details     The function return the number of elements in the queue from a given queue.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ *
+ * @return		The number of elements in the queue OR error
+ *
+ * @retval		0						= 	On error when initalize OR when size is 0
+ * @retval 		size					=	On success
+ */
+size_t QueueSize(Queue* const _myQueue)
+{
+	size_t counter;
+
+	if( NULL == _myQueue )
+	{
+		return 0;
+	}
+
+	Lock(_myQueue);
+	counter = _myQueue->m_numOfElements;
+	Unlock(_myQueue);
+
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The counters are changed under the lock that insert and remove hold
+ *				anyway, so the counting adds no contention and no memory per thread.
+ *				A wait is counted when QueueInsert finds the queue full OR QueueRemove
+ *				finds it empty, before it sleeps, and its time is added when the thread
+ *				has the lock again with room (an element), the try functions never wait. The try functions that succeed
+ *				are counted as inserts (removes) and lock holds like the others.
+ *				A snapshot, writers and readers may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+
+	if( NULL == _stats )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+
+	Lock(_myQueue);
+	*_stats = _myQueue->m_stats;
+	Unlock(_myQueue);
+
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void Lock(Queue* _myQueue)
+{
+	int state = UNLOCKED;
+
+	/* Free lock: one compare and swap, no system call */
+	if( __atomic_compare_exchange_n(&_myQueue->m_lock, &state, LOCKED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) )
+	{
+		return;
+	}
+
+	/* Mark that a thread sleeps, so the owner wakes one on unlock */
+	if(LOCKED_WITH_SLEEPERS != state)
+	{
+		state = __atomic_exchange_n(&_myQueue->m_lock, LOCKED_WITH_SLEEPERS, __ATOMIC_ACQUIRE);
+	}
+
+	while(UNLOCKED != state)
+	{
+		syscall(SYS_futex, &_myQueue->m_lock, FUTEX_WAIT_PRIVATE, LOCKED_WITH_SLEEPERS, NULL, NULL, 0);
+		state = __atomic_exchange_n(&_myQueue->m_lock, LOCKED_WITH_SLEEPERS, __ATOMIC_ACQUIRE);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void Unlock(Queue* _myQueue)
+{
+	if(LOCKED_WITH_SLEEPERS == __atomic_exchange_n(&_myQueue->m_lock, UNLOCKED, __ATOMIC_RELEASE) )
+	{
+		WakeOne(&_myQueue->m_lock);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void Sleep(Queue* _myQueue, int* _seq, unsigned int* _nSleepers)
+{
+	int seq = __atomic_load_n(_seq, __ATOMIC_RELAXED);
+
+	++(*_nSleepers);
+	Unlock(_myQueue);
+
+	/* Returns at once if the sequence already changed, EINTR is a wake as well */
+	syscall(SYS_futex, _seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+
+	Lock(_myQueue);
+
+	/* A waker took this thread off the count when it changed the sequence */
+	if(seq == __atomic_load_n(_seq, __ATOMIC_RELAXED) )
+	{
+		--(*_nSleepers);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int PrepareWake(int* _seq, unsigned int* _nSleepers)
+{
+	if(0 == *_nSleepers)
+	{
+		return 0;
+	}
+
+	/* The thread to wake is off the count now, the next insert (remove) wakes another one */
+	--(*_nSleepers);
+	__atomic_add_fetch(_seq, 1, __ATOMIC_RELAXED);
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void WakeOne(int* _futexWord)
+{
+	syscall(SYS_futex, _futexWord, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void PutItem(Queue* _myQueue, void* _data)
+{
+	_myQueue->m_items[_myQueue->m_tail] = _data;
+	_myQueue->m_tail = (_myQueue->m_capacity - 1 == _myQueue->m_tail) ? 0 : _myQueue->m_tail + 1;
+	++(_myQueue->m_numOfElements);
+	if(_myQueue->m_numOfElements > _myQueue->m_stats.m_highWaterMark)
+	{
+		_myQueue->m_stats.m_highWaterMark = _myQueue->m_numOfElements;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* TakeItem(Queue* _myQueue)
+{
+	void* item = _myQueue->m_items[_myQueue->m_head];
+
+	_myQueue->m_head = (_myQueue->m_capacity - 1 == _myQueue->m_head) ? 0 : _myQueue->m_head + 1;
+	--(_myQueue->m_numOfElements);
+
+	return item;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NowNs(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (size_t)now.tv_sec * 1000000000 + (size_t)now.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RecordBlocked(Queue* _myQueue, size_t _waitStart)
+{
+	size_t blockedNs = NowNs() - _waitStart;
+
+	_myQueue->m_stats.m_blockedNs += blockedNs;
+	if(blockedNs > _myQueue->m_stats.m_maxBlockedNs)
+	{
+		_myQueue->m_stats.m_maxBlockedNs = blockedNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t StartOp(Queue* _myQueue)
+{
+	if(0 != (_myQueue->m_nLockHolds)++ % STATS_SAMPLE_RATE)
+	{
+		return 0;
+	}
+
+	return NowNs();
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _holdStart)
+{
+	size_t holdNs;
+
+	++(*(_isWriter ? &_myQueue->m_stats.m_nInserts : &_myQueue->m_stats.m_nRemoves));
+	if(0 == _holdStart)
+	{
+		return;
+	}
+
+	holdNs = NowNs() - _holdStart;
+	++(_myQueue->m_stats.m_nLockHoldSamples);
+	_myQueue->m_stats.m_lockHoldNs += holdNs;
+	if(holdNs > _myQueue->m_stats.m_maxLockHoldNs)
+	{
+		_myQueue->m_stats.m_maxLockHoldNs = holdNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
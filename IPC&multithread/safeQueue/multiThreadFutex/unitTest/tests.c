@@ -0,0 +1,481 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Set of tests for src futex multithreads safeQueue API functions
+ *
+ *  @details 	The API stores functions to operate and manage the same memory
+ *				space while multithreads operate on it as reader threads and/or as writer threads.
+ *				The memory space implemented as a generic queue.
+ *				The multithreads implemented with Linux futexes.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+
+#include "safeQueue.h"  /* header file */
+#include "matan_test.h" /* define test macros file */
+#include <stdlib.h> 	/* for size_t & malloc & calloc */
+#include <stdio.h>      /* for printf */
+#include <pthread.h> 	/* for pthread API */
+#include <sched.h> 		/* for sched_yield */
+
+#define QUEUE_SIZE (10) 		/* The size of the Queue (num of element) */
+#define SMALL_QUEUE_SIZE (2) 	/* The size of the Queue in the blocking test, threads sleep a lot */
+#define AMOUNT_OF_MSG (300000) 	/* Num of messages in the threads tests, divided by 3, 4 and 5 */
+#define MAX_THREADS (5)
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Shared
+{
+	Queue* m_queue;
+	char* m_messages;		/* The messages are the addresses m_messages + i */
+	size_t* m_counters;		/* Num of times every message was removed */
+	size_t m_nWriters;
+	size_t m_nReaders;
+	int m_isBlocking;		/* Use QueueInsert/QueueRemove OR the try functions */
+} Shared;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct ThreadArgs
+{
+	Shared* m_shared;
+	size_t m_id;
+} ThreadArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Writer _id inserts the messages _id, _id + nWriters, ...
+ */
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Every reader removes AMOUNT_OF_MSG / nReaders messages and counts them
+ */
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Run the writers and the readers, check every message was removed once
+ */
+static int RunThreads(size_t _size, size_t _nWriters, size_t _nReaders, int _isBlocking);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+static size_t g_nDestroyed = 0;
+
+
+
+
+/******************************* Tests functions ******************************/
+/*----------------------------------------------------------------------------*/
+TEST(Test001_CreateAndNullArguments)
+	Queue* ip;
+	void* value;
+	int item;
+
+	ASSERT_THAT( NULL == QueueCreate(0) );
+	ASSERT_THAT( NULL == QueueCreate((size_t)-1) );
+
+	ip = QueueCreate(QUEUE_SIZE);
+	ASSERT_THAT( NULL != ip && QUEUE_SIZE == QueueCapacity(ip) && 0 == QueueSize(ip) );
+	ASSERT_THAT( QUEUE_UNINITIALIZED_ERROR == QueueInsert(NULL, &item) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueInsert(ip, NULL) );
+	ASSERT_THAT( QUEUE_UNINITIALIZED_ERROR == QueueRemove(NULL, &value) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueRemove(ip, NULL) );
+	ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == QueueTryRemove(ip, NULL) );
+	ASSERT_THAT( 0 == QueueCapacity(NULL) && 0 == QueueSize(NULL) );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( NULL == ip );
+	QueueDestroy(&ip, NULL);
+	QueueDestroy(NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test002_TryFunctions_FullAndEmpty)
+	Queue* ip;
+	int items[QUEUE_SIZE + 1];
+	void* value;
+	size_t i;
+	int result = 1;
+
+	ip = QueueCreate(QUEUE_SIZE);
+	result = ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) );
+
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueTryInsert(ip, &items[i]) );
+	}
+	result = result && ( QUEUE_OVERFLOW == QueueTryInsert(ip, &items[QUEUE_SIZE]) );
+	result = result && ( QUEUE_SIZE == QueueSize(ip) );
+
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueTryRemove(ip, &value) && &items[i] == value );
+	}
+	result = result && ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) && 0 == QueueSize(ip) );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test003_WrapAroundKeepOrder)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* value;
+	size_t round;
+	size_t i;
+	int result = 1;
+
+	ip = QueueCreate(QUEUE_SIZE);
+
+	/* 7 in and 7 out, the head and the tail go around the queue many times */
+	for(round = 0; round < 1000; ++round)
+	{
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[(round + i) % QUEUE_SIZE]) );
+		}
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+			result = result && ( &items[(round + i) % QUEUE_SIZE] == value );
+		}
+	}
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test004_4Consumers_4Producers_TryFunctions)
+	ASSERT_THAT( RunThreads(QUEUE_SIZE, 4, 4, 0) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test005_3Consumers_5Producers_Blocking)
+	ASSERT_THAT( RunThreads(SMALL_QUEUE_SIZE, 5, 3, 1) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test006_5Consumers_3Producers_Blocking)
+	ASSERT_THAT( RunThreads(SMALL_QUEUE_SIZE, 3, 5, 1) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test007_DestroyWithElements)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* value;
+	size_t i;
+
+	ip = QueueCreate(QUEUE_SIZE);
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		QueueInsert(ip, &items[i]);
+	}
+	QueueRemove(ip, &value);
+	QueueRemove(ip, &value);
+	QueueInsert(ip, &items[0]);
+
+	g_nDestroyed = 0;
+	QueueDestroy(&ip, CountDestroy);
+	ASSERT_THAT( QUEUE_SIZE - 1 == g_nDestroyed );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test008_Stats_NullArgumentsAndTryFunctions)
+	Queue* ip;
+	QueueStats stats;
+	int items[2];
+	void* value;
+	int result;
+
+	ip = QueueCreate(2);
+	result = ( QUEUE_UNINITIALIZED_ERROR == QueueGetStats(NULL, &stats) );
+	result = result && ( ITEM_UNINITIALIZED_ERROR == QueueGetStats(ip, NULL) );
+
+	/* The try functions never wait, a full OR empty queue is not counted. The first lock hold is timed */
+	result = result && ( QUEUE_UNDERFLOW == QueueTryRemove(ip, &value) );
+	result = result && ( QUEUE_SUCCESS == QueueTryInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[1]) );
+	result = result && ( QUEUE_OVERFLOW == QueueTryInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 2 == stats.m_nInserts && 1 == stats.m_nRemoves && 2 == stats.m_highWaterMark );
+	result = result && ( 0 == stats.m_nWaitsOnFull && 0 == stats.m_nWaitsOnEmpty && 0 == stats.m_blockedNs );
+	result = result && ( 1 == stats.m_nLockHoldSamples && stats.m_maxLockHoldNs == stats.m_lockHoldNs );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test009_Stats_WaitOnEmptyAndFull)
+	Queue* ip;
+	QueueStats stats;
+	pthread_t threadID;
+	int items[2];
+	void* value;
+	int result;
+
+	ip = QueueCreate(2);
+
+	/* The reader finds the queue empty, it is counted before it sleeps */
+	pthread_create(&threadID, NULL, RemoveOne, ip);
+	while( QUEUE_SUCCESS == QueueGetStats(ip, &stats) && 0 == stats.m_nWaitsOnEmpty )
+	{
+		sched_yield();
+	}
+	result = ( QUEUE_SUCCESS == QueueInsert(ip, &items[0]) );
+	pthread_join(threadID, NULL);
+
+	/* The writer finds the queue full */
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[0]) );
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[1]) );
+	pthread_create(&threadID, NULL, InsertOne, ip);
+	while( QUEUE_SUCCESS == QueueGetStats(ip, &stats) && 0 == stats.m_nWaitsOnFull )
+	{
+		sched_yield();
+	}
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	pthread_join(threadID, NULL);
+
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 1 == stats.m_nWaitsOnEmpty && 1 == stats.m_nWaitsOnFull );
+	result = result && ( 0 < stats.m_maxBlockedNs && stats.m_maxBlockedNs < stats.m_blockedNs );
+	result = result && ( 4 == stats.m_nInserts && 2 == stats.m_nRemoves && 2 == stats.m_highWaterMark );
+
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/********************************* Test Suite *********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test futex safeQueue Module)
+	PRINT(Test001_CreateAndNullArguments)
+	PRINT(Test002_TryFunctions_FullAndEmpty)
+	PRINT(Test003_WrapAroundKeepOrder)
+	PRINT(Test004_4Consumers_4Producers_TryFunctions)
+	PRINT(Test005_3Consumers_5Producers_Blocking)
+	PRINT(Test006_5Consumers_3Producers_Blocking)
+	PRINT(Test007_DestroyWithElements)
+	PRINT(Test008_Stats_NullArgumentsAndTryFunctions)
+	PRINT(Test009_Stats_WaitOnEmptyAndFull)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	Shared* shared = args->m_shared;
+	size_t i;
+
+	for(i = args->m_id; i < AMOUNT_OF_MSG; i += shared->m_nWriters)
+	{
+		if( shared->m_isBlocking )
+		{
+			QueueInsert(shared->m_queue, shared->m_messages + i);
+		}
+		else
+		{
+			while( QUEUE_OVERFLOW == QueueTryInsert(shared->m_queue, shared->m_messages + i) )
+			{
+				sched_yield();
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	Shared* shared = args->m_shared;
+	void* value = NULL;
+	size_t i;
+
+	for(i = 0; i < AMOUNT_OF_MSG / shared->m_nReaders; ++i)
+	{
+		if( shared->m_isBlocking )
+		{
+			QueueRemove(shared->m_queue, &value);
+		}
+		else
+		{
+			while( QUEUE_UNDERFLOW == QueueTryRemove(shared->m_queue, &value) )
+			{
+				sched_yield();
+			}
+		}
+
+		__atomic_add_fetch(&shared->m_counters[(char*)value - shared->m_messages], 1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int RunThreads(size_t _size, size_t _nWriters, size_t _nReaders, int _isBlocking)
+{
+	Shared shared;
+	pthread_t writers[MAX_THREADS];
+	pthread_t readers[MAX_THREADS];
+	ThreadArgs writerArgs[MAX_THREADS];
+	ThreadArgs readerArgs[MAX_THREADS];
+	size_t i;
+	int result = 1;
+
+	shared.m_queue = QueueCreate(_size);
+	shared.m_messages = (char*)malloc(AMOUNT_OF_MSG);
+	shared.m_counters = (size_t*)calloc(AMOUNT_OF_MSG, sizeof(size_t));
+	shared.m_nWriters = _nWriters;
+	shared.m_nReaders = _nReaders;
+	shared.m_isBlocking = _isBlocking;
+	if( NULL == shared.m_queue || NULL == shared.m_messages || NULL == shared.m_counters )
+	{
+		QueueDestroy(&shared.m_queue, NULL);
+		free(shared.m_messages);
+		free(shared.m_counters);
+		return 0;
+	}
+
+	for(i = 0; i < _nReaders; ++i)
+	{
+		readerArgs[i].m_shared = &shared;
+		readerArgs[i].m_id = i;
+		pthread_create(&readers[i], NULL, Reader, &readerArgs[i]);
+	}
+	for(i = 0; i < _nWriters; ++i)
+	{
+		writerArgs[i].m_shared = &shared;
+		writerArgs[i].m_id = i;
+		pthread_create(&writers[i], NULL, Writer, &writerArgs[i]);
+	}
+
+	for(i = 0; i < _nWriters; ++i)
+	{
+		pthread_join(writers[i], NULL);
+	}
+	for(i = 0; i < _nReaders; ++i)
+	{
+		pthread_join(readers[i], NULL);
+	}
+
+	for(i = 0; i < AMOUNT_OF_MSG; ++i)
+	{
+		result = result && ( 1 == shared.m_counters[i] );
+	}
+	result = result && ( 0 == QueueSize(shared.m_queue) );
+
+	QueueDestroy(&shared.m_queue, NULL);
+	free(shared.m_messages);
+	free(shared.m_counters);
+
+	return result;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _item)
+{
+	if( NULL != _item )
+	{
+		++g_nDestroyed;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue)
+{
+	static int item;
+
+	QueueInsert(_queue, &item);
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue)
+{
+	void* value;
+
+	QueueRemove(_queue, &value);
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
@@ -31,6 +31,7 @@
 #define MSG_SIZE (10)
 #define AMOUNT_OF_MSG (20)
 #define QUEUE_SIZE (10) 		/* SIZE = The size of the Queue (num of element) */  
+#define BATCH_SIZE (4) 			/* Max num of elements a batch consumer removes at once */
 #define DEBUG_ERRORS	(0)
 #define DEBUG_PRINT_MSG	(0)
 
@@ -66,6 +67,26 @@ static void* ConsumerHalf(void* _queue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+static void* BatchProducer(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BatchConsumer(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 static void* GenerateString();
 /*----------------------------------------------------------------------------*/
@@ -612,6 +633,224 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+TEST(Test007_Batch_NullArguments)
+	Queue* ip;
+	int items[3];
+	void* pItems[3];
+	void* values[3];
+	size_t nRemoved = 1;
+	int result;
+	
+	pItems[0] = &items[0];
+	pItems[1] = NULL;
+	pItems[2] = &items[2];
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	result = ( QUEUE_UNITIALIZED_ERROR == QueueInsertBatch(NULL, pItems, 3) );
+	result = result && ( ITEM_UNITIALIZED_ERROR == QueueInsertBatch(ip, NULL, 3) );
+	result = result && ( ITEM_UNITIALIZED_ERROR == QueueInsertBatch(ip, pItems, 3) && 0 == QueueSize(ip) );
+	result = result && ( QUEUE_UNITIALIZED_ERROR == QueueRemoveBatch(NULL, values, 3, &nRemoved) );
+	result = result && ( ITEM_UNITIALIZED_ERROR == QueueRemoveBatch(ip, NULL, 3, &nRemoved) );
+	result = result && ( ITEM_UNITIALIZED_ERROR == QueueRemoveBatch(ip, values, 3, NULL) );
+	
+	/* Nothing to move, nothing to wait for */
+	result = result && ( QUEUE_SUCCESS == QueueInsertBatch(ip, pItems, 0) );
+	result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values, 0, &nRemoved) && 0 == nRemoved );
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test008_Batch_KeepOrderAndWrapAround)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* pItems[QUEUE_SIZE];
+	void* values[QUEUE_SIZE];
+	size_t nRemoved;
+	size_t round;
+	size_t i;
+	int result = 1;
+	
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		pItems[i] = &items[i];
+	}
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	
+	/* 7 in and 3 + 4 out, the head and the tail go around the queue */
+	for(round = 0; round < 100; ++round)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueInsertBatch(ip, pItems, 7) && 7 == QueueSize(ip) );
+		result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values, 3, &nRemoved) && 3 == nRemoved );
+		result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values + 3, QUEUE_SIZE, &nRemoved) && 4 == nRemoved );
+		
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( pItems[i] == values[i] );
+		}
+	}
+	
+	result = result && ( 0 == QueueSize(ip) );
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test009_5Consumers_5Producers_Batch)
+	Queue* ip;
+	pthread_t producerIDs[5];
+	pthread_t consumerIDs[5];
+	size_t queueSize;
+	size_t i;
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	if(NULL == ip)
+	{
+		printf("Allocation Error on QueueCreate\n");
+	}
+	
+	/* Every producer inserts more than the capacity in one call */
+	for(i = 0; i < 5; ++i)
+	{
+		if( 0 != pthread_create(&producerIDs[i], NULL, BatchProducer, ip) )
+		{
+			QueueDestroy(&ip, NULL);
+		}
+	}
+	
+	for(i = 0; i < 5; ++i)
+	{
+		if( 0 != pthread_create(&consumerIDs[i], NULL, BatchConsumer, ip) )
+		{
+			QueueDestroy(&ip, NULL);
+		}
+	}
+	
+	for(i = 0; i < 5; ++i)
+	{
+		pthread_join(producerIDs[i], NULL);
+		pthread_join(consumerIDs[i], NULL);
+	}
+	
+	queueSize = QueueSize(ip);
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( 0 == queueSize );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test010_BatchAndSingleTogether)
+	Queue* ip;
+	pthread_t producerIDs[2];
+	pthread_t consumerIDs[2];
+	size_t queueSize;
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	if(NULL == ip)
+	{
+		printf("Allocation Error on QueueCreate\n");
+	}
+	
+	pthread_create(&producerIDs[0], NULL, BatchProducer, ip);
+	pthread_create(&producerIDs[1], NULL, Producer, ip);
+	pthread_create(&consumerIDs[0], NULL, Consumer, ip);
+	pthread_create(&consumerIDs[1], NULL, BatchConsumer, ip);
+	
+	pthread_join(producerIDs[0], NULL);
+	pthread_join(producerIDs[1], NULL);
+	pthread_join(consumerIDs[0], NULL);
+	pthread_join(consumerIDs[1], NULL);
+	
+	queueSize = QueueSize(ip);
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( 0 == queueSize );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test011_Stats_NullArguments)
+	Queue* ip;
+	QueueStats stats;
+	int items[QUEUE_SIZE];
+	void* values[QUEUE_SIZE];
+	size_t nRemoved;
+	size_t i;
+	int result;
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	
+	result = ( QUEUE_UNITIALIZED_ERROR == QueueGetStats(NULL, &stats) );
+	result = result && ( ITEM_UNITIALIZED_ERROR == QueueGetStats(ip, NULL) );
+	
+	/* No insert finds the queue full and no remove finds it empty, nothing is counted */
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		values[i] = &items[i];
+		result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[i]) );
+	}
+	result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values, QUEUE_SIZE, &nRemoved) );
+	result = result && ( QUEUE_SUCCESS == QueueInsertBatch(ip, values, nRemoved) );
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &values[0]) );
+	
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 2 * QUEUE_SIZE == stats.m_nInserts && QUEUE_SIZE + 1 == stats.m_nRemoves );
+	result = result && ( QUEUE_SIZE == stats.m_highWaterMark );
+	result = result && ( 0 == stats.m_nWaitsOnFull && 0 == stats.m_nWaitsOnEmpty && 0 == stats.m_blockedNs );
+	result = result && ( 0 < stats.m_nLockHoldSamples && stats.m_maxLockHoldNs <= stats.m_lockHoldNs );
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(Test012_Stats_WaitOnEmptyAndFull)
+	Queue* ip;
+	QueueStats stats;
+	pthread_t threadID;
+	int item;
+	void* value;
+	int result;
+	
+	ip = QueueCreate(1);
+	
+	/* The reader finds the queue empty and waits for the insert */
+	pthread_create(&threadID, NULL, RemoveOne, ip);
+	sleep(1);
+	result = ( QUEUE_SUCCESS == QueueInsert(ip, &item) );
+	pthread_join(threadID, NULL);
+	
+	/* The writer finds the queue full and waits for the remove */
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &item) );
+	pthread_create(&threadID, NULL, InsertOne, ip);
+	sleep(1);
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	pthread_join(threadID, NULL);
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 1 == stats.m_nWaitsOnEmpty && 1 == stats.m_nWaitsOnFull );
+	result = result && ( 0 < stats.m_maxBlockedNs && stats.m_maxBlockedNs < stats.m_blockedNs );
+	result = result && ( 3 == stats.m_nInserts && 3 == stats.m_nRemoves && 1 == stats.m_highWaterMark );
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 /********************************* Test Suite *********************************/
 /*----------------------------------------------------------------------------*/
 TEST_SET(Test safeQueue Module)
@@ -621,6 +860,12 @@ TEST_SET(Test safeQueue Module)
 	PRINT(Test004_5Consumers_5Producers_EvenAction)
 	PRINT(Test005_5Consumers_1Producers_EvenAction)
 	PRINT(Test006_1Consumers_5Producers_EvenAction)
+	PRINT(Test007_Batch_NullArguments)
+	PRINT(Test008_Batch_KeepOrderAndWrapAround)
+	PRINT(Test009_5Consumers_5Producers_Batch)
+	PRINT(Test010_BatchAndSingleTogether)
+	PRINT(Test011_Stats_NullArguments)
+	PRINT(Test012_Stats_WaitOnEmptyAndFull)
 END_SET
 /*----------------------------------------------------------------------------*/
 
@@ -723,6 +968,86 @@ static void* ConsumerHalf(void* _queue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+static void* BatchProducer(void* _queue)
+{
+	void* items[AMOUNT_OF_MSG];
+	size_t i;
+	
+	for(i = 0; i < AMOUNT_OF_MSG; ++i)
+	{
+		items[i] = GenerateString();
+	}
+	
+	if(QUEUE_SUCCESS != QueueInsertBatch(_queue, items, AMOUNT_OF_MSG) )
+	{
+		#if DEBUG_ERRORS
+		printf("Error on QueueInsertBatch\n");
+		#endif
+	}
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BatchConsumer(void* _queue)
+{
+	void* values[BATCH_SIZE];
+	size_t nConsumed = 0;
+	size_t nRemoved;
+	size_t nMax;
+	size_t i;
+	
+	while(nConsumed < AMOUNT_OF_MSG)
+	{
+		nMax = (AMOUNT_OF_MSG - nConsumed < BATCH_SIZE) ? AMOUNT_OF_MSG - nConsumed : BATCH_SIZE;
+		if(QUEUE_SUCCESS != QueueRemoveBatch(_queue, values, nMax, &nRemoved) )
+		{
+			#if DEBUG_ERRORS
+			printf("Error on QueueRemoveBatch\n");
+			#endif
+			
+			return NULL;
+		}
+		
+		for(i = 0; i < nRemoved; ++i)
+		{
+			free(values[i]);
+		}
+		nConsumed += nRemoved;
+	}
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue)
+{
+	static int item;
+	
+	QueueInsert(_queue, &item);
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue)
+{
+	void* value;
+	
+	QueueRemove(_queue, &value);
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 static void* GenerateString()
 {
@@ -742,7 +1067,7 @@ static void* GenerateString()
 	printf("Msg: %s\n", msg);
 	#endif
 	
-	ptr = (char*)malloc( sizeof(MSG_SIZE) );
+	ptr = (char*)malloc( MSG_SIZE );
 	memcpy(ptr, msg, MSG_SIZE);
 	
 	return ptr;
@@ -0,0 +1,193 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Per element VS batch throughput benchmark for the safeQueue API
+ *
+ *  @details 	A writer thread inserts AMOUNT_OF_MSG messages and a reader thread
+ *  			removes them, once with QueueInsert/QueueRemove per message and once
+ *  			with QueueInsertBatch/QueueRemoveBatch of BATCH_SIZE messages.
+ *  			The messages per second of both runs are printed.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-06
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "safeQueue.h"  /* header file */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & atol */
+#include <time.h> 		/* for clock_gettime */
+#include <pthread.h> 	/* for pthread API */
+
+#define AMOUNT_OF_MSG (2000000) 	/* Num of messages, can be changed from the command line */
+#define QUEUE_SIZE (1024) 			/* The size of the Queue (num of element) */
+#define BATCH_SIZE (64) 			/* Num of messages in one batch */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct StreamArgs
+{
+	Queue* m_queue;
+	size_t m_nMessages;
+	int m_isBatch;			/* Use the batch functions OR the per element functions */
+	size_t m_sum;			/* Keep the removes from being optimized away */
+} StreamArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+static double RunStream(size_t _nMessages, int _isBatch);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nMessages = AMOUNT_OF_MSG;
+	double perElement;
+	double batch;
+
+	if( 1 < argc )
+	{
+		nMessages = (size_t)atol(argv[1]);
+	}
+
+	perElement = RunStream(nMessages, 0);
+	batch = RunStream(nMessages, 1);
+	if( 0 > perElement || 0 > batch )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	printf("%s: %lu messages, queue of %d\n", argv[0], (unsigned long)nMessages, QUEUE_SIZE);
+	printf("\tper element:   %.2f M messages/sec\n", perElement);
+	printf("\tbatch of %d:   %.2f M messages/sec\n", BATCH_SIZE, batch);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static double RunStream(size_t _nMessages, int _isBatch)
+{
+	StreamArgs args;
+	pthread_t writerID;
+	pthread_t readerID;
+	struct timespec start;
+	struct timespec end;
+	double seconds;
+
+	args.m_queue = QueueCreate(QUEUE_SIZE);
+	args.m_nMessages = _nMessages;
+	args.m_isBatch = _isBatch;
+	args.m_sum = 0;
+	if( NULL == args.m_queue )
+	{
+		return -1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pthread_create(&readerID, NULL, Reader, &args);
+	pthread_create(&writerID, NULL, Writer, &args);
+	pthread_join(writerID, NULL);
+	pthread_join(readerID, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	QueueDestroy(&args.m_queue, NULL);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+	return (double)_nMessages / seconds / 1e6;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Writer(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	void* items[BATCH_SIZE];
+	size_t nItems;
+	size_t i;
+
+	for(i = 0; i < BATCH_SIZE; ++i)
+	{
+		items[i] = args;
+	}
+
+	for(i = 0; i < args->m_nMessages; i += nItems)
+	{
+		nItems = (args->m_nMessages - i < BATCH_SIZE) ? args->m_nMessages - i : BATCH_SIZE;
+		if( args->m_isBatch )
+		{
+			QueueInsertBatch(args->m_queue, items, nItems);
+		}
+		else
+		{
+			nItems = 1;
+			QueueInsert(args->m_queue, args);
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	StreamArgs* args = (StreamArgs*)_args;
+	void* values[BATCH_SIZE];
+	size_t nRemoved;
+	size_t nMax;
+	size_t i;
+
+	for(i = 0; i < args->m_nMessages; i += nRemoved)
+	{
+		nMax = (args->m_nMessages - i < BATCH_SIZE) ? args->m_nMessages - i : BATCH_SIZE;
+		if( args->m_isBatch )
+		{
+			QueueRemoveBatch(args->m_queue, values, nMax, &nRemoved);
+		}
+		else
+		{
+			nRemoved = 1;
+			QueueRemove(args->m_queue, values);
+		}
+		args->m_sum += (NULL != values[0]);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
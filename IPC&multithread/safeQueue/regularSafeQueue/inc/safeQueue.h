@@ -44,6 +44,23 @@ typedef enum Queue_Result {
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/* What the threads of the queue did and how long they waited, see QueueGetStats */
+typedef struct QueueStats {
+	size_t m_nInserts;			/* Num of elements inserted */
+	size_t m_nRemoves;			/* Num of elements removed */
+	size_t m_nWaitsOnFull;		/* Num of times a writer found the queue full and waited */
+	size_t m_nWaitsOnEmpty;		/* Num of times a reader found the queue empty and waited */
+	size_t m_blockedNs;			/* Total time of all the waits, in nano seconds */
+	size_t m_maxBlockedNs;		/* The longest wait, in nano seconds */
+	size_t m_nLockHoldSamples;	/* Num of lock holds that were timed, about one of every 64 */
+	size_t m_lockHoldNs;		/* Total time of the timed lock holds, in nano seconds */
+	size_t m_maxLockHoldNs;		/* The longest timed lock hold, in nano seconds */
+	size_t m_highWaterMark;		/* The max num of elements that were in the queue at once */
+} QueueStats;
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -118,6 +135,52 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function put _nItems elements into queue, wait while the queue is full
+ * @details     Every time the function takes the lock it writes as many elements as
+ *				there is room for and posts the semaphore once per moved element, so
+ *				a batch costs one lock hand off per pass instead of one per element.
+ *				The elements are inserted in the order of _items, the function returns
+ *				after all of them are in the queue.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _items    				=   Array of _nItems pointers to memory messages
+ * @param       _nItems    				=   Num of elements in _items
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _items OR one of the elements is NULL, nothing is inserted
+ * @retval 		SEMAPHORE_ERROR			=	Error on the semaphore part of the code
+ */
+QueueResult QueueInsertBatch(Queue* const _myQueue, void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get up to _maxItems elements from the queue, wait while the queue is empty
+ * @details     The function takes the lock once, reads all the elements there are
+ *				(up to _maxItems) in the queue order and posts the semaphore once per moved element.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValues    			=   Array of _maxItems pointers to get messages from memory
+ * @param       _maxItems    			=   Num of places in _pValues
+ * @param       _nRemoved    			=   Pointer to get the num of elements that removed
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success, 1 to _maxItems elements removed (0 if _maxItems is 0)
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValues OR _nRemoved is NULL
+ * @retval 		SEMAPHORE_ERROR			=	Error on the semaphore part of the code
+ */
+QueueResult QueueRemoveBatch(Queue* const _myQueue, void** _pValues, size_t _maxItems, size_t* _nRemoved);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief       The function return the orignal memory buffer capacity in the queue
@@ -150,4 +213,29 @@ size_t QueueSize(Queue* const _myQueue);
 /*----------------------------------------------------------------------------*/
 
 
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The counters are changed under the mutex that insert and remove hold
+ *				anyway, so the counting adds no contention and no memory per thread.
+ *				A wait starts when an insert finds no free place OR a remove finds no
+ *				element on the semaphore, and ends when the semaphore lets the thread
+ *				go on, the wait for the mutex after it is not counted.
+ *				A batch that waits a few times counts a few waits.
+ *				A snapshot, the other threads may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ * @retval 		MUTEX_ERROR			=	Error on the mutex part of the code
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats);
+/*----------------------------------------------------------------------------*/
+
 #endif /* __SAFE_QUEUE_H__ */
@@ -15,13 +15,15 @@
  *	If you found any bug in my code OR just want to send me an email for any reason,
  *  feel free to do so, I will do my best to send you a respond as soon as possible
  */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
  
 #include "safeQueue.h"	/* header file */
 #include <stdlib.h> 	/* for size_t  & malloc */
 #include <fcntl.h> 		/* for semaphore o_flag define */
 #include <sys/stat.h> 	/* for O_CREAT mode parameters in semaphore API */
 #include <semaphore.h> 	/* for semaphore API */
-#include <time.h> 		/* for mutex */
+#include <time.h> 		/* for mutex & clock_gettime */
 #include <stdio.h>      /* for perror */
 #include <errno.h> 		/* for display errors on errno */
 #include <pthread.h> 	/* for pthread API */
@@ -30,6 +32,9 @@
 #define SEMAPHORE_INIT_FAILED (-1)
 #define SEMAPHORE_INIT_SUCCESS (0)
 #define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define IS_WRITER			(1)
+#define IS_READER			(0)
+#define STATS_SAMPLE_RATE	(64)	/* Time one of every 64 lock holds */
 
 
 
@@ -43,8 +48,8 @@ struct Queue
     size_t m_head; 				/* Index to the first message to remove from the structuer */
     size_t m_tail; 				/* Index to the last message that insert to the structuer */
     size_t m_numOfElements; 	/* The current number of message in the structuer */
-    size_t m_numOfWaitOnEmpty; 	/* The number of times thread wait for remove on empty queue */
-    size_t m_numOfWaitOnFull; 	/* The number of times thread wait for remove on full queue */
+    QueueStats m_stats;			/* Changed and read under the mutex, that the thread holds anyway */
+    size_t m_nLockHolds; 		/* Num of lock holds, picks the timed ones */
     sem_t m_semaphoreEmpty;		/* Pointer to semaphore for Empty condition */
     sem_t m_semaphoreFull;		/* Pointer to semaphore for full condition */
     pthread_mutex_t m_mutex;	/* Pointer to mutex */
@@ -61,6 +66,73 @@ int InitSemaphore(Queue* _myQueue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return 1 if one of the _nItems elements of _items is NULL, otherwise 0
+ */
+static int IsAnyNull(void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Decrement _semaphore, wait while it is 0, return -1 on error
+ * @details If it waited, *_waitStart gets the time the wait started, otherwise it is not changed.
+ */
+static int WaitSemaphore(sem_t* _semaphore, size_t* _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Decrement _semaphore up to _max times without waiting, return the num of times
+ */
+static size_t TakeMore(sem_t* _semaphore, size_t _max);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Increment _semaphore _n times, return -1 on error
+ * @details POSIX has no post of n, sem_post makes a system call only when a thread waits.
+ */
+static int PostMany(sem_t* _semaphore, size_t _n);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Return the monotonic clock in nano seconds
+ */
+static size_t NowNs(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Count the wait that started at *_waitStart (0 for no wait) and zero it
+ */
+static void RecordWait(Queue* _myQueue, int _isWriter, size_t* _waitStart);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called when the lock is taken for work, return the time to time the
+ *			hold with OR 0 if this hold is not sampled
+ */
+static size_t StartOp(Queue* _myQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Called before the unlock, count _nItems elements and the hold from _holdStart
+ */
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _nItems, size_t _holdStart);
+/*----------------------------------------------------------------------------*/
+
+
 
 
 /******************************** API functions *******************************/
@@ -182,6 +254,9 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
  */
 QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 {
+	size_t waitStart = 0;
+	size_t holdStart;
+	
 	if( NULL == _myQueue )
 	{
 		return QUEUE_UNINITIALIZED_ERROR;
@@ -192,12 +267,7 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 		return ITEM_UNINITIALIZED_ERROR;
 	}
 	
-	if(_myQueue->m_numOfElements == _myQueue->m_capacity)
-	{
-		++(_myQueue->m_numOfWaitOnFull);
-	}
-	
-	if(-1 == sem_wait( &(_myQueue->m_semaphoreEmpty) ))
+	if(-1 == WaitSemaphore( &(_myQueue->m_semaphoreEmpty), &waitStart) )
 	{
 		#if DEBUG
 		perror("SEM_FAILED on sem_wait: ");
@@ -217,9 +287,17 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 		return MUTEX_ERROR;
 	}
 	
+	RecordWait(_myQueue, IS_WRITER, &waitStart);
+	holdStart = StartOp(_myQueue);
+	
 	_myQueue->m_items[_myQueue->m_tail] = _data;
 	(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) % (_myQueue->m_capacity)  );
 	++(_myQueue->m_numOfElements);
+	if(_myQueue->m_numOfElements > _myQueue->m_stats.m_highWaterMark)
+	{
+		_myQueue->m_stats.m_highWaterMark = _myQueue->m_numOfElements;
+	}
+	EndOp(_myQueue, IS_WRITER, 1, holdStart);
 	
 	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
 	{
@@ -264,6 +342,9 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
  */
 QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 {
+	size_t waitStart = 0;
+	size_t holdStart;
+	
 	if( NULL == _myQueue )
 	{
 		return QUEUE_UNINITIALIZED_ERROR;
@@ -274,12 +355,7 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 		return ITEM_UNINITIALIZED_ERROR;
 	}
 	
-	if(0 == _myQueue->m_numOfElements)
-	{
-		++(_myQueue->m_numOfWaitOnFull);
-	}
-	
-	if(-1 == sem_wait( &(_myQueue->m_semaphoreFull) ) )
+	if(-1 == WaitSemaphore( &(_myQueue->m_semaphoreFull), &waitStart) )
 	{
 		#if DEBUG
 		perror("SEM_FAILED on sem_wait: ");
@@ -299,9 +375,13 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 		return MUTEX_ERROR;
 	}
 	
+	RecordWait(_myQueue, IS_READER, &waitStart);
+	holdStart = StartOp(_myQueue);
+	
 	*_pValue = (_myQueue->m_items)[_myQueue->m_head];
 	(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) % (_myQueue->m_capacity)  ) ;
 	--(_myQueue->m_numOfElements);
+	EndOp(_myQueue, IS_READER, 1, holdStart);
 	
 	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
 	{
@@ -328,6 +408,214 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function put _nItems elements into queue, wait while the queue is full
+ * @details     Every time the function takes the lock it writes as many elements as
+ *				there is room for and posts the semaphore once per moved element, so
+ *				a batch costs one lock hand off per pass instead of one per element.
+ *				The elements are inserted in the order of _items, the function returns
+ *				after all of them are in the queue.
+ *
+ * @param       _myQueue				=   Pointer to memory
+ * @param       _items    				=   Array of _nItems pointers to memory messages
+ * @param       _nItems    				=   Num of elements in _items
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _items OR one of the elements is NULL, nothing is inserted
+ * @retval 		SEMAPHORE_ERROR			=	Error on the semaphore part of the code
+ */
+QueueResult QueueInsertBatch(Queue* const _myQueue, void** _items, size_t _nItems)
+{
+	size_t nInserted = 0;
+	size_t nMove;
+	size_t i;
+	size_t waitStart = 0;
+	size_t holdStart;
+	
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+	
+	if( NULL == _items || IsAnyNull(_items, _nItems) )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+	
+	while(nInserted < _nItems)
+	{
+		/* Wait for one free place, then take the other free places without waiting */
+		if(-1 == WaitSemaphore( &(_myQueue->m_semaphoreEmpty), &waitStart) )
+		{
+			#if DEBUG
+			perror("SEM_FAILED on sem_wait: ");
+			printf("errno Error: %u\n", errno);
+			#endif
+			
+			return SEMAPHORE_ERROR;
+		}
+		
+		nMove = 1 + TakeMore( &(_myQueue->m_semaphoreEmpty), _nItems - nInserted - 1);
+		
+		if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+		{
+			#if DEBUG
+			perror("mutex_FAILED on mutex_lock: ");
+			printf("errno Error: %u\n", errno);
+			#endif
+			
+			return MUTEX_ERROR;
+		}
+		
+		RecordWait(_myQueue, IS_WRITER, &waitStart);
+		holdStart = StartOp(_myQueue);
+		
+		for(i = 0; i < nMove; ++i)
+		{
+			_myQueue->m_items[_myQueue->m_tail] = _items[nInserted + i];
+			(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) % (_myQueue->m_capacity)  );
+		}
+		_myQueue->m_numOfElements += nMove;
+		if(_myQueue->m_numOfElements > _myQueue->m_stats.m_highWaterMark)
+		{
+			_myQueue->m_stats.m_highWaterMark = _myQueue->m_numOfElements;
+		}
+		EndOp(_myQueue, IS_WRITER, nMove, holdStart);
+		
+		if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+		{
+			#if DEBUG
+			perror("mutex_FAILED on mutex_unlock: ");
+			printf("errno Error: %u\n", errno);
+			#endif
+			
+			return MUTEX_ERROR;
+		}
+		
+		nInserted += nMove;
+		
+		if(-1 == PostMany( &(_myQueue->m_semaphoreFull), nMove) )
+		{
+			#if DEBUG
+			perror("SEM_FAILED on sem_post: ");
+			printf("errno Error: %u\n", errno);
+			#endif
+			
+			return SEMAPHORE_ERROR;
+		}
+	}
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get up to _maxItems elements from the queue, wait while the queue is empty
+ * @details     The function takes the lock once, reads all the elements there are
+ *				(up to _maxItems) in the queue order and posts the semaphore once per moved element.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _pValues    			=   Array of _maxItems pointers to get messages from memory
+ * @param       _maxItems    			=   Num of places in _pValues
+ * @param       _nRemoved    			=   Pointer to get the num of elements that removed
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success, 1 to _maxItems elements removed (0 if _maxItems is 0)
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValues OR _nRemoved is NULL
+ * @retval 		SEMAPHORE_ERROR			=	Error on the semaphore part of the code
+ */
+QueueResult QueueRemoveBatch(Queue* const _myQueue, void** _pValues, size_t _maxItems, size_t* _nRemoved)
+{
+	size_t nMove;
+	size_t i;
+	size_t waitStart = 0;
+	size_t holdStart;
+	
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+	
+	if( NULL == _pValues || NULL == _nRemoved )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+	
+	*_nRemoved = 0;
+	if( 0 == _maxItems )
+	{
+		return QUEUE_SUCCESS;
+	}
+	
+	/* Wait for one element, then take the other elements without waiting */
+	if(-1 == WaitSemaphore( &(_myQueue->m_semaphoreFull), &waitStart) )
+	{
+		#if DEBUG
+		perror("SEM_FAILED on sem_wait: ");
+		printf("errno Error: %u\n", errno);
+		#endif
+		
+		return SEMAPHORE_ERROR;
+	}
+	
+	nMove = 1 + TakeMore( &(_myQueue->m_semaphoreFull), _maxItems - 1);
+	
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		#if DEBUG
+		perror("mutex_FAILED on mutex_lock: ");
+		printf("errno Error: %u\n", errno);
+		#endif
+		
+		return MUTEX_ERROR;
+	}
+	
+	RecordWait(_myQueue, IS_READER, &waitStart);
+	holdStart = StartOp(_myQueue);
+	
+	for(i = 0; i < nMove; ++i)
+	{
+		_pValues[i] = (_myQueue->m_items)[_myQueue->m_head];
+		(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) % (_myQueue->m_capacity)  ) ;
+	}
+	_myQueue->m_numOfElements -= nMove;
+	EndOp(_myQueue, IS_READER, nMove, holdStart);
+	
+	if(0 != pthread_mutex_unlock( &(_myQueue->m_mutex) ) )
+	{
+		#if DEBUG
+		perror("mutex_FAILED on mutex_unlock: ");
+		printf("errno Error: %u\n", errno);
+		#endif
+		
+		return MUTEX_ERROR;
+	}
+	
+	*_nRemoved = nMove;
+	
+	if( -1 == PostMany( &(_myQueue->m_semaphoreEmpty), nMove) )
+	{
+		#if DEBUG
+		perror("SEM_FAILED on sem_post: ");
+		printf("errno Error: %u\n", errno);
+		#endif
+		
+		return SEMAPHORE_ERROR;
+	}
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief       The function return the orignal memory buffer capacity in the queue
@@ -392,6 +680,53 @@ size_t QueueSize(Queue* const _myQueue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function return the contention and wait time stats of the queue
+ * @details     The counters are changed under the mutex that insert and remove hold
+ *				anyway, so the counting adds no contention and no memory per thread.
+ *				A wait starts when an insert finds no free place OR a remove finds no
+ *				element on the semaphore, and ends when the semaphore lets the thread
+ *				go on, the wait for the mutex after it is not counted.
+ *				A batch that waits a few times counts a few waits.
+ *				A snapshot, the other threads may change it right away.
+ *
+ * @param       _myQueue        		=   Pointer to memory
+ * @param       _stats        			=   Pointer to get the stats
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS			=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _stats is NULL
+ * @retval 		MUTEX_ERROR			=	Error on the mutex part of the code
+ */
+QueueResult QueueGetStats(Queue* const _myQueue, QueueStats* _stats)
+{
+	if( NULL == _myQueue )
+	{
+		return QUEUE_UNINITIALIZED_ERROR;
+	}
+	
+	if( NULL == _stats )
+	{
+		return ITEM_UNINITIALIZED_ERROR;
+	}
+	
+	if(0 != pthread_mutex_lock( &(_myQueue->m_mutex) ) )
+	{
+		return MUTEX_ERROR;
+	}
+	
+	*_stats = _myQueue->m_stats;
+	
+	pthread_mutex_unlock( &(_myQueue->m_mutex) );
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -423,3 +758,138 @@ int InitSemaphore(Queue* _myQueue)
 	return SEMAPHORE_INIT_SUCCESS;
 }
 /*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsAnyNull(void** _items, size_t _nItems)
+{
+	size_t i;
+	
+	for(i = 0; i < _nItems; ++i)
+	{
+		if( NULL == _items[i] )
+		{
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int WaitSemaphore(sem_t* _semaphore, size_t* _waitStart)
+{
+	if(0 == sem_trywait(_semaphore) )
+	{
+		return 0;
+	}
+	
+	*_waitStart = NowNs();
+	return sem_wait(_semaphore);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t TakeMore(sem_t* _semaphore, size_t _max)
+{
+	size_t nTaken = 0;
+	
+	while(nTaken < _max && 0 == sem_trywait(_semaphore) )
+	{
+		++nTaken;
+	}
+	
+	return nTaken;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int PostMany(sem_t* _semaphore, size_t _n)
+{
+	size_t i;
+	
+	for(i = 0; i < _n; ++i)
+	{
+		if(-1 == sem_post(_semaphore) )
+		{
+			return -1;
+		}
+	}
+	
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NowNs(void)
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return (size_t)now.tv_sec * 1000000000 + (size_t)now.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RecordWait(Queue* _myQueue, int _isWriter, size_t* _waitStart)
+{
+	size_t blockedNs;
+	
+	if(0 == *_waitStart)
+	{
+		return;
+	}
+	
+	blockedNs = NowNs() - *_waitStart;
+	*_waitStart = 0;
+	
+	++(*(_isWriter ? &_myQueue->m_stats.m_nWaitsOnFull : &_myQueue->m_stats.m_nWaitsOnEmpty));
+	_myQueue->m_stats.m_blockedNs += blockedNs;
+	if(blockedNs > _myQueue->m_stats.m_maxBlockedNs)
+	{
+		_myQueue->m_stats.m_maxBlockedNs = blockedNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t StartOp(Queue* _myQueue)
+{
+	if(0 != (_myQueue->m_nLockHolds)++ % STATS_SAMPLE_RATE)
+	{
+		return 0;
+	}
+	
+	return NowNs();
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void EndOp(Queue* _myQueue, int _isWriter, size_t _nItems, size_t _holdStart)
+{
+	size_t holdNs;
+	
+	*(_isWriter ? &_myQueue->m_stats.m_nInserts : &_myQueue->m_stats.m_nRemoves) += _nItems;
+	if(0 == _holdStart)
+	{
+		return;
+	}
+	
+	holdNs = NowNs() - _holdStart;
+	++(_myQueue->m_stats.m_nLockHoldSamples);
+	_myQueue->m_stats.m_lockHoldNs += holdNs;
+	if(holdNs > _myQueue->m_stats.m_maxLockHoldNs)
+	{
+		_myQueue->m_stats.m_maxLockHoldNs = holdNs;
+	}
+}
+/*----------------------------------------------------------------------------*/
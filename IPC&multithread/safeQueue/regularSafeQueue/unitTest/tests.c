@@ -24,10 +24,12 @@
 #include <pthread.h> 	/* for pthread API */
 #include <string.h> 	/* for memset */
 #include <sys/types.h>	/* for gettid */
+#include <unistd.h>		/* for sleep */
 
 #define MSG_SIZE (10)
 #define AMOUNT_OF_MSG (20)
 #define QUEUE_SIZE (10) 		/* SIZE = The size of the Queue (num of element) */  
+#define BATCH_SIZE (4) 			/* Max num of elements the batch consumer removes at once */
 #define DEBUG1	(0)
 #define DEBUG2	(1)
 
@@ -43,6 +45,26 @@ static void* Consumer(void* _queue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+static void* BatchProducer(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BatchConsumer(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 static void* GenerateString();
 /*----------------------------------------------------------------------------*/
@@ -94,12 +116,163 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+TEST(BatchKeepOrderTest)
+	Queue* ip;
+	int items[QUEUE_SIZE];
+	void* pItems[QUEUE_SIZE];
+	void* values[QUEUE_SIZE];
+	size_t nRemoved;
+	size_t round;
+	size_t i;
+	int result = 1;
+	
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		pItems[i] = &items[i];
+	}
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	result = ( ITEM_UNINITIALIZED_ERROR == QueueInsertBatch(ip, NULL, QUEUE_SIZE) );
+	result = result && ( ITEM_UNINITIALIZED_ERROR == QueueRemoveBatch(ip, values, QUEUE_SIZE, NULL) );
+	
+	/* 7 in and 3 + 4 out, the head and the tail go around the queue */
+	for(round = 0; round < 100; ++round)
+	{
+		result = result && ( QUEUE_SUCCESS == QueueInsertBatch(ip, pItems, 7) );
+		result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values, 3, &nRemoved) && 3 == nRemoved );
+		result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values + 3, QUEUE_SIZE, &nRemoved) && 4 == nRemoved );
+		
+		for(i = 0; i < 7; ++i)
+		{
+			result = result && ( pItems[i] == values[i] );
+		}
+	}
+	
+	result = result && ( 0 == QueueSize(ip) );
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BatchFullTest)
+	Queue* ip;
+	pthread_t producerID;
+	pthread_t consumerID;
+	size_t queueSize;
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	if(NULL == ip)
+	{
+		printf("Allocation Error on QueueCreate\n");
+	}
+	
+	if( 0 != pthread_create(&producerID, NULL, BatchProducer, ip) )
+	{
+		QueueDestroy(&ip, NULL);
+	}
+	
+	if( 0 != pthread_create(&consumerID, NULL, BatchConsumer, ip) )
+	{
+		QueueDestroy(&ip, NULL);
+	}
+	
+	pthread_join(producerID, NULL);
+	pthread_join(consumerID, NULL);
+	
+	queueSize = QueueSize(ip);
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( 0 == queueSize );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(StatsNullArgumentsTest)
+	Queue* ip;
+	QueueStats stats;
+	int items[QUEUE_SIZE];
+	void* values[QUEUE_SIZE];
+	size_t nRemoved;
+	size_t i;
+	int result;
+	
+	ip = QueueCreate(QUEUE_SIZE);
+	
+	result = ( QUEUE_UNINITIALIZED_ERROR == QueueGetStats(NULL, &stats) );
+	result = result && ( ITEM_UNINITIALIZED_ERROR == QueueGetStats(ip, NULL) );
+	
+	/* No insert finds the queue full and no remove finds it empty, nothing is counted */
+	for(i = 0; i < QUEUE_SIZE; ++i)
+	{
+		values[i] = &items[i];
+		result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &items[i]) );
+	}
+	result = result && ( QUEUE_SUCCESS == QueueRemoveBatch(ip, values, QUEUE_SIZE, &nRemoved) );
+	result = result && ( QUEUE_SUCCESS == QueueInsertBatch(ip, values, nRemoved) );
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &values[0]) );
+	
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 2 * QUEUE_SIZE == stats.m_nInserts && QUEUE_SIZE + 1 == stats.m_nRemoves );
+	result = result && ( QUEUE_SIZE == stats.m_highWaterMark );
+	result = result && ( 0 == stats.m_nWaitsOnFull && 0 == stats.m_nWaitsOnEmpty && 0 == stats.m_blockedNs );
+	result = result && ( 0 < stats.m_nLockHoldSamples && stats.m_maxLockHoldNs <= stats.m_lockHoldNs );
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(StatsWaitTest)
+	Queue* ip;
+	QueueStats stats;
+	pthread_t threadID;
+	int item;
+	void* value;
+	int result;
+	
+	ip = QueueCreate(1);
+	
+	/* The reader finds the queue empty and waits for the insert */
+	pthread_create(&threadID, NULL, RemoveOne, ip);
+	sleep(1);
+	result = ( QUEUE_SUCCESS == QueueInsert(ip, &item) );
+	pthread_join(threadID, NULL);
+	
+	/* The writer finds the queue full and waits for the remove */
+	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &item) );
+	pthread_create(&threadID, NULL, InsertOne, ip);
+	sleep(1);
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	pthread_join(threadID, NULL);
+	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, &value) );
+	
+	result = result && ( QUEUE_SUCCESS == QueueGetStats(ip, &stats) );
+	result = result && ( 1 == stats.m_nWaitsOnEmpty && 1 == stats.m_nWaitsOnFull );
+	result = result && ( 0 < stats.m_maxBlockedNs && stats.m_maxBlockedNs < stats.m_blockedNs );
+	result = result && ( 3 == stats.m_nInserts && 3 == stats.m_nRemoves && 1 == stats.m_highWaterMark );
+	
+	QueueDestroy(&ip, NULL);
+	ASSERT_THAT ( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 
 
 /********************************* Test Suite *********************************/
 /*----------------------------------------------------------------------------*/
 TEST_SET(safeQueue)
 	PRINT(FullTest)
+	PRINT(BatchKeepOrderTest)
+	PRINT(BatchFullTest)
+	PRINT(StatsNullArgumentsTest)
+	PRINT(StatsWaitTest)
 END_SET
 /*----------------------------------------------------------------------------*/
 
@@ -119,7 +292,7 @@ static void* Producer(void* _queue)
 		ptr = GenerateString();
 		
 		#if DEBUG2
-		printf("Producer: Msg number %u- %s\n",i, (char*)ptr);
+		printf("Producer: Msg number %lu- %.*s\n", (unsigned long)i, MSG_SIZE, (char*)ptr);
 		#endif
 		
 		if(QUEUE_SUCCESS != QueueInsert( _queue,  ptr))
@@ -147,7 +320,7 @@ static void* Consumer(void* _queue)
 		}
 		
 		#if DEBUG2
-		printf("Consumer: Msg number %u- %s\n",i, ptr);
+		printf("Consumer: Msg number %lu- %.*s\n", (unsigned long)i, MSG_SIZE, ptr);
 		#endif
 		
 		free(ptr);
@@ -158,6 +331,86 @@ static void* Consumer(void* _queue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+static void* BatchProducer(void* _queue)
+{
+	void* items[AMOUNT_OF_MSG];
+	size_t i;
+	
+	for(i = 0; i < AMOUNT_OF_MSG; ++i)
+	{
+		items[i] = GenerateString();
+	}
+	
+	/* More than the capacity, the producer waits for the consumer in the middle */
+	if(QUEUE_SUCCESS != QueueInsertBatch(_queue, items, AMOUNT_OF_MSG) )
+	{
+		printf("Error on QueueInsertBatch\n");
+	}
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BatchConsumer(void* _queue)
+{
+	void* values[BATCH_SIZE];
+	size_t nConsumed = 0;
+	size_t nRemoved;
+	size_t nMax;
+	size_t i;
+	
+	while(nConsumed < AMOUNT_OF_MSG)
+	{
+		nMax = (AMOUNT_OF_MSG - nConsumed < BATCH_SIZE) ? AMOUNT_OF_MSG - nConsumed : BATCH_SIZE;
+		if(QUEUE_SUCCESS != QueueRemoveBatch(_queue, values, nMax, &nRemoved) )
+		{
+			printf("Error on QueueRemoveBatch\n");
+			return NULL;
+		}
+		
+		#if DEBUG2
+		printf("Consumer: %lu msgs in one batch\n", (unsigned long)nRemoved);
+		#endif
+		
+		for(i = 0; i < nRemoved; ++i)
+		{
+			free(values[i]);
+		}
+		nConsumed += nRemoved;
+	}
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* InsertOne(void* _queue)
+{
+	static int item;
+	
+	QueueInsert(_queue, &item);
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* RemoveOne(void* _queue)
+{
+	void* value;
+	
+	QueueRemove(_queue, &value);
+	
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 static void* GenerateString()
 {
@@ -177,7 +430,7 @@ static void* GenerateString()
 	printf("Msg: %s\n", msg);
 	#endif
 	
-	ptr = (char*)malloc( sizeof(MSG_SIZE) );
+	ptr = (char*)malloc( MSG_SIZE );
 	memcpy(ptr, msg, MSG_SIZE);
 	
 	return ptr;
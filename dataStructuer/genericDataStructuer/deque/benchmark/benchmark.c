@@ -0,0 +1,224 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic Deque against Generic Stack and Generic Queue
+ *
+ *  @details 	Measure the time to push all items and pop all of them, for the deque
+ *  			as a stack against the Vector based stack, and for the deque as a
+ *  			queue against the growable ring queue. All start from a small capacity.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "deque.h"			/* header file */
+#include "stack.h"			/* stack header */
+#include "queue.h"			/* queue header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & atol */
+#include <time.h> 			/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of items in each run, can be changed from the command line */
+#define INITIAL_CAPACITY (16)
+#define STACK_BLOCK_SIZE (1024) /* The Vector grows by a fixed block */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push all items to the back of a deque and pop all from the back OR from the front
+ */
+static void RunDeque(void** _items, size_t _nElements, int _isQueue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push all items to the stack and pop all
+ */
+static void RunStack(void** _items, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert all items to the queue and remove all
+ */
+static void RunQueue(void** _items, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	void** items;
+	int dummy;
+
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+
+	items = (void**)malloc(nElements * sizeof(void*));
+	if( NULL == items )
+	{
+		return 1;
+	}
+
+	for(i = 0; i < nElements; ++i)
+	{
+		items[i] = &dummy;
+	}
+
+	printf("Deque benchmark, %lu items:\n", (unsigned long)nElements);
+	RunStack(items, nElements);
+	RunDeque(items, nElements, 0);
+	RunQueue(items, nElements);
+	RunDeque(items, nElements, 1);
+
+	free(items);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void RunDeque(void** _items, size_t _nElements, int _isQueue)
+{
+	Deque* deque;
+	void* value = NULL;
+	clock_t start;
+	clock_t pushEnd;
+	clock_t popEnd;
+	size_t i;
+
+	deque = DequeCreate(INITIAL_CAPACITY);
+	if( NULL == deque )
+	{
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		DequePushBack(deque, _items[i]);
+	}
+	pushEnd = clock();
+
+	if( _isQueue )
+	{
+		while( DEQUE_SUCCESS == DequePopFront(deque, &value) )
+		{
+		}
+	}
+	else
+	{
+		while( DEQUE_SUCCESS == DequePopBack(deque, &value) )
+		{
+		}
+	}
+	popEnd = clock();
+
+	DequeDestroy(&deque, NULL);
+
+	printf("%s push: %8.1f ms   pop all: %8.1f ms\n", (_isQueue) ? "Deque as queue " : "Deque as stack ",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunStack(void** _items, size_t _nElements)
+{
+	Stack* stack;
+	void* value = _items;
+	clock_t start;
+	clock_t pushEnd;
+	clock_t popEnd;
+	size_t i;
+
+	stack = StackCreate(INITIAL_CAPACITY, STACK_BLOCK_SIZE);
+	if( NULL == stack )
+	{
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		StackPush(stack, _items[i]);
+	}
+	pushEnd = clock();
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		StackPop(stack, &value);
+	}
+	popEnd = clock();
+
+	StackDestroy(&stack, NULL);
+
+	printf("Vector Stack    push: %8.1f ms   pop all: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunQueue(void** _items, size_t _nElements)
+{
+	Queue* queue;
+	void* value = NULL;
+	clock_t start;
+	clock_t pushEnd;
+	clock_t popEnd;
+	size_t i;
+
+	queue = QueueCreateGrowable(INITIAL_CAPACITY);
+	if( NULL == queue )
+	{
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		QueueInsert(queue, _items[i]);
+	}
+	pushEnd = clock();
+
+	while( QUEUE_SUCCESS == QueueRemove(queue, &value) )
+	{
+	}
+	popEnd = clock();
+
+	QueueDestroy(&queue, NULL);
+
+	printf("Ring Queue      push: %8.1f ms   pop all: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
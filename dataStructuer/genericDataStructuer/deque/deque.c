@@ -0,0 +1,511 @@
+/**
+ *  @file 		deque.c
+ *  @brief 		src file for Generic Deque (double ended queue) data type
+ *
+ *  @details 	The elements are kept in blocks of BLOCK_SIZE pointers, the map is a
+ * 				cyclic array of block pointers with a power of 2 size. Position p of
+ * 				the ring is in block (p / BLOCK_SIZE) at offset (p % BLOCK_SIZE), so the
+ * 				deque is a ring of (map size * BLOCK_SIZE) slots that are allocated
+ * 				one block at a time.
+ * 				The map grows (and is unwrapped) when the blocks of the front and
+ * 				the back would meet, only the block pointers are copied.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "deque.h"			/* header file */
+#include <stdlib.h>  		/* size_t &malloc */
+
+#define BLOCK_BITS (7)
+#define BLOCK_SIZE ((size_t)1 << BLOCK_BITS)	/* 128 pointers in a block */
+#define BLOCK_MASK (BLOCK_SIZE - 1)
+#define MIN_MAP_SIZE ((size_t)4)
+#define MAX_MAP_SIZE ( ((size_t)-1) >> (BLOCK_BITS + 1) )
+#define POSITION_MASK(deque)		( (((deque)->m_mapMask + 1) << BLOCK_BITS) - 1 )
+#define CHECK_DEQUE_NULL(param)		do{ if(NULL == (param) ) { return DEQUE_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return DEQUE_NULL_ELEMENT_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+struct Deque
+{
+    void*** m_map; 				/* Cyclic array of blocks, NULL for a block that is not allocated yet */
+    size_t m_mapMask; 			/* Number of blocks in the map - 1 */
+    size_t m_first; 			/* Position of the front element in the ring */
+    size_t m_size; 				/* Number of elements */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Get the address of the element at _index from the front
+ */
+static void** Slot(const Deque* _deque, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Make sure one more element fits when the front is at offset _firstOffset of it's block,
+ * grow the map if the new element would be in the block of the other end
+ */
+static DequeResult MakeRoom(Deque* _deque, size_t _firstOffset);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate the block of ring position _position if it is not allocated
+ */
+static DequeResult AllocateBlock(Deque* _deque, size_t _position);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new deque
+ *
+ * @param 	initialCapacity			= Number of elements the map is made for initially,
+ *									  blocks are allocated only when used
+ *
+ * @return 	The deque pointer
+ * @retval	Deque*					= On success
+ * @retval	NULL 					= On allocation failure
+ */
+Deque* DequeCreate(size_t _initialCapacity)
+{
+	Deque* deque;
+	size_t mapSize = MIN_MAP_SIZE;
+
+	while( (mapSize << BLOCK_BITS) < _initialCapacity )
+	{
+		mapSize <<= 1;
+		if( MAX_MAP_SIZE < mapSize )
+		{
+			return NULL;
+		}
+	}
+
+	deque = (Deque*)malloc( sizeof(Deque) );
+	if( NULL == deque )
+	{
+		return NULL;
+	}
+
+	deque->m_map = (void***)calloc( mapSize, sizeof(void**) );
+	if( NULL == deque->m_map )
+	{
+		free(deque);
+		return NULL;
+	}
+
+	deque->m_mapMask = mapSize - 1;
+	deque->m_first = 0;
+	deque->m_size = 0;
+
+	return deque;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated deque
+ *
+ * @param	deque					= Deque to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all
+ *								  elements or a null if no such destroy is required
+ *
+ * @return void
+ */
+void DequeDestroy(Deque** _deque, void (*_elementDestroy)(void* _item))
+{
+	Deque* deque;
+	size_t i;
+
+	if( NULL == _deque || NULL == *_deque )
+	{
+		return;
+	}
+	deque = *_deque;
+
+	if( NULL != _elementDestroy )
+	{
+		for(i = 0; i < deque->m_size; ++i)
+		{
+			_elementDestroy( *Slot(deque, i) );
+		}
+	}
+
+	for(i = 0; i <= deque->m_mapMask; ++i)
+	{
+		free(deque->m_map[i]);
+	}
+
+	free(deque->m_map);
+	free(deque);
+	*_deque = NULL;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element at the front of the deque
+ * @Complexity	O(1) amortized
+ *
+ * @param	deque						= Deque to use.
+ * @param	item						= Element to add.
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When item is uninitialized
+ * @retval 	DEQUE_ALLOCATION_ERROR 		= On allocation failure, the deque is not changed
+ */
+DequeResult DequePushFront(Deque* _deque, void* _item)
+{
+	size_t first;
+
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_item);
+
+	if( DEQUE_SUCCESS != MakeRoom(_deque, (_deque->m_first - 1) & BLOCK_MASK) )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	first = (_deque->m_first - 1) & POSITION_MASK(_deque);
+	if( DEQUE_SUCCESS != AllocateBlock(_deque, first) )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	_deque->m_first = first;
+	++_deque->m_size;
+	*Slot(_deque, 0) = _item;
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element at the back of the deque
+ * @Complexity	O(1) amortized
+ *
+ * @param	deque						= Deque to use.
+ * @param	item						= Element to add.
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When item is uninitialized
+ * @retval 	DEQUE_ALLOCATION_ERROR 		= On allocation failure, the deque is not changed
+ */
+DequeResult DequePushBack(Deque* _deque, void* _item)
+{
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_item);
+
+	if( DEQUE_SUCCESS != MakeRoom(_deque, _deque->m_first & BLOCK_MASK) )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	if( DEQUE_SUCCESS != AllocateBlock(_deque, (_deque->m_first + _deque->m_size) & POSITION_MASK(_deque)) )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	*Slot(_deque, _deque->m_size) = _item;
+	++_deque->m_size;
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element at the front of the deque
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When pValue is NULL
+ * @retval 	DEQUE_IS_EMPTY 				= When the deque is empty
+ */
+DequeResult DequePopFront(Deque* _deque, void** _pValue)
+{
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_pValue);
+	if( 0 == _deque->m_size )
+	{
+		return DEQUE_IS_EMPTY;
+	}
+
+	*_pValue = *Slot(_deque, 0);
+	_deque->m_first = (_deque->m_first + 1) & POSITION_MASK(_deque);
+	--_deque->m_size;
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element at the back of the deque
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When pValue is NULL
+ * @retval 	DEQUE_IS_EMPTY 				= When the deque is empty
+ */
+DequeResult DequePopBack(Deque* _deque, void** _pValue)
+{
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_pValue);
+	if( 0 == _deque->m_size )
+	{
+		return DEQUE_IS_EMPTY;
+	}
+
+	--_deque->m_size;
+	*_pValue = *Slot(_deque, _deque->m_size);
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the element at _index, 0 is the front
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	index						= Index of the element, from the front
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS					= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 		= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 		= When pValue is NULL
+ * @retval 	DEQUE_INDEX_OUT_OF_BOUNDS_ERROR = When index >= size
+ */
+DequeResult DequeGet(const Deque* _deque, size_t _index, void** _pValue)
+{
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_pValue);
+	if( _deque->m_size <= _index )
+	{
+		return DEQUE_INDEX_OUT_OF_BOUNDS_ERROR;
+	}
+
+	*_pValue = *Slot(_deque, _index);
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Replace the element at _index, 0 is the front
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	index						= Index of the element, from the front
+ * @param	item						= New element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS					= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 		= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 		= When item is NULL
+ * @retval 	DEQUE_INDEX_OUT_OF_BOUNDS_ERROR = When index >= size
+ */
+DequeResult DequeSet(Deque* _deque, size_t _index, void* _item)
+{
+	CHECK_DEQUE_NULL(_deque);
+	CHECK_ELEMENT_NULL(_item);
+	if( _deque->m_size <= _index )
+	{
+		return DEQUE_INDEX_OUT_OF_BOUNDS_ERROR;
+	}
+
+	*Slot(_deque, _index) = _item;
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the deque.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the deque is empty OR pointer is uninitialized
+ */
+size_t DequeSize(const Deque* _deque)
+{
+	if( NULL == _deque )
+	{
+		return 0;
+	}
+
+	return _deque->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Iterate over all elements in the deque, from the front.
+ * @details The user provided _action function will be called for each element
+ *          if _action return a zero for an element the iteration will stop.
+ *
+ * @param	deque			= Deque to iterate over.
+ * @param	action			= User provided function pointer to be invoked for each element
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of times the user functions was invoked
+ */
+size_t DequeForEach(const Deque* _deque, DequeElementAction _action, void* _context)
+{
+	size_t i;
+
+	if( NULL == _deque || NULL == _action )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _deque->m_size; ++i)
+	{
+		if( 0 == _action(*Slot(_deque, i), i, _context) )
+		{
+			return i + 1;
+		}
+	}
+
+	return i;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Get the address of the element at _index from the front
+ */
+static void** Slot(const Deque* _deque, size_t _index)
+{
+	size_t position = (_deque->m_first + _index) & POSITION_MASK(_deque);
+
+	return &_deque->m_map[position >> BLOCK_BITS][position & BLOCK_MASK];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Make sure one more element fits when the front is at offset _firstOffset of it's block,
+ * grow the map if the new element would be in the block of the other end
+ */
+static DequeResult MakeRoom(Deque* _deque, size_t _firstOffset)
+{
+	void*** newMap;
+	size_t firstBlock;
+	size_t mapSize = _deque->m_mapMask + 1;
+	size_t i;
+
+	/* Number of blocks from the front block to the back block, with the new element */
+	if( ((_firstOffset + _deque->m_size) >> BLOCK_BITS) < mapSize )
+	{
+		return DEQUE_SUCCESS;
+	}
+
+	if( MAX_MAP_SIZE / 2 < mapSize )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	newMap = (void***)calloc( mapSize * 2, sizeof(void**) );
+	if( NULL == newMap )
+	{
+		return DEQUE_ALLOCATION_ERROR;
+	}
+
+	/* Unwrap, the front block goes to 0, the blocks that are not used move with the rest */
+	firstBlock = _deque->m_first >> BLOCK_BITS;
+	for(i = 0; i < mapSize; ++i)
+	{
+		newMap[i] = _deque->m_map[(firstBlock + i) & _deque->m_mapMask];
+	}
+
+	free(_deque->m_map);
+	_deque->m_map = newMap;
+	_deque->m_mapMask = mapSize * 2 - 1;
+	_deque->m_first &= BLOCK_MASK;
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate the block of ring position _position if it is not allocated
+ */
+static DequeResult AllocateBlock(Deque* _deque, size_t _position)
+{
+	void*** block = &_deque->m_map[_position >> BLOCK_BITS];
+
+	if( NULL == *block )
+	{
+		*block = (void**)malloc( BLOCK_SIZE * sizeof(void*) );
+		if( NULL == *block )
+		{
+			return DEQUE_ALLOCATION_ERROR;
+		}
+	}
+
+	return DEQUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
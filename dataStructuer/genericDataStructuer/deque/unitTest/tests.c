@@ -0,0 +1,388 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic Deque data structure
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type,
+ * 				elements are pushed and popped at both ends and accessed by index.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "deque.h"			/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+
+#define SIZE (5000) /* SIZE = Num of elements in each test, many blocks */
+#define N_RAND_OPERATIONS (100000) /* N_RAND_OPERATIONS = Num of random push/pop in the model test */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check the element is the next one of the array in _context (an int**)
+ */
+static int CheckNext(void* _element, size_t _index, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Count the destroyed elements in a global counter
+ */
+static void CountDestroy(void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check all the elements of _deque are the elements of _model, in order
+ *
+ * @return	1 if equal, 0 otherwise
+ */
+static int IsEqualToModel(const Deque* _deque, int** _model, size_t _first, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+static size_t g_nDestroyed = 0; /* Counter of CountDestroy */
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*-------------------------------- DequeCreate -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequeCreate_CheckNull)
+    Deque* deque;
+
+    deque = DequeCreate(0);
+    ASSERT_THAT( NULL != deque && 0 == DequeSize(deque) );
+    DequeDestroy(&deque, NULL);
+    ASSERT_THAT( NULL == deque );
+    DequeDestroy(&deque, NULL);
+    DequeDestroy(NULL, NULL);
+    ASSERT_THAT( 0 == DequeSize(NULL) && 0 == DequeForEach(NULL, CheckNext, NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*--------------------------------- DequePush --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequePush_CheckNull)
+    Deque* deque;
+    int item = 1;
+
+    deque = DequeCreate(1);
+    ASSERT_THAT( DEQUE_UNINITIALIZED_ERROR == DequePushFront(NULL, &item) );
+    ASSERT_THAT( DEQUE_UNINITIALIZED_ERROR == DequePushBack(NULL, &item) );
+    ASSERT_THAT( DEQUE_NULL_ELEMENT_ERROR == DequePushFront(deque, NULL) );
+    ASSERT_THAT( DEQUE_NULL_ELEMENT_ERROR == DequePushBack(deque, NULL) );
+    ASSERT_THAT( 0 == DequeSize(deque) );
+    DequeDestroy(&deque, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------------- DequePop --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequePop_CheckEmpty)
+    Deque* deque;
+    void* value = NULL;
+    int item = 1;
+
+    deque = DequeCreate(1);
+    ASSERT_THAT( DEQUE_IS_EMPTY == DequePopFront(deque, &value) );
+    ASSERT_THAT( DEQUE_IS_EMPTY == DequePopBack(deque, &value) );
+    ASSERT_THAT( DEQUE_UNINITIALIZED_ERROR == DequePopFront(NULL, &value) );
+    DequePushBack(deque, &item);
+    ASSERT_THAT( DEQUE_NULL_ELEMENT_ERROR == DequePopBack(deque, NULL) );
+    ASSERT_THAT( DEQUE_SUCCESS == DequePopFront(deque, &value) && &item == value );
+    ASSERT_THAT( DEQUE_IS_EMPTY == DequePopBack(deque, &value) );
+    DequeDestroy(&deque, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(DequePop_CheckCase_QueueAndStack)
+    Deque* deque;
+    int array[SIZE];
+    void* value = NULL;
+    size_t i;
+    int result = 1;
+
+    deque = DequeCreate(0);
+
+    /* As a queue, every second push pops one, the front moves along the blocks */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( DEQUE_SUCCESS == DequePushBack(deque, &array[i]) );
+    	if( 1 == i % 2 )
+    	{
+    		result = result && ( DEQUE_SUCCESS == DequePopFront(deque, &value) && &array[i / 2] == value );
+    	}
+    }
+    for(i = 0; i < SIZE / 2; ++i)
+    {
+    	result = result && ( DEQUE_SUCCESS == DequePopFront(deque, &value) && &array[SIZE / 2 + i] == value );
+    }
+    result = result && ( 0 == DequeSize(deque) );
+
+    /* As a stack on the front */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( DEQUE_SUCCESS == DequePushFront(deque, &array[i]) );
+    }
+    for(i = SIZE; 0 < i; --i)
+    {
+    	result = result && ( DEQUE_SUCCESS == DequePopFront(deque, &value) && &array[i - 1] == value );
+    }
+    result = result && ( 0 == DequeSize(deque) );
+
+    DequeDestroy(&deque, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(DequePop_CheckCase_RandModel)
+    Deque* deque;
+    int array[SIZE];
+    int* model[SIZE * 4]; 		/* The elements are at [first, first + nElements) */
+    void* value = NULL;
+    size_t first = SIZE * 2;
+    size_t nElements = 0;
+    size_t i;
+    size_t index;
+    int result = 1;
+
+    srand((unsigned)time(NULL));
+    deque = DequeCreate(10);
+
+    for(i = 0; i < N_RAND_OPERATIONS && result; ++i)
+    {
+    	index = (size_t)rand() % SIZE;
+    	/* More pushes then pops, the deque grows to SIZE while the map is wrapped */
+    	switch( rand() % 6 )
+    	{
+    		case 0:
+    		case 4:
+    			if( 0 < first && nElements < SIZE )
+    			{
+    				model[--first] = &array[index];
+    				++nElements;
+    				result = ( DEQUE_SUCCESS == DequePushFront(deque, &array[index]) );
+    			}
+    			break;
+
+    		case 1:
+    		case 5:
+    			if( first + nElements < SIZE * 4 && nElements < SIZE )
+    			{
+    				model[first + nElements] = &array[index];
+    				++nElements;
+    				result = ( DEQUE_SUCCESS == DequePushBack(deque, &array[index]) );
+    			}
+    			break;
+
+    		case 2:
+    			result = ( (0 == nElements) ? DEQUE_IS_EMPTY : DEQUE_SUCCESS ) == DequePopFront(deque, &value);
+    			if( 0 < nElements )
+    			{
+    				result = result && ( model[first] == value );
+    				++first;
+    				--nElements;
+    			}
+    			break;
+
+    		default:
+    			result = ( (0 == nElements) ? DEQUE_IS_EMPTY : DEQUE_SUCCESS ) == DequePopBack(deque, &value);
+    			if( 0 < nElements )
+    			{
+    				--nElements;
+    				result = result && ( model[first + nElements] == value );
+    			}
+    			break;
+    	}
+
+    	/* Random access of any element */
+    	if( 0 < nElements )
+    	{
+    		index = (size_t)rand() % nElements;
+    		result = result && ( DEQUE_SUCCESS == DequeGet(deque, index, &value) && model[first + index] == value );
+    	}
+
+    	/* Bring the model back to the middle */
+    	if( 0 == nElements )
+    	{
+    		first = SIZE * 2;
+    	}
+    }
+
+    result = result && IsEqualToModel(deque, model, first, nElements);
+    DequeDestroy(&deque, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ DequeGet & Set ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequeGet_CheckIndex)
+    Deque* deque;
+    int array[3];
+    void* value = NULL;
+
+    deque = DequeCreate(3);
+    DequePushBack(deque, &array[1]);
+    DequePushFront(deque, &array[0]);
+
+    ASSERT_THAT( DEQUE_INDEX_OUT_OF_BOUNDS_ERROR == DequeGet(deque, 2, &value) );
+    ASSERT_THAT( DEQUE_INDEX_OUT_OF_BOUNDS_ERROR == DequeSet(deque, 2, &array[2]) );
+    ASSERT_THAT( DEQUE_NULL_ELEMENT_ERROR == DequeGet(deque, 0, NULL) );
+    ASSERT_THAT( DEQUE_NULL_ELEMENT_ERROR == DequeSet(deque, 0, NULL) );
+    ASSERT_THAT( DEQUE_UNINITIALIZED_ERROR == DequeGet(NULL, 0, &value) );
+    ASSERT_THAT( DEQUE_SUCCESS == DequeSet(deque, 1, &array[2]) );
+    ASSERT_THAT( DEQUE_SUCCESS == DequeGet(deque, 0, &value) && &array[0] == value );
+    ASSERT_THAT( DEQUE_SUCCESS == DequePopBack(deque, &value) && &array[2] == value );
+    DequeDestroy(&deque, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- DequeForEach -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequeForEach_CheckOrderAndStop)
+    Deque* deque;
+    int array[SIZE];
+    int* next;
+    size_t i;
+
+    /* Stop on the element that is not in order */
+    deque = DequeCreate(0);
+    for(i = SIZE / 2; 0 < i; --i)
+    {
+    	DequePushFront(deque, &array[i - 1]);
+    }
+    for(i = SIZE / 2; i < SIZE; ++i)
+    {
+    	DequePushBack(deque, &array[i]);
+    }
+    DequePushBack(deque, &array[0]);
+    DequePushBack(deque, &array[1]);
+
+    next = array;
+    ASSERT_THAT( SIZE + 1 == DequeForEach(deque, CheckNext, &next) && &array[SIZE] == next );
+    DequeDestroy(&deque, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- DequeDestroy -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(DequeDestroy_CheckElementDestroy)
+    Deque* deque;
+    int array[SIZE];
+    void* value = NULL;
+    size_t i;
+
+    deque = DequeCreate(0);
+    for(i = 0; i < SIZE; ++i)
+    {
+    	DequePushFront(deque, &array[i]);
+    	DequePushBack(deque, &array[i]);
+    	DequePopBack(deque, &value);
+    }
+
+    g_nDestroyed = 0;
+    DequeDestroy(&deque, CountDestroy);
+    ASSERT_THAT( SIZE == g_nDestroyed );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Deque Module)
+	PRINT(DequeCreate_CheckNull)
+
+	PRINT(DequePush_CheckNull)
+
+	PRINT(DequePop_CheckEmpty)
+	PRINT(DequePop_CheckCase_QueueAndStack)
+	PRINT(DequePop_CheckCase_RandModel)
+
+	PRINT(DequeGet_CheckIndex)
+
+	PRINT(DequeForEach_CheckOrderAndStop)
+
+	PRINT(DequeDestroy_CheckElementDestroy)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CheckNext(void* _element, size_t _index, void* _context)
+{
+	int** next = (int**)_context;
+
+	if( _element != *next )
+	{
+		return 0;
+	}
+
+	++*next;
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _element)
+{
+	++g_nDestroyed;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsEqualToModel(const Deque* _deque, int** _model, size_t _first, size_t _nElements)
+{
+	void* value = NULL;
+	size_t i;
+
+	if( _nElements != DequeSize(_deque) )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( DEQUE_SUCCESS != DequeGet(_deque, i, &value) || _model[_first + i] != value )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
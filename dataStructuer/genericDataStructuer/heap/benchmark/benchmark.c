@@ -0,0 +1,154 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic Heap data type
+ *
+ *  @details 	Measure the time to make a heap of random items, once with HeapBuild
+ *  			on a full vector (Floyd, O(n)) and once with HeapInsert of every item
+ *  			to an empty heap (O(n log n)), then the time to extract all the items.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "heap.h"		/* header file */
+#include "vector.h"		/* vector header */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand & malloc */
+#include <time.h> 		/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of items in each run, can be changed from the command line */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Make a heap of all the items, extract all of them, print the times
+ *
+ * @param   _name       = The name of the run to print
+ * @param   _array		= The items
+ * @param   _nElements  = The number of items
+ * @param   _useBuild   = None zero to make the heap with HeapBuild, zero for HeapInsert
+ */
+static void RunBenchmark(const char* _name, int* _array, size_t _nElements, int _useBuild);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	int* array;
+
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+
+	array = (int*)malloc(nElements * sizeof(int));
+	if( NULL == array )
+	{
+		return 1;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < nElements; ++i)
+	{
+		array[i] = rand();
+	}
+
+	printf("Heap benchmark, %lu random items:\n", (unsigned long)nElements);
+	RunBenchmark("HeapBuild", array, nElements, 1);
+	RunBenchmark("HeapInsert", array, nElements, 0);
+
+	free(array);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return ( *(int*)_a  < *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunBenchmark(const char* _name, int* _array, size_t _nElements, int _useBuild)
+{
+	Vector* vec;
+	Heap* heap;
+	void* value = NULL;
+	clock_t start;
+	clock_t makeEnd;
+	clock_t extractEnd;
+	size_t counter = 0;
+	size_t i;
+
+	vec = VectorCreate(_nElements, _nElements);
+	if( NULL == vec )
+	{
+		return;
+	}
+
+	start = clock();
+	if( _useBuild )
+	{
+		for(i = 0; i < _nElements; ++i)
+		{
+			VectorAppend(vec, &_array[i]);
+		}
+		heap = HeapBuild(vec, CompareData);
+	}
+	else
+	{
+		heap = HeapBuild(vec, CompareData);
+		for(i = 0; i < _nElements; ++i)
+		{
+			HeapInsert(heap, &_array[i]);
+		}
+	}
+	makeEnd = clock();
+
+	while( HEAP_SUCCESS == HeapExtractMax(heap, &value) )
+	{
+		++counter;
+	}
+	extractEnd = clock();
+
+	HeapDestroy(&heap);
+	VectorDestroy(&vec, NULL);
+
+	printf("%-12s make: %8.1f ms   extract all: %8.1f ms   (%lu items)\n", _name,
+			TO_MSEC(start, makeEnd), TO_MSEC(makeEnd, extractEnd), (unsigned long)counter);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,384 @@
+/**
+ *  @file 		heap.c
+ *  @brief 		src file for Generic Heap data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				Implemented as a binary max heap over a user provided generic Vector,
+ * 				the sons of index i are 2i+1 and 2i+2.
+ * 				Sift up and sift down move a hole instead of swapping, every moved
+ * 				element is written once and the new element is written only at the end.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "heap.h"			/* header file */
+#include "vector.h"			/* vector header */
+#include <stdlib.h>  		/* size_t &malloc */
+
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_HEAP_NULL(param)		do{ if(NULL == (param) ) { return HEAP_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return HEAP_NULL_ELEMENT_ERROR;}  } while(0)
+#define LEFT_SON(index)				( 2 * (index) + 1 )
+#define FATHER(index)				( ((index) - 1) / 2 )
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+struct Heap
+{
+    Vector* m_vec; 				/* The vector the heap is built on, not owned */
+    HeapLessComparator m_less;
+    size_t m_nItems; 			/* Same as VectorSize, kept to save the calls */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Get the element at _index, the index is in bound
+ */
+static void* ElementAt(const Vector* _vec, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _element in the hole at _hole, moving smaller fathers down on the way up
+ */
+static void SiftUp(Heap* _heap, size_t _hole, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _element in the hole at _hole, moving bigger sons up on the way down
+ */
+static void SiftDown(Heap* _heap, size_t _hole, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Build a new heap from the elements of an existing vector
+ * @details The elements are reordered in place (Floyd's build), the vector is
+ *			used by the heap until HeapDestroy.
+ * @Complexity	O(n)
+ *
+ * @param 	vec						= The vector to build the heap on
+ * @param 	less					= A comparison function that returns true (none zero value)
+ *								  if x < y and false (zero) otherwise.
+ *
+ * @return 	The heap pointer
+ * @retval	Heap*					= On success
+ * @retval	NULL 					= If _vec OR _less is NULL OR allocation failed
+ */
+Heap* HeapBuild(Vector* _vec, HeapLessComparator _less)
+{
+	Heap* heap;
+	size_t i;
+
+	CHECK_NULL(_vec);
+	CHECK_NULL(_less);
+
+	heap = (Heap*)malloc( sizeof(Heap) );
+	CHECK_NULL(heap);
+
+	heap->m_vec = _vec;
+	heap->m_less = _less;
+	heap->m_nItems = VectorSize(_vec);
+
+	/* Sift down every father from the last one up, the leaves are heaps already */
+	for(i = heap->m_nItems / 2; 0 < i; --i)
+	{
+		SiftDown(heap, i - 1, ElementAt(_vec, i - 1));
+	}
+
+	return heap;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Deallocate a previously built heap, the vector is not destroyed
+ *
+ * @param	heap					= Heap to be deallocated, set to NULL.
+ *
+ * @return 	The vector the heap was built on, in heap order
+ * @retval	NULL 					= If the heap is uninitialized
+ */
+Vector* HeapDestroy(Heap** _heap)
+{
+	Vector* vec;
+
+	if( NULL == _heap || NULL == *_heap )
+	{
+		return NULL;
+	}
+
+	vec = (*_heap)->m_vec;
+
+	free(*_heap);
+	*_heap = NULL;
+
+	return vec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element to the heap
+ * @Complexity	O(log n)
+ *
+ * @param	heap						= Heap to use.
+ * @param	element						= Element to add.
+ *
+ * @return	Status HeapResult that indicate in which state the function ended:
+ *
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	HEAP_ALLOCATION_ERROR 		= When the vector failed to grow
+ * @retval 	HEAP_OVERFLOW 				= When the vector is full and it's _blockSize is 0
+ */
+HeapResult HeapInsert(Heap* _heap, void* _element)
+{
+	VectorResult status;
+
+	CHECK_HEAP_NULL(_heap);
+	CHECK_ELEMENT_NULL(_element);
+
+	/* The append opens the hole at the end, the vector grows if needed */
+	status = VectorAppend(_heap->m_vec, _element);
+	switch(status)
+	{
+		case VECTOR_SUCCESS:
+			break;
+		case VECTOR_OVERFLOW_ERROR:
+			return HEAP_OVERFLOW;
+		default:
+			return HEAP_ALLOCATION_ERROR;
+	}
+
+	SiftUp(_heap, _heap->m_nItems++, _element);
+
+	return HEAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the max element without removing it
+ * @Complexity	O(1)
+ *
+ * @param	heap						= Heap to use.
+ * @param	pValue						= Pointer to variable that will receive the max element
+ *
+ * @return	Status HeapResult that indicate in which state the function ended:
+ *
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	HEAP_IS_EMPTY 				= When there are no elements in the heap
+ */
+HeapResult HeapMax(const Heap* _heap, void** _pValue)
+{
+	CHECK_HEAP_NULL(_heap);
+	CHECK_ELEMENT_NULL(_pValue);
+
+	if( 0 == _heap->m_nItems )
+	{
+		return HEAP_IS_EMPTY;
+	}
+
+	*_pValue = ElementAt(_heap->m_vec, 0);
+
+	return HEAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the max element
+ * @Complexity	O(log n)
+ *
+ * @param	heap						= Heap to use.
+ * @param	pValue						= Pointer to variable that will receive the removed element
+ *
+ * @return	Status HeapResult that indicate in which state the function ended:
+ *
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	HEAP_IS_EMPTY 				= When there are no elements in the heap
+ */
+HeapResult HeapExtractMax(Heap* _heap, void** _pValue)
+{
+	void* last = _heap; /* VectorRemove needs a none NULL value in *_pValue */
+
+	CHECK_HEAP_NULL(_heap);
+	CHECK_ELEMENT_NULL(_pValue);
+
+	if( 0 == _heap->m_nItems )
+	{
+		return HEAP_IS_EMPTY;
+	}
+
+	*_pValue = ElementAt(_heap->m_vec, 0);
+
+	/* A failed shrink still removes the last element */
+	VectorRemove(_heap->m_vec, &last);
+	if( 0 < --_heap->m_nItems )
+	{
+		SiftDown(_heap, 0, last);
+	}
+
+	return HEAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the heap.
+ *
+ * @param	heap			= Heap to use.
+ *
+ * @return  Number of elements
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If heap is empty OR pointer is uninitialized
+ */
+size_t HeapItemsNum(const Heap* _heap)
+{
+	if( NULL == _heap )
+	{
+		return 0;
+	}
+
+	return _heap->m_nItems;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Iterate over all elements in the heap, in the vector order (not sorted).
+ * @details The user provided _action function will be called for each element
+ *          if _action return a zero for an element the iteration will stop.
+ *
+ * @param	heap			= Heap to iterate over.
+ * @param	action			= User provided function pointer to be invoked for each element
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of times the user functions was invoked
+ */
+size_t HeapForEach(const Heap* _heap, VectorElementAction _action, void* _context)
+{
+	if( NULL == _heap )
+	{
+		return 0;
+	}
+
+	return VectorForEach(_heap->m_vec, _action, _context);
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Get the element at _index, the index is in bound
+ */
+static void* ElementAt(const Vector* _vec, size_t _index)
+{
+	void* element = (void*)_vec; /* VectorGet needs a none NULL value in *_pValue */
+
+	VectorGet(_vec, _index, &element);
+
+	return element;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _element in the hole at _hole, moving smaller fathers down on the way up
+ */
+static void SiftUp(Heap* _heap, size_t _hole, void* _element)
+{
+	void* father;
+
+	while( 0 < _hole )
+	{
+		father = ElementAt(_heap->m_vec, FATHER(_hole));
+		if( 0 == _heap->m_less(father, _element) )
+		{
+			break;
+		}
+
+		VectorSet(_heap->m_vec, _hole, father);
+		_hole = FATHER(_hole);
+	}
+
+	VectorSet(_heap->m_vec, _hole, _element);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _element in the hole at _hole, moving bigger sons up on the way down
+ */
+static void SiftDown(Heap* _heap, size_t _hole, void* _element)
+{
+	size_t son;
+	void* sonElement;
+	void* rightElement;
+
+	while( (son = LEFT_SON(_hole)) < _heap->m_nItems )
+	{
+		sonElement = ElementAt(_heap->m_vec, son);
+		if( son + 1 < _heap->m_nItems )
+		{
+			rightElement = ElementAt(_heap->m_vec, son + 1);
+			if( 0 != _heap->m_less(sonElement, rightElement) )
+			{
+				++son;
+				sonElement = rightElement;
+			}
+		}
+
+		if( 0 == _heap->m_less(_element, sonElement) )
+		{
+			break;
+		}
+
+		VectorSet(_heap->m_vec, _hole, sonElement);
+		_hole = son;
+	}
+
+	VectorSet(_heap->m_vec, _hole, _element);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,362 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic Heap data structure
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				The heap is a binary max heap built over a user provided vector.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "heap.h"		/* header file */
+#include "vector.h"		/* vector header */
+#include "matan_test.h"	/* def of unit test */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand */
+#include <time.h> 		/* for time_t */
+
+#define SIZE (1000) /* SIZE = Num of elements in each test */
+#define MAX_RAND_VALUE (50) /* MAX_RAND_VALUE = The max value of the random elements, with repeats */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function for int elements
+ */
+static int IntLess(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Create a vector of _nElements random values of _array in [0, MAX_RAND_VALUE)
+ *
+ * @return	The vector OR NULL on allocation failure
+ */
+static Vector* CreateRandVector(int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check that every element of the vector is not bigger then it's father
+ *
+ * @return	1 if the vector is in heap order, 0 otherwise
+ */
+static int IsHeapOrder(const Vector* _vec);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Extract all the elements, check they come in decreasing order
+ *
+ * @return	Number of extracted elements if the order is right, 0 otherwise
+ */
+static size_t ExtractAllSorted(Heap* _heap);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that sum the int elements to the int context
+ */
+static int SumAction(void* _element, size_t _index, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*--------------------------------- HeapBuild --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(HeapBuild_CheckNull)
+    Vector* vec;
+
+    vec = VectorCreate(1, 1);
+    ASSERT_THAT( NULL == HeapBuild(NULL, IntLess) );
+    ASSERT_THAT( NULL == HeapBuild(vec, NULL) );
+    VectorDestroy(&vec, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(HeapBuild_CheckCase_RandValues)
+    Vector* vec;
+    Heap* heap;
+    int array[SIZE];
+    int result;
+
+    vec = CreateRandVector(array, SIZE);
+    heap = HeapBuild(vec, IntLess);
+
+    result = ( SIZE == HeapItemsNum(heap) && IsHeapOrder(vec) );
+    ASSERT_THAT( vec == HeapDestroy(&heap) && NULL == heap );
+    VectorDestroy(&vec, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(HeapBuild_CheckCase_EmptyVector)
+    Vector* vec;
+    Heap* heap;
+    void* value = NULL;
+    int result;
+
+    vec = VectorCreate(1, 1);
+    heap = HeapBuild(vec, IntLess);
+
+    result = ( 0 == HeapItemsNum(heap) && HEAP_IS_EMPTY == HeapMax(heap, &value) );
+    result = result && HEAP_IS_EMPTY == HeapExtractMax(heap, &value);
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- HeapInsert --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(HeapInsert_CheckNull)
+    Vector* vec;
+    Heap* heap;
+    int item = 1;
+
+    vec = VectorCreate(1, 1);
+    heap = HeapBuild(vec, IntLess);
+
+    ASSERT_THAT( HEAP_UNINITIALIZED_ERROR == HeapInsert(NULL, &item) );
+    ASSERT_THAT( HEAP_NULL_ELEMENT_ERROR == HeapInsert(heap, NULL) );
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(HeapInsert_CheckOverflow)
+    Vector* vec;
+    Heap* heap;
+    int array[2] = {1, 2};
+
+    vec = VectorCreate(1, 0);
+    heap = HeapBuild(vec, IntLess);
+
+    ASSERT_THAT( HEAP_SUCCESS == HeapInsert(heap, &array[0]) );
+    ASSERT_THAT( HEAP_OVERFLOW == HeapInsert(heap, &array[1]) && 1 == HeapItemsNum(heap) );
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(HeapInsert_CheckCase_MaxAfterEachInsert)
+    Vector* vec;
+    Heap* heap;
+    int array[SIZE];
+    void* value = NULL;
+    int max = -1;
+    size_t i;
+    int result = 1;
+
+    vec = VectorCreate(1, 10);
+    heap = HeapBuild(vec, IntLess);
+
+    srand((unsigned)time(NULL));
+    for(i = 0; i < SIZE; ++i)
+    {
+    	array[i] = rand() % MAX_RAND_VALUE;
+    	max = ( array[i] > max ) ? array[i] : max;
+
+    	result = result && ( HEAP_SUCCESS == HeapInsert(heap, &array[i]) );
+    	result = result && ( HEAP_SUCCESS == HeapMax(heap, &value) && max == *(int*)value );
+    }
+
+    result = result && IsHeapOrder(vec) && SIZE == ExtractAllSorted(heap);
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ HeapExtractMax ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(HeapExtractMax_CheckNull)
+    void* value = NULL;
+
+    ASSERT_THAT( HEAP_UNINITIALIZED_ERROR == HeapExtractMax(NULL, &value) );
+    ASSERT_THAT( HEAP_UNINITIALIZED_ERROR == HeapMax(NULL, &value) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(HeapExtractMax_CheckCase_SortedAfterBuild)
+    Vector* vec;
+    Heap* heap;
+    int array[SIZE];
+    int result;
+
+    vec = CreateRandVector(array, SIZE);
+    heap = HeapBuild(vec, IntLess);
+
+    result = ( SIZE == ExtractAllSorted(heap) && 0 == HeapItemsNum(heap) && 0 == VectorSize(vec) );
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- HeapForEach -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(HeapForEach_CheckCase_SumValues)
+    Vector* vec;
+    Heap* heap;
+    int array[SIZE];
+    int sum = 0;
+    int expected = 0;
+    size_t i;
+
+    vec = CreateRandVector(array, SIZE);
+    heap = HeapBuild(vec, IntLess);
+    for(i = 0; i < SIZE; ++i)
+    {
+    	expected += array[i];
+    }
+
+    ASSERT_THAT( 0 == HeapForEach(NULL, SumAction, &sum) );
+    HeapForEach(heap, SumAction, &sum);
+    HeapDestroy(&heap);
+    VectorDestroy(&vec, NULL);
+    ASSERT_THAT( expected == sum );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Heap Module)
+	PRINT(HeapBuild_CheckNull)
+	PRINT(HeapBuild_CheckCase_RandValues)
+	PRINT(HeapBuild_CheckCase_EmptyVector)
+
+	PRINT(HeapInsert_CheckNull)
+	PRINT(HeapInsert_CheckOverflow)
+	PRINT(HeapInsert_CheckCase_MaxAfterEachInsert)
+
+	PRINT(HeapExtractMax_CheckNull)
+	PRINT(HeapExtractMax_CheckCase_SortedAfterBuild)
+
+	PRINT(HeapForEach_CheckCase_SumValues)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int IntLess(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static Vector* CreateRandVector(int* _array, size_t _nElements)
+{
+	Vector* vec;
+	size_t i;
+
+	vec = VectorCreate(_nElements, 10);
+	if( NULL == vec )
+	{
+		return NULL;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < _nElements; ++i)
+	{
+		_array[i] = rand() % MAX_RAND_VALUE;
+		VectorAppend(vec, &_array[i]);
+	}
+
+	return vec;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsHeapOrder(const Vector* _vec)
+{
+	void* father = (void*)_vec;
+	void* son = (void*)_vec;
+	size_t i;
+
+	for(i = 1; i < VectorSize(_vec); ++i)
+	{
+		VectorGet(_vec, (i - 1) / 2, &father);
+		VectorGet(_vec, i, &son);
+		if( *(int*)father < *(int*)son )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t ExtractAllSorted(Heap* _heap)
+{
+	void* value = NULL;
+	int last = MAX_RAND_VALUE;
+	size_t counter = 0;
+
+	while( HEAP_SUCCESS == HeapExtractMax(_heap, &value) )
+	{
+		if( *(int*)value > last )
+		{
+			return 0;
+		}
+		last = *(int*)value;
+		++counter;
+	}
+
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int SumAction(void* _element, size_t _index, void* _context)
+{
+	*(int*)_context += *(int*)_element;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
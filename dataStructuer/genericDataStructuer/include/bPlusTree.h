@@ -0,0 +1,280 @@
+/**
+ *  @file 		bPlusTree.h
+ *  @brief 		Header file for Generic B+ Tree data type
+ *
+ *  @details 	Implement an ordered set ADT of user items as a B+ tree.
+ *  			Every node is 512 bytes (8 cache lines) so one node holds tens of
+ *  			items, and a search touch only a few nodes instead of a node per level.
+ *  			All the items are kept in the leaves, the leaves are linked in order
+ *  			so in order walk and range scans move over contiguous arrays.
+ *  			Items are ordered by user provided less function, like BSTree.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __B_PLUS_TREE_H__
+#define __B_PLUS_TREE_H__
+
+#include <stddef.h>  /* for size_t */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct BPTree BPTree;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Iterator is a position inside a leaf, any insert OR remove invalidate it */
+typedef struct BPTreeItr
+{
+	void* m_leaf;		/* The leaf of the item, NULL for the end */
+	size_t m_index;		/* The index of the item in the leaf */
+} BPTreeItr;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as LessComparator of binTree.h, none zero if _left is before _right */
+typedef int (*BPTreeLessComparator)(void* _left, void* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as ActionFunction of binTree.h, return zero to stop the iteration */
+typedef int (*BPTreeActionFunction)(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum BPTree_Result
+{
+	BPTREE_SUCCESS = 0,
+	BPTREE_UNINITIALIZED_ERROR,		/* Uninitialized tree error */
+	BPTREE_ITEM_NULL_ERROR, 		/* Uninitialized item error */
+	BPTREE_DUPLICATE_ERROR, 		/* Item already in the tree */
+	BPTREE_ALLOCATION_ERROR 		/* Allocation error 	 	*/
+} BPTreeResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create an empty B+ tree
+ *
+ * @param   less			= A comparison function that returns true (none zero value)
+ *							if x < y  and false (zero) otherwise.
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On failure due to allocation failure OR due to uninitialized pointer given
+ */
+BPTree* BPTree_Create(BPTreeLessComparator _less);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create a B+ tree from sorted items
+ * @details The leaves are filled in one pass and the upper levels are built on top of
+ *			them, all nodes are (almost) full.
+ * @Complexity	O(n)
+ *
+ * @param   less			= A comparison function, as in BPTree_Create
+ * @param   items			= Array of _nItems items sorted by _less, with no duplicates
+ * @param   nItems			= The number of items
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ *							  OR if the items are not sorted without duplicates
+ */
+BPTree* BPTree_BuildFromSorted(BPTreeLessComparator _less, void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy tree
+ * @details Destroys the tree, If supplied with non-NULL destroyer function,
+ *			frees the items in the tree.
+ * @Complexity	O(n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   destroyer      	= A function to destroy the items (may be NULL if unnecessary)
+ */
+void BPTree_Destroy(BPTree* _tree, void (*_destroyer)(void*));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add an item to the tree if it's not already there
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   item           	= An item to add to the tree
+ *
+ * @return  Success indicator
+ * @retval  BPTREE_SUCCESS				= On success
+ * @retval  BPTREE_UNINITIALIZED_ERROR	= If the tree is not initialized
+ * @retval  BPTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  BPTREE_DUPLICATE_ERROR		= If an equal item already in the tree
+ * @retval  BPTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+BPTreeResult BPTree_Insert(BPTree* _tree, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the item equal to _key from the tree
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The removed item OR NULL if not found OR uninitialized pointer given
+ */
+void* BPTree_Remove(BPTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* BPTree_Find(const BPTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the tree
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t BPTree_Size(const BPTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details Iteration will stop on the first item for which action returns a zero
+ *          or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Tree to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* BPTree_Range(const BPTree* _tree, void* _low, void* _high,
+				BPTreeActionFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the first item that is NOT less then _key
+ * @Complexity  O(log n)
+ *
+ * @return  Iterator to the item OR end iterator if there is no such item OR on NULL input
+ */
+BPTreeItr BPTree_LowerBound(const BPTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the first item that is greater then _key
+ * @Complexity  O(log n)
+ *
+ * @return  Iterator to the item OR end iterator if there is no such item OR on NULL input
+ */
+BPTreeItr BPTree_UpperBound(const BPTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the smallest item
+ * @Complexity  O(1)
+ *
+ * @return  Iterator to the first item OR end iterator if the tree is empty OR uninitialized
+ */
+BPTreeItr BPTreeItr_Begin(const BPTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the end of the tree, one after the greatest item
+ * @Complexity  O(1)
+ *
+ * @return  The end iterator
+ */
+BPTreeItr BPTreeItr_End(const BPTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Compare two iterators
+ *
+ * @retval  1 				= If iterators are the same
+ * @retval  0 				= If are not the same
+ */
+int BPTreeItr_Equals(BPTreeItr _a, BPTreeItr _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the next item in order
+ * @Complexity  O(1)
+ * @warning if _itr is end iterator it will be returned
+ */
+BPTreeItr BPTreeItr_Next(BPTreeItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the item the iterator is pointing to
+ *
+ * @retval  item         	=   If the iterator is pointing at item
+ * @retval  NULL         	=   If iterator pointing to the end
+ */
+void* BPTreeItr_Get(BPTreeItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __B_PLUS_TREE_H__ */
@@ -5,6 +5,8 @@
  *  @details 	Implement a binary search tree ADT.
  *  			The tree is implemented using a sentinel. 
  *  			The first node in the tree is the sentinel left subtree.
+ *  			The tree is kept as a red-black tree, so the height is O(log n)
+ *  			even when the items are inserted in sorted order.
  * 
  *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
  *
@@ -95,6 +97,48 @@ BSTree* BSTree_Create(LessComparator _less);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Create a balanced tree from sorted items
+ * @details All the nodes are taken from one allocation and linked in one pass.
+ *			A removed node of that allocation is released only when the tree is destroyed.
+ * @Complexity	O(n)
+ *
+ * @param   less			= A comparison function, as in BSTree_Create
+ * @param   items			= Array of _nItems items sorted by _less, with no duplicates
+ * @param   nItems			= The number of items
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ *							  OR if the items are not sorted without duplicates
+ */
+BSTree* BSTree_BuildFromSorted(LessComparator _less, void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Create a balanced tree with the items of two trees
+ * @details The trees are walked together in order and the new tree is built as in
+ *			BSTree_BuildFromSorted. The two trees are not changed, the items are shared,
+ *			so destroy the old trees with NULL destroyer. An item of _second that is
+ *			equal to an item of _first is not taken. The new tree use _first less function.
+ * @Complexity	O(n + m)
+ *
+ * @param   first			= A previously created Tree ADT returned via BSTreeCreate
+ * @param   second			= A tree with the same less function as _first
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ */
+BSTree* BSTree_Merge(const BSTree* _first, const BSTree* _second);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief   Destroy tree
@@ -115,8 +159,7 @@ void  BSTree_Destroy(BSTree* _tree, void (*_destroyer)(void *) );
 /** 
  * @brief   Add an element to tree if it's not already there
  * @details Insert element to binary tree, using the tree's comparison function
- * @Complexity 	Average O(log n).
- * 				Worst 	O(n)
+ * @Complexity 	Average/Worst O(log n).
  *
  * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
  * @param   item           	= An item to add to the tree
@@ -153,11 +196,132 @@ BSTreeItr BSTree_FindFirst(const BSTree* _tree, PredicateFunction _predicate, vo
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief   Get an in-order itertator to the tree's begin 
+ * @brief   Search an element equal to _key, using the tree's comparison function
+ * @details Two elements are equal if none of them is less then the other
+ * @Complexity  O(log n)
+ *
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
+ *
+ * @return  An iterator pointing to the element found:
+ *
+ * @retval  NULL            = On NULL input OR when the element NOT found
+ * @retval  Iterator found  = When the element found
+ */
+BSTreeItr BSTree_Find(const BSTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get iterator to the first element that is NOT less then _key
+ * @Complexity  O(log n)
+ *
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
+ *
+ * @return  An iterator pointing to the element found:
+ *
+ * @retval  NULL            = On NULL input OR when all the elements are less then _key
+ * @retval  Iterator found  = The first element >= _key
+ */
+BSTreeItr BSTree_LowerBound(const BSTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get iterator to the first element that is greater then _key
+ * @Complexity  O(log n)
+ *
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
+ *
+ * @return  An iterator pointing to the element found:
+ *
+ * @retval  NULL            = On NULL input OR when no element is greater then _key
+ * @retval  Iterator found  = The first element > _key
+ */
+BSTreeItr BSTree_UpperBound(const BSTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Performs an action function on every element in the range [_low, _high], in order
+ * @details Iteration will stop on the first element for which action returns a zero
+ *          or after the last element that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of elements in the range
+ *
+ * @param   tree           	=       Tree to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each element
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  Iterator to the specific element where action returned zero value
+ *
+ * @retval  iterator        =   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+BSTreeItr BSTree_Range(const BSTree* _tree, void* _low, void* _high,
+                 ActionFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get the number of elements in the tree
  * @Complexity  O(1) 
  *
  * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
  *
+ * @retval  number          = Number of elements in the tree, 0 on NULL input
+ */
+size_t BSTree_Size(const BSTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get iterator to the element at position _index in order (0 is the smallest)
+ * @details Every node keep the size of it's subtree, so the search go down one path.
+ * @Complexity  O(log n) 
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   index           = The position of the element, 0 to (size - 1)
+ *
+ * @return  Iterator to the element at the position
+ *
+ * @retval  NULL            = On NULL input OR when _index is not less then the tree size
+ * @retval  Iterator found  = The element that have exactly _index elements before it
+ */
+BSTreeItr BSTree_Select(const BSTree* _tree, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get the number of elements in the tree that are less then _key
+ * @details If _key is in the tree this is it's position, as given to BSTree_Select.
+ * @Complexity  O(log n) 
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   key           	= An item to compare the elements to
+ *
+ * @retval  number          = Number of elements less then _key, 0 on NULL input
+ */
+size_t BSTree_Rank(const BSTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get an in-order itertator to the tree's begin 
+ * @Complexity  O(log n) 
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ *
  * @return  An iterator pointing at the tree's begin: 
  *
  * @retval  NULL            = On NULL input
@@ -171,7 +335,7 @@ BSTreeItr BSTreeItr_Begin(const BSTree* _tree);
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief   Get itertator to the tree's end (in order)
- * @Complexity  O(1)
+ * @Complexity  O(log n)
  *
  * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
  *
@@ -240,8 +404,8 @@ BSTreeItr BSTreeItr_Prev(BSTreeItr _it);
 /** 
  * @brief 	Removes the BSTreeItr the current iterator is pointing at
  * @details Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
- * @Complexity 	Best 	O(1) -	If the current iterator have no more the 1 child.
- * 				Worst 	O(n) -	If the current iterator and all the next have 2 children.
+ * @Complexity 	Average/Worst O(log n).
+ *			Only _it is invalidated, iterators to the other elements stay valid.
  *
  * @param   it         		=   Pointer to Tree itself- use in case of removing the root
  * @param   it         		=   Pointer to current iterator to remove
@@ -273,8 +437,9 @@ void* BSTreeItr_Get(BSTreeItr _it);
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief   Performs an action function on every element in tree, by given traversal mode
- * @details Iteration will on the first element for which action returns a zero
- *          or on reaching end of the conrainer
+ * @details Iteration will stop on the first element for which action returns a zero
+ *          or on reaching end of the container.
+ *			The walk is not recursive and use no extra memory, so any tree depth is fine.
  * @Complexity  O(n)
  *
  * @param   tree           	=       Tree to iterate over
@@ -292,4 +457,27 @@ BSTreeItr BSTree_ForEach(const BSTree* _tree, BSTreeTraversalMode _mode,
 /*----------------------------------------------------------------------------*/
 
 
+#ifdef BSTREE_CHECK
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Check the tree keeps the rules of the implementation, for the unit tests
+ * @details The items are in order by less, every son points back to it's father,
+ *			every subtree size is right, no red node has a red father and every path
+ *			from the root to a NULL son has the same num of black nodes.
+ *			Compiled only when BSTREE_CHECK is defined, the tree makefile defines it.
+ * @Complexity  O(n log n)
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   height         	= Pointer to get the num of nodes on the longest path from the root, can be NULL
+ *
+ * @return  Status of the check:
+ *
+ * @retval  1 				= If the tree keeps all the rules
+ * @retval  0 				= If a rule is broken OR tree is uninitialized
+ */
+int BSTree_CheckInvariants(const BSTree* _tree, size_t* _height);
+/*----------------------------------------------------------------------------*/
+#endif /* BSTREE_CHECK */
+
+
 #endif /* __BINARY_TREE_H__ */
@@ -0,0 +1,187 @@
+/**
+ *  @file 		concurrentTree.h
+ *  @brief 		Header file for Generic read mostly concurrent ordered tree
+ *
+ *  @details 	Implement an ordered set ADT of user items that many reader threads
+ *  			can search while one writer thread at a time change it.
+ *  			Readers never lock: a writer copies the path it change (copy on write),
+ *  			links the new nodes to the old subtrees and publishes the new root,
+ *  			so a reader always see one complete version of the tree.
+ *  			A replaced node is freed only after every reader that could see it is done
+ *  			(epoch based reclamation). Writers serialize on one mutex.
+ *  			The tree is kept as an AVL tree, the height is O(log n).
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	Every reader thread use it's own reader id, two threads must not read
+ *  			with the same id at the same time.
+ *  			CTree_Destroy: The tree can't protect destroy thread from reader/writer threads
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __CONCURRENT_TREE_H__
+#define __CONCURRENT_TREE_H__
+
+#include <stddef.h>  /* for size_t */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct CTree CTree;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as LessComparator of binTree.h, none zero if _left is before _right */
+typedef int (*CTreeLessComparator)(void* _left, void* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as ActionFunction of binTree.h, return zero to stop the iteration */
+typedef int (*CTreeActionFunction)(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum CTree_Result
+{
+	CTREE_SUCCESS = 0,
+	CTREE_UNINITIALIZED_ERROR,		/* Uninitialized tree error */
+	CTREE_ITEM_NULL_ERROR, 			/* Uninitialized item error */
+	CTREE_DUPLICATE_ERROR, 			/* Item already in the tree */
+	CTREE_ALLOCATION_ERROR 			/* Allocation error 	 	*/
+} CTreeResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create an empty concurrent tree
+ *
+ * @param   less			= A comparison function that returns true (none zero value)
+ *							if x < y  and false (zero) otherwise.
+ * @param   maxReaders		= The number of reader ids, the ids are 0 to (_maxReaders - 1)
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On failure due to allocation failure OR due to uninitialized pointer given
+ *							  OR if _maxReaders is 0
+ */
+CTree* CTree_Create(CTreeLessComparator _less, size_t _maxReaders);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy tree
+ * @details Destroys the tree, If supplied with non-NULL destroyer function,
+ *			frees the items in the tree. No thread may use the tree while it is destroyed.
+ * @Complexity	O(n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   destroyer      	= A function to destroy the items (may be NULL if unnecessary)
+ */
+void CTree_Destroy(CTree* _tree, void (*_destroyer)(void*));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add an item to the tree if it's not already there
+ * @details The writers are serialized, the readers are not blocked.
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   item           	= An item to add to the tree
+ *
+ * @return  Success indicator
+ * @retval  CTREE_SUCCESS				= On success
+ * @retval  CTREE_UNINITIALIZED_ERROR	= If the tree is not initialized
+ * @retval  CTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  CTREE_DUPLICATE_ERROR		= If an equal item already in the tree
+ * @retval  CTREE_ALLOCATION_ERROR		= On failure to allocate memory, the tree is not changed
+ */
+CTreeResult CTree_Insert(CTree* _tree, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the item equal to _key from the tree
+ * @details The writers are serialized, the readers are not blocked.
+ *			The tree never free the items, a reader can still hold the removed item.
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The removed item OR NULL if not found OR on allocation failure OR uninitialized pointer given
+ */
+void* CTree_Remove(CTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key, without locking
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   readerId        = The id of the calling reader, less then _maxReaders
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* CTree_Find(CTree* _tree, size_t _readerId, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details All the items are taken from the same version of the tree, updates that are
+ *			published during the iteration are not seen. Iteration will stop on the first
+ *			item for which action returns a zero or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Tree to iterate over
+ * @param   readerId        =       The id of the calling reader, less then _maxReaders
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* CTree_Range(CTree* _tree, size_t _readerId, void* _low, void* _high,
+				CTreeActionFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the tree
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t CTree_Size(const CTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __CONCURRENT_TREE_H__ */
@@ -0,0 +1,228 @@
+/**
+ *  @file 		deque.h
+ *  @brief 		header file for Generic Deque (double ended queue) data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				Elements can be pushed and popped at both ends in O(1) and
+ * 				accessed by index in O(1).
+ * 				Implemented as a cyclic map of fixed size blocks, the map grows by
+ * 				doubling (only block pointers are copied, never the elements) and
+ * 				blocks are allocated on demand and kept for reuse until destroy.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __DEQUE_H__
+#define __DEQUE_H__
+
+#include <stddef.h>  /* size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Deque Deque;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef int	(*DequeElementAction)(void* _element, size_t _index, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum Deque_Result {
+	DEQUE_SUCCESS = 0,
+	DEQUE_UNINITIALIZED_ERROR,			/* Uninitialized deque error 			*/
+	DEQUE_ALLOCATION_ERROR,				/* Allocation of block OR map failed 	*/
+	DEQUE_NULL_ELEMENT_ERROR,			/* Uninitialized element error 			*/
+	DEQUE_INDEX_OUT_OF_BOUNDS_ERROR,	/* Index is not less then the size 		*/
+	DEQUE_IS_EMPTY						/* Pop from an empty deque 				*/
+} DequeResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new deque
+ *
+ * @param 	initialCapacity			= Number of elements the map is made for initially,
+ *									  blocks are allocated only when used
+ *
+ * @return 	The deque pointer
+ * @retval	Deque*					= On success
+ * @retval	NULL 					= On allocation failure
+ */
+Deque* DequeCreate(size_t _initialCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated deque
+ *
+ * @param	deque					= Deque to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all
+ *								  elements or a null if no such destroy is required
+ *
+ * @return void
+ */
+void DequeDestroy(Deque** _deque, void (*_elementDestroy)(void* _item));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element at the front of the deque
+ * @Complexity	O(1) amortized
+ *
+ * @param	deque						= Deque to use.
+ * @param	item						= Element to add.
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When item is uninitialized
+ * @retval 	DEQUE_ALLOCATION_ERROR 		= On allocation failure, the deque is not changed
+ */
+DequeResult DequePushFront(Deque* _deque, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element at the back of the deque
+ * @Complexity	O(1) amortized
+ *
+ * @param	deque						= Deque to use.
+ * @param	item						= Element to add.
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When item is uninitialized
+ * @retval 	DEQUE_ALLOCATION_ERROR 		= On allocation failure, the deque is not changed
+ */
+DequeResult DequePushBack(Deque* _deque, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element at the front of the deque
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When pValue is NULL
+ * @retval 	DEQUE_IS_EMPTY 				= When the deque is empty
+ */
+DequeResult DequePopFront(Deque* _deque, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element at the back of the deque
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS				= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 	= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 	= When pValue is NULL
+ * @retval 	DEQUE_IS_EMPTY 				= When the deque is empty
+ */
+DequeResult DequePopBack(Deque* _deque, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the element at _index, 0 is the front
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	index						= Index of the element, from the front
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS					= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 		= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 		= When pValue is NULL
+ * @retval 	DEQUE_INDEX_OUT_OF_BOUNDS_ERROR = When index >= size
+ */
+DequeResult DequeGet(const Deque* _deque, size_t _index, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Replace the element at _index, 0 is the front
+ * @Complexity	O(1)
+ *
+ * @param	deque						= Deque to use.
+ * @param	index						= Index of the element, from the front
+ * @param	item						= New element
+ *
+ * @return	Status DequeResult that indicate in which state the function ended:
+ *
+ * @retval 	DEQUE_SUCCESS					= On success
+ * @retval 	DEQUE_UNINITIALIZED_ERROR 		= When deque is uninitialized
+ * @retval 	DEQUE_NULL_ELEMENT_ERROR 		= When item is NULL
+ * @retval 	DEQUE_INDEX_OUT_OF_BOUNDS_ERROR = When index >= size
+ */
+DequeResult DequeSet(Deque* _deque, size_t _index, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the deque.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the deque is empty OR pointer is uninitialized
+ */
+size_t DequeSize(const Deque* _deque);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Iterate over all elements in the deque, from the front.
+ * @details The user provided _action function will be called for each element
+ *          if _action return a zero for an element the iteration will stop.
+ *
+ * @param	deque			= Deque to iterate over.
+ * @param	action			= User provided function pointer to be invoked for each element
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of times the user functions was invoked
+ */
+size_t DequeForEach(const Deque* _deque, DequeElementAction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __DEQUE_H__ */
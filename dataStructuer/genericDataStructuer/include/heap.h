@@ -1,191 +1,177 @@
+/**
+ *  @file 		heap.h
+ *  @brief 		header file for Generic Heap data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				Implemented as a binary max heap over a user provided generic Vector,
+ * 				the order of the elements is given by a user provided less function.
+ * 				The heap does not own the vector, the user get it back on destroy.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
 #ifndef __HEAP_H__
 #define __HEAP_H__
 
-/** 
- *  @file heap.h
- *  @brief Create a Generic Heap dataBase type
- * 
- *  @details Implemented as heap using generic vector 
- *  Struct are allocated from heap and store pointers to user proveded element.
- * 
- *  @author Matan Asaf
- *  @date 08/11/2016 
- * 
- *  @bug No known bugs.
- */ 
- 
- 
 #include "vector.h" 	/* vector header */
-#include "privateHeapStruct.h" /* define heap struct */
-#include <stdlib.h> 	/* for size_t */ 
-                                               
-                                                
-                                                
-                                                
-                                                
-/***************************************** Declaration of typedef *****************************************/
-/*--------------------------------------------------------------------------------------------------------*/
+#include <stddef.h>  	/* size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
 typedef struct Heap Heap;
-/*--------------------------------------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-typedef int	(*VectorElementAction)(void* _element, size_t _index, void* _context);
-/*--------------------------------------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+/* Same form as LessComparator of binTree.h, none zero if _left is before _right */
+typedef int (*HeapLessComparator)(void* _left, void* _right);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 typedef enum Heap_Result {
 	HEAP_SUCCESS = 0,
-	HEAP_UNINITIALIZED_ERROR,			/* Uninitialized list 					 	*/
-	HEAP_ALLOCATION_ERROR,				/* Node allocation failed due to heap error */
-	HEAP_NULL_ELEMENT_ERROR,            /* Uninitialized element 					*/
-	HEAP_UNDERFLOW,                 	/* realloc failed 			                */
-    HEAP_OVERFLOW,						/* realloc with _blockSize of 0				*/
-    HEAP_WRONG_INDEX,					/* ... TODO				                    */
-    HEAP_IS_EMPTY						/* when trying to get an element from empty heap */
+	HEAP_UNINITIALIZED_ERROR,			/* Uninitialized heap error 				*/
+	HEAP_ALLOCATION_ERROR,				/* Realloc of the vector failed 			*/
+	HEAP_NULL_ELEMENT_ERROR,            /* Uninitialized element error 				*/
+    HEAP_OVERFLOW,						/* The vector is full and _blockSize is 0	*/
+    HEAP_IS_EMPTY						/* When trying to get an element from empty heap */
 } HeapResult;
-/*--------------------------------------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
 
 
-/********************************************* API functions **********************************************/
-/*--------------------------------------------------------------------------------------------------------*/
-/** @brief  Build new heap
- * Average time complexity O(n^2).
- * Worst: O(n^2)
- *
- * @params  	_vec                    	=   The pointer to generic vector
- * @param       _less           =       A comparison function 
- *				that returns true (none zero value) if x < y 
- *				and false (zero) otherwise.
- * @returns 	Pointer to the new Heap
- * @retval  	NULL 						=	If dynamic vector is NULL OR allocation failed
- */
-Heap* HeapBuild(Vector* _vec, LessComparator _less);
-/*--------------------------------------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-/* Description : Destroy the heap but not the dynamic vector
- * 
- * Parameters  : ~ _heap - pointer to heap
- * 
- * Outputs 	   : ~ NONE
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Build a new heap from the elements of an existing vector
+ * @details The elements are reordered in place (Floyd's build), the vector is
+ *			used by the heap until HeapDestroy.
+ * @Complexity	O(n)
  *
- * Erros 	   : ~ NONE
+ * @param 	vec						= The vector to build the heap on
+ * @param 	less					= A comparison function that returns true (none zero value)
+ *								  if x < y and false (zero) otherwise.
  *
- * Limitations : ~ NONE 
+ * @return 	The heap pointer
+ * @retval	Heap*					= On success
+ * @retval	NULL 					= If _vec OR _less is NULL OR allocation failed
  */
-void HeapDestroy(Heap* _heap);
-/*--------------------------------------------------------------------------------------------------------*/
+Heap* HeapBuild(Vector* _vec, HeapLessComparator _less);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-/* Description : Insert data to the heap
- * 
- * Parameters  : ~ _heap - pointer to heap
- *               ~ _data - data that need to insert
- * 
- * Outputs 	   : ~ NONE
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Deallocate a previously built heap, the vector is not destroyed
  *
- * Erros 	   : ~ ERR_NOT_INITIALIZED
- *               ~ ERR_OK
- *               ~ ERR_OVERFLOW 
- *               ~ ERR_REALLOCATION_FIALED
+ * @param	heap					= Heap to be deallocated, set to NULL.
  *
- * Limitations : ~ NONE 
+ * @return 	The vector the heap was built on, in heap order
+ * @retval	NULL 					= If the heap is uninitialized
  */
-HeapResult HeapInsert(Heap* _heap, int _data);
-/*--------------------------------------------------------------------------------------------------------*/
+Vector* HeapDestroy(Heap** _heap);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
- /** @brief  Return the max item
- * Average time complexity O(1).
- * Worst: O(1)
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element to the heap
+ * @Complexity	O(log n)
+ *
+ * @param	heap						= Heap to use.
+ * @param	element						= Element to add.
  *
- * @params  	_heap                    	=   The pointer to generic heap
- * @param       **_pValue					=	Pointer to get the element pointer
- * @returns 	The element in the Heap with the max value
- * @retval  	NULL 						=	If dynamic heap is NULL
- * @retval  	HEAP_IS_EMPTY 				=	If there is no elements in the heap
- * @retval  	max item 					=	When HEAP_SUCCESS
+ * @return	Status HeapResult that indicate in which state the function ended:
+ *
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	HEAP_ALLOCATION_ERROR 		= When the vector failed to grow
+ * @retval 	HEAP_OVERFLOW 				= When the vector is full and it's _blockSize is 0
  */
-HeapResult HeapMax(Heap* _heap, void** _pValue);
-/*--------------------------------------------------------------------------------------------------------*/
+HeapResult HeapInsert(Heap* _heap, void* _element);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-/* Description : Return the max item and delete it
- * 
- * Parameters  : ~ _heap - pointer to heap
- *               ~ _data - pointer to store the max item
- * 
- * Outputs 	   : ~ deleted max item in the heap
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the max element without removing it
+ * @Complexity	O(1)
+ *
+ * @param	heap						= Heap to use.
+ * @param	pValue						= Pointer to variable that will receive the max element
  *
- * Erros 	   : ~ ERR_NOT_INITIALIZED
- *               ~ ERR_OK
- *               ~ ERR_WRONG_INDEX if heap is empty
- *               ~ ERR_UNDERFLOW if heap is empty
- *               ~ ERR_REALLOCATION_FIALED
+ * @return	Status HeapResult that indicate in which state the function ended:
  *
- * Limitations : ~ NONE 
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	HEAP_IS_EMPTY 				= When there are no elements in the heap
  */
-HeapResult HeapExtractMax(Heap* _heap, int* _data);
-/*--------------------------------------------------------------------------------------------------------*/
+HeapResult HeapMax(const Heap* _heap, void** _pValue);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
- /** @brief  Return the numbers of elements in the item
- * Average time complexity O(1).
- * Worst: O(1)
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the max element
+ * @Complexity	O(log n)
+ *
+ * @param	heap						= Heap to use.
+ * @param	pValue						= Pointer to variable that will receive the removed element
  *
- * @params  	_heap                    	=   The pointer to generic heap
- * @returns 	The number of element in the Heap 
- * @retval  	0 							=	If dynamic heap is NULL Or if the heap is empty
- * @retval  	heapSize 					=	Otherwise
+ * @return	Status HeapResult that indicate in which state the function ended:
+ *
+ * @retval 	HEAP_SUCCESS				= On success
+ * @retval 	HEAP_UNINITIALIZED_ERROR 	= When heap is uninitialized
+ * @retval 	HEAP_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	HEAP_IS_EMPTY 				= When there are no elements in the heap
  */
-size_t HeapItemsNum(Heap* _heap);
-/*--------------------------------------------------------------------------------------------------------*/
+HeapResult HeapExtractMax(Heap* _heap, void** _pValue);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-/* Description : print all items in heap
- * 
- * Parameters  : ~ _heap - pointer to heap
- * 
- * Outputs 	   : ~ NONE
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the heap.
+ *
+ * @param	heap			= Heap to use.
  *
- * Erros 	   : ~ NONE
+ * @return  Number of elements
  *
- * Limitations : ~ NONE 
+ * @retval	number			= On success
+ * @retval	0 				= If heap is empty OR pointer is uninitialized
  */
-void HeapPrint(Heap* _heap);
-/*--------------------------------------------------------------------------------------------------------*/
-/* TODO heap search */
+size_t HeapItemsNum(const Heap* _heap);
+/*----------------------------------------------------------------------------*/
 
 
-/*--------------------------------------------------------------------------------------------------------*/
-/**  
- * @brief Iterate over all elements in the vector.
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Iterate over all elements in the heap, in the vector order (not sorted).
  * @details The user provided _action function will be called for each element
- *          if _action return a zero for an element the iteration will stop.  
- * @param[in] _heap - heap to iterate over.
- * @param[in] _action - User provided function pointer to be invoked for each element
- * @param[in] _context - User provided context, will be sent to _action
- * @returns number of times the user functions was invoked
- * equevallent to:
- *      for(i = 1; i < Vector_Size(v); ++i){
- *             Vector_Get(v, i, &elem);
- *             if(_action(elem, i, _context) == 0)
- *					break;	
- *      }
- *		return i;
+ *          if _action return a zero for an element the iteration will stop.
+ *
+ * @param	heap			= Heap to iterate over.
+ * @param	action			= User provided function pointer to be invoked for each element
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of times the user functions was invoked
  */
-size_t VectorForEach(const Heap* _heap, VectorElementAction _action, void* _context);
-/*--------------------------------------------------------------------------------------------------------*/
-
+size_t HeapForEach(const Heap* _heap, VectorElementAction _action, void* _context);
+/*----------------------------------------------------------------------------*/
 
 
 #endif /* __HEAP_H__ */
@@ -0,0 +1,244 @@
+/**
+ *  @file 		inlineStack.h
+ *  @brief 		header file for Generic Inline Stack data type
+ *
+ *  @details 	The stack stores copies of fixed size elements (of _elementSize bytes)
+ *				inline in one array, not pointers to user elements. The array grows by
+ *				doubling.
+ *				The functions check their arguments and grow on demand. For hot loops
+ *				the typed macros access the array directly with no checks at all:
+ *				reserve room once (InlineStackReserve) before INLINE_STACK_PUSH and
+ *				test INLINE_STACK_IS_EMPTY before INLINE_STACK_POP.
+ *
+ *  			Example:
+ *				InlineStack* stack = InlineStackCreate(sizeof(int), 1024);
+ *				if( INLINE_STACK_SUCCESS == InlineStackReserve(stack, 2) )
+ *				{
+ *					INLINE_STACK_PUSH(stack, int, 7);
+ *					INLINE_STACK_PUSH(stack, int, 8);
+ *				}
+ *				while( !INLINE_STACK_IS_EMPTY(stack) ) { sum += INLINE_STACK_POP(stack, int); }
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	The macros do not check anything, the _type must be the type of
+ *				_elementSize the stack was created with.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __INLINE_STACK_H__
+#define __INLINE_STACK_H__
+
+#include <stddef.h>  /* size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+/* Open for the macros only, should not be accessed directly */
+typedef struct InlineStack
+{
+	void* m_items; 				/* Array of m_capacity elements, m_items[0] is the bottom */
+	size_t m_size; 				/* Number of elements */
+	size_t m_capacity; 			/* Number of elements that fit in m_items */
+	size_t m_elementSize; 		/* Size of an element in bytes */
+} InlineStack;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum InlineStack_Result {
+	INLINE_STACK_SUCCESS = 0,
+	INLINE_STACK_UNINITIALIZED_ERROR,	/* Uninitialized stack error 			*/
+	INLINE_STACK_NULL_ELEMENT_ERROR,	/* Uninitialized element error 			*/
+	INLINE_STACK_ALLOCATION_ERROR,		/* Realloc error on grow 				*/
+	INLINE_STACK_UNDERFLOW_ERROR		/* Pop OR top of an empty stack 		*/
+} InlineStackResult;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Unchecked push of _value of type _type, there must be room (see InlineStackReserve) */
+#define INLINE_STACK_PUSH(_stack, _type, _value)	\
+			( ((_type*)(_stack)->m_items)[(_stack)->m_size++] = (_value) )
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Unchecked pop, evaluate to the top element of type _type, the stack must not be empty */
+#define INLINE_STACK_POP(_stack, _type)		\
+			( ((_type*)(_stack)->m_items)[--(_stack)->m_size] )
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Unchecked top, evaluate to the top element of type _type (an lvalue), the stack must not be empty */
+#define INLINE_STACK_TOP(_stack, _type)		\
+			( ((_type*)(_stack)->m_items)[(_stack)->m_size - 1] )
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+#define INLINE_STACK_IS_EMPTY(_stack)		( 0 == (_stack)->m_size )
+#define INLINE_STACK_HAS_ROOM(_stack)		( (_stack)->m_size < (_stack)->m_capacity )
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new stack of elements of _elementSize bytes
+ *
+ * @param 	elementSize				= Size of one element in bytes
+ * @param 	initialCapacity			= Number of elements that can be stored initially
+ *
+ * @return 	The stack pointer
+ * @retval	InlineStack*			= On success
+ * @retval	NULL 					= On allocation failure OR when _elementSize is 0
+ */
+InlineStack* InlineStackCreate(size_t _elementSize, size_t _initialCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated stack
+ *
+ * @param	stack					= Stack to be deallocated, set to NULL.
+ *
+ * @return void
+ */
+void InlineStackDestroy(InlineStack** _stack);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Make sure _nElements more elements can be pushed without a grow
+ * @details After a success INLINE_STACK_PUSH can be used _nElements times.
+ *
+ * @param	stack							= Stack to use.
+ * @param	nElements						= Number of elements to make room for
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure, the stack is not changed
+ */
+InlineStackResult InlineStackReserve(InlineStack* _stack, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push a copy of the element at _element
+ * @Complexity	O(1) amortized
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address of the element to copy
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure
+ */
+InlineStackResult InlineStackPush(InlineStack* _stack, const void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop the top element and copy it to _element
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address to copy the element to (may be NULL if unnecessary)
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_UNDERFLOW_ERROR 		= When the stack is empty
+ */
+InlineStackResult InlineStackPop(InlineStack* _stack, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Copy the top element to _element without removing it
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address to copy the element to
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	INLINE_STACK_UNDERFLOW_ERROR 		= When the stack is empty
+ */
+InlineStackResult InlineStackTop(const InlineStack* _stack, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push _nElements elements from the array _elements, _elements[0] first
+ * @details One grow (at most) and one copy for all the elements.
+ *
+ * @param	stack							= Stack to use.
+ * @param	elements						= Array of _nElements elements
+ * @param	nElements						= Number of elements to push
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When elements is NULL
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure, nothing is pushed
+ */
+InlineStackResult InlineStackPushMany(InlineStack* _stack, const void* _elements, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop up to _maxElements elements to the array _elements
+ * @details The elements are copied in the order they were pushed, the last
+ *			popped (the deepest) is _elements[0] and the old top is the last one,
+ *			so InlineStackPushMany of the result restores the stack.
+ *
+ * @param	stack			= Stack to use.
+ * @param	elements		= Array of _maxElements elements to copy to
+ * @param	maxElements		= Max number of elements to pop
+ *
+ * @returns Number of popped elements, min(_maxElements, size) (0 on NULL arguments)
+ */
+size_t InlineStackPopMany(InlineStack* _stack, void* _elements, size_t _maxElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the stack.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the stack is empty OR pointer is uninitialized
+ */
+size_t InlineStackSize(const InlineStack* _stack);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __INLINE_STACK_H__ */
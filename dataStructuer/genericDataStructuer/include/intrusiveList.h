@@ -0,0 +1,351 @@
+/**
+ *  @file 		intrusiveList.h
+ *  @brief 		header file for Intrusive Double Linked List data type
+ *
+ *  @details 	The user embed an ILink member inside his own record and the list
+ *				chain the records through it, so insert and remove never allocate.
+ *				A record can live on several lists by embedding several links.
+ *				The record is reached back from a link by ILIST_ENTRY (container of).
+ *				Implemented as circular double linked list with one head sentinel,
+ *				a link that is not on any list points at itself.
+ *
+ *  			Example:
+ *				struct Record { int m_id; ILink m_byAge; ILink m_byKey; };
+ *				Record* rec = ILIST_ENTRY(IListBegin(&ages), Record, m_byAge);
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-28
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __INTRUSIVE_LIST_H__
+#define __INTRUSIVE_LIST_H__
+
+
+#include <stddef.h> /* for size_t, offsetof */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct ILink ILink;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Embedded by the user inside his record, should not be accessed directly */
+struct ILink
+{
+	ILink* m_next;
+	ILink* m_prev;
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* The list head, can be embedded as well (e.g. a bucket of a hash map) */
+typedef struct IList
+{
+	ILink m_head;
+} IList;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the record of type _type that hold the link _link in member _member */
+#define ILIST_ENTRY(_link, _type, _member)	\
+			( (_type*)( (char*)(_link) - offsetof(_type, _member) ) )
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Return none zero if the record of _a should be before the record of _b */
+typedef int (*ILinkLessFunction)(const ILink* _a, const ILink* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Return zero to stop the iteration */
+typedef int (*ILinkActionFunction)(ILink* _link, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Initialize an empty list
+ *
+ * @params  list       	=   The list to initialize
+ *
+ * @returns void
+ */
+void IListInit(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Initialize a link as not linked to any list
+ *
+ * @params  link       	=   The link to initialize
+ *
+ * @returns void
+ */
+void ILinkInit(ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if a link is currently on a list
+ *
+ * @params  link       	=   A link initialized with ILinkInit
+ *
+ * @retval  1          	=   If the link is on a list
+ * @retval  0          	=   If the link is not on a list OR uninitialized
+ */
+int ILinkIsLinked(const ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if the list is empty
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  1          	=   If the list is empty OR uninitialized
+ * @retval  0          	=   If there are elements in the list
+ */
+int IListIsEmpty(const IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get number of elements in the list
+ * @details Time complexity: O(n).
+ *
+ * @params  list              	= A previously initialized list
+ *
+ * @retval  number              = Number of elements, 0 if the list is uninitialized
+ */
+size_t IListSize(const IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add link to the head of list
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  list       	=   A previously initialized list
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListPushHead(IList* _list, ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add link to the tail of list
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  list       	=   A previously initialized list
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListPushTail(IList* _list, ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the link from the list's head
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  link        =   The removed link
+ * @retval  NULL        =   If the list is empty OR uninitialized
+ */
+ILink* IListPopHead(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the link from the list's tail
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  link        =   The removed link
+ * @retval  NULL        =   If the list is empty OR uninitialized
+ */
+ILink* IListPopTail(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Insert a link before _pos
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  pos       	=   A link on a list OR the list's end
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListInsertBefore(ILink* _pos, ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove a link from the list it is on
+ * @details Time complexity: O(1), the list itself is not needed.
+ *			After removal the link is not linked and can be removed again safely.
+ *
+ * @params  link       	=   A link to remove
+ *
+ * @returns void
+ */
+void IListRemove(ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the first link of the list
+ *
+ * @retval 	link        =   The first link OR the end if the list is empty
+ * @retval  NULL        =   If list is uninitialized
+ */
+ILink* IListBegin(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the end of the list, one after the last link
+ *
+ * @retval 	link        =   The end of the list
+ * @retval  NULL        =   If list is uninitialized
+ */
+ILink* IListEnd(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the next link
+ * @warning For the end of the list it return the first link, the list is circular
+ */
+ILink* IListNext(const ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the previous link
+ * @warning For the first link it return the end of the list, the list is circular
+ */
+ILink* IListPrev(const ILink* _link);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Preform action on each link in [_begin.._end)
+ * @details 	Iteration will stop if Action function returns 0 for a link
+ *
+ * @params 		_begin				= Link to start from
+ * @params 		_end				= Link to end on
+ * @params 		_action				= User provided action function
+ * @params 		_context			= Parameters for the function
+ *
+ * @return      The link where the iteration stoped, this might be _end
+ */
+ILink* IList_ForEach(ILink* _begin, ILink* _end, ILinkActionFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Sorts the list in place using merge sort, stable
+ * @Complexity 	O(n log n), no allocation
+ *
+ * @params 		_list				= A previously initialized list
+ * @params 		_less				= Less compare function
+ *
+ * @return void
+ */
+void IList_Sort(IList* _list, ILinkLessFunction _less);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Splice all links from [_begin.._end) into _dest
+ * @details 	Remove all links from the half open range [_begin.._end)
+ * 				and insert them before _dest
+ * @Complexity  O(1)
+ *
+ * @warning 	The function assumes that:
+ *  			_begin and _end are in the correct order and on the same list
+ *  			_dest is not between them
+ * 				Otherwise behavior is undefined
+ *
+ * @params 		_dest				= Link to insert before
+ * @params 		_begin				= Link to sublist start
+ * @params 		_end				= Link to sublist end
+ *
+ * @retval		NULL				= On initalize error OR when _begin == _end
+ * @retval		_begin				= The first spliced link
+ */
+ILink* IList_Splice(ILink* _dest, ILink* _begin, ILink* _end);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Merges two sorted sub lists into destination
+ * @details 	Merge links from two sub lists defined by [_firstBegin.._firstEnd)
+ * 				and [_secondBegin.._secondEnd), each sorted by _less, in sorted order.
+ * 				Merged links will be inserted before _dest, on equal links the
+ *				first sub list come first.
+ * 				If _less is NULL the first sub list and then the second are spliced.
+ *
+ * @warning 	This will removes all merged links from source ranges.
+ * @Complexity  O(n), no allocation
+ *
+ * @params 		_dest				= Link to insert before
+ * @params 		_firstBegin			= Link to sublist1 start
+ * @params 		_firstEnd			= Link to sublist1 end
+ * @params 		_secondBegin		= Link to sublist2 start
+ * @params 		_secondEnd			= Link to sublist2 end
+ * @params 		_less				= Less compare function
+ *
+ * @retval		NULL				= On initalize error OR when both sub lists are empty
+ * @retval		newBegin			= The first merged link
+ */
+ILink* IList_Merge(ILink* _dest, ILink* _firstBegin, ILink* _firstEnd,
+			ILink* _secondBegin, ILink* _secondEnd, ILinkLessFunction _less);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __INTRUSIVE_LIST_H__ */
@@ -5,7 +5,8 @@
  *  @details 	The API stores pointer to user provided elements of generic type.
  * 				The List is heap allocated and can grow and shrink on demand.
  *				Implemented as double linked list using head and tail sentinels.
- *  			Nodes are allocated from heap an store pointer to user proveded element.
+ *  			Nodes are taken from a per list pool of contiguous node blocks with a
+ *  			free list, and store pointer to user proveded element.
  * 
  *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
  *
@@ -169,4 +170,26 @@ size_t ListSize(const List* _list);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Rewrite the list's nodes in traversal order inside fresh node blocks
+ * @details After a lot of push/pop/insert/remove the nodes are scattered in the
+ *			pool, compaction make sequential iteration a sequential memory access
+ *			and release the memory of all the old blocks.
+ *  		Time complexity O(n).
+ *
+ * @params  list                       	=   A previously created List ADT returned via ListCreate
+ *
+ * @return	Status ListResult that indicate in which state the function ended:
+ *
+ * @retval  LIST_SUCCESS                =   On success
+ * @retval  LIST_UNINITIALIZED_ERROR    =   If the list ptr is uninitialized
+ * @retval  LIST_ALLOCATION_ERROR       =   On memory allocation failure, the list is unchanged
+ *
+ * @warning All the iterators of the list are invalid after successful compaction.
+ */
+ListResult ListCompact(List* _list);
+/*----------------------------------------------------------------------------*/
+
+
 #endif /* __LIST_H__ */
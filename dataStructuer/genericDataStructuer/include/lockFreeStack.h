@@ -0,0 +1,166 @@
+/**
+ *  @file 		lockFreeStack.h
+ *  @brief 		header file for Generic lock free stack data type
+ *
+ *  @details 	The API stores pointers to user provided elements in a LIFO stack that
+ *  			many threads push to and pop from at the same time, without locks
+ *  			(Treiber stack). Every change of the top is one compare and swap.
+ *  			The nodes are allocated once, on create, and are never freed until
+ *  			destroy, so a thread that lost a race never reads freed memory.
+ *  			The top holds the index of the top node and a tag that every change
+ *  			increments, so a compare and swap fails if the top was popped and pushed
+ *  			back between the read and the swap (the ABA problem).
+ *  			LFStack_PopAll detaches all the elements with one compare and swap,
+ *  			useful to drain a shared free list.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	The stack is of fixed capacity.
+ *  			The tag is half of a size_t, a thread that is stopped between the read
+ *  			and the swap while 2^32 (2^16 on 32 bit) other changes are done may miss an ABA.
+ *  			LFStack_Destroy: The stack can't protect destroy thread from other threads
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __LOCK_FREE_STACK_H__
+#define __LOCK_FREE_STACK_H__
+
+#include <stddef.h>  /* for size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct LFStack LFStack;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Action function called by LFStack_PopAll for every popped element
+ * @param 	element	 = The popped element
+ * @param	context	 = User context
+ */
+typedef void (*LFStackElementAction)(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum LFStack_Result {
+	LFSTACK_SUCCESS = 0,
+	LFSTACK_UNINITIALIZED_ERROR,	/* Uninitialized stack error 				*/
+	LFSTACK_NULL_ELEMENT_ERROR,		/* Uninitialized element error 				*/
+	LFSTACK_OVERFLOW_ERROR,			/* All the nodes are in use 				*/
+	LFSTACK_UNDERFLOW_ERROR			/* Pop of an empty stack 					*/
+} LFStackResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new lock free stack of fixed capacity
+ *
+ * @param 	capacity				= Max number of elements in the stack
+ *
+ * @return 	The stack pointer
+ * @retval	LFStack*				= On success
+ * @retval	NULL 					= On allocation failure OR when _capacity is 0 OR too big
+ */
+LFStack* LFStack_Create(size_t _capacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated stack
+ *
+ * @param	stack					= Stack to be deallocated, set to NULL.
+ * @params	elementDestroy 			= A function pointer to be used to destroy all
+ * 									elements in the stack OR a null if no such destroy is required
+ *
+ * @return void
+ *
+ * @warning No other thread may use the stack while it is destroyed
+ */
+void LFStack_Destroy(LFStack** _stack, void (*_elementDestroy)(void* _element));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push an element to the top of the stack, thread safe and lock free
+ * @Complexity	O(1), retried on every lost race
+ *
+ * @param	stack						= Stack to use.
+ * @param	element						= Element to push.
+ *
+ * @return	Status LFStackResult that indicate in which state the function ended:
+ *
+ * @retval 	LFSTACK_SUCCESS				= On success
+ * @retval 	LFSTACK_UNINITIALIZED_ERROR = When stack is uninitialized
+ * @retval 	LFSTACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	LFSTACK_OVERFLOW_ERROR 		= When the stack holds capacity elements
+ */
+LFStackResult LFStack_Push(LFStack* _stack, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop the element at the top of the stack, thread safe and lock free
+ * @Complexity	O(1), retried on every lost race
+ *
+ * @param	stack						= Stack to use.
+ * @param	pElement					= Pointer to variable that will receive the popped element
+ *
+ * @return	Status LFStackResult that indicate in which state the function ended:
+ *
+ * @retval 	LFSTACK_SUCCESS				= On success
+ * @retval 	LFSTACK_UNINITIALIZED_ERROR = When stack is uninitialized
+ * @retval 	LFSTACK_NULL_ELEMENT_ERROR 	= When pElement is NULL
+ * @retval 	LFSTACK_UNDERFLOW_ERROR 	= When the stack is empty
+ */
+LFStackResult LFStack_Pop(LFStack* _stack, void** _pElement);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop all the elements of the stack at once, thread safe and lock free
+ * @details All the elements are detached with one compare and swap, then _action
+ * 			is called for every element from the top down, after that the nodes are
+ * 			returned with one more compare and swap.
+ * 			Elements pushed by other threads after the detach stay in the stack.
+ *
+ * @param	stack			= Stack to use.
+ * @param	action			= Function called for every popped element (may be NULL)
+ * @param	context			= Context passed to _action
+ *
+ * @returns Number of popped elements (0 if the stack is empty OR uninitialized)
+ */
+size_t LFStack_PopAll(LFStack* _stack, LFStackElementAction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if the stack is empty, a snapshot that other threads may change
+ *
+ * @retval	1 				= If the stack is empty OR pointer is uninitialized
+ * @retval	0 				= Otherwise
+ */
+int LFStack_IsEmpty(const LFStack* _stack);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __LOCK_FREE_STACK_H__ */
@@ -0,0 +1,205 @@
+/**
+ *  @file 		persistentTree.h
+ *  @brief 		Header file for Generic persistent (immutable) ordered tree
+ *
+ *  @details 	Implement an ordered set ADT of user items where every version of the
+ *  			tree stays valid. Insert and remove never change a version, they return a
+ *  			new version that copies only the path to the changed item and shares all
+ *  			the other subtrees with the old version (path copying).
+ *  			A snapshot of a version costs O(1) time and memory, so a long report can
+ *  			read a point in time view while updates keep going.
+ *  			Nodes are reference counted, destroying a version frees only the nodes that
+ *  			no other version use. The tree is kept as an AVL tree, the height is O(log n).
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	A version is never changed, so any number of threads can read versions and
+ *  			make new versions from them. One version must not be destroyed while it is used.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __PERSISTENT_TREE_H__
+#define __PERSISTENT_TREE_H__
+
+#include <stddef.h>  /* for size_t */
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+/* One version of the tree */
+typedef struct PTree PTree;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as LessComparator of binTree.h, none zero if _left is before _right */
+typedef int (*PTreeLessComparator)(void* _left, void* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as ActionFunction of binTree.h, return zero to stop the iteration */
+typedef int (*PTreeActionFunction)(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum PTree_Result
+{
+	PTREE_SUCCESS = 0,
+	PTREE_UNINITIALIZED_ERROR,		/* Uninitialized tree error */
+	PTREE_ITEM_NULL_ERROR, 			/* Uninitialized item error */
+	PTREE_DUPLICATE_ERROR, 			/* Item already in the tree */
+	PTREE_NOT_FOUND_ERROR, 			/* Item is not in the tree */
+	PTREE_ALLOCATION_ERROR 			/* Allocation error 	 	*/
+} PTreeResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create the empty version of a persistent tree
+ *
+ * @param   less			= A comparison function that returns true (none zero value)
+ *							if x < y  and false (zero) otherwise.
+ *
+ * @return 	The version pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created version.
+ * @retval  NULL          	= On failure due to allocation failure OR due to uninitialized pointer given
+ */
+PTree* PTree_Create(PTreeLessComparator _less);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy one version
+ * @details Frees the nodes that no other version use, the other versions are not changed.
+ *			The items are never freed, they can be shared by many versions.
+ * @Complexity	O(k) where k is the number of nodes that only this version use
+ *
+ * @param   tree           	= A version returned by any function of this API
+ */
+void PTree_Destroy(PTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Take a snapshot of a version
+ * @details The snapshot share all the nodes with _tree, both must be destroyed.
+ * @Complexity	O(1)
+ *
+ * @param   tree           	= A version returned by any function of this API
+ *
+ * @return 	The snapshot OR NULL on allocation failure OR uninitialized pointer given
+ */
+PTree* PTree_Snapshot(const PTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Make a new version with _item added
+ * @details _tree is not changed, the new version share with it all the nodes
+ *			that are not on the path to _item.
+ * @Complexity 	O(log n) time and memory
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   item           	= An item to add
+ * @param   newTree        	= Set to the new version on success
+ *
+ * @return  Success indicator
+ * @retval  PTREE_SUCCESS				= On success
+ * @retval  PTREE_UNINITIALIZED_ERROR	= If _tree OR _newTree is not initialized
+ * @retval  PTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  PTREE_DUPLICATE_ERROR		= If an equal item already in _tree
+ * @retval  PTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+PTreeResult PTree_Insert(const PTree* _tree, void* _item, PTree** _newTree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Make a new version without the item equal to _key
+ * @details _tree is not changed, the new version share with it all the nodes
+ *			that are not on the path to the removed item.
+ * @Complexity 	O(log n) time and memory
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   key           	= An item to compare the items to
+ * @param   newTree        	= Set to the new version on success
+ * @param   removed        	= Set to the removed item on success (may be NULL if unnecessary)
+ *
+ * @return  Success indicator
+ * @retval  PTREE_SUCCESS				= On success
+ * @retval  PTREE_UNINITIALIZED_ERROR	= If _tree OR _newTree is not initialized
+ * @retval  PTREE_ITEM_NULL_ERROR		= If _key is NULL
+ * @retval  PTREE_NOT_FOUND_ERROR		= If no equal item in _tree
+ * @retval  PTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+PTreeResult PTree_Remove(const PTree* _tree, void* _key, PTree** _newTree, void** _removed);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* PTree_Find(const PTree* _tree, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the version
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t PTree_Size(const PTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details Iteration will stop on the first item for which action returns a zero
+ *          or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Version to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* PTree_Range(const PTree* _tree, void* _low, void* _high,
+				PTreeActionFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __PERSISTENT_TREE_H__ */
@@ -0,0 +1,211 @@
+/**
+ *  @file 		priorityQueue.h
+ *  @brief 		header file for Generic indexed Priority Queue data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				The first element is the smallest by a user provided less function.
+ * 				Every inserted element gets a handle, the handle can change the
+ * 				priority of the element OR remove it from any place in the queue.
+ * 				Implemented as a 4-ary heap, the 4 sons of a father are next to each
+ * 				other in memory and the tree is half as high as a binary heap.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	A handle is valid from the insert until the element leaves the queue
+ *  			(PQueue_Pop, PQueue_Remove OR PQueue_Destroy).
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __PRIORITY_QUEUE_H__
+#define __PRIORITY_QUEUE_H__
+
+#include <stddef.h>  /* size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct PQueue PQueue;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Handle of one element in the queue */
+typedef struct PQueueHandle PQueueHandle;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as LessComparator of binTree.h, none zero if _left is before _right */
+typedef int (*PQueueLessComparator)(void* _left, void* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum PQueue_Result {
+	PQUEUE_SUCCESS = 0,
+	PQUEUE_UNINITIALIZED_ERROR,			/* Uninitialized queue error 			*/
+	PQUEUE_ALLOCATION_ERROR,			/* Allocation of element OR array failed */
+	PQUEUE_NULL_ELEMENT_ERROR,          /* Uninitialized element error 			*/
+	PQUEUE_HANDLE_ERROR,				/* Handle is not of an element in the queue */
+    PQUEUE_IS_EMPTY						/* When trying to get an element from empty queue */
+} PQueueResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new priority queue
+ *
+ * @param 	less					= A comparison function that returns true (none zero value)
+ *								  if x < y and false (zero) otherwise.
+ * @param 	initialCapacity			= Number of elements that can be stored before the first grow,
+ *								  the queue doubles it's capacity when full
+ *
+ * @return 	The queue pointer
+ * @retval	PQueue*					= On success
+ * @retval	NULL 					= If _less is NULL OR allocation failed
+ */
+PQueue* PQueue_Create(PQueueLessComparator _less, size_t _initialCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated queue, all the handles are freed
+ *
+ * @param	pQueue					= Queue to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all
+ *								  elements in the queue or a null if no such destroy is required
+ *
+ * @return void
+ */
+void PQueue_Destroy(PQueue** _pQueue, void (*_elementDestroy)(void* _item));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element to the queue
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	element						= Element to add.
+ * @param	handle						= Set to the handle of the element (may be NULL if unnecessary)
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	PQUEUE_ALLOCATION_ERROR 	= On allocation failure
+ */
+PQueueResult PQueue_Insert(PQueue* _pQueue, void* _element, PQueueHandle** _handle);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the first (smallest) element without removing it
+ * @Complexity	O(1)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	PQUEUE_IS_EMPTY 			= When there are no elements in the queue
+ */
+PQueueResult PQueue_Top(const PQueue* _pQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the first (smallest) element, it's handle is freed
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	pValue						= Pointer to variable that will receive the removed element
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	PQUEUE_IS_EMPTY 			= When there are no elements in the queue
+ */
+PQueueResult PQueue_Pop(PQueue* _pQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Replace the element of a handle and move it to it's new place
+ * @details To change the priority of an element in place, change the element
+ *			and call this function with the same element.
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	handle						= Handle returned by PQueue_Insert
+ * @param	element						= The new element of the handle
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	PQUEUE_HANDLE_ERROR 		= When handle is NULL OR not of this queue
+ */
+PQueueResult PQueue_ChangePriority(PQueue* _pQueue, PQueueHandle* _handle, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element of a handle from any place in the queue, the handle is freed
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	handle						= Handle returned by PQueue_Insert
+ * @param	pValue						= Set to the removed element (may be NULL if unnecessary)
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_HANDLE_ERROR 		= When handle is NULL OR not of this queue
+ */
+PQueueResult PQueue_Remove(PQueue* _pQueue, PQueueHandle* _handle, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the queue.
+ *
+ * @param	pQueue			= Queue to use.
+ *
+ * @return  Number of elements
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If queue is empty OR pointer is uninitialized
+ */
+size_t PQueue_Size(const PQueue* _pQueue);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __PRIORITY_QUEUE_H__ */
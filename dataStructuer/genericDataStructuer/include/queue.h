@@ -37,7 +37,8 @@ typedef enum Queue_Result {
 	QUEUE_UNINITIALIZED_ERROR,	/* Uninitialized Queue error */
 	ITEM_UNINITIALIZED_ERROR,	/* Uninitialized item error */
 	QUEUE_OVERFLOW,				/* Overflow error, when there is no room to add more elements */
-	QUEUE_UNDERFLOW				/* Underflow error, when there is no elements in the queue to get */
+	QUEUE_UNDERFLOW,			/* Underflow error, when there is no elements in the queue to get */
+	QUEUE_ALLOCATION_ERROR		/* Allocation error, when a growable queue failed to grow */
 } QueueResult;
 /*----------------------------------------------------------------------------*/
 
@@ -63,6 +64,24 @@ Queue* QueueCreate(size_t _initialCapacity);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function create a new queue that grows when it is full
+ * @details     Like QueueCreate, but an insert to a full queue doubles the capacity
+ *				instead of QUEUE_OVERFLOW. The capacity is always a power of 2.
+ *
+ * @param       _initialCapacity 	=   Number of elements that can be stored initially,
+ *										rounded up to a power of 2
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL				= 	On error when initalize
+ * @retval 		_myQueue			=	On success
+ */
+Queue* QueueCreateGrowable(size_t _initialCapacity);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /**  
  * @brief 		Dynamically deallocate a previously allocated Queue 
@@ -91,6 +110,7 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) );
  * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
  * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
  * @retval 		QUEUE_OVERFLOW				=	When there is no room to add more elements
+ * @retval 		QUEUE_ALLOCATION_ERROR		=	When a growable queue failed to grow
  */
 QueueResult QueueInsert(Queue* const _myQueue, void* _data);
 /*----------------------------------------------------------------------------*/
@@ -108,12 +128,63 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data);
  *
  * @retval 		QUEUE_SUCCESS				=	On success
  * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
- * @retval 		QUEUE_ALLOCATION_ERROR		=	Allocation error 
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_UNDERFLOW				=	When the queue is empty
  */
 QueueResult QueueRemove(Queue* const _myQueue, void** _pValue);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get the next element of the queue without removing it
+ *
+ * @param       _myQueue        			=   Pointer to queue
+ * @param       _pValue    					=   Pointer to variable that will receive item data
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS				=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW				=	When the queue is empty
+ */
+QueueResult QueuePeek(const Queue* _myQueue, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function put a block of elements into queue, in order
+ * @details     A growable queue grows once to fit all the elements, a fixed queue
+ *				takes as many as it has room for. Stops on the first NULL element.
+ *
+ * @param       _myQueue					=   Pointer to queue
+ * @param       _items    					=   Array of _nItems elements
+ * @param       _nItems    					=   Number of elements in _items
+ *
+ * @return		Number of elements that were inserted, from the start of _items
+ *				(0 if _myQueue OR _items is NULL)
+ */
+size_t QueueInsertMany(Queue* const _myQueue, void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get a block of elements from the queue, in order
+ *
+ * @param       _myQueue					=   Pointer to queue
+ * @param       _values    					=   Array of _maxItems to receive the elements
+ * @param       _maxItems  					=   Max number of elements to remove
+ *
+ * @return		Number of elements that were removed, min(_maxItems, QueueSize)
+ *				(0 if _myQueue OR _values is NULL)
+ */
+size_t QueueRemoveMany(Queue* const _myQueue, void** _values, size_t _maxItems);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief       The function return the orignal memory buffer capacity of the queue
@@ -0,0 +1,253 @@
+/**
+ *  @file 		skipList.h
+ *  @brief 		header file for Generic Skip List ordered map data type
+ *
+ *  @details 	The API stores pairs of pointers to user provided key and value.
+ *				The pairs are kept ordered by the keys using user provided less function,
+ *				insert, find, remove and bound queries are O(log n) expected.
+ *				Each node get a random height (p = 1/4) from a fast xorshift generator,
+ *				nodes are taken from a per list pool of contiguous chunks.
+ *				The user only hold opaque pointers and iterators, so a lock free
+ *				variant can replace the implementation without changing the API.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __SKIP_LIST_H__
+#define __SKIP_LIST_H__
+
+#include <stddef.h>  /* for size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct SkipList SkipList;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef void* SkipListItr;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum SkipList_Result
+{
+	SKIPLIST_SUCCESS = 0,
+	SKIPLIST_UNINITIALIZED_ERROR,	/* Uninitialized skip list error */
+	SKIPLIST_KEY_NULL_ERROR, 		/* Uninitialized key error  */
+	SKIPLIST_KEY_DUPLICATE_ERROR, 	/* Duplicate key error 		*/
+	SKIPLIST_KEY_NOT_FOUND_ERROR, 	/* Key not found 			*/
+	SKIPLIST_ALLOCATION_ERROR 		/* Allocation error 	 	*/
+} SkipListResult;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Same form as LessFunction of listFunctions.h, none zero if _a is before _b */
+typedef int (*SkipListLessFunction)(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Create a new skip list
+ *
+ * @param 	_less 		= Less function for the keys
+ *
+ * @return 	Newly created skip list or NULL on failure
+ */
+SkipList* SkipList_Create(SkipListLessFunction _less);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Destroy skip list
+ * @details Destroys the list completely optionally destroys keys and values
+ *			using user provided functions
+ *
+ * @params	_list 		= A pointer to previously created list, on completion *_list will be null
+ * @params	_keyDestroy = A function to destroy keys OR NULL
+ * @params	_valDestroy = A function to destroy values OR NULL
+ */
+void SkipList_Destroy(SkipList** _list, void (*_keyDestroy)(void* _key), void (*_valDestroy)(void* _value));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Insert a key-value pair into the skip list
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_key 		= Key to serve as index
+ * @param 	_value 		= The value to associate with the key
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _key is NULL
+ * @retval  SKIPLIST_KEY_DUPLICATE_ERROR	= If key already present in the list
+ * @retval  SKIPLIST_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+SkipListResult SkipList_Insert(SkipList* _list, void* _key, void* _value);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove a key-value pair from the skip list
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_searchKey 	= Key to search for
+ * @param 	_pKey 		= Pointer to variable that will get the key stored in the list, can be NULL
+ * @param 	_pValue 	= Pointer to variable that will get the value stored in the list, can be NULL
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _searchKey is NULL
+ * @retval  SKIPLIST_KEY_NOT_FOUND_ERROR	= If the key is not in the list
+ */
+SkipListResult SkipList_Remove(SkipList* _list, void* _searchKey, void** _pKey, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Find a value by key
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_searchKey 	= Key to search for
+ * @param 	_pValue 	= Pointer to variable that will get the value, can be NULL
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _searchKey is NULL
+ * @retval  SKIPLIST_KEY_NOT_FOUND_ERROR	= If the key is not in the list
+ */
+SkipListResult SkipList_Find(const SkipList* _list, void* _searchKey, void** _pValue);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get number of pairs in the list
+ * @details Time complexity O(1).
+ *
+ * @retval  number 		= Number of pairs, 0 if the list is uninitialized
+ */
+size_t SkipList_Size(const SkipList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the first pair that its key is not less then _key
+ * @details Expected time complexity O(log n).
+ *			Range [lo, hi) is iterated from SkipList_LowerBound(lo) to SkipList_LowerBound(hi).
+ *
+ * @retval  itr 		= Iterator to the pair OR end iterator if there is no such pair
+ * @retval  NULL 		= If the list OR key are uninitialized
+ */
+SkipListItr SkipList_LowerBound(const SkipList* _list, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the first pair that its key is greater then _key
+ * @details Expected time complexity O(log n).
+ *			Range [lo, hi] is iterated from SkipList_LowerBound(lo) to SkipList_UpperBound(hi).
+ *
+ * @retval  itr 		= Iterator to the pair OR end iterator if there is no such pair
+ * @retval  NULL 		= If the list OR key are uninitialized
+ */
+SkipListItr SkipList_UpperBound(const SkipList* _list, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the pair with the smallest key
+ *
+ * @retval  itr 		= Iterator to the first pair OR end iterator if the list is empty
+ * @retval  NULL 		= If the list is uninitialized
+ */
+SkipListItr SkipListItr_Begin(const SkipList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the end of the list, one after the greatest key
+ *
+ * @retval  itr 		= The end iterator
+ * @retval  NULL 		= If the list is uninitialized
+ */
+SkipListItr SkipListItr_End(const SkipList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Compare two iterators
+ *
+ * @retval  1 			= If both iterators point to the same pair
+ * @retval  0 			= Otherwise
+ */
+int SkipListItr_Equals(SkipListItr _a, SkipListItr _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the next pair in key order
+ * @warning if _itr is end iterator it will be returned
+ *
+ * @retval  itr 		= Iterator to the next pair
+ * @retval  NULL 		= If _itr is uninitialized
+ */
+SkipListItr SkipListItr_Next(SkipListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the key of the pair the iterator point at
+ *
+ * @retval  key 		= The key
+ * @retval  NULL 		= If _itr is the end OR uninitialized
+ */
+void* SkipListItr_GetKey(SkipListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the value of the pair the iterator point at
+ *
+ * @retval  value 		= The value
+ * @retval  NULL 		= If _itr is the end OR uninitialized
+ */
+void* SkipListItr_GetValue(SkipListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __SKIP_LIST_H__ */
@@ -0,0 +1,190 @@
+/**
+ *  @file 		timerWheel.h
+ *  @brief 		header file for Generic hierarchical Timer Wheel data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type,
+ * 				each with a deadline in ticks. The time of the wheel moves forward
+ * 				only by TimerWheel_Advance, that calls a user action for every
+ * 				element that its deadline has come.
+ * 				Implemented as 4 levels of 256 slots, level k holds the timers that are
+ * 				less then 256^(k+1) ticks away. Every slot is an intrusive list, so add,
+ * 				cancel and advance are O(1) amortized (a timer moves down a level at most
+ * 				3 times). Timer nodes are recycled, they are not freed until destroy.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *  @warning 	A timer handle is checked by it's generation, a handle of a timer that
+ *  			expired OR was canceled is rejected even after the node is reused.
+ *  			The handles of a wheel must not be used after the wheel is destroyed.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <stddef.h>  /* size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct TimerWheel TimerWheel;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct Timer Timer;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Handle of one timer, copied by value. The timer node is reused after the timer
+ * is released, the generation tells a handle of an old timer from the current one */
+typedef struct TimerHandle {
+	Timer* m_timer;				/* The timer node */
+	size_t m_generation;		/* The generation of the node when the timer was added */
+} TimerHandle;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Called for every expired element, the timer handle is already released */
+typedef void (*TimerExpireFunction)(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum TimerWheel_Result {
+	TIMER_WHEEL_SUCCESS = 0,
+	TIMER_WHEEL_UNINITIALIZED_ERROR,	/* Uninitialized wheel error 			*/
+	TIMER_WHEEL_ALLOCATION_ERROR,		/* Allocation of timer node failed 		*/
+	TIMER_WHEEL_NULL_ELEMENT_ERROR,		/* Uninitialized element error 			*/
+	TIMER_WHEEL_HANDLE_ERROR			/* Handle is NULL, not pending OR of another wheel */
+} TimerWheelResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new timer wheel, the time starts at 0
+ *
+ * @return 	The wheel pointer
+ * @retval	TimerWheel*				= On success
+ * @retval	NULL 					= On allocation failure
+ */
+TimerWheel* TimerWheel_Create(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated wheel, pending timers do not expire
+ *
+ * @param	wheel					= Wheel to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all pending
+ *								  elements or a null if no such destroy is required
+ *
+ * @return void
+ */
+void TimerWheel_Destroy(TimerWheel** _wheel, void (*_elementDestroy)(void* _item));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element that expires _delay ticks from now
+ * @details A delay of 0 expires on the next tick, like a delay of 1.
+ *			Delays longer then 2^32 ticks are supported, they are kept on the top
+ *			level until they get closer.
+ * @Complexity	O(1) amortized
+ *
+ * @param	wheel						= Wheel to use.
+ * @param	delay						= Ticks from now to the deadline
+ * @param	element						= Element to add.
+ * @param	handle						= Set to the handle of the timer (may be NULL if unnecessary)
+ *
+ * @return	Status TimerWheelResult that indicate in which state the function ended:
+ *
+ * @retval 	TIMER_WHEEL_SUCCESS				= On success
+ * @retval 	TIMER_WHEEL_UNINITIALIZED_ERROR = When wheel is uninitialized
+ * @retval 	TIMER_WHEEL_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	TIMER_WHEEL_ALLOCATION_ERROR 	= On allocation failure
+ */
+TimerWheelResult TimerWheel_Add(TimerWheel* _wheel, size_t _delay, void* _element, TimerHandle* _handle);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Cancel a pending timer, the action is not called for it
+ * @details Canceling a timer that already expired OR was canceled is safe, the
+ *			handle does not match the node any more and nothing is changed.
+ * @Complexity	O(1)
+ *
+ * @param	wheel						= Wheel to use.
+ * @param	handle						= Handle set by TimerWheel_Add
+ * @param	pElement					= Set to the element of the timer (may be NULL if unnecessary)
+ *
+ * @return	Status TimerWheelResult that indicate in which state the function ended:
+ *
+ * @retval 	TIMER_WHEEL_SUCCESS				= On success
+ * @retval 	TIMER_WHEEL_UNINITIALIZED_ERROR = When wheel is uninitialized
+ * @retval 	TIMER_WHEEL_HANDLE_ERROR 		= When the handle is NULL, expired, canceled OR of another wheel
+ */
+TimerWheelResult TimerWheel_Cancel(TimerWheel* _wheel, TimerHandle _handle, void** _pElement);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Move the time _ticks forward and expire the due timers
+ * @details The timers of each tick are taken from the wheel together in one list
+ *			and then _action is called for each of them, ticks are expired in order.
+ *			_action may add and cancel timers, a timer added with delay 0 expires
+ *			on the next tick.
+ * @Complexity	O(_ticks + expired) amortized, O(1) if the wheel is empty
+ *
+ * @param	wheel			= Wheel to use.
+ * @param	ticks			= Number of ticks to move
+ * @param	action			= Function to call for every expired element (may be NULL)
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of expired timers
+ */
+size_t TimerWheel_Advance(TimerWheel* _wheel, size_t _ticks, TimerExpireFunction _action, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of pending timers.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the wheel is empty OR pointer is uninitialized
+ */
+size_t TimerWheel_Size(const TimerWheel* _wheel);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the current time of the wheel, in ticks.
+ *
+ * @retval	now				= On success
+ * @retval	0 				= If pointer is uninitialized
+ */
+size_t TimerWheel_Now(const TimerWheel* _wheel);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __TIMER_WHEEL_H__ */
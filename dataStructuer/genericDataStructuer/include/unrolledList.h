@@ -0,0 +1,283 @@
+/**
+ *  @file 		unrolledList.h
+ *  @brief 		header file for Generic Unrolled Double Linked List data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				The List is heap allocated and can grow and shrink on demand.
+ *				Implemented as double linked list of nodes, each node keep a small
+ *				array of elements, so the list spend about 1/3 of the memory
+ *				per element of the regular List and iteration is mostly contiguous.
+ *				Fit for long FIFO lists that mostly iterated.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-27
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#ifndef __UNROLLED_LIST_H__
+#define __UNROLLED_LIST_H__
+
+
+#include <stddef.h> /* for size_t */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct UnrolledList UnrolledList;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Iterator is passed by value, the user should not access it's members */
+typedef struct UnrolledListItr
+{
+	const UnrolledList* m_list;
+	void* m_node;					/* NULL when pointing at the end */
+	size_t m_index;
+} UnrolledListItr;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef enum UnrolledList_Result {
+	UNROLLED_LIST_SUCCESS,
+	UNROLLED_LIST_UNINITIALIZED_ERROR,	/* Uninitialized list */
+	UNROLLED_LIST_ALLOCATION_ERROR,		/* Node allocation failed due to heap error */
+	UNROLLED_LIST_NULL_ELEMENT_ERROR,	/* Uninitialized element */
+	UNROLLED_LIST_EMPTY_ERROR			/* No element in the list to pop */
+} UnrolledListResult;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Create an unrolled list
+ *
+ * @return 	The UnrolledList pointer
+ *
+ * @retval 	On success    =   A pointer to the created list.
+ * @retval  NULL          =   On failure due to allocation failure
+ */
+UnrolledList* UnrolledListCreate(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy unrolled list
+ * @details Destroys the list completely optionally destroys elements using user provided function
+ *
+ * @params	pList       	=   A pointer to previously created UnrolledList returned via
+ *							UnrolledListCreate on completion *_pList will be null
+ * @params	elementDestroy  =   A function pointer to be used to destroy elements
+ *							inserted into the list or a null if no such destroy is required
+ * @returns void
+ */
+void UnrolledListDestroy(UnrolledList** _pList, void (*_elementDestroy)(void* _item));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add element to head of list
+ * @details Time complexity: O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  item                       		=   An item to add to the list
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If item element is uninitialized
+ * @retval  UNROLLED_LIST_ALLOCATION_ERROR      =   On memory allocation failure
+ */
+UnrolledListResult UnrolledListPushHead(UnrolledList* _list, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add element to tail of list
+ * @details Time complexity: O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  item                       		=   An item to add to the list
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If item element is uninitialized
+ * @retval  UNROLLED_LIST_ALLOCATION_ERROR      =   On memory allocation failure
+ */
+UnrolledListResult UnrolledListPushTail(UnrolledList* _list, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove element from list's head
+ * @details If successfull, stores a pointer to the removed item in _item
+ *  		Time complexity O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  pItem                      		=   Pointer to variable that will receive deleted item value
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If pItem is uninitialized
+ * @retval  UNROLLED_LIST_EMPTY_ERROR         	=   No element in the list to pop
+ */
+UnrolledListResult UnrolledListPopHead(UnrolledList* _list, void** _pItem);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove element from list's tail
+ * @details If successfull, stores a pointer to the removed item in _item
+ *  		Time complexity O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  pItem                      		=   Pointer to variable that will receive deleted item value
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If pItem is uninitialized
+ * @retval  UNROLLED_LIST_EMPTY_ERROR         	=   No element in the list to pop
+ */
+UnrolledListResult UnrolledListPopTail(UnrolledList* _list, void** _pItem);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get number of elements in the list
+ * @details Time complexity: O(1).
+ *
+ * @params  list              			= A previously created UnrolledList
+ *
+ * @returns Number of elements:
+ *
+ * @retval  number                  	= If there are more then 0
+ * @retval  0                       	= If the list is uninitialized OR number
+ *										of elements is 0
+ */
+size_t UnrolledListSize(const UnrolledList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the list's beginning
+ *
+ * @params  list       	=   list to return begin iterator, pointing at first element
+ *                          or at the end if list is empty
+ *
+ * @return  Iterator pointing at the list's beginning, if the list is
+ *			uninitialized the iterator will be at the end of no list
+ */
+UnrolledListItr UnrolledListItrBegin(const UnrolledList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the list end
+ *
+ * @params  list       	=   list to return end iterator
+ *
+ * @return  Iterator pointing at the list's end
+ */
+UnrolledListItr UnrolledListItrEnd(const UnrolledList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Function that compare between two iterators
+ *
+ * @params  a          	=   Iterator a
+ * @params  b          	=   Iterator b
+ *
+ * @retval  1           =   If iterator _a and iterator _b equals
+ * @retval  0           =   If iterator _a and iterator _b NOT equals
+ */
+int UnrolledListItrEquals(UnrolledListItr _a, UnrolledListItr _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the next element from a given iterator
+ * @warning if _itr is end iterator it will be returned
+ *
+ * @params  itr                            	=   current iterator
+ *
+ * @retval  All iterator exclude the end    =   Iterator pointing at the next element
+ * @retval  At end of the list              =   Iterator pointing at itself
+ */
+UnrolledListItr UnrolledListItrNext(UnrolledListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the previous element
+ * @warning if _itr is begin iterator it will be returned
+ *
+ * @params  itr                            	=   current iterator
+ *
+ * @retval  All iterator exclude the begin  =   Iterator pointing at the prev element
+ * @retval  In begin of the list            =   Iterator pointing at itself
+ */
+UnrolledListItr UnrolledListItrPrev(UnrolledListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get data from the element the current iterator is pointing to
+ *
+ * @params  itr         	=   A list iterator
+ *
+ * @retval  Data         	=   If the iterator is pointing at data
+ * @retval  NULL         	=   If iterator pointing to the end
+ */
+void* UnrolledListItrGet(UnrolledListItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Set data at the element where the current iterator is pointing at
+ *
+ * @params  itr         	=   A list iterator
+ * @params  element     	=   A iterator data
+ *
+ * @return  The orignal data from the element before the change:
+ *
+ * @retval  Data         	=   If the iterator is pointing at data
+ * @retval  NULL         	=   If iterator pointing to the end OR element is uninitialized
+ */
+void* UnrolledListItrSet(UnrolledListItr _itr, void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+#endif /* __UNROLLED_LIST_H__ */
@@ -0,0 +1,643 @@
+/**
+ *  @file 		intrusiveList.c
+ *  @brief 		src file for Intrusive Double Linked List data type
+ *
+ *  @details 	The user embed an ILink member inside his own record and the list
+ *				chain the records through it, so insert and remove never allocate.
+ *				Implemented as circular double linked list with one head sentinel,
+ *				a link that is not on any list points at itself.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-28
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "intrusiveList.h"	/* header file */
+#include <stdlib.h> 		/* for size_t, NULL */
+
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_VOID_NULL(param)		do{ if(NULL == (param) ) { return;}  } while(0)
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Connect a link between previous and next links
+ *
+ * @params  _current        =   The link to connect
+ * @params  _previous       =   The link that need to be before the current link
+ * @params  _next			=   The link that need to be after the current link
+ *
+ * @returns void
+ */
+static void PushConnect(ILink* _current, ILink* _previous, ILink* _next);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Bottom up merge sort of NULL terminated chain, using m_next only
+ *
+ * @params  _first          =   The first link of the chain
+ * @params  _less			=   Less compare function
+ *
+ * @returns The first link of the sorted chain
+ */
+static ILink* SortChain(ILink* _first, ILinkLessFunction _less);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Initialize an empty list
+ *
+ * @params  list       	=   The list to initialize
+ *
+ * @returns void
+ */
+void IListInit(IList* _list)
+{
+    CHECK_VOID_NULL(_list);
+
+    ILinkInit(&_list->m_head);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Initialize a link as not linked to any list
+ *
+ * @params  link       	=   The link to initialize
+ *
+ * @returns void
+ */
+void ILinkInit(ILink* _link)
+{
+    CHECK_VOID_NULL(_link);
+
+    _link->m_next = _link;
+    _link->m_prev = _link;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if a link is currently on a list
+ *
+ * @params  link       	=   A link initialized with ILinkInit
+ *
+ * @retval  1          	=   If the link is on a list
+ * @retval  0          	=   If the link is not on a list OR uninitialized
+ */
+int ILinkIsLinked(const ILink* _link)
+{
+    return (NULL != _link && _link != _link->m_next);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if the list is empty
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  1          	=   If the list is empty OR uninitialized
+ * @retval  0          	=   If there are elements in the list
+ */
+int IListIsEmpty(const IList* _list)
+{
+    return !ILinkIsLinked( (NULL == _list) ? NULL : &_list->m_head );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get number of elements in the list
+ * @details Time complexity: O(n).
+ *
+ * @params  list              	= A previously initialized list
+ *
+ * @retval  number              = Number of elements, 0 if the list is uninitialized
+ */
+size_t IListSize(const IList* _list)
+{
+    const ILink* link;
+    size_t counter = 0;
+
+    if( NULL == _list )
+    {
+        return 0;
+    }
+
+    for(link = _list->m_head.m_next; &_list->m_head != link; link = link->m_next)
+    {
+        ++counter;
+    }
+
+    return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add link to the head of list
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  list       	=   A previously initialized list
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListPushHead(IList* _list, ILink* _link)
+{
+    CHECK_VOID_NULL(_list);
+    CHECK_VOID_NULL(_link);
+
+    PushConnect(_link, &_list->m_head, _list->m_head.m_next);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add link to the tail of list
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  list       	=   A previously initialized list
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListPushTail(IList* _list, ILink* _link)
+{
+    CHECK_VOID_NULL(_list);
+    CHECK_VOID_NULL(_link);
+
+    PushConnect(_link, _list->m_head.m_prev, &_list->m_head);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the link from the list's head
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  link        =   The removed link
+ * @retval  NULL        =   If the list is empty OR uninitialized
+ */
+ILink* IListPopHead(IList* _list)
+{
+    ILink* link;
+
+    if( IListIsEmpty(_list) )
+    {
+        return NULL;
+    }
+
+    link = _list->m_head.m_next;
+    IListRemove(link);
+
+    return link;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the link from the list's tail
+ * @details Time complexity: O(1).
+ *
+ * @params  list       	=   A previously initialized list
+ *
+ * @retval  link        =   The removed link
+ * @retval  NULL        =   If the list is empty OR uninitialized
+ */
+ILink* IListPopTail(IList* _list)
+{
+    ILink* link;
+
+    if( IListIsEmpty(_list) )
+    {
+        return NULL;
+    }
+
+    link = _list->m_head.m_prev;
+    IListRemove(link);
+
+    return link;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Insert a link before _pos
+ * @details Time complexity: O(1), no allocation.
+ *
+ * @params  pos       	=   A link on a list OR the list's end
+ * @params  link       	=   A link that is not on any list
+ *
+ * @returns void
+ */
+void IListInsertBefore(ILink* _pos, ILink* _link)
+{
+    CHECK_VOID_NULL(_pos);
+    CHECK_VOID_NULL(_link);
+
+    PushConnect(_link, _pos->m_prev, _pos);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove a link from the list it is on
+ * @details Time complexity: O(1), the list itself is not needed.
+ *			After removal the link is not linked and can be removed again safely.
+ *
+ * @params  link       	=   A link to remove
+ *
+ * @returns void
+ */
+void IListRemove(ILink* _link)
+{
+    CHECK_VOID_NULL(_link);
+
+    _link->m_prev->m_next = _link->m_next;
+    _link->m_next->m_prev = _link->m_prev;
+    ILinkInit(_link);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the first link of the list
+ *
+ * @retval 	link        =   The first link OR the end if the list is empty
+ * @retval  NULL        =   If list is uninitialized
+ */
+ILink* IListBegin(IList* _list)
+{
+    CHECK_NULL(_list);
+
+    return _list->m_head.m_next;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the end of the list, one after the last link
+ *
+ * @retval 	link        =   The end of the list
+ * @retval  NULL        =   If list is uninitialized
+ */
+ILink* IListEnd(IList* _list)
+{
+    CHECK_NULL(_list);
+
+    return &_list->m_head;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the next link
+ * @warning For the end of the list it return the first link, the list is circular
+ */
+ILink* IListNext(const ILink* _link)
+{
+    CHECK_NULL(_link);
+
+    return _link->m_next;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the previous link
+ * @warning For the first link it return the end of the list, the list is circular
+ */
+ILink* IListPrev(const ILink* _link)
+{
+    CHECK_NULL(_link);
+
+    return _link->m_prev;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Preform action on each link in [_begin.._end)
+ * @details 	Iteration will stop if Action function returns 0 for a link
+ *
+ * @params 		_begin				= Link to start from
+ * @params 		_end				= Link to end on
+ * @params 		_action				= User provided action function
+ * @params 		_context			= Parameters for the function
+ *
+ * @return      The link where the iteration stoped, this might be _end
+ */
+ILink* IList_ForEach(ILink* _begin, ILink* _end, ILinkActionFunction _action, void* _context)
+{
+    ILink* next;
+
+    CHECK_NULL(_begin);
+    CHECK_NULL(_end);
+    CHECK_NULL(_action);
+
+    /* Next is taken before the action, so the action can remove the link */
+    for(; _end != _begin; _begin = next)
+    {
+        next = _begin->m_next;
+        if( 0 == _action(_begin, _context) )
+        {
+            break;
+        }
+    }
+
+    return _begin;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Sorts the list in place using merge sort, stable
+ * @Complexity 	O(n log n), no allocation
+ *
+ * @params 		_list				= A previously initialized list
+ * @params 		_less				= Less compare function
+ *
+ * @return void
+ */
+void IList_Sort(IList* _list, ILinkLessFunction _less)
+{
+    ILink* previous;
+    ILink* current;
+
+    if( NULL == _less || IListIsEmpty(_list) )
+    {
+        return;
+    }
+
+    _list->m_head.m_prev->m_next = NULL;
+    _list->m_head.m_next = SortChain(_list->m_head.m_next, _less);
+
+    /* Fix the back links and close the circle */
+    previous = &_list->m_head;
+    for(current = _list->m_head.m_next; NULL != current; current = current->m_next)
+    {
+        current->m_prev = previous;
+        previous = current;
+    }
+    previous->m_next = &_list->m_head;
+    _list->m_head.m_prev = previous;
+
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Splice all links from [_begin.._end) into _dest
+ * @details 	Remove all links from the half open range [_begin.._end)
+ * 				and insert them before _dest
+ * @Complexity  O(1)
+ *
+ * @warning 	The function assumes that:
+ *  			_begin and _end are in the correct order and on the same list
+ *  			_dest is not between them
+ * 				Otherwise behavior is undefined
+ *
+ * @params 		_dest				= Link to insert before
+ * @params 		_begin				= Link to sublist start
+ * @params 		_end				= Link to sublist end
+ *
+ * @retval		NULL				= On initalize error OR when _begin == _end
+ * @retval		_begin				= The first spliced link
+ */
+ILink* IList_Splice(ILink* _dest, ILink* _begin, ILink* _end)
+{
+    ILink* last;
+
+    CHECK_NULL(_dest);
+    CHECK_NULL(_begin);
+    CHECK_NULL(_end);
+
+    if( _begin == _end )
+    {
+        return NULL;
+    }
+
+    last = _end->m_prev;
+
+    _begin->m_prev->m_next = _end;
+    _end->m_prev = _begin->m_prev;
+
+    _begin->m_prev = _dest->m_prev;
+    _dest->m_prev->m_next = _begin;
+    last->m_next = _dest;
+    _dest->m_prev = last;
+
+    return _begin;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 		Merges two sorted sub lists into destination
+ * @details 	Merge links from two sub lists defined by [_firstBegin.._firstEnd)
+ * 				and [_secondBegin.._secondEnd), each sorted by _less, in sorted order.
+ * 				Merged links will be inserted before _dest, on equal links the
+ *				first sub list come first.
+ * 				If _less is NULL the first sub list and then the second are spliced.
+ *
+ * @warning 	This will removes all merged links from source ranges.
+ * @Complexity  O(n), no allocation
+ *
+ * @params 		_dest				= Link to insert before
+ * @params 		_firstBegin			= Link to sublist1 start
+ * @params 		_firstEnd			= Link to sublist1 end
+ * @params 		_secondBegin		= Link to sublist2 start
+ * @params 		_secondEnd			= Link to sublist2 end
+ * @params 		_less				= Less compare function
+ *
+ * @retval		NULL				= On initalize error OR when both sub lists are empty
+ * @retval		newBegin			= The first merged link
+ */
+ILink* IList_Merge(ILink* _dest, ILink* _firstBegin, ILink* _firstEnd,
+			ILink* _secondBegin, ILink* _secondEnd, ILinkLessFunction _less)
+{
+    IList first;
+    IList second;
+    ILink* before;
+    ILink* link;
+
+    CHECK_NULL(_dest);
+    CHECK_NULL(_firstBegin);
+    CHECK_NULL(_firstEnd);
+    CHECK_NULL(_secondBegin);
+    CHECK_NULL(_secondEnd);
+
+    if( _firstBegin == _firstEnd && _secondBegin == _secondEnd )
+    {
+        return NULL;
+    }
+
+    /* Detach both ranges first, so _dest may be the end of any of them */
+    IListInit(&first);
+    IListInit(&second);
+    IList_Splice(&first.m_head, _firstBegin, _firstEnd);
+    IList_Splice(&second.m_head, _secondBegin, _secondEnd);
+    before = _dest->m_prev;
+
+    if( NULL != _less )
+    {
+        while( !IListIsEmpty(&first) && !IListIsEmpty(&second) )
+        {
+            link = _less(second.m_head.m_next, first.m_head.m_next) ?
+                    IListPopHead(&second) : IListPopHead(&first);
+            IListInsertBefore(_dest, link);
+        }
+    }
+
+    IList_Splice(_dest, first.m_head.m_next, &first.m_head);
+    IList_Splice(_dest, second.m_head.m_next, &second.m_head);
+
+    return before->m_next;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Connect a link between previous and next links
+ *
+ * @params  _current        =   The link to connect
+ * @params  _previous       =   The link that need to be before the current link
+ * @params  _next			=   The link that need to be after the current link
+ *
+ * @returns void
+ */
+static void PushConnect(ILink* _current, ILink* _previous, ILink* _next)
+{
+    _current->m_prev = _previous;
+    _current->m_next = _next;
+
+    _previous->m_next = _current;
+    _next->m_prev = _current;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Bottom up merge sort of NULL terminated chain, using m_next only
+ *
+ * @params  _first          =   The first link of the chain
+ * @params  _less			=   Less compare function
+ *
+ * @returns The first link of the sorted chain
+ */
+static ILink* SortChain(ILink* _first, ILinkLessFunction _less)
+{
+    ILink* left;
+    ILink* right;
+    ILink* tail;
+    ILink* element;
+    size_t runSize = 1;
+    size_t leftSize;
+    size_t rightSize;
+    size_t nMerges;
+
+    do
+    {
+        left = _first;
+        _first = NULL;
+        tail = NULL;
+        nMerges = 0;
+
+        while( NULL != left )
+        {
+            ++nMerges;
+            right = left;
+            for(leftSize = 0; leftSize < runSize && NULL != right; ++leftSize)
+            {
+                right = right->m_next;
+            }
+            rightSize = runSize;
+
+            /* Merge 2 runs, take from the left run unless right is less (stable) */
+            while( 0 < leftSize || (0 < rightSize && NULL != right) )
+            {
+                if( 0 == leftSize )
+                {
+                    element = right;
+                    right = right->m_next;
+                    --rightSize;
+                }
+                else if( 0 == rightSize || NULL == right || !_less(right, left) )
+                {
+                    element = left;
+                    left = left->m_next;
+                    --leftSize;
+                }
+                else
+                {
+                    element = right;
+                    right = right->m_next;
+                    --rightSize;
+                }
+
+                if( NULL == tail )
+                {
+                    _first = element;
+                }
+                else
+                {
+                    tail->m_next = element;
+                }
+                tail = element;
+            }
+
+            left = right;
+        }
+
+        tail->m_next = NULL;
+        runSize *= 2;
+    }
+    while( 1 < nMerges );
+
+    return _first;
+}
+/*----------------------------------------------------------------------------*/
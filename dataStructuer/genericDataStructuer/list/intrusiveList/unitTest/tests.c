@@ -0,0 +1,386 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Intrusive Double Linked List data structure
+ *
+ *  @details 	The user embed an ILink member inside his own record and the list
+ *				chain the records through it, so insert and remove never allocate.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-28
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "intrusiveList.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h> 			/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+
+#define SIZE (20) 			/* SIZE = Num of records in each test */
+#define MAX_RAND_VALUE (10) /* MAX_RAND_VALUE = Small range to get equal keys */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Record
+{
+	int m_key;
+	int m_order;	/* Insert order, to check stability */
+	ILink m_byKey;
+	ILink m_byAge;
+} Record;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Initialize records and push all of them to the tail of both lists
+ *
+ * @param   records		= Array of records
+ * @param   nRecords	= The number of records
+ * @param   byKey		= List chained by m_byKey
+ * @param   byAge		= List chained by m_byAge
+ * @param   random		= If none zero keys are random, otherwise the key is the index
+*/
+static void FillRecords(Record* _records, size_t _nRecords, IList* _byKey, IList* _byAge, int _random);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function by key of records on the m_byKey list
+*/
+static int KeyLess(const ILink* _a, const ILink* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check the list is sorted by key and stable by insert order
+ *
+ * @return	1 if sorted, 0 otherwise
+*/
+static int IsSortedStable(IList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that count the links, context is size_t counter
+*/
+static int CountAction(ILink* _link, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------- Push and Pop -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(IList_CheckEmpty)
+    IList list;
+    ILink link;
+
+    IListInit(&list);
+    ILinkInit(&link);
+
+    ASSERT_THAT( IListIsEmpty(&list) && 0 == IListSize(&list) && !ILinkIsLinked(&link) );
+    ASSERT_THAT( NULL == IListPopHead(&list) && NULL == IListPopTail(&list) );
+    ASSERT_THAT( IListBegin(&list) == IListEnd(&list) );
+    ASSERT_THAT( IListIsEmpty(NULL) && 0 == IListSize(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_CheckPushPopOrder)
+    IList list;
+    Record rec[3];
+    size_t i;
+
+    IListInit(&list);
+    for(i = 0; i < 3; ++i)
+    {
+    	rec[i].m_key = (int)i;
+    }
+    IListPushTail(&list, &rec[1].m_byKey);
+    IListPushHead(&list, &rec[0].m_byKey);
+    IListPushTail(&list, &rec[2].m_byKey);
+
+    ASSERT_THAT( 3 == IListSize(&list) );
+    ASSERT_THAT( &rec[0] == ILIST_ENTRY(IListPopHead(&list), Record, m_byKey) );
+    ASSERT_THAT( &rec[2] == ILIST_ENTRY(IListPopTail(&list), Record, m_byKey) );
+    ASSERT_THAT( &rec[1] == ILIST_ENTRY(IListPopTail(&list), Record, m_byKey) );
+    ASSERT_THAT( IListIsEmpty(&list) && !ILinkIsLinked(&rec[1].m_byKey) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_CheckRecordOnTwoLists)
+    IList byKey;
+    IList byAge;
+    Record rec[SIZE];
+
+    FillRecords(rec, SIZE, &byKey, &byAge, 0);
+    IListRemove(&rec[5].m_byKey);
+
+    ASSERT_THAT( SIZE - 1 == IListSize(&byKey) && SIZE == IListSize(&byAge) );
+    ASSERT_THAT( !ILinkIsLinked(&rec[5].m_byKey) && ILinkIsLinked(&rec[5].m_byAge) );
+
+    IListRemove(&rec[5].m_byKey);
+    ASSERT_THAT( SIZE - 1 == IListSize(&byKey) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_CheckInsertBefore)
+    IList list;
+    Record rec[SIZE];
+    Record extra;
+    IList dummy;
+
+    FillRecords(rec, SIZE, &list, &dummy, 0);
+    IListInsertBefore(&rec[3].m_byKey, &extra.m_byKey);
+
+    ASSERT_THAT( IListNext(&rec[2].m_byKey) == &extra.m_byKey );
+    ASSERT_THAT( IListPrev(&rec[3].m_byKey) == &extra.m_byKey );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*--------------------------------- ForEach ----------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(IList_ForEach_CheckAll)
+    IList list;
+    IList dummy;
+    Record rec[SIZE];
+    size_t counter = 0;
+    ILink* result;
+
+    FillRecords(rec, SIZE, &list, &dummy, 0);
+    result = IList_ForEach(IListBegin(&list), IListEnd(&list), CountAction, &counter);
+
+    ASSERT_THAT( SIZE == counter && IListEnd(&list) == result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------------- Sort ------------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(IList_Sort_CheckRandom)
+    IList list;
+    IList dummy;
+    Record rec[SIZE];
+
+    FillRecords(rec, SIZE, &list, &dummy, 1);
+    IList_Sort(&list, KeyLess);
+
+    ASSERT_THAT( SIZE == IListSize(&list) && IsSortedStable(&list) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_Sort_CheckOneElement)
+    IList list;
+    Record rec;
+
+    IListInit(&list);
+    rec.m_key = 1;
+    rec.m_order = 0;
+    IListPushHead(&list, &rec.m_byKey);
+    IList_Sort(&list, KeyLess);
+
+    ASSERT_THAT( IListBegin(&list) == &rec.m_byKey && IListPrev(IListEnd(&list)) == &rec.m_byKey );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*--------------------------------- Splice -----------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(IList_Splice_CheckNull)
+    IList list;
+
+    IListInit(&list);
+    ASSERT_THAT( NULL == IList_Splice(NULL, IListBegin(&list), IListEnd(&list)) );
+    ASSERT_THAT( NULL == IList_Splice(IListEnd(&list), IListBegin(&list), IListEnd(&list)) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_Splice_CheckMoveRange)
+    IList src;
+    IList dest;
+    IList dummy;
+    Record rec[SIZE];
+    ILink* result;
+
+    FillRecords(rec, SIZE, &src, &dummy, 0);
+    IListInit(&dest);
+    result = IList_Splice(IListEnd(&dest), &rec[5].m_byKey, &rec[15].m_byKey);
+
+    ASSERT_THAT( &rec[5].m_byKey == result );
+    ASSERT_THAT( 10 == IListSize(&dest) && SIZE - 10 == IListSize(&src) );
+    ASSERT_THAT( IListNext(&rec[4].m_byKey) == &rec[15].m_byKey );
+    ASSERT_THAT( IListPrev(IListEnd(&dest)) == &rec[14].m_byKey );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------------- Merge -----------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(IList_Merge_CheckSorted)
+    IList first;
+    IList second;
+    IList dest;
+    IList dummy;
+    Record rec1[SIZE];
+    Record rec2[SIZE];
+    ILink* result;
+    size_t i;
+
+    FillRecords(rec1, SIZE, &first, &dummy, 1);
+    FillRecords(rec2, SIZE, &second, &dummy, 1);
+    for(i = 0; i < SIZE; ++i)
+    {
+    	rec2[i].m_order += SIZE;
+    }
+    IList_Sort(&first, KeyLess);
+    IList_Sort(&second, KeyLess);
+    IListInit(&dest);
+
+    result = IList_Merge(IListEnd(&dest), IListBegin(&first), IListEnd(&first),
+    			IListBegin(&second), IListEnd(&second), KeyLess);
+
+    ASSERT_THAT( IListBegin(&dest) == result );
+    ASSERT_THAT( 2 * SIZE == IListSize(&dest) && IListIsEmpty(&first) && IListIsEmpty(&second) );
+    ASSERT_THAT( IsSortedStable(&dest) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(IList_Merge_CheckNoLess)
+    IList first;
+    IList second;
+    IList dest;
+    IList dummy;
+    Record rec1[SIZE];
+    Record rec2[SIZE];
+
+    FillRecords(rec1, SIZE, &first, &dummy, 0);
+    FillRecords(rec2, SIZE, &second, &dummy, 0);
+    IListInit(&dest);
+
+    IList_Merge(IListEnd(&dest), IListBegin(&first), IListEnd(&first),
+    			IListBegin(&second), IListEnd(&second), NULL);
+
+    ASSERT_THAT( IListBegin(&dest) == &rec1[0].m_byKey );
+    ASSERT_THAT( IListNext(&rec1[SIZE - 1].m_byKey) == &rec2[0].m_byKey );
+    ASSERT_THAT( IListPrev(IListEnd(&dest)) == &rec2[SIZE - 1].m_byKey );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Intrusive List Module)
+	PRINT(IList_CheckEmpty)
+	PRINT(IList_CheckPushPopOrder)
+	PRINT(IList_CheckRecordOnTwoLists)
+	PRINT(IList_CheckInsertBefore)
+
+	PRINT(IList_ForEach_CheckAll)
+
+	PRINT(IList_Sort_CheckRandom)
+	PRINT(IList_Sort_CheckOneElement)
+
+	PRINT(IList_Splice_CheckNull)
+	PRINT(IList_Splice_CheckMoveRange)
+
+	PRINT(IList_Merge_CheckSorted)
+	PRINT(IList_Merge_CheckNoLess)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void FillRecords(Record* _records, size_t _nRecords, IList* _byKey, IList* _byAge, int _random)
+{
+	size_t i;
+
+	srand((unsigned)time(NULL));
+	IListInit(_byKey);
+	IListInit(_byAge);
+	for(i = 0; i < _nRecords; ++i)
+	{
+		_records[i].m_key = _random ? rand() % MAX_RAND_VALUE : (int)i;
+		_records[i].m_order = (int)i;
+		IListPushTail(_byKey, &_records[i].m_byKey);
+		IListPushTail(_byAge, &_records[i].m_byAge);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int KeyLess(const ILink* _a, const ILink* _b)
+{
+	return ILIST_ENTRY(_a, Record, m_byKey)->m_key < ILIST_ENTRY(_b, Record, m_byKey)->m_key;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int IsSortedStable(IList* _list)
+{
+	ILink* link;
+	Record* prev;
+	Record* current;
+
+	for(link = IListNext(IListBegin(_list)); IListEnd(_list) != link; link = IListNext(link))
+	{
+		prev = ILIST_ENTRY(IListPrev(link), Record, m_byKey);
+		current = ILIST_ENTRY(link, Record, m_byKey);
+		if( prev->m_key > current->m_key ||
+			(prev->m_key == current->m_key && prev->m_order > current->m_order) )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CountAction(ILink* _link, void* _context)
+{
+	(void)_link;
+	++*(size_t*)_context;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
@@ -5,7 +5,8 @@
  *  @details 	The API stores pointer to user provided elements of generic type.
  * 				The List is heap allocated and can grow and shrink on demand.
  *				Implemented as double linked list using head and tail sentinels.
- *  			Nodes are allocated from heap an store pointer to user proveded element.
+ *  			Nodes are taken from a per list pool of contiguous node blocks with a
+ *  			free list, and store pointer to user proveded element.
  * 
  *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
  *
@@ -19,12 +20,15 @@
 
 #include "list.h" 
 #include "privateListStruct.h" /* for struct Node, struct List */
-#include <stdlib.h> 			/* for size_t, malloc */
+#include <stdlib.h> 			/* for size_t, malloc, free */
+
+#define NODES_IN_BLOCK (64)	/* Number of nodes the pool allocate in each new block */
 
 #define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
 #define CHECK_LIST_NULL(param)		do{ if(NULL == (param) ) { return LIST_UNINITIALIZED_ERROR;}  } while(0)
 #define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return LIST_NULL_ELEMENT_ERROR;}  } while(0)
 #define CHECK_ALLOCATION_ERROR(err)	do{ if(NULL == (err) ) { return LIST_ALLOCATION_ERROR;}  } while(0)
+#define BLOCK_NODES(block)			( (Node*)( (NodeBlock*)(block) + 1 ) )
 
 
 
@@ -57,13 +61,41 @@ static void PopConnectNode(Node* _current);
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief  Create new node and insert it's value
+ * @brief  Initialize an empty node pool
+ *
+ * @params  _pool           =   The pool to initialize
+ *
+ * @returns void
+ */
+static void PoolInit(NodePool* _pool);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief  Allocate new block of nodes and make it the pool's bump area
+ *
+ * @params  _pool           =   The pool to add the block to
+ * @params  _capacity       =   The number of nodes in the new block
+ *
+ * @returns Status ListResult:
+ *
+ * @retval  LIST_SUCCESS            =   On success
+ * @retval  LIST_ALLOCATION_ERROR   =   On memory allocation failure
+ */
+static ListResult PoolAddBlock(NodePool* _pool, size_t _capacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief  Free all the blocks of the pool
  *
- * @params  _item           =   An item to add to the list
+ * @params  _pool           =   The pool to release
  *
  * @returns void
  */
-static Node* CreateNewNode(void* _item);
+static void PoolDestroy(NodePool* _pool);
 /*----------------------------------------------------------------------------*/
 
 
@@ -100,6 +132,9 @@ List* ListCreate(void)
     ptr = (List*)malloc( sizeof(List) );  
     CHECK_NULL(ptr); 
     
+    PoolInit(&ptr->m_pool);
+    ptr->m_head.m_owner = ptr;
+    ptr->m_tail.m_owner = ptr;
     ptr->m_head.m_next = &(ptr->m_tail);
     ptr->m_head.m_prev = &(ptr->m_head);
     ptr->m_tail.m_prev = &(ptr->m_head);
@@ -132,18 +167,17 @@ void ListDestroy(List** _pList, void (*_elementDestroy)(void* _item))
     }
     
     nodeAddress = (*_pList)->m_head.m_next;
-            
-    while( &(*_pList)->m_tail != nodeAddress->m_next)
+    
+    if( NULL != _elementDestroy )
     {
-        if( NULL != (*_elementDestroy) )
+        while( &(*_pList)->m_tail != nodeAddress)
         {
             (*_elementDestroy)(nodeAddress->m_data);
+            nodeAddress = nodeAddress->m_next;
         }
-        
-        nodeAddress = nodeAddress->m_next;
-        free(nodeAddress->m_prev);
     }
     
+    PoolDestroy(&(*_pList)->m_pool);
     free(*_pList);
     *_pList = NULL;
     
@@ -174,7 +208,7 @@ ListResult ListPushHead(List* _list, void* _item)
     CHECK_LIST_NULL( _list);
     CHECK_ELEMENT_NULL(_item);
     
-    newNode = CreateNewNode(_item);
+    newNode = ListNodeAlloc(_list, _item);
     CHECK_ALLOCATION_ERROR(newNode);
     
     ConnectPushNode(newNode, &_list->m_head, _list->m_head.m_next);
@@ -206,7 +240,7 @@ ListResult ListPushTail(List* _list, void* _item)
     CHECK_LIST_NULL( _list);
     CHECK_ELEMENT_NULL(_item);
     
-    newNode = CreateNewNode(_item);
+    newNode = ListNodeAlloc(_list, _item);
     CHECK_ALLOCATION_ERROR(newNode);
     
     ConnectPushNode(newNode, _list->m_tail.m_prev, &_list->m_tail);
@@ -238,7 +272,6 @@ ListResult ListPopHead(List* _list, void** _pItem)
                               
     CHECK_LIST_NULL( _list);
     CHECK_ELEMENT_NULL(_pItem);
-    CHECK_ELEMENT_NULL(*_pItem);
     
     if( &(_list->m_tail) == _list->m_head.m_next)
     {
@@ -247,8 +280,8 @@ ListResult ListPopHead(List* _list, void** _pItem)
     
     tempNode = _list->m_head.m_next;
     
+    PopConnectNode(tempNode);
     Pop(tempNode, _pItem);
-    PopConnectNode(_list->m_head.m_next);
 
     return LIST_SUCCESS;
 }
@@ -277,7 +310,6 @@ ListResult ListPopTail(List* _list, void** _pItem)
     
     CHECK_LIST_NULL( _list);
     CHECK_ELEMENT_NULL(_pItem);
-    CHECK_ELEMENT_NULL(*_pItem);
     
     if( &(_list->m_tail) == _list->m_head.m_next)
     {
@@ -286,8 +318,8 @@ ListResult ListPopTail(List* _list, void** _pItem)
     
     tempNode = _list->m_tail.m_prev;
     
+    PopConnectNode(tempNode);
     Pop(tempNode, _pItem);
-    PopConnectNode(_list->m_tail.m_prev);
     
     return LIST_SUCCESS;
 }
@@ -330,6 +362,125 @@ size_t ListSize(const List* _list)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Rewrite the list's nodes in traversal order inside fresh node blocks
+ * @details After a lot of push/pop/insert/remove the nodes are scattered in the
+ *			pool, compaction make sequential iteration a sequential memory access
+ *			and release the memory of all the old blocks.
+ *  		Time complexity O(n).
+ *
+ * @params  list                       	=   A previously created List ADT returned via ListCreate
+ *
+ * @return	Status ListResult that indicate in which state the function ended:
+ *
+ * @retval  LIST_SUCCESS                =   On success
+ * @retval  LIST_UNINITIALIZED_ERROR    =   If the list ptr is uninitialized
+ * @retval  LIST_ALLOCATION_ERROR       =   On memory allocation failure, the list is unchanged
+ *
+ * @warning All the iterators of the list are invalid after successful compaction.
+ */
+ListResult ListCompact(List* _list)
+{
+    NodePool newPool;
+    Node* oldNode;
+    Node* newNode;
+    Node* previous;
+    size_t nNodes;
+    
+    CHECK_LIST_NULL(_list);
+    
+    PoolInit(&newPool);
+    nNodes = ListSize(_list);
+    if( 0 < nNodes && LIST_SUCCESS != PoolAddBlock(&newPool, nNodes) )
+    {
+        return LIST_ALLOCATION_ERROR;
+    }
+    
+    previous = &_list->m_head;
+    for(oldNode = _list->m_head.m_next; &_list->m_tail != oldNode; oldNode = oldNode->m_next)
+    {
+        newNode = newPool.m_bumpNext++;
+        newNode->m_data = oldNode->m_data;
+        newNode->m_owner = _list;
+        newNode->m_prev = previous;
+        previous->m_next = newNode;
+        previous = newNode;
+    }
+    previous->m_next = &_list->m_tail;
+    _list->m_tail.m_prev = previous;
+    
+    PoolDestroy(&_list->m_pool);
+    _list->m_pool = newPool;
+    
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node from the list's pool and insert it's value
+ * @details Time complexity: O(1) amortized.
+ *
+ * @params  _list           =   The list that the node will belong to
+ * @params  _item           =   An item to store in the node
+ *
+ * @returns Node pointer:
+ *
+ * @retval  Node*           =   On success
+ * @retval  NULL            =   On memory allocation failure
+ */
+Node* ListNodeAlloc(List* _list, void* _item)
+{
+    NodePool* pool = &_list->m_pool;
+    Node* newNode;
+    
+    if( NULL != pool->m_freeList )
+    {
+        newNode = pool->m_freeList;
+        pool->m_freeList = newNode->m_next;
+    }
+    else
+    {
+        if( pool->m_bumpNext == pool->m_bumpEnd && 
+            LIST_SUCCESS != PoolAddBlock(pool, NODES_IN_BLOCK) )
+        {
+            return NULL;
+        }
+        newNode = pool->m_bumpNext++;
+    }
+    
+    newNode->m_data = _item;
+    newNode->m_owner = _list;
+    
+    return newNode;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Return an unlinked node to the free list of it's owner pool
+ * @details Time complexity: O(1).
+ *
+ * @params  _node           =   The node to release
+ *
+ * @returns void
+ */
+void ListNodeFree(Node* _node)
+{
+    NodePool* pool = &_node->m_owner->m_pool;
+    
+    _node->m_data = NULL;
+    _node->m_next = pool->m_freeList;
+    pool->m_freeList = _node;
+    
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -380,22 +531,77 @@ static void PopConnectNode(Node* _current)
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief  Create new node and insert it's value
+ * @brief  Initialize an empty node pool
  *
- * @params  _item           =   An item to add to the list
+ * @params  _pool           =   The pool to initialize
  *
  * @returns void
  */
-static Node* CreateNewNode(void* _item)
+static void PoolInit(NodePool* _pool)
 {
-    Node* newNode;
+    _pool->m_blocks = NULL;
+    _pool->m_freeList = NULL;
+    _pool->m_bumpNext = NULL;
+    _pool->m_bumpEnd = NULL;
+    
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief  Allocate new block of nodes and make it the pool's bump area
+ *
+ * @params  _pool           =   The pool to add the block to
+ * @params  _capacity       =   The number of nodes in the new block
+ *
+ * @returns Status ListResult:
+ *
+ * @retval  LIST_SUCCESS            =   On success
+ * @retval  LIST_ALLOCATION_ERROR   =   On memory allocation failure
+ */
+static ListResult PoolAddBlock(NodePool* _pool, size_t _capacity)
+{
+    NodeBlock* newBlock;
     
-    newNode = (Node*)malloc( sizeof(Node) );
-    CHECK_NULL(newNode);
+    newBlock = (NodeBlock*)malloc( sizeof(NodeBlock) + _capacity * sizeof(Node) );
+    CHECK_ALLOCATION_ERROR(newBlock);
     
-    newNode->m_data = _item;
+    newBlock->m_capacity = _capacity;
+    newBlock->m_next = _pool->m_blocks;
+    _pool->m_blocks = newBlock;
+
+    _pool->m_bumpNext = BLOCK_NODES(newBlock);
+    _pool->m_bumpEnd = BLOCK_NODES(newBlock) + _capacity;
     
-    return newNode;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief  Free all the blocks of the pool
+ *
+ * @params  _pool           =   The pool to release
+ *
+ * @returns void
+ */
+static void PoolDestroy(NodePool* _pool)
+{
+    NodeBlock* block;
+    
+    while( NULL != _pool->m_blocks )
+    {
+        block = _pool->m_blocks;
+        _pool->m_blocks = block->m_next;
+        free(block);
+    }
+    
+    PoolInit(_pool);
+    
+    return;
 }
 /*----------------------------------------------------------------------------*/
 
@@ -412,7 +618,7 @@ static Node* CreateNewNode(void* _item)
 static void Pop(Node* _curNode, void** _pItem)
 {
     *_pItem = _curNode->m_data;
-    free(_curNode);
+    ListNodeFree(_curNode);
     
     return;
 }
@@ -1,9 +1,13 @@
 #ifndef __STRUCT_H__
 #define __STRUCT_H__
 
+#include <stddef.h> /* for size_t */
+
 /****************************** Define Declaration ****************************/
 /*----------------------------------------------------------------------------*/
 typedef struct Node Node;
+typedef struct NodeBlock NodeBlock;
+typedef struct NodePool NodePool;
 /*----------------------------------------------------------------------------*/
 
 
@@ -13,6 +17,28 @@ struct Node
     void* m_data;
     Node* m_next;
     Node* m_prev;
+    List* m_owner;	/* The list that the node pool belong to */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Contiguous chunk of nodes, the nodes array is allocated right after the header */
+struct NodeBlock
+{
+    NodeBlock* m_next;
+    size_t m_capacity;
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct NodePool
+{
+    NodeBlock* m_blocks;	/* All the blocks allocated by the pool */
+    Node* m_freeList;		/* Released nodes, chained by m_next */
+    Node* m_bumpNext;		/* Next never used node in the newest block */
+    Node* m_bumpEnd;		/* One past the last node of the newest block */
 };
 /*----------------------------------------------------------------------------*/
 
@@ -22,7 +48,42 @@ struct List
 {
     Node m_head;
     Node m_tail;
+    NodePool m_pool;
 };
 /*----------------------------------------------------------------------------*/
 
+
+
+
+
+/************************** Private functions for List ************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node from the list's pool and insert it's value
+ * @details Time complexity: O(1) amortized.
+ *
+ * @params  _list           =   The list that the node will belong to
+ * @params  _item           =   An item to store in the node
+ *
+ * @returns Node pointer:
+ *
+ * @retval  Node*           =   On success
+ * @retval  NULL            =   On memory allocation failure
+ */
+Node* ListNodeAlloc(List* _list, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Return an unlinked node to the free list of it's owner pool
+ * @details Time complexity: O(1).
+ *
+ * @params  _node           =   The node to release
+ *
+ * @returns void
+ */
+void ListNodeFree(Node* _node);
+/*----------------------------------------------------------------------------*/
+
 #endif /* __STRUCT_H__ */
@@ -366,6 +366,86 @@ END_TEST
 
 
 
+/*-------------------------------- ListCompact -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(ListCompact_CheckNull) 
+    ASSERT_THAT( LIST_UNINITIALIZED_ERROR == ListCompact(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(ListCompact_CheckEmptyList) 
+    ListResult result[2];
+    List* ip;
+    int item = 2;
+    int* retVal;
+    
+    ip = ListCreate();
+    result[0] = ListCompact(ip);
+    result[1] = ListPushTail(ip, (void*)&item);
+    ListPopHead(ip, (void**)&retVal);
+    
+    ListDestroy(&ip, NULL);
+    ASSERT_THAT( LIST_SUCCESS == result[0] && LIST_SUCCESS == result[1] && *retVal == item );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(ListCompact_CheckOrderKept) 
+    ListResult result;
+    List* ip;
+    int item[SIZE];
+    int* retVal[SIZE];
+    int* trash;
+    size_t i;
+	
+	ip = ListCreate();
+	InsertSortedValues(ip, item ,SIZE, 1, 0);
+	ListPopHead(ip, (void**)&trash);
+	ListPopTail(ip, (void**)&trash);
+	ListPushTail(ip, (void*)&item[0]);
+	
+	result = ListCompact(ip);
+	for(i = 0; i < SIZE - 1; ++i)
+	{
+		ListPopHead(ip, (void**)&retVal[i]);
+	}
+    
+    ListDestroy(&ip, NULL);
+    ASSERT_THAT( LIST_SUCCESS == result );
+    for(i = 0; i < SIZE - 2; ++i)
+	{
+    	ASSERT_THAT( *retVal[i] == item[SIZE - i - 2] );
+    }
+    ASSERT_THAT( *retVal[SIZE - 2] == item[0] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(ListCompact_CheckPushAfterCompact) 
+    List* ip;
+    int item[SIZE];
+    int extra = 100;
+    int* retVal;
+	
+	ip = ListCreate();
+	InsertSortedValues(ip, item ,SIZE, 1, 0);
+	ListCompact(ip);
+	ListPushTail(ip, (void*)&extra);
+	ListPopTail(ip, (void**)&retVal);
+    
+    ASSERT_THAT( SIZE == ListSize(ip) && *retVal == extra );
+    ListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
 /********************************* Tests SET ********************************/
 /*----------------------------------------------------------------------------*/
 TEST_SET(Test Generic List Module)
@@ -389,6 +469,11 @@ TEST_SET(Test Generic List Module)
 	
 	PRINT(ListSize_CheckNull)
 	PRINT(ListSize_CheckCorrectReturn) 
+	
+	PRINT(ListCompact_CheckNull)
+	PRINT(ListCompact_CheckEmptyList)
+	PRINT(ListCompact_CheckOrderKept)
+	PRINT(ListCompact_CheckPushAfterCompact)
 END_SET
 /*----------------------------------------------------------------------------*/
 
@@ -19,7 +19,7 @@
 
 #include "listItr.h" 			/* header file */ 
 #include "privateListStruct.h" 	/* for struct Node, struct List */
-#include <stdlib.h> 			/* for NULL, malloc, free */
+#include <stdlib.h> 			/* for NULL */
 
 #define AS_NODE(parameter)		( (Node*)(parameter) )
 #define CHECK_NULL(param)		do{ if(NULL == (param) ) { return NULL;}  } while(0)
@@ -40,19 +40,6 @@ static void PushConnect(Node* _current, Node* _previous, Node* _next);
 /*----------------------------------------------------------------------------*/
 
 
-/*----------------------------------------------------------------------------*/
-/** 
- * @brief  Create new ListItr and insert it's value
- *
- * @params  list       =   A pointer to previously created List returned via ListCreate
- * @params  item       =   An item to add to the list
- *
- * @returns void
- */
-static ListItr* CreateNewListItr(void* _item);
-/*----------------------------------------------------------------------------*/
-
-
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief  Find and connect 2 ListItr that came before and after the currentListItr to each outer
@@ -254,17 +241,17 @@ void* ListItrSet(ListItr _itr, void* _element)
  */
 ListItr ListItrInsertBefore(ListItr _itr, void* _element)
 {
-    ListItr* newListItr;
+    Node* newListItr;
     
     CHECK_NULL(_itr);
     CHECK_NULL(_element);
     
-    newListItr = CreateNewListItr(_element);
-    CHECK_NULL(_itr);
+    newListItr = ListNodeAlloc(AS_NODE(_itr)->m_owner, _element);
+    CHECK_NULL(newListItr);
     
-    PushConnect((Node*)newListItr, AS_NODE(_itr)->m_prev, (Node*)_itr);
+    PushConnect(newListItr, AS_NODE(_itr)->m_prev, AS_NODE(_itr));
     
-    return newListItr;
+    return (ListItr)newListItr;
 }
 /*----------------------------------------------------------------------------*/
 
@@ -293,7 +280,7 @@ void* ListItrRemove(ListItr _itr)
     
     tempData = AS_NODE(_itr)->m_data;
     PopConnect(_itr);
-    free(_itr);
+    ListNodeFree(_itr);
     
     return tempData;
     
@@ -326,28 +313,6 @@ static void PushConnect(Node* _current, Node* _previous, Node* _next)
 /*----------------------------------------------------------------------------*/
 
 
-/*----------------------------------------------------------------------------*/
-/** 
- * @brief  Create new ListItr and insert it's value
- *
- * @params  list       =   A pointer to previously created List returned via ListCreate
- * @params  item       =   An item to add to the list
- *
- * @returns void
- */
-static ListItr* CreateNewListItr(void* _item)
-{
-    Node* new;
-    
-    new = (Node*)malloc(  sizeof(Node) );
-    CHECK_NULL(new);
-    
-    new->m_data = _item;
-    return (ListItr*)new;
-}
-/*----------------------------------------------------------------------------*/
-
-
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief  Find and connect 2 ListItr that came before and after the currentListItr to each outer
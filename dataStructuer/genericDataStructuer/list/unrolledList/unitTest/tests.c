@@ -0,0 +1,364 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic Unrolled Double Linked List data structure
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ *				Each node of the list keep a small array of elements.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-27
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "unrolledList.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h> 			/* for printf */
+#include <stdlib.h> 		/* for size_t */
+
+#define SIZE (100) 		/* SIZE = Num of element in each test, more then one node */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that insert to the list values in sort order to the tail
+ *
+ * @param   list       	= The address of the the source list
+ * @param   array		= Pointer to the elements neeeded to insert to list
+ * @param   nElements  	= The number of elements to insert
+ *
+ * @return	Status UnrolledListResult of the last push
+*/
+static UnrolledListResult InsertSortedValues(UnrolledList* _list, int* _array ,size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*---------------------------- UnrolledListPush ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPush_CheckNull)
+    int item = 2;
+
+    ASSERT_THAT( UNROLLED_LIST_UNINITIALIZED_ERROR == UnrolledListPushHead(NULL, &item) );
+    ASSERT_THAT( UNROLLED_LIST_UNINITIALIZED_ERROR == UnrolledListPushTail(NULL, &item) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPush_CheckItemNull)
+    UnrolledListResult result[2];
+    UnrolledList* ip;
+
+	ip = UnrolledListCreate();
+    result[0] = UnrolledListPushHead(ip, NULL);
+    result[1] = UnrolledListPushTail(ip, NULL);
+
+    UnrolledListDestroy(&ip, NULL);
+    ASSERT_THAT( UNROLLED_LIST_NULL_ELEMENT_ERROR == result[0] );
+    ASSERT_THAT( UNROLLED_LIST_NULL_ELEMENT_ERROR == result[1] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPushHead_CheckOrder)
+    UnrolledList* ip;
+    int item[SIZE];
+    int* retVal;
+    size_t i;
+
+	ip = UnrolledListCreate();
+	for(i = 0; i < SIZE; ++i)
+	{
+		item[i] = (int)i;
+		UnrolledListPushHead(ip, &item[i]);
+	}
+
+	for(i = 0; i < SIZE; ++i)
+	{
+		UnrolledListPopHead(ip, (void**)&retVal);
+		ASSERT_THAT( *retVal == item[SIZE - i - 1] );
+	}
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- UnrolledListPop -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPop_CheckEmpty)
+    UnrolledListResult result[2];
+    UnrolledList* ip;
+    int* retVal;
+
+	ip = UnrolledListCreate();
+    result[0] = UnrolledListPopHead(ip, (void**)&retVal);
+    result[1] = UnrolledListPopTail(ip, (void**)&retVal);
+
+    UnrolledListDestroy(&ip, NULL);
+    ASSERT_THAT( UNROLLED_LIST_EMPTY_ERROR == result[0] && UNROLLED_LIST_EMPTY_ERROR == result[1] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPop_CheckFifo)
+    UnrolledList* ip;
+    int item[SIZE];
+    int* retVal;
+    size_t i;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+	for(i = 0; i < SIZE; ++i)
+	{
+		ASSERT_THAT( UNROLLED_LIST_SUCCESS == UnrolledListPopHead(ip, (void**)&retVal) );
+		ASSERT_THAT( *retVal == item[i] );
+	}
+
+    ASSERT_THAT( 0 == UnrolledListSize(ip) );
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPop_CheckLifo)
+    UnrolledList* ip;
+    int item[SIZE];
+    int* retVal;
+    size_t i;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+	for(i = 0; i < SIZE; ++i)
+	{
+		ASSERT_THAT( UNROLLED_LIST_SUCCESS == UnrolledListPopTail(ip, (void**)&retVal) );
+		ASSERT_THAT( *retVal == item[SIZE - i - 1] );
+	}
+
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListPop_CheckRefillAfterEmpty)
+    UnrolledList* ip;
+    int item[SIZE];
+    int* retVal;
+    size_t i;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+	for(i = 0; i < SIZE; ++i)
+	{
+		UnrolledListPopHead(ip, (void**)&retVal);
+	}
+	InsertSortedValues(ip, item, SIZE);
+	UnrolledListPopTail(ip, (void**)&retVal);
+
+    ASSERT_THAT( SIZE - 1 == UnrolledListSize(ip) && *retVal == item[SIZE - 1] );
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- UnrolledListSize ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListSize_CheckNull)
+    ASSERT_THAT( 0 == UnrolledListSize(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListSize_CheckCorrectReturn)
+    UnrolledList* ip;
+    int item[SIZE];
+    size_t result;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+	UnrolledListPushHead(ip, &item[0]);
+	result = UnrolledListSize(ip);
+
+    UnrolledListDestroy(&ip, NULL);
+    ASSERT_THAT( SIZE + 1 == result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- UnrolledListItr -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListItr_CheckEmptyBeginIsEnd)
+    UnrolledList* ip;
+    int result;
+
+	ip = UnrolledListCreate();
+	result = UnrolledListItrEquals(UnrolledListItrBegin(ip), UnrolledListItrEnd(ip));
+
+    UnrolledListDestroy(&ip, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListItr_CheckForwardIteration)
+    UnrolledList* ip;
+    UnrolledListItr itr;
+    int item[SIZE];
+    int extra = -1;
+    size_t i = 0;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+	UnrolledListPushHead(ip, &extra);
+
+	itr = UnrolledListItrBegin(ip);
+	ASSERT_THAT( *(int*)UnrolledListItrGet(itr) == extra );
+	for(itr = UnrolledListItrNext(itr); !UnrolledListItrEquals(itr, UnrolledListItrEnd(ip)); itr = UnrolledListItrNext(itr))
+	{
+		ASSERT_THAT( *(int*)UnrolledListItrGet(itr) == item[i] );
+		++i;
+	}
+
+    ASSERT_THAT( SIZE == i && NULL == UnrolledListItrGet(itr) );
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListItr_CheckBackwardIteration)
+    UnrolledList* ip;
+    UnrolledListItr itr;
+    UnrolledListItr begin;
+    int item[SIZE];
+    size_t i = SIZE;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+
+	begin = UnrolledListItrBegin(ip);
+	itr = UnrolledListItrEnd(ip);
+	while( !UnrolledListItrEquals(itr, begin) )
+	{
+		itr = UnrolledListItrPrev(itr);
+		--i;
+		ASSERT_THAT( *(int*)UnrolledListItrGet(itr) == item[i] );
+	}
+
+    ASSERT_THAT( 0 == i && UnrolledListItrEquals(begin, UnrolledListItrPrev(begin)) );
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListItr_CheckNextOnEnd)
+    UnrolledList* ip;
+    UnrolledListItr end;
+    int result;
+
+	ip = UnrolledListCreate();
+	end = UnrolledListItrEnd(ip);
+	result = UnrolledListItrEquals(end, UnrolledListItrNext(end));
+
+    UnrolledListDestroy(&ip, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(UnrolledListItr_CheckSet)
+    UnrolledList* ip;
+    UnrolledListItr itr;
+    int item[SIZE];
+    int newValue = 1000;
+    int* oldValue;
+
+	ip = UnrolledListCreate();
+	InsertSortedValues(ip, item, SIZE);
+
+	itr = UnrolledListItrPrev(UnrolledListItrEnd(ip));
+	oldValue = (int*)UnrolledListItrSet(itr, &newValue);
+
+    ASSERT_THAT( oldValue == &item[SIZE - 1] && &newValue == UnrolledListItrGet(itr) );
+    ASSERT_THAT( NULL == UnrolledListItrSet(UnrolledListItrEnd(ip), &newValue) );
+    UnrolledListDestroy(&ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Unrolled List Module)
+	PRINT(UnrolledListPush_CheckNull)
+	PRINT(UnrolledListPush_CheckItemNull)
+	PRINT(UnrolledListPushHead_CheckOrder)
+
+	PRINT(UnrolledListPop_CheckEmpty)
+	PRINT(UnrolledListPop_CheckFifo)
+	PRINT(UnrolledListPop_CheckLifo)
+	PRINT(UnrolledListPop_CheckRefillAfterEmpty)
+
+	PRINT(UnrolledListSize_CheckNull)
+	PRINT(UnrolledListSize_CheckCorrectReturn)
+
+	PRINT(UnrolledListItr_CheckEmptyBeginIsEnd)
+	PRINT(UnrolledListItr_CheckForwardIteration)
+	PRINT(UnrolledListItr_CheckBackwardIteration)
+	PRINT(UnrolledListItr_CheckNextOnEnd)
+	PRINT(UnrolledListItr_CheckSet)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that insert to the list values in sort order to the tail
+ *
+ * @param   list       	= The address of the the source list
+ * @param   array		= Pointer to the elements neeeded to insert to list
+ * @param   nElements  	= The number of elements to insert
+ *
+ * @return	Status UnrolledListResult of the last push
+*/
+static UnrolledListResult InsertSortedValues(UnrolledList* _list, int* _array ,size_t _nElements)
+{
+    UnrolledListResult status = UNROLLED_LIST_SUCCESS;
+    size_t i;
+
+    for( i = 0;  i < _nElements; ++i )
+    {
+    	_array[i] = (int)i;
+        status = UnrolledListPushTail(_list, &_array[i]);
+        if(UNROLLED_LIST_SUCCESS != status)
+        {
+        	return status;
+        }
+    }
+
+    return status;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,619 @@
+/**
+ *  @file 		unrolledList.c
+ *  @brief 		src file for Generic Unrolled Double Linked List data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				The List is heap allocated and can grow and shrink on demand.
+ *				Implemented as double linked list of nodes, each node keep a small
+ *				array of elements, so the list spend about 1/3 of the memory
+ *				per element of the regular List and iteration is mostly contiguous.
+ *				Fit for long FIFO lists that mostly iterated.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2016-12-27
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "unrolledList.h"	/* header file */
+#include <stdlib.h> 		/* for size_t, malloc, free */
+
+#define ELEMENTS_IN_NODE (32)	/* Number of elements each node can hold */
+#define AS_NODE(parameter)			( (UNode*)(parameter) )
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_LIST_NULL(param)		do{ if(NULL == (param) ) { return UNROLLED_LIST_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return UNROLLED_LIST_NULL_ELEMENT_ERROR;}  } while(0)
+#define CHECK_ALLOCATION_ERROR(err)	do{ if(NULL == (err) ) { return UNROLLED_LIST_ALLOCATION_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct UNode UNode;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* The elements of the node are stored in m_items[m_begin, m_end) */
+struct UNode
+{
+    UNode* m_next;
+    UNode* m_prev;
+    size_t m_begin;
+    size_t m_end;
+    void* m_items[ELEMENTS_IN_NODE];
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct UnrolledList
+{
+    UNode* m_first;
+    UNode* m_last;
+    UNode* m_spare;		/* Last emptied node, kept to avoid malloc/free on node edge */
+    size_t m_size;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get an empty node from the spare OR from the heap
+ *
+ * @params  _list           =   The list that the node will belong to
+ * @params  _index          =   The index to set as begin and end of the empty node
+ *
+ * @returns Node pointer OR NULL on allocation failure
+ */
+static UNode* GetNode(UnrolledList* _list, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Unlink an empty node from the list and keep it as spare OR free it
+ *
+ * @params  _list           =   The list that the node belong to
+ * @params  _node           =   The empty node to release
+ *
+ * @returns void
+ */
+static void ReleaseNode(UnrolledList* _list, UNode* _node);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Create an unrolled list
+ *
+ * @return 	The UnrolledList pointer
+ *
+ * @retval 	On success    =   A pointer to the created list.
+ * @retval  NULL          =   On failure due to allocation failure
+ */
+UnrolledList* UnrolledListCreate(void)
+{
+    UnrolledList* ptr;
+
+    ptr = (UnrolledList*)malloc( sizeof(UnrolledList) );
+    CHECK_NULL(ptr);
+
+    ptr->m_first = NULL;
+    ptr->m_last = NULL;
+    ptr->m_spare = NULL;
+    ptr->m_size = 0;
+
+    return ptr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy unrolled list
+ * @details Destroys the list completely optionally destroys elements using user provided function
+ *
+ * @params	pList       	=   A pointer to previously created UnrolledList returned via
+ *							UnrolledListCreate on completion *_pList will be null
+ * @params	elementDestroy  =   A function pointer to be used to destroy elements
+ *							inserted into the list or a null if no such destroy is required
+ * @returns void
+ */
+void UnrolledListDestroy(UnrolledList** _pList, void (*_elementDestroy)(void* _item))
+{
+    UNode* node;
+    UNode* next;
+    size_t i;
+
+    if(NULL == _pList || NULL == *_pList)
+    {
+        return;
+    }
+
+    for(node = (*_pList)->m_first; NULL != node; node = next)
+    {
+        if( NULL != _elementDestroy )
+        {
+            for(i = node->m_begin; i < node->m_end; ++i)
+            {
+                (*_elementDestroy)(node->m_items[i]);
+            }
+        }
+
+        next = node->m_next;
+        free(node);
+    }
+
+    free( (*_pList)->m_spare );
+    free(*_pList);
+    *_pList = NULL;
+
+    return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add element to head of list
+ * @details Time complexity: O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  item                       		=   An item to add to the list
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If item element is uninitialized
+ * @retval  UNROLLED_LIST_ALLOCATION_ERROR      =   On memory allocation failure
+ */
+UnrolledListResult UnrolledListPushHead(UnrolledList* _list, void* _item)
+{
+    UNode* node;
+
+    CHECK_LIST_NULL(_list);
+    CHECK_ELEMENT_NULL(_item);
+
+    node = _list->m_first;
+    if( NULL == node || 0 == node->m_begin )
+    {
+        node = GetNode(_list, ELEMENTS_IN_NODE);
+        CHECK_ALLOCATION_ERROR(node);
+
+        node->m_prev = NULL;
+        node->m_next = _list->m_first;
+        if( NULL == _list->m_first )
+        {
+            _list->m_last = node;
+        }
+        else
+        {
+            _list->m_first->m_prev = node;
+        }
+        _list->m_first = node;
+    }
+
+    node->m_items[--node->m_begin] = _item;
+    ++_list->m_size;
+
+    return UNROLLED_LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add element to tail of list
+ * @details Time complexity: O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  item                       		=   An item to add to the list
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If item element is uninitialized
+ * @retval  UNROLLED_LIST_ALLOCATION_ERROR      =   On memory allocation failure
+ */
+UnrolledListResult UnrolledListPushTail(UnrolledList* _list, void* _item)
+{
+    UNode* node;
+
+    CHECK_LIST_NULL(_list);
+    CHECK_ELEMENT_NULL(_item);
+
+    node = _list->m_last;
+    if( NULL == node || ELEMENTS_IN_NODE == node->m_end )
+    {
+        node = GetNode(_list, 0);
+        CHECK_ALLOCATION_ERROR(node);
+
+        node->m_next = NULL;
+        node->m_prev = _list->m_last;
+        if( NULL == _list->m_last )
+        {
+            _list->m_first = node;
+        }
+        else
+        {
+            _list->m_last->m_next = node;
+        }
+        _list->m_last = node;
+    }
+
+    node->m_items[node->m_end++] = _item;
+    ++_list->m_size;
+
+    return UNROLLED_LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove element from list's head
+ * @details If successfull, stores a pointer to the removed item in _item
+ *  		Time complexity O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  pItem                      		=   Pointer to variable that will receive deleted item value
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If pItem is uninitialized
+ * @retval  UNROLLED_LIST_EMPTY_ERROR         	=   No element in the list to pop
+ */
+UnrolledListResult UnrolledListPopHead(UnrolledList* _list, void** _pItem)
+{
+    UNode* node;
+
+    CHECK_LIST_NULL(_list);
+    CHECK_ELEMENT_NULL(_pItem);
+
+    if( 0 == _list->m_size )
+    {
+        return UNROLLED_LIST_EMPTY_ERROR;
+    }
+
+    node = _list->m_first;
+    *_pItem = node->m_items[node->m_begin++];
+    --_list->m_size;
+
+    if( node->m_begin == node->m_end )
+    {
+        ReleaseNode(_list, node);
+    }
+
+    return UNROLLED_LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove element from list's tail
+ * @details If successfull, stores a pointer to the removed item in _item
+ *  		Time complexity O(1).
+ *
+ * @params  list                       		=   A previously created UnrolledList
+ * @params  pItem                      		=   Pointer to variable that will receive deleted item value
+ *
+ * @return	Status UnrolledListResult that indicate in which state the function ended:
+ *
+ * @retval  UNROLLED_LIST_SUCCESS               =   On success
+ * @retval  UNROLLED_LIST_UNINITIALIZED_ERROR   =   If the list ptr is uninitialized
+ * @retval  UNROLLED_LIST_NULL_ELEMENT_ERROR    =   If pItem is uninitialized
+ * @retval  UNROLLED_LIST_EMPTY_ERROR         	=   No element in the list to pop
+ */
+UnrolledListResult UnrolledListPopTail(UnrolledList* _list, void** _pItem)
+{
+    UNode* node;
+
+    CHECK_LIST_NULL(_list);
+    CHECK_ELEMENT_NULL(_pItem);
+
+    if( 0 == _list->m_size )
+    {
+        return UNROLLED_LIST_EMPTY_ERROR;
+    }
+
+    node = _list->m_last;
+    *_pItem = node->m_items[--node->m_end];
+    --_list->m_size;
+
+    if( node->m_begin == node->m_end )
+    {
+        ReleaseNode(_list, node);
+    }
+
+    return UNROLLED_LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get number of elements in the list
+ * @details Time complexity: O(1).
+ *
+ * @params  list              			= A previously created UnrolledList
+ *
+ * @returns Number of elements:
+ *
+ * @retval  number                  	= If there are more then 0
+ * @retval  0                       	= If the list is uninitialized OR number
+ *										of elements is 0
+ */
+size_t UnrolledListSize(const UnrolledList* _list)
+{
+    return (NULL == _list) ? 0 : _list->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the list's beginning
+ *
+ * @params  list       	=   list to return begin iterator, pointing at first element
+ *                          or at the end if list is empty
+ *
+ * @return  Iterator pointing at the list's beginning, if the list is
+ *			uninitialized the iterator will be at the end of no list
+ */
+UnrolledListItr UnrolledListItrBegin(const UnrolledList* _list)
+{
+    UnrolledListItr itr;
+
+    itr.m_list = _list;
+    itr.m_node = (NULL == _list) ? NULL : _list->m_first;
+    itr.m_index = (NULL == itr.m_node) ? 0 : AS_NODE(itr.m_node)->m_begin;
+
+    return itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the list end
+ *
+ * @params  list       	=   list to return end iterator
+ *
+ * @return  Iterator pointing at the list's end
+ */
+UnrolledListItr UnrolledListItrEnd(const UnrolledList* _list)
+{
+    UnrolledListItr itr;
+
+    itr.m_list = _list;
+    itr.m_node = NULL;
+    itr.m_index = 0;
+
+    return itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Function that compare between two iterators
+ *
+ * @params  a          	=   Iterator a
+ * @params  b          	=   Iterator b
+ *
+ * @retval  1           =   If iterator _a and iterator _b equals
+ * @retval  0           =   If iterator _a and iterator _b NOT equals
+ */
+int UnrolledListItrEquals(UnrolledListItr _a, UnrolledListItr _b)
+{
+    return (_a.m_list == _b.m_list && _a.m_node == _b.m_node && _a.m_index == _b.m_index);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the next element from a given iterator
+ * @warning if _itr is end iterator it will be returned
+ *
+ * @params  itr                            	=   current iterator
+ *
+ * @retval  All iterator exclude the end    =   Iterator pointing at the next element
+ * @retval  At end of the list              =   Iterator pointing at itself
+ */
+UnrolledListItr UnrolledListItrNext(UnrolledListItr _itr)
+{
+    if( NULL == _itr.m_node )
+    {
+        return _itr;
+    }
+
+    if( ++_itr.m_index == AS_NODE(_itr.m_node)->m_end )
+    {
+        _itr.m_node = AS_NODE(_itr.m_node)->m_next;
+        _itr.m_index = (NULL == _itr.m_node) ? 0 : AS_NODE(_itr.m_node)->m_begin;
+    }
+
+    return _itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the previous element
+ * @warning if _itr is begin iterator it will be returned
+ *
+ * @params  itr                            	=   current iterator
+ *
+ * @retval  All iterator exclude the begin  =   Iterator pointing at the prev element
+ * @retval  In begin of the list            =   Iterator pointing at itself
+ */
+UnrolledListItr UnrolledListItrPrev(UnrolledListItr _itr)
+{
+    UNode* prev;
+
+    if( NULL == _itr.m_node )
+    {
+        prev = (NULL == _itr.m_list) ? NULL : _itr.m_list->m_last;
+    }
+    else if( _itr.m_index > AS_NODE(_itr.m_node)->m_begin )
+    {
+        --_itr.m_index;
+        return _itr;
+    }
+    else
+    {
+        prev = AS_NODE(_itr.m_node)->m_prev;
+    }
+
+    if( NULL != prev )
+    {
+        _itr.m_node = prev;
+        _itr.m_index = prev->m_end - 1;
+    }
+
+    return _itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get data from the element the current iterator is pointing to
+ *
+ * @params  itr         	=   A list iterator
+ *
+ * @retval  Data         	=   If the iterator is pointing at data
+ * @retval  NULL         	=   If iterator pointing to the end
+ */
+void* UnrolledListItrGet(UnrolledListItr _itr)
+{
+    CHECK_NULL(_itr.m_node);
+
+    return AS_NODE(_itr.m_node)->m_items[_itr.m_index];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Set data at the element where the current iterator is pointing at
+ *
+ * @params  itr         	=   A list iterator
+ * @params  element     	=   A iterator data
+ *
+ * @return  The orignal data from the element before the change:
+ *
+ * @retval  Data         	=   If the iterator is pointing at data
+ * @retval  NULL         	=   If iterator pointing to the end OR element is uninitialized
+ */
+void* UnrolledListItrSet(UnrolledListItr _itr, void* _element)
+{
+    void* tempData;
+
+    CHECK_NULL(_itr.m_node);
+    CHECK_NULL(_element);
+
+    tempData = AS_NODE(_itr.m_node)->m_items[_itr.m_index];
+    AS_NODE(_itr.m_node)->m_items[_itr.m_index] = _element;
+
+    return tempData;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get an empty node from the spare OR from the heap
+ *
+ * @params  _list           =   The list that the node will belong to
+ * @params  _index          =   The index to set as begin and end of the empty node
+ *
+ * @returns Node pointer OR NULL on allocation failure
+ */
+static UNode* GetNode(UnrolledList* _list, size_t _index)
+{
+    UNode* node = _list->m_spare;
+
+    if( NULL != node )
+    {
+        _list->m_spare = NULL;
+    }
+    else
+    {
+        node = (UNode*)malloc( sizeof(UNode) );
+        CHECK_NULL(node);
+    }
+
+    node->m_begin = _index;
+    node->m_end = _index;
+
+    return node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Unlink an empty node from the list and keep it as spare OR free it
+ *
+ * @params  _list           =   The list that the node belong to
+ * @params  _node           =   The empty node to release
+ *
+ * @returns void
+ */
+static void ReleaseNode(UnrolledList* _list, UNode* _node)
+{
+    if( NULL == _node->m_prev )
+    {
+        _list->m_first = _node->m_next;
+    }
+    else
+    {
+        _node->m_prev->m_next = _node->m_next;
+    }
+
+    if( NULL == _node->m_next )
+    {
+        _list->m_last = _node->m_prev;
+    }
+    else
+    {
+        _node->m_next->m_prev = _node->m_prev;
+    }
+
+    if( NULL == _list->m_spare )
+    {
+        _list->m_spare = _node;
+    }
+    else
+    {
+        free(_node);
+    }
+
+    return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,219 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic indexed Priority Queue against Generic Heap
+ *
+ *  @details 	Measure the time to insert random items and pop all of them, for the
+ *  			4-ary indexed priority queue and for the binary heap. Then measure
+ *  			the decrease key of the priority queue, done with the handles.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "priorityQueue.h"	/* header file */
+#include "heap.h"			/* heap header */
+#include "vector.h"			/* vector header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand & malloc */
+#include <time.h> 			/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of items in each run, can be changed from the command line */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data > _b data, the heap is a max heap
+ */
+static int CompareDataReverse(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert all items to the priority queue, decrease every other item and pop all
+ */
+static void RunPQueue(int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert all items to the heap and extract all
+ */
+static void RunHeap(int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	int* array;
+
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+
+	array = (int*)malloc(nElements * sizeof(int));
+	if( NULL == array )
+	{
+		return 1;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < nElements; ++i)
+	{
+		array[i] = rand();
+	}
+
+	printf("Priority queue benchmark, %lu random items:\n", (unsigned long)nElements);
+	RunHeap(array, nElements);
+	RunPQueue(array, nElements);
+
+	free(array);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return ( *(int*)_a  < *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CompareDataReverse(void* _a, void* _b)
+{
+	return ( *(int*)_a  > *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunPQueue(int* _array, size_t _nElements)
+{
+	PQueue* pQueue;
+	PQueueHandle** handles;
+	void* value = NULL;
+	clock_t start;
+	clock_t insertEnd;
+	clock_t popEnd;
+	clock_t changeEnd;
+	size_t i;
+
+	pQueue = PQueue_Create(CompareData, _nElements);
+	handles = (PQueueHandle**)malloc(_nElements * sizeof(PQueueHandle*));
+	if( NULL == pQueue || NULL == handles )
+	{
+		PQueue_Destroy(&pQueue, NULL);
+		free(handles);
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		PQueue_Insert(pQueue, &_array[i], &handles[i]);
+	}
+	insertEnd = clock();
+
+	while( PQUEUE_SUCCESS == PQueue_Pop(pQueue, &value) )
+	{
+	}
+	popEnd = clock();
+
+	/* Insert again and decrease every other item to half, like a relax of Dijkstra */
+	for(i = 0; i < _nElements; ++i)
+	{
+		PQueue_Insert(pQueue, &_array[i], &handles[i]);
+	}
+	changeEnd = clock();
+	for(i = 0; i < _nElements; i += 2)
+	{
+		_array[i] /= 2;
+		PQueue_ChangePriority(pQueue, handles[i], &_array[i]);
+	}
+	changeEnd = clock() - changeEnd;
+
+	PQueue_Destroy(&pQueue, NULL);
+	free(handles);
+
+	printf("4-ary PQueue   insert: %8.1f ms   pop all: %8.1f ms   decrease n/2: %8.1f ms\n",
+			TO_MSEC(start, insertEnd), TO_MSEC(insertEnd, popEnd), TO_MSEC(0, changeEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunHeap(int* _array, size_t _nElements)
+{
+	Vector* vec;
+	Heap* heap;
+	void* value = NULL;
+	clock_t start;
+	clock_t insertEnd;
+	clock_t popEnd;
+	size_t i;
+
+	vec = VectorCreate(_nElements, _nElements);
+	heap = HeapBuild(vec, CompareDataReverse);
+	if( NULL == heap )
+	{
+		VectorDestroy(&vec, NULL);
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		HeapInsert(heap, &_array[i]);
+	}
+	insertEnd = clock();
+
+	while( HEAP_SUCCESS == HeapExtractMax(heap, &value) )
+	{
+	}
+	popEnd = clock();
+
+	HeapDestroy(&heap);
+	VectorDestroy(&vec, NULL);
+
+	printf("Binary Heap    insert: %8.1f ms   pop all: %8.1f ms\n",
+			TO_MSEC(start, insertEnd), TO_MSEC(insertEnd, popEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,490 @@
+/**
+ *  @file 		priorityQueue.c
+ *  @brief 		src file for Generic indexed Priority Queue data type
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type.
+ * 				Implemented as a 4-ary min heap, the sons of index i are 4i+1 ... 4i+4.
+ * 				A slot of the heap array keeps the element next to it's handle, so the
+ * 				compares read only the array. Every handle keeps it's index in the array,
+ * 				so a handle finds it's element place in O(1).
+ * 				Sift up and sift down move a hole instead of swapping, and update the
+ * 				index of every handle they move.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "priorityQueue.h"	/* header file */
+#include <stdlib.h>  		/* size_t &malloc */
+
+#define ARITY (4)
+#define MIN_CAPACITY (16)
+#define FIRST_SON(index)			( ARITY * (index) + 1 )
+#define FATHER(index)				( ((index) - 1) / ARITY )
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_PQUEUE_NULL(param)	do{ if(NULL == (param) ) { return PQUEUE_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return PQUEUE_NULL_ELEMENT_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+struct PQueueHandle
+{
+    size_t m_index; 			/* The place of the element in m_slots */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct Slot
+{
+    void* m_element;
+    PQueueHandle* m_handle;
+} Slot;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct PQueue
+{
+    Slot* m_slots; 				/* The heap array */
+    size_t m_nItems;
+    size_t m_capacity;
+    PQueueLessComparator m_less;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Check that _handle is of an element in the queue
+ */
+static int IsValidHandle(const PQueue* _pQueue, const PQueueHandle* _handle);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, moving bigger fathers down on the way up
+ */
+static void SiftUp(PQueue* _pQueue, size_t _hole, Slot _slot);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, moving smaller sons up on the way down
+ */
+static void SiftDown(PQueue* _pQueue, size_t _hole, Slot _slot);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, up OR down by it's father
+ */
+static void Fix(PQueue* _pQueue, size_t _hole, Slot _slot);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new priority queue
+ *
+ * @param 	less					= A comparison function that returns true (none zero value)
+ *								  if x < y and false (zero) otherwise.
+ * @param 	initialCapacity			= Number of elements that can be stored before the first grow,
+ *								  the queue doubles it's capacity when full
+ *
+ * @return 	The queue pointer
+ * @retval	PQueue*					= On success
+ * @retval	NULL 					= If _less is NULL OR allocation failed
+ */
+PQueue* PQueue_Create(PQueueLessComparator _less, size_t _initialCapacity)
+{
+	PQueue* pQueue;
+
+	CHECK_NULL(_less);
+
+	pQueue = (PQueue*)malloc( sizeof(PQueue) );
+	CHECK_NULL(pQueue);
+
+	pQueue->m_capacity = ( MIN_CAPACITY > _initialCapacity ) ? MIN_CAPACITY : _initialCapacity;
+	pQueue->m_slots = (Slot*)malloc( pQueue->m_capacity * sizeof(Slot) );
+	if( NULL == pQueue->m_slots )
+	{
+		free(pQueue);
+		return NULL;
+	}
+
+	pQueue->m_nItems = 0;
+	pQueue->m_less = _less;
+
+	return pQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated queue, all the handles are freed
+ *
+ * @param	pQueue					= Queue to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all
+ *								  elements in the queue or a null if no such destroy is required
+ *
+ * @return void
+ */
+void PQueue_Destroy(PQueue** _pQueue, void (*_elementDestroy)(void* _item))
+{
+	size_t i;
+
+	if( NULL == _pQueue || NULL == *_pQueue )
+	{
+		return;
+	}
+
+	for(i = 0; i < (*_pQueue)->m_nItems; ++i)
+	{
+		if( NULL != _elementDestroy )
+		{
+			_elementDestroy( (*_pQueue)->m_slots[i].m_element );
+		}
+		free( (*_pQueue)->m_slots[i].m_handle );
+	}
+
+	free( (*_pQueue)->m_slots );
+	free(*_pQueue);
+	*_pQueue = NULL;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element to the queue
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	element						= Element to add.
+ * @param	handle						= Set to the handle of the element (may be NULL if unnecessary)
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	PQUEUE_ALLOCATION_ERROR 	= On allocation failure
+ */
+PQueueResult PQueue_Insert(PQueue* _pQueue, void* _element, PQueueHandle** _handle)
+{
+	Slot slot;
+	Slot* slots;
+
+	CHECK_PQUEUE_NULL(_pQueue);
+	CHECK_ELEMENT_NULL(_element);
+
+	if( _pQueue->m_nItems == _pQueue->m_capacity )
+	{
+		slots = (Slot*)realloc(_pQueue->m_slots, 2 * _pQueue->m_capacity * sizeof(Slot));
+		if( NULL == slots )
+		{
+			return PQUEUE_ALLOCATION_ERROR;
+		}
+		_pQueue->m_slots = slots;
+		_pQueue->m_capacity *= 2;
+	}
+
+	slot.m_handle = (PQueueHandle*)malloc( sizeof(PQueueHandle) );
+	if( NULL == slot.m_handle )
+	{
+		return PQUEUE_ALLOCATION_ERROR;
+	}
+	slot.m_element = _element;
+
+	SiftUp(_pQueue, _pQueue->m_nItems++, slot);
+
+	if( NULL != _handle )
+	{
+		*_handle = slot.m_handle;
+	}
+
+	return PQUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the first (smallest) element without removing it
+ * @Complexity	O(1)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	pValue						= Pointer to variable that will receive the element
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	PQUEUE_IS_EMPTY 			= When there are no elements in the queue
+ */
+PQueueResult PQueue_Top(const PQueue* _pQueue, void** _pValue)
+{
+	CHECK_PQUEUE_NULL(_pQueue);
+	CHECK_ELEMENT_NULL(_pValue);
+
+	if( 0 == _pQueue->m_nItems )
+	{
+		return PQUEUE_IS_EMPTY;
+	}
+
+	*_pValue = _pQueue->m_slots[0].m_element;
+
+	return PQUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the first (smallest) element, it's handle is freed
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	pValue						= Pointer to variable that will receive the removed element
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When pValue is uninitialized
+ * @retval 	PQUEUE_IS_EMPTY 			= When there are no elements in the queue
+ */
+PQueueResult PQueue_Pop(PQueue* _pQueue, void** _pValue)
+{
+	CHECK_PQUEUE_NULL(_pQueue);
+	CHECK_ELEMENT_NULL(_pValue);
+
+	if( 0 == _pQueue->m_nItems )
+	{
+		return PQUEUE_IS_EMPTY;
+	}
+
+	return PQueue_Remove(_pQueue, _pQueue->m_slots[0].m_handle, _pValue);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Replace the element of a handle and move it to it's new place
+ * @details To change the priority of an element in place, change the element
+ *			and call this function with the same element.
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	handle						= Handle returned by PQueue_Insert
+ * @param	element						= The new element of the handle
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	PQUEUE_HANDLE_ERROR 		= When handle is NULL OR not of this queue
+ */
+PQueueResult PQueue_ChangePriority(PQueue* _pQueue, PQueueHandle* _handle, void* _element)
+{
+	CHECK_PQUEUE_NULL(_pQueue);
+	CHECK_ELEMENT_NULL(_element);
+
+	if( !IsValidHandle(_pQueue, _handle) )
+	{
+		return PQUEUE_HANDLE_ERROR;
+	}
+
+	_pQueue->m_slots[_handle->m_index].m_element = _element;
+	Fix(_pQueue, _handle->m_index, _pQueue->m_slots[_handle->m_index]);
+
+	return PQUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove the element of a handle from any place in the queue, the handle is freed
+ * @Complexity	O(log n)
+ *
+ * @param	pQueue						= Queue to use.
+ * @param	handle						= Handle returned by PQueue_Insert
+ * @param	pValue						= Set to the removed element (may be NULL if unnecessary)
+ *
+ * @return	Status PQueueResult that indicate in which state the function ended:
+ *
+ * @retval 	PQUEUE_SUCCESS				= On success
+ * @retval 	PQUEUE_UNINITIALIZED_ERROR 	= When queue is uninitialized
+ * @retval 	PQUEUE_HANDLE_ERROR 		= When handle is NULL OR not of this queue
+ */
+PQueueResult PQueue_Remove(PQueue* _pQueue, PQueueHandle* _handle, void** _pValue)
+{
+	Slot last;
+
+	CHECK_PQUEUE_NULL(_pQueue);
+
+	if( !IsValidHandle(_pQueue, _handle) )
+	{
+		return PQUEUE_HANDLE_ERROR;
+	}
+
+	if( NULL != _pValue )
+	{
+		*_pValue = _pQueue->m_slots[_handle->m_index].m_element;
+	}
+
+	/* The last slot fills the hole of the removed one */
+	last = _pQueue->m_slots[--_pQueue->m_nItems];
+	if( last.m_handle != _handle )
+	{
+		Fix(_pQueue, _handle->m_index, last);
+	}
+	free(_handle);
+
+	return PQUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the queue.
+ *
+ * @param	pQueue			= Queue to use.
+ *
+ * @return  Number of elements
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If queue is empty OR pointer is uninitialized
+ */
+size_t PQueue_Size(const PQueue* _pQueue)
+{
+	if( NULL == _pQueue )
+	{
+		return 0;
+	}
+
+	return _pQueue->m_nItems;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Check that _handle is of an element in the queue
+ */
+static int IsValidHandle(const PQueue* _pQueue, const PQueueHandle* _handle)
+{
+	return NULL != _handle && _handle->m_index < _pQueue->m_nItems &&
+			_handle == _pQueue->m_slots[_handle->m_index].m_handle;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, moving bigger fathers down on the way up
+ */
+static void SiftUp(PQueue* _pQueue, size_t _hole, Slot _slot)
+{
+	Slot* slots = _pQueue->m_slots;
+
+	while( 0 < _hole && 0 != _pQueue->m_less(_slot.m_element, slots[FATHER(_hole)].m_element) )
+	{
+		slots[_hole] = slots[FATHER(_hole)];
+		slots[_hole].m_handle->m_index = _hole;
+		_hole = FATHER(_hole);
+	}
+
+	slots[_hole] = _slot;
+	_slot.m_handle->m_index = _hole;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, moving smaller sons up on the way down
+ */
+static void SiftDown(PQueue* _pQueue, size_t _hole, Slot _slot)
+{
+	Slot* slots = _pQueue->m_slots;
+	size_t son;
+	size_t lastSon;
+	size_t minSon;
+
+	while( (son = FIRST_SON(_hole)) < _pQueue->m_nItems )
+	{
+		/* The smallest of up to ARITY sons, they are next to each other */
+		lastSon = ( son + ARITY < _pQueue->m_nItems ) ? son + ARITY : _pQueue->m_nItems;
+		for(minSon = son++; son < lastSon; ++son)
+		{
+			if( 0 != _pQueue->m_less(slots[son].m_element, slots[minSon].m_element) )
+			{
+				minSon = son;
+			}
+		}
+
+		if( 0 == _pQueue->m_less(slots[minSon].m_element, _slot.m_element) )
+		{
+			break;
+		}
+
+		slots[_hole] = slots[minSon];
+		slots[_hole].m_handle->m_index = _hole;
+		_hole = minSon;
+	}
+
+	slots[_hole] = _slot;
+	_slot.m_handle->m_index = _hole;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Place _slot in the hole at _hole, up OR down by it's father
+ */
+static void Fix(PQueue* _pQueue, size_t _hole, Slot _slot)
+{
+	if( 0 < _hole &&
+		0 != _pQueue->m_less(_slot.m_element, _pQueue->m_slots[FATHER(_hole)].m_element) )
+	{
+		SiftUp(_pQueue, _hole, _slot);
+	}
+	else
+	{
+		SiftDown(_pQueue, _hole, _slot);
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
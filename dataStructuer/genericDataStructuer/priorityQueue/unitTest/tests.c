@@ -0,0 +1,309 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic indexed Priority Queue data structure
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type,
+ * 				every element has a handle to change it's priority OR remove it.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "priorityQueue.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+
+#define SIZE (1000) /* SIZE = Num of elements in each test */
+#define MAX_RAND_VALUE (500) /* MAX_RAND_VALUE = The max value of the random elements, with repeats */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function for int elements
+ */
+static int IntLess(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Create a queue of _nElements random values of _array, keep the handles
+ *
+ * @return	The queue OR NULL on allocation failure
+ */
+static PQueue* CreateRandQueue(int* _array, PQueueHandle** _handles, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Pop all the elements, check they come in increasing order
+ *
+ * @return	Number of popped elements if the order is right, 0 otherwise
+ */
+static size_t PopAllSorted(PQueue* _pQueue);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------- PQueue_Create ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_Create_CheckNull)
+    PQueue* pQueue;
+
+    ASSERT_THAT( NULL == PQueue_Create(NULL, 10) );
+
+    pQueue = PQueue_Create(IntLess, 0);
+    ASSERT_THAT( NULL != pQueue && 0 == PQueue_Size(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+    ASSERT_THAT( NULL == pQueue );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- PQueue_Insert ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_Insert_CheckNull)
+    PQueue* pQueue;
+    int item = 1;
+
+    pQueue = PQueue_Create(IntLess, 1);
+    ASSERT_THAT( PQUEUE_UNINITIALIZED_ERROR == PQueue_Insert(NULL, &item, NULL) );
+    ASSERT_THAT( PQUEUE_NULL_ELEMENT_ERROR == PQueue_Insert(pQueue, NULL, NULL) );
+    ASSERT_THAT( PQUEUE_SUCCESS == PQueue_Insert(pQueue, &item, NULL) && 1 == PQueue_Size(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- PQueue_Pop --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_Pop_CheckEmpty)
+    PQueue* pQueue;
+    void* value = NULL;
+
+    pQueue = PQueue_Create(IntLess, 1);
+    ASSERT_THAT( PQUEUE_IS_EMPTY == PQueue_Pop(pQueue, &value) );
+    ASSERT_THAT( PQUEUE_IS_EMPTY == PQueue_Top(pQueue, &value) );
+    ASSERT_THAT( PQUEUE_NULL_ELEMENT_ERROR == PQueue_Pop(pQueue, NULL) );
+    ASSERT_THAT( PQUEUE_UNINITIALIZED_ERROR == PQueue_Pop(NULL, &value) );
+    PQueue_Destroy(&pQueue, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_Pop_CheckCase_RandValues)
+    PQueue* pQueue;
+    int array[SIZE];
+    PQueueHandle* handles[SIZE];
+    int result;
+
+    pQueue = CreateRandQueue(array, handles, SIZE);
+    result = ( SIZE == PopAllSorted(pQueue) && 0 == PQueue_Size(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------- PQueue_ChangePriority ---------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_ChangePriority_CheckCase_DecreaseToTop)
+    PQueue* pQueue;
+    int array[SIZE];
+    PQueueHandle* handles[SIZE];
+    void* value = NULL;
+    size_t i;
+    int result = 1;
+
+    pQueue = CreateRandQueue(array, handles, SIZE);
+
+    /* Every decreased element becomes the top */
+    for(i = 0; i < SIZE; i += 7)
+    {
+    	array[i] = -(int)i - 1;
+    	result = result && ( PQUEUE_SUCCESS == PQueue_ChangePriority(pQueue, handles[i], &array[i]) );
+    	result = result && ( PQUEUE_SUCCESS == PQueue_Top(pQueue, &value) && &array[i] == value );
+    }
+
+    result = result && ( SIZE == PopAllSorted(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_ChangePriority_CheckCase_RandChanges)
+    PQueue* pQueue;
+    int array[SIZE];
+    int newValues[SIZE];
+    PQueueHandle* handles[SIZE];
+    size_t i;
+    int result = 1;
+
+    pQueue = CreateRandQueue(array, handles, SIZE);
+
+    /* Up and down, half in place and half with a new element */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	if( 0 == i % 2 )
+    	{
+    		array[i] = rand() % MAX_RAND_VALUE;
+    		result = result && ( PQUEUE_SUCCESS == PQueue_ChangePriority(pQueue, handles[i], &array[i]) );
+    	}
+    	else
+    	{
+    		newValues[i] = rand() % MAX_RAND_VALUE;
+    		result = result && ( PQUEUE_SUCCESS == PQueue_ChangePriority(pQueue, handles[i], &newValues[i]) );
+    	}
+    }
+
+    result = result && ( SIZE == PopAllSorted(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_ChangePriority_CheckHandleError)
+    PQueue* pQueue;
+    PQueue* otherQueue;
+    PQueueHandle* handle = NULL;
+    PQueueHandle* otherHandle = NULL;
+    int item = 1;
+
+    pQueue = PQueue_Create(IntLess, 1);
+    otherQueue = PQueue_Create(IntLess, 1);
+    PQueue_Insert(pQueue, &item, &handle);
+    PQueue_Insert(otherQueue, &item, &otherHandle);
+
+    ASSERT_THAT( PQUEUE_HANDLE_ERROR == PQueue_ChangePriority(pQueue, NULL, &item) );
+    ASSERT_THAT( PQUEUE_HANDLE_ERROR == PQueue_ChangePriority(pQueue, otherHandle, &item) );
+    ASSERT_THAT( PQUEUE_NULL_ELEMENT_ERROR == PQueue_ChangePriority(pQueue, handle, NULL) );
+    ASSERT_THAT( PQUEUE_HANDLE_ERROR == PQueue_Remove(otherQueue, handle, NULL) );
+    PQueue_Destroy(&pQueue, NULL);
+    PQueue_Destroy(&otherQueue, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- PQueue_Remove ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PQueue_Remove_CheckCase_EveryThird)
+    PQueue* pQueue;
+    int array[SIZE];
+    PQueueHandle* handles[SIZE];
+    void* value = NULL;
+    size_t i;
+    int result = 1;
+
+    pQueue = CreateRandQueue(array, handles, SIZE);
+
+    for(i = 0; i < SIZE; i += 3)
+    {
+    	result = result && ( PQUEUE_SUCCESS == PQueue_Remove(pQueue, handles[i], &value) );
+    	result = result && ( &array[i] == value );
+    }
+
+    result = result && ( SIZE - (SIZE + 2) / 3 == PopAllSorted(pQueue) );
+    PQueue_Destroy(&pQueue, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Indexed Priority Queue Module)
+	PRINT(PQueue_Create_CheckNull)
+
+	PRINT(PQueue_Insert_CheckNull)
+
+	PRINT(PQueue_Pop_CheckEmpty)
+	PRINT(PQueue_Pop_CheckCase_RandValues)
+
+	PRINT(PQueue_ChangePriority_CheckCase_DecreaseToTop)
+	PRINT(PQueue_ChangePriority_CheckCase_RandChanges)
+	PRINT(PQueue_ChangePriority_CheckHandleError)
+
+	PRINT(PQueue_Remove_CheckCase_EveryThird)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int IntLess(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static PQueue* CreateRandQueue(int* _array, PQueueHandle** _handles, size_t _nElements)
+{
+	PQueue* pQueue;
+	size_t i;
+
+	pQueue = PQueue_Create(IntLess, 1);
+	if( NULL == pQueue )
+	{
+		return NULL;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < _nElements; ++i)
+	{
+		_array[i] = rand() % MAX_RAND_VALUE;
+		PQueue_Insert(pQueue, &_array[i], &_handles[i]);
+	}
+
+	return pQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t PopAllSorted(PQueue* _pQueue)
+{
+	void* value = NULL;
+	int last = -2 * SIZE;
+	size_t counter = 0;
+
+	while( PQUEUE_SUCCESS == PQueue_Pop(_pQueue, &value) )
+	{
+		if( *(int*)value < last )
+		{
+			return 0;
+		}
+		last = *(int*)value;
+		++counter;
+	}
+
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
@@ -16,6 +16,7 @@
  
 #include "queue.h"		/* header file */
 #include <stdlib.h> 	/* for size_t & calloc & malloc */
+#include <string.h> 	/* for memcpy */
 
 #define CHECK_NULL(var)				do{ if(NULL == (var) ) { return NULL;}  } while(0)
 #define CHECK_QUEUE_NULL(param)		do{ if(NULL == (param) ) { return QUEUE_UNINITIALIZED_ERROR;}  } while(0)
@@ -28,11 +29,13 @@
 /*----------------------------------------------------------------------------*/
 struct Queue
 {
-    void** m_items;			/* Pointer to the actual items */
-    size_t m_capacity; 		/* The size of the structuer */
+    void** m_items;			/* Pointer to the actual items, a power of 2 ring */
+    size_t m_mask; 			/* The size of m_items - 1, index & m_mask is the index in the ring */
+    size_t m_capacity; 		/* The size of the structuer (may be less then the ring when fixed) */
     size_t m_head; 			/* Index to the first message to remove from the structuer */
     size_t m_tail; 			/* Index to the last message that insert to the structuer */
     size_t m_numOfElements; /* The current number of message in the structuer */
+    int m_isGrowable; 		/* Double the ring instead of overflow */
 };
 /*----------------------------------------------------------------------------*/
 
@@ -40,6 +43,31 @@ struct Queue
 
 
 
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Create a queue with a ring of the smallest power of 2 that fits _initialCapacity
+ */
+static Queue* CreateQueue(size_t _initialCapacity, int _isGrowable);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Double the ring until _minCapacity elements fit, and unwrap it so head is 0
+ */
+static QueueResult Grow(Queue* _myQueue, size_t _minCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy _nItems from the ring starting at _index to _dest, in up to 2 blocks
+ */
+static void CopyFromRing(const Queue* _myQueue, size_t _index, void** _dest, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
 /******************************** API functions *******************************/
 /*----------------------------------------------------------------------------*/
 /** 
@@ -56,26 +84,28 @@ struct Queue
  */
 Queue* QueueCreate(size_t _initialCapacity)
 {
-	Queue* myQueue;
-	
-	if( 0 == _initialCapacity)
-	{
-		return NULL;
-	}
-	
-	myQueue = (Queue*)calloc( 1, sizeof(Queue) );
-	CHECK_NULL(myQueue);
-	
-	myQueue->m_items = malloc( _initialCapacity * sizeof(Queue*) );
-	if( NULL == myQueue->m_items)
-	{
-		free(myQueue->m_items);
-		return NULL;
-	}
-	
-	myQueue->m_capacity = _initialCapacity;
-	
-	return myQueue;
+	return CreateQueue(_initialCapacity, 0);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function create a new queue that grows when it is full
+ * @details     Like QueueCreate, but an insert to a full queue doubles the capacity
+ *				instead of QUEUE_OVERFLOW. The capacity is always a power of 2.
+ *
+ * @param       _initialCapacity 	=   Number of elements that can be stored initially,
+ *										rounded up to a power of 2
+ *
+ * @return		The orignal memory buffer OR NULL at error
+ *
+ * @retval		NULL				= 	On error when initalize
+ * @retval 		_myQueue			=	On success
+ */
+Queue* QueueCreateGrowable(size_t _initialCapacity)
+{
+	return CreateQueue(_initialCapacity, 1);
 }
 /*----------------------------------------------------------------------------*/
 
@@ -107,7 +137,7 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
         
         for(i = 0; i < elementCounter; ++i)
         {
-            (*_elementDestroy)( (*_myQueue)->m_items[i] );
+            (*_elementDestroy)( (*_myQueue)->m_items[((*_myQueue)->m_head + i) & (*_myQueue)->m_mask] );
         }
     }
     
@@ -134,6 +164,7 @@ void QueueDestroy(Queue** _myQueue, void (*_elementDestroy)(void* _item) )
  * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
  * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
  * @retval 		QUEUE_OVERFLOW				=	When there is no room to add more elements
+ * @retval 		QUEUE_ALLOCATION_ERROR		=	When a growable queue failed to grow
  */
 QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 {
@@ -142,11 +173,19 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
 	
 	if(_myQueue->m_numOfElements == _myQueue->m_capacity)
 	{
-		return QUEUE_OVERFLOW;
+		if( !_myQueue->m_isGrowable )
+		{
+			return QUEUE_OVERFLOW;
+		}
+		
+		if( QUEUE_SUCCESS != Grow(_myQueue, _myQueue->m_capacity + 1) )
+		{
+			return QUEUE_ALLOCATION_ERROR;
+		}
 	}
 	
 	_myQueue->m_items[_myQueue->m_tail] = _data;
-	(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) % (_myQueue->m_capacity)  );
+	(_myQueue->m_tail) = ( (_myQueue->m_tail + 1 ) & (_myQueue->m_mask)  );
 	++(_myQueue->m_numOfElements);
 	
 	return QUEUE_SUCCESS;
@@ -166,13 +205,13 @@ QueueResult QueueInsert(Queue* const _myQueue, void* _data)
  *
  * @retval 		QUEUE_SUCCESS				=	On success
  * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
- * @retval 		QUEUE_ALLOCATION_ERROR		=	Allocation error 
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	Uninitialized item error
+ * @retval 		QUEUE_UNDERFLOW				=	When the queue is empty
  */
 QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 {
 	CHECK_QUEUE_NULL(_myQueue);
 	CHECK_ITEM_NULL(_pValue);
-	CHECK_ITEM_NULL(*_pValue);
 	
 	if(0 == _myQueue->m_numOfElements)
 	{
@@ -180,7 +219,7 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 	}
 	
 	*_pValue = (_myQueue->m_items)[_myQueue->m_head];
-	(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) % (_myQueue->m_capacity)  ) ;
+	(_myQueue->m_head) = ( (_myQueue->m_head + 1 ) & (_myQueue->m_mask)  ) ;
 	--(_myQueue->m_numOfElements);
 	
 	return QUEUE_SUCCESS;
@@ -188,6 +227,123 @@ QueueResult QueueRemove(Queue* const _myQueue, void** _pValue)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get the next element of the queue without removing it
+ *
+ * @param       _myQueue        			=   Pointer to queue
+ * @param       _pValue    					=   Pointer to variable that will receive item data
+ *
+ * @return		Status QueueResult that indicate in which state the function ended:
+ *
+ * @retval 		QUEUE_SUCCESS				=	On success
+ * @retval 		QUEUE_UNINITIALIZED_ERROR	=	Uninitialized Queue error
+ * @retval 		ITEM_UNINITIALIZED_ERROR	=	When _pValue is NULL
+ * @retval 		QUEUE_UNDERFLOW				=	When the queue is empty
+ */
+QueueResult QueuePeek(const Queue* _myQueue, void** _pValue)
+{
+	CHECK_QUEUE_NULL(_myQueue);
+	CHECK_ITEM_NULL(_pValue);
+	
+	if(0 == _myQueue->m_numOfElements)
+	{
+		return QUEUE_UNDERFLOW;
+	}
+	
+	*_pValue = (_myQueue->m_items)[_myQueue->m_head];
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function put a block of elements into queue, in order
+ * @details     A growable queue grows once to fit all the elements, a fixed queue
+ *				takes as many as it has room for. Stops on the first NULL element.
+ *
+ * @param       _myQueue					=   Pointer to queue
+ * @param       _items    					=   Array of _nItems elements
+ * @param       _nItems    					=   Number of elements in _items
+ *
+ * @return		Number of elements that were inserted, from the start of _items
+ *				(0 if _myQueue OR _items is NULL)
+ */
+size_t QueueInsertMany(Queue* const _myQueue, void** _items, size_t _nItems)
+{
+	size_t nItems;
+	size_t first;
+	size_t room;
+	
+	if( NULL == _myQueue || NULL == _items )
+	{
+		return 0;
+	}
+	
+	for(nItems = 0; nItems < _nItems && NULL != _items[nItems]; ++nItems)
+	{
+	}
+	
+	room = _myQueue->m_capacity - _myQueue->m_numOfElements;
+	if( room < nItems )
+	{
+		if( !_myQueue->m_isGrowable
+		 || QUEUE_SUCCESS != Grow(_myQueue, _myQueue->m_numOfElements + nItems) )
+		{
+			nItems = room;
+		}
+	}
+	
+	/* From tail to the end of the ring, then the rest from the start */
+	first = _myQueue->m_mask + 1 - _myQueue->m_tail;
+	if( nItems < first )
+	{
+		first = nItems;
+	}
+	memcpy(_myQueue->m_items + _myQueue->m_tail, _items, first * sizeof(void*));
+	memcpy(_myQueue->m_items, _items + first, (nItems - first) * sizeof(void*));
+	
+	(_myQueue->m_tail) = ( (_myQueue->m_tail + nItems ) & (_myQueue->m_mask)  );
+	(_myQueue->m_numOfElements) += nItems;
+	
+	return nItems;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       The function get a block of elements from the queue, in order
+ *
+ * @param       _myQueue					=   Pointer to queue
+ * @param       _values    					=   Array of _maxItems to receive the elements
+ * @param       _maxItems  					=   Max number of elements to remove
+ *
+ * @return		Number of elements that were removed, min(_maxItems, QueueSize)
+ *				(0 if _myQueue OR _values is NULL)
+ */
+size_t QueueRemoveMany(Queue* const _myQueue, void** _values, size_t _maxItems)
+{
+	size_t nItems;
+	
+	if( NULL == _myQueue || NULL == _values )
+	{
+		return 0;
+	}
+	
+	nItems = (_maxItems < _myQueue->m_numOfElements) ? _maxItems : _myQueue->m_numOfElements;
+	CopyFromRing(_myQueue, _myQueue->m_head, _values, nItems);
+	
+	(_myQueue->m_head) = ( (_myQueue->m_head + nItems ) & (_myQueue->m_mask)  );
+	(_myQueue->m_numOfElements) -= nItems;
+	
+	return nItems;
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief       The function return the orignal memory buffer capacity of the queue
@@ -245,3 +401,104 @@ size_t QueueSize(Queue* const _myQueue)
 }
 /*----------------------------------------------------------------------------*/
 
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Create a queue with a ring of the smallest power of 2 that fits _initialCapacity
+ */
+static Queue* CreateQueue(size_t _initialCapacity, int _isGrowable)
+{
+	Queue* myQueue;
+	size_t ringSize = 1;
+	
+	if( 0 == _initialCapacity)
+	{
+		return NULL;
+	}
+	
+	while( ringSize < _initialCapacity )
+	{
+		ringSize <<= 1;
+		if( 0 == ringSize )
+		{
+			return NULL;
+		}
+	}
+	
+	myQueue = (Queue*)calloc( 1, sizeof(Queue) );
+	CHECK_NULL(myQueue);
+	
+	myQueue->m_items = (void**)malloc( ringSize * sizeof(void*) );
+	if( NULL == myQueue->m_items)
+	{
+		free(myQueue);
+		return NULL;
+	}
+	
+	myQueue->m_mask = ringSize - 1;
+	myQueue->m_capacity = (_isGrowable) ? ringSize : _initialCapacity;
+	myQueue->m_isGrowable = _isGrowable;
+	
+	return myQueue;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Double the ring until _minCapacity elements fit, and unwrap it so head is 0
+ */
+static QueueResult Grow(Queue* _myQueue, size_t _minCapacity)
+{
+	void** newItems;
+	size_t newSize = _myQueue->m_mask + 1;
+	
+	while( newSize < _minCapacity )
+	{
+		newSize <<= 1;
+		if( 0 == newSize )
+		{
+			return QUEUE_ALLOCATION_ERROR;
+		}
+	}
+	
+	newItems = (void**)malloc( newSize * sizeof(void*) );
+	if( NULL == newItems )
+	{
+		return QUEUE_ALLOCATION_ERROR;
+	}
+	
+	CopyFromRing(_myQueue, _myQueue->m_head, newItems, _myQueue->m_numOfElements);
+	free(_myQueue->m_items);
+	
+	_myQueue->m_items = newItems;
+	_myQueue->m_mask = newSize - 1;
+	_myQueue->m_capacity = newSize;
+	_myQueue->m_head = 0;
+	_myQueue->m_tail = _myQueue->m_numOfElements & _myQueue->m_mask;
+	
+	return QUEUE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy _nItems from the ring starting at _index to _dest, in up to 2 blocks
+ */
+static void CopyFromRing(const Queue* _myQueue, size_t _index, void** _dest, size_t _nItems)
+{
+	size_t first = _myQueue->m_mask + 1 - _index;
+	
+	if( _nItems < first )
+	{
+		first = _nItems;
+	}
+	
+	memcpy(_dest, _myQueue->m_items + _index, first * sizeof(void*));
+	memcpy(_dest + first, _myQueue->m_items, (_nItems - first) * sizeof(void*));
+	
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -247,6 +247,146 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*--------------------------------- QueuePeek --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(QueuePeek_CheckValue)
+    Queue* ip;
+    QueueResult retVal[4];
+    int item[2] = {55, 66};
+    void* value = NULL;
+    
+    ip = QueueCreate(QUEUE_SIZE);
+    
+    retVal[0] = QueuePeek(ip, &value );
+    QueueInsert(ip, (void*)&item[0] );
+    QueueInsert(ip, (void*)&item[1] );
+    retVal[1] = QueuePeek(ip, &value );
+    retVal[2] = QueuePeek(ip, NULL );
+    retVal[3] = QueuePeek(NULL, &value );
+	
+    ASSERT_THAT( QUEUE_UNDERFLOW == retVal[0] && QUEUE_SUCCESS == retVal[1] && &item[0] == value );
+    ASSERT_THAT( ITEM_UNINITIALIZED_ERROR == retVal[2] && QUEUE_UNINITIALIZED_ERROR == retVal[3] );
+    ASSERT_THAT( 2 == QueueSize(ip) );
+    
+    QueueDestroy( &ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- QueueCreateGrowable ---------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(QueueCreateGrowable_CheckGrow)
+    Queue* ip;
+    int item[QUEUE_SIZE * 10];
+    int* value[QUEUE_SIZE * 10];
+    size_t i;
+    int result = 1;
+    
+    ASSERT_THAT( NULL == QueueCreateGrowable(0) );
+    
+    ip = QueueCreateGrowable(3);
+    ASSERT_THAT( 4 == QueueCapacity(ip) );
+    
+    /* Wrap the ring before it grows, the order must stay */
+    InsertSortedValues(ip, item, 3, 1, 0);
+    QueueRemove(ip, (void**)&value[0] );
+    QueueRemove(ip, (void**)&value[1] );
+    
+    for(i = 3; i < QUEUE_SIZE * 10; ++i)
+    {
+    	item[i] = (int)i;
+    	result = result && ( QUEUE_SUCCESS == QueueInsert(ip, &item[i]) );
+    }
+    
+    result = result && ( QUEUE_SIZE * 10 - 2 == QueueSize(ip) && 128 == QueueCapacity(ip) );
+    for(i = 2; i < QUEUE_SIZE * 10; ++i)
+    {
+    	result = result && ( QUEUE_SUCCESS == QueueRemove(ip, (void**)&value[i]) && (int)i == *value[i] );
+    }
+	
+    QueueDestroy( &ip, NULL);
+    
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ QueueInsertMany -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(QueueInsertMany_CheckOverflow)
+    Queue* ip;
+    int item[QUEUE_SIZE];
+    void* items[QUEUE_SIZE];
+    size_t i;
+    
+    for(i = 0; i < QUEUE_SIZE; ++i)
+    {
+    	items[i] = &item[i];
+    }
+    
+    ip = QueueCreate(QUEUE_SIZE - 2);
+    ASSERT_THAT( 0 == QueueInsertMany(NULL, items, QUEUE_SIZE) && 0 == QueueInsertMany(ip, NULL, QUEUE_SIZE) );
+    ASSERT_THAT( 3 == QueueInsertMany(ip, items, 3) );
+    ASSERT_THAT( QUEUE_SIZE - 5 == QueueInsertMany(ip, items, QUEUE_SIZE) );
+    ASSERT_THAT( 0 == QueueInsertMany(ip, items, QUEUE_SIZE) && QUEUE_SIZE - 2 == QueueSize(ip) );
+    QueueDestroy( &ip, NULL);
+    
+    /* Stop on NULL */
+    ip = QueueCreateGrowable(1);
+    items[4] = NULL;
+    ASSERT_THAT( 4 == QueueInsertMany(ip, items, QUEUE_SIZE) && 4 == QueueSize(ip) );
+    QueueDestroy( &ip, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ QueueRemoveMany -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(QueueRemoveMany_CheckCyclie)
+    Queue* ip;
+    int item[QUEUE_SIZE * 3];
+    void* items[QUEUE_SIZE * 3];
+    void* values[QUEUE_SIZE * 3 + 3];
+    size_t i;
+    size_t round;
+    size_t next = 0;
+    int result = 1;
+    
+    for(i = 0; i < QUEUE_SIZE * 3; ++i)
+    {
+    	item[i] = (int)i;
+    	items[i] = &item[i];
+    }
+    
+    /* Blocks of 7 over a ring of 16, every block after the first wraps OR ends on the border */
+    ip = QueueCreateGrowable(QUEUE_SIZE);
+    for(round = 0; round < 4; ++round)
+    {
+    	result = result && ( 7 == QueueInsertMany(ip, items + round * 7, 7) );
+    	result = result && ( 7 == QueueRemoveMany(ip, values, 7) );
+    	for(i = 0; i < 7; ++i, ++next)
+    	{
+    		result = result && ( &item[next] == values[i] );
+    	}
+    }
+    
+    /* Grow while wrapped */
+    result = result && ( 3 == QueueInsertMany(ip, items, 3) );
+    result = result && ( QUEUE_SIZE * 3 == QueueInsertMany(ip, items, QUEUE_SIZE * 3) );
+    result = result && ( 3 + QUEUE_SIZE * 3 == QueueRemoveMany(ip, values, QUEUE_SIZE * 3 + 3) );
+    for(i = 0; i < QUEUE_SIZE * 3; ++i)
+    {
+    	result = result && ( &item[i] == values[i + 3] );
+    }
+    result = result && ( 0 == QueueSize(ip) && 0 == QueueRemoveMany(ip, values, 1) );
+	
+    QueueDestroy( &ip, NULL);
+    
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 /*-------------------------------- QueueCapacity -----------------------------*/
 /*----------------------------------------------------------------------------*/
 TEST(QueueCapacity_CheckNull_Queue)
@@ -324,6 +464,14 @@ TEST_SET(PRINT SysV Module)
 	PRINT(QueueRemove_CheckAllValue)
 	PRINT(QueueRemove_CheckCyclie)
 	
+	PRINT(QueuePeek_CheckValue)
+	
+	PRINT(QueueCreateGrowable_CheckGrow)
+	
+	PRINT(QueueInsertMany_CheckOverflow)
+	
+	PRINT(QueueRemoveMany_CheckCyclie)
+	
 	PRINT(QueueCapacity_CheckNull_Queue)
 	PRINT(QueueCapacity_CheckCorrectAnswer)
 	
@@ -0,0 +1,690 @@
+/**
+ *  @file 		skipList.c
+ *  @brief 		src file for Generic Skip List ordered map data type
+ *
+ *  @details 	The API stores pairs of pointers to user provided key and value.
+ *				The pairs are kept ordered by the keys using user provided less function,
+ *				insert, find, remove and bound queries are O(log n) expected.
+ *				Each node get a random height (p = 1/4) from a fast xorshift generator,
+ *				nodes are taken from a per list pool of contiguous chunks.
+ *				All the levels end at a tail sentinel that serve as the end iterator.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "skipList.h" 	/* header file */
+#include <stdlib.h> 	/* for size_t, NULL, malloc, free */
+
+#define CHECK_NULL(param)	do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define MAX_LEVEL (16)				/* Enough for 4^16 pairs with p = 1/4 */
+#define CHUNK_SIZE (4096)			/* Bytes the pool allocate in each new chunk */
+#define RAND_SEED (2463534242UL)
+#define NODE_SIZE(height)	( sizeof(SNode) + (height) * sizeof(SNode*) )
+#define FORWARD(node)		( (SNode**)( (SNode*)(node) + 1 ) )
+#define AS_NODE(itr)		( (SNode*)(itr) )
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct SNode SNode;
+typedef struct Chunk Chunk;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* The forward pointers array of m_height entries is allocated right after the node */
+struct SNode
+{
+    void* m_key;
+    void* m_value;
+    size_t m_height;
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Chunk
+{
+    Chunk* m_next;
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct SkipList
+{
+    SNode* m_head;					/* Sentinel of MAX_LEVEL height */
+    SNode* m_tail;					/* Sentinel, the end iterator */
+    SkipListLessFunction m_less;
+    size_t m_level;					/* Number of levels in use */
+    size_t m_size;
+    unsigned long m_randState;
+    Chunk* m_chunks;				/* All the chunks of the pool */
+    char* m_bumpNext;				/* Next free byte in the newest chunk */
+    char* m_bumpEnd;
+    SNode* m_freeLists[MAX_LEVEL];	/* Released nodes by height, chained by forward[0] */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Draw a random height in [1, MAX_LEVEL] with probability 1/4 to grow
+ *
+ * @params  _list           =   The list that hold the generator state
+ *
+ * @returns The height
+ */
+static size_t RandomHeight(SkipList* _list);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node of a given height from the list's pool
+ *
+ * @params  _list           =   The list that own the pool
+ * @params  _height         =   Number of forward pointers of the node
+ *
+ * @returns Node pointer OR NULL on allocation failure
+ */
+static SNode* PoolAlloc(SkipList* _list, size_t _height);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Return a node to the free list of it's height
+ *
+ * @params  _list           =   The list that own the pool
+ * @params  _node           =   The node to release
+ *
+ * @returns void
+ */
+static void PoolFree(SkipList* _list, SNode* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Find the last node in each level that its key is less then _key
+ *
+ * @params  _list           =   The list to search
+ * @params  _key            =   The key to search for
+ * @params  _update         =   Array of MAX_LEVEL to fill with the nodes, can be NULL
+ *
+ * @returns The first node that its key is not less then _key, might be the tail
+ */
+static SNode* FindPredecessors(const SkipList* _list, void* _key, SNode** _update);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Create a new skip list
+ *
+ * @param 	_less 		= Less function for the keys
+ *
+ * @return 	Newly created skip list or NULL on failure
+ */
+SkipList* SkipList_Create(SkipListLessFunction _less)
+{
+    SkipList* newList;
+    size_t i;
+
+    CHECK_NULL(_less);
+
+    newList = (SkipList*)malloc( sizeof(SkipList) );
+    CHECK_NULL(newList);
+
+    newList->m_size = 0;
+    newList->m_chunks = NULL;
+    newList->m_bumpNext = NULL;
+    newList->m_bumpEnd = NULL;
+    for(i = 0; i < MAX_LEVEL; ++i)
+    {
+        newList->m_freeLists[i] = NULL;
+    }
+
+    newList->m_head = PoolAlloc(newList, MAX_LEVEL);
+    newList->m_tail = PoolAlloc(newList, 1);
+    if( NULL == newList->m_head || NULL == newList->m_tail )
+    {
+        SkipList_Destroy(&newList, NULL, NULL);
+        return NULL;
+    }
+
+    for(i = 0; i < MAX_LEVEL; ++i)
+    {
+        FORWARD(newList->m_head)[i] = newList->m_tail;
+    }
+    FORWARD(newList->m_tail)[0] = newList->m_tail;
+    newList->m_head->m_key = NULL;
+    newList->m_tail->m_key = NULL;
+    newList->m_tail->m_value = NULL;
+
+    newList->m_less = _less;
+    newList->m_level = 1;
+    newList->m_randState = RAND_SEED;
+
+    return newList;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Destroy skip list
+ * @details Destroys the list completely optionally destroys keys and values
+ *			using user provided functions
+ *
+ * @params	_list 		= A pointer to previously created list, on completion *_list will be null
+ * @params	_keyDestroy = A function to destroy keys OR NULL
+ * @params	_valDestroy = A function to destroy values OR NULL
+ */
+void SkipList_Destroy(SkipList** _list, void (*_keyDestroy)(void* _key), void (*_valDestroy)(void* _value))
+{
+    SNode* node;
+    Chunk* chunk;
+
+    if( NULL == _list || NULL == *_list )
+    {
+        return;
+    }
+
+    if( 0 < (*_list)->m_size && (NULL != _keyDestroy || NULL != _valDestroy) )
+    {
+        for(node = FORWARD((*_list)->m_head)[0]; (*_list)->m_tail != node; node = FORWARD(node)[0])
+        {
+            if( NULL != _keyDestroy )
+            {
+                _keyDestroy(node->m_key);
+            }
+            if( NULL != _valDestroy )
+            {
+                _valDestroy(node->m_value);
+            }
+        }
+    }
+
+    while( NULL != (*_list)->m_chunks )
+    {
+        chunk = (*_list)->m_chunks;
+        (*_list)->m_chunks = chunk->m_next;
+        free(chunk);
+    }
+
+    free(*_list);
+    *_list = NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Insert a key-value pair into the skip list
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_key 		= Key to serve as index
+ * @param 	_value 		= The value to associate with the key
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _key is NULL
+ * @retval  SKIPLIST_KEY_DUPLICATE_ERROR	= If key already present in the list
+ * @retval  SKIPLIST_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+SkipListResult SkipList_Insert(SkipList* _list, void* _key, void* _value)
+{
+    SNode* update[MAX_LEVEL];
+    SNode* found;
+    SNode* newNode;
+    size_t height;
+    size_t i;
+
+    if( NULL == _list )
+    {
+        return SKIPLIST_UNINITIALIZED_ERROR;
+    }
+    if( NULL == _key )
+    {
+        return SKIPLIST_KEY_NULL_ERROR;
+    }
+
+    found = FindPredecessors(_list, _key, update);
+    if( _list->m_tail != found && !_list->m_less(_key, found->m_key) )
+    {
+        return SKIPLIST_KEY_DUPLICATE_ERROR;
+    }
+
+    height = RandomHeight(_list);
+    newNode = PoolAlloc(_list, height);
+    if( NULL == newNode )
+    {
+        return SKIPLIST_ALLOCATION_ERROR;
+    }
+
+    for(; _list->m_level < height; ++_list->m_level)
+    {
+        update[_list->m_level] = _list->m_head;
+    }
+
+    newNode->m_key = _key;
+    newNode->m_value = _value;
+    for(i = 0; i < height; ++i)
+    {
+        FORWARD(newNode)[i] = FORWARD(update[i])[i];
+        FORWARD(update[i])[i] = newNode;
+    }
+    ++_list->m_size;
+
+    return SKIPLIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Remove a key-value pair from the skip list
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_searchKey 	= Key to search for
+ * @param 	_pKey 		= Pointer to variable that will get the key stored in the list, can be NULL
+ * @param 	_pValue 	= Pointer to variable that will get the value stored in the list, can be NULL
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _searchKey is NULL
+ * @retval  SKIPLIST_KEY_NOT_FOUND_ERROR	= If the key is not in the list
+ */
+SkipListResult SkipList_Remove(SkipList* _list, void* _searchKey, void** _pKey, void** _pValue)
+{
+    SNode* update[MAX_LEVEL];
+    SNode* found;
+    size_t i;
+
+    if( NULL == _list )
+    {
+        return SKIPLIST_UNINITIALIZED_ERROR;
+    }
+    if( NULL == _searchKey )
+    {
+        return SKIPLIST_KEY_NULL_ERROR;
+    }
+
+    found = FindPredecessors(_list, _searchKey, update);
+    if( _list->m_tail == found || _list->m_less(_searchKey, found->m_key) )
+    {
+        return SKIPLIST_KEY_NOT_FOUND_ERROR;
+    }
+
+    for(i = 0; i < found->m_height; ++i)
+    {
+        FORWARD(update[i])[i] = FORWARD(found)[i];
+    }
+    while( 1 < _list->m_level && _list->m_tail == FORWARD(_list->m_head)[_list->m_level - 1] )
+    {
+        --_list->m_level;
+    }
+    --_list->m_size;
+
+    if( NULL != _pKey )
+    {
+        *_pKey = found->m_key;
+    }
+    if( NULL != _pValue )
+    {
+        *_pValue = found->m_value;
+    }
+    PoolFree(_list, found);
+
+    return SKIPLIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Find a value by key
+ * @details Expected time complexity O(log n).
+ *
+ * @param 	_list 		= A previously created list
+ * @param 	_searchKey 	= Key to search for
+ * @param 	_pValue 	= Pointer to variable that will get the value, can be NULL
+ *
+ * @return 	Success indicator
+ * @retval  SKIPLIST_SUCCESS				= On success
+ * @retval  SKIPLIST_UNINITIALIZED_ERROR	= If the list is not initialized
+ * @retval  SKIPLIST_KEY_NULL_ERROR			= If _searchKey is NULL
+ * @retval  SKIPLIST_KEY_NOT_FOUND_ERROR	= If the key is not in the list
+ */
+SkipListResult SkipList_Find(const SkipList* _list, void* _searchKey, void** _pValue)
+{
+    SNode* found;
+
+    if( NULL == _list )
+    {
+        return SKIPLIST_UNINITIALIZED_ERROR;
+    }
+    if( NULL == _searchKey )
+    {
+        return SKIPLIST_KEY_NULL_ERROR;
+    }
+
+    found = FindPredecessors(_list, _searchKey, NULL);
+    if( _list->m_tail == found || _list->m_less(_searchKey, found->m_key) )
+    {
+        return SKIPLIST_KEY_NOT_FOUND_ERROR;
+    }
+
+    if( NULL != _pValue )
+    {
+        *_pValue = found->m_value;
+    }
+
+    return SKIPLIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get number of pairs in the list
+ * @details Time complexity O(1).
+ *
+ * @retval  number 		= Number of pairs, 0 if the list is uninitialized
+ */
+size_t SkipList_Size(const SkipList* _list)
+{
+    return (NULL == _list) ? 0 : _list->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the first pair that its key is not less then _key
+ * @details Expected time complexity O(log n).
+ *			Range [lo, hi) is iterated from SkipList_LowerBound(lo) to SkipList_LowerBound(hi).
+ *
+ * @retval  itr 		= Iterator to the pair OR end iterator if there is no such pair
+ * @retval  NULL 		= If the list OR key are uninitialized
+ */
+SkipListItr SkipList_LowerBound(const SkipList* _list, void* _key)
+{
+    CHECK_NULL(_list);
+    CHECK_NULL(_key);
+
+    return (SkipListItr)FindPredecessors(_list, _key, NULL);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the first pair that its key is greater then _key
+ * @details Expected time complexity O(log n).
+ *			Range [lo, hi] is iterated from SkipList_LowerBound(lo) to SkipList_UpperBound(hi).
+ *
+ * @retval  itr 		= Iterator to the pair OR end iterator if there is no such pair
+ * @retval  NULL 		= If the list OR key are uninitialized
+ */
+SkipListItr SkipList_UpperBound(const SkipList* _list, void* _key)
+{
+    SNode* found;
+
+    CHECK_NULL(_list);
+    CHECK_NULL(_key);
+
+    found = FindPredecessors(_list, _key, NULL);
+    if( _list->m_tail != found && !_list->m_less(_key, found->m_key) )
+    {
+        found = FORWARD(found)[0];
+    }
+
+    return (SkipListItr)found;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the pair with the smallest key
+ *
+ * @retval  itr 		= Iterator to the first pair OR end iterator if the list is empty
+ * @retval  NULL 		= If the list is uninitialized
+ */
+SkipListItr SkipListItr_Begin(const SkipList* _list)
+{
+    CHECK_NULL(_list);
+
+    return (SkipListItr)FORWARD(_list->m_head)[0];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the end of the list, one after the greatest key
+ *
+ * @retval  itr 		= The end iterator
+ * @retval  NULL 		= If the list is uninitialized
+ */
+SkipListItr SkipListItr_End(const SkipList* _list)
+{
+    CHECK_NULL(_list);
+
+    return (SkipListItr)_list->m_tail;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Compare two iterators
+ *
+ * @retval  1 			= If both iterators point to the same pair
+ * @retval  0 			= Otherwise
+ */
+int SkipListItr_Equals(SkipListItr _a, SkipListItr _b)
+{
+    return (_a == _b);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get iterator to the next pair in key order
+ * @warning if _itr is end iterator it will be returned
+ *
+ * @retval  itr 		= Iterator to the next pair
+ * @retval  NULL 		= If _itr is uninitialized
+ */
+SkipListItr SkipListItr_Next(SkipListItr _itr)
+{
+    CHECK_NULL(_itr);
+
+    return (SkipListItr)FORWARD(_itr)[0];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the key of the pair the iterator point at
+ *
+ * @retval  key 		= The key
+ * @retval  NULL 		= If _itr is the end OR uninitialized
+ */
+void* SkipListItr_GetKey(SkipListItr _itr)
+{
+    CHECK_NULL(_itr);
+
+    return AS_NODE(_itr)->m_key;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the value of the pair the iterator point at
+ *
+ * @retval  value 		= The value
+ * @retval  NULL 		= If _itr is the end OR uninitialized
+ */
+void* SkipListItr_GetValue(SkipListItr _itr)
+{
+    CHECK_NULL(_itr);
+
+    return AS_NODE(_itr)->m_value;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Draw a random height in [1, MAX_LEVEL] with probability 1/4 to grow
+ *
+ * @params  _list           =   The list that hold the generator state
+ *
+ * @returns The height
+ */
+static size_t RandomHeight(SkipList* _list)
+{
+    unsigned long x = _list->m_randState;
+    size_t height = 1;
+
+    /* xorshift32, kept in 32 bits so it behave the same when long is 64 bits */
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    _list->m_randState = x;
+
+    while( 0 == (x & 3) && height < MAX_LEVEL )
+    {
+        ++height;
+        x >>= 2;
+    }
+
+    return height;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node of a given height from the list's pool
+ *
+ * @params  _list           =   The list that own the pool
+ * @params  _height         =   Number of forward pointers of the node
+ *
+ * @returns Node pointer OR NULL on allocation failure
+ */
+static SNode* PoolAlloc(SkipList* _list, size_t _height)
+{
+    SNode* node = _list->m_freeLists[_height - 1];
+    Chunk* newChunk;
+    size_t size = NODE_SIZE(_height);
+
+    if( NULL != node )
+    {
+        _list->m_freeLists[_height - 1] = FORWARD(node)[0];
+        return node;
+    }
+
+    if( NULL == _list->m_bumpNext || (size_t)(_list->m_bumpEnd - _list->m_bumpNext) < size )
+    {
+        newChunk = (Chunk*)malloc(CHUNK_SIZE);
+        CHECK_NULL(newChunk);
+
+        newChunk->m_next = _list->m_chunks;
+        _list->m_chunks = newChunk;
+        _list->m_bumpNext = (char*)(newChunk + 1);
+        _list->m_bumpEnd = (char*)newChunk + CHUNK_SIZE;
+    }
+
+    node = (SNode*)_list->m_bumpNext;
+    _list->m_bumpNext += size;
+    node->m_height = _height;
+
+    return node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Return a node to the free list of it's height
+ *
+ * @params  _list           =   The list that own the pool
+ * @params  _node           =   The node to release
+ *
+ * @returns void
+ */
+static void PoolFree(SkipList* _list, SNode* _node)
+{
+    FORWARD(_node)[0] = _list->m_freeLists[_node->m_height - 1];
+    _list->m_freeLists[_node->m_height - 1] = _node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Find the last node in each level that its key is less then _key
+ *
+ * @params  _list           =   The list to search
+ * @params  _key            =   The key to search for
+ * @params  _update         =   Array of MAX_LEVEL to fill with the nodes, can be NULL
+ *
+ * @returns The first node that its key is not less then _key, might be the tail
+ */
+static SNode* FindPredecessors(const SkipList* _list, void* _key, SNode** _update)
+{
+    SNode* current = _list->m_head;
+    SNode* next;
+    size_t level = _list->m_level;
+
+    while( 0 < level-- )
+    {
+        next = FORWARD(current)[level];
+        while( _list->m_tail != next && _list->m_less(next->m_key, _key) )
+        {
+            current = next;
+            next = FORWARD(current)[level];
+        }
+
+        if( NULL != _update )
+        {
+            _update[level] = current;
+        }
+    }
+
+    return FORWARD(current)[0];
+}
+/*----------------------------------------------------------------------------*/
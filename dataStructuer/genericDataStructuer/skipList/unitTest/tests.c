@@ -0,0 +1,353 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic Skip List ordered map data structure
+ *
+ *  @details 	The API stores pairs of pointers to user provided key and value,
+ *				ordered by the keys using user provided less function.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "skipList.h"	/* header file */
+#include "matan_test.h"	/* def of unit test */
+#include <stdio.h> 		/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand & malloc */
+#include <time.h> 		/* for time_t */
+
+#define SIZE (1000) 		/* SIZE = Num of pairs in each test */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function for int keys
+*/
+static int IntLess(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert keys 0, 2, 4 ... (2 * _nElements - 2) in random order
+ *
+ * @param   list       	= The skip list
+ * @param   keys		= Array of _nElements keys to fill
+ * @param   nElements  	= The number of keys
+ *
+ * @return	Number of successful inserts
+*/
+static size_t InsertEvenKeys(SkipList* _list, int* _keys, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------ SkipList_Create -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Create_CheckNull)
+    ASSERT_THAT( NULL == SkipList_Create(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Create_CheckEmpty)
+    SkipList* list;
+    int result;
+
+    list = SkipList_Create(IntLess);
+    result = (0 == SkipList_Size(list) &&
+              SkipListItr_Equals(SkipListItr_Begin(list), SkipListItr_End(list)));
+
+    SkipList_Destroy(&list, NULL, NULL);
+    ASSERT_THAT( result && NULL == list );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ SkipList_Insert -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Insert_CheckNull)
+    SkipList* list;
+    int key = 1;
+    SkipListResult result;
+
+    list = SkipList_Create(IntLess);
+    result = SkipList_Insert(list, NULL, &key);
+
+    SkipList_Destroy(&list, NULL, NULL);
+    ASSERT_THAT( SKIPLIST_KEY_NULL_ERROR == result );
+    ASSERT_THAT( SKIPLIST_UNINITIALIZED_ERROR == SkipList_Insert(NULL, &key, &key) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Insert_CheckDuplicate)
+    SkipList* list;
+    int key = 1;
+    int sameKey = 1;
+    SkipListResult result[2];
+
+    list = SkipList_Create(IntLess);
+    result[0] = SkipList_Insert(list, &key, &key);
+    result[1] = SkipList_Insert(list, &sameKey, &sameKey);
+
+    ASSERT_THAT( SKIPLIST_SUCCESS == result[0] && SKIPLIST_KEY_DUPLICATE_ERROR == result[1] );
+    ASSERT_THAT( 1 == SkipList_Size(list) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Insert_CheckSortedIteration)
+    SkipList* list;
+    SkipListItr itr;
+    int keys[SIZE];
+    int expected = 0;
+
+    list = SkipList_Create(IntLess);
+    ASSERT_THAT( SIZE == InsertEvenKeys(list, keys, SIZE) );
+
+    for(itr = SkipListItr_Begin(list); !SkipListItr_Equals(itr, SkipListItr_End(list)); itr = SkipListItr_Next(itr))
+    {
+    	ASSERT_THAT( expected == *(int*)SkipListItr_GetKey(itr) );
+    	ASSERT_THAT( SkipListItr_GetKey(itr) == SkipListItr_GetValue(itr) );
+    	expected += 2;
+    }
+
+    ASSERT_THAT( 2 * SIZE == expected && SIZE == SkipList_Size(list) );
+    ASSERT_THAT( NULL == SkipListItr_GetKey(SkipListItr_End(list)) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- SkipList_Find ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Find_CheckAll)
+    SkipList* list;
+    int keys[SIZE];
+    int search;
+    int* value;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+
+    for(search = 0; search < 2 * SIZE; ++search)
+    {
+    	value = NULL;
+    	if( 0 == search % 2 )
+    	{
+    		ASSERT_THAT( SKIPLIST_SUCCESS == SkipList_Find(list, &search, (void**)&value) );
+    		ASSERT_THAT( search == *value );
+    	}
+    	else
+    	{
+    		ASSERT_THAT( SKIPLIST_KEY_NOT_FOUND_ERROR == SkipList_Find(list, &search, (void**)&value) );
+    	}
+    }
+
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ SkipList_Remove -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Remove_CheckNotFound)
+    SkipList* list;
+    int keys[SIZE];
+    int search = 7;
+    SkipListResult result;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+    result = SkipList_Remove(list, &search, NULL, NULL);
+
+    ASSERT_THAT( SKIPLIST_KEY_NOT_FOUND_ERROR == result && SIZE == SkipList_Size(list) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Remove_CheckAllAndReinsert)
+    SkipList* list;
+    int keys[SIZE];
+    int search;
+    int* key;
+    int* value;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+
+    for(search = 0; search < 2 * SIZE; search += 4)
+    {
+    	ASSERT_THAT( SKIPLIST_SUCCESS == SkipList_Remove(list, &search, (void**)&key, (void**)&value) );
+    	ASSERT_THAT( search == *key && key == value );
+    	ASSERT_THAT( SKIPLIST_KEY_NOT_FOUND_ERROR == SkipList_Find(list, &search, NULL) );
+    }
+    ASSERT_THAT( SIZE / 2 == SkipList_Size(list) );
+
+    search = 4;
+    ASSERT_THAT( SKIPLIST_SUCCESS == SkipList_Insert(list, &keys[2], &keys[2]) );
+    ASSERT_THAT( SKIPLIST_SUCCESS == SkipList_Find(list, &search, NULL) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- SkipList_Bounds -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_LowerBound_CheckCorrectPair)
+    SkipList* list;
+    int keys[SIZE];
+    int search = 11;
+    int exact = 12;
+    int tooBig = 2 * SIZE;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+
+    ASSERT_THAT( 12 == *(int*)SkipListItr_GetKey(SkipList_LowerBound(list, &search)) );
+    ASSERT_THAT( 12 == *(int*)SkipListItr_GetKey(SkipList_LowerBound(list, &exact)) );
+    ASSERT_THAT( SkipListItr_Equals(SkipListItr_End(list), SkipList_LowerBound(list, &tooBig)) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_UpperBound_CheckCorrectPair)
+    SkipList* list;
+    int keys[SIZE];
+    int search = 11;
+    int exact = 12;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+
+    ASSERT_THAT( 12 == *(int*)SkipListItr_GetKey(SkipList_UpperBound(list, &search)) );
+    ASSERT_THAT( 14 == *(int*)SkipListItr_GetKey(SkipList_UpperBound(list, &exact)) );
+    ASSERT_THAT( NULL == SkipList_UpperBound(list, NULL) );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(SkipList_Range_CheckCount)
+    SkipList* list;
+    SkipListItr itr;
+    SkipListItr end;
+    int keys[SIZE];
+    int low = 100;
+    int high = 200;
+    size_t counter = 0;
+
+    list = SkipList_Create(IntLess);
+    InsertEvenKeys(list, keys, SIZE);
+
+    end = SkipList_UpperBound(list, &high);
+    for(itr = SkipList_LowerBound(list, &low); !SkipListItr_Equals(itr, end); itr = SkipListItr_Next(itr))
+    {
+    	++counter;
+    }
+
+    ASSERT_THAT( 51 == counter );
+    SkipList_Destroy(&list, NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Skip List Module)
+	PRINT(SkipList_Create_CheckNull)
+	PRINT(SkipList_Create_CheckEmpty)
+
+	PRINT(SkipList_Insert_CheckNull)
+	PRINT(SkipList_Insert_CheckDuplicate)
+	PRINT(SkipList_Insert_CheckSortedIteration)
+
+	PRINT(SkipList_Find_CheckAll)
+
+	PRINT(SkipList_Remove_CheckNotFound)
+	PRINT(SkipList_Remove_CheckAllAndReinsert)
+
+	PRINT(SkipList_LowerBound_CheckCorrectPair)
+	PRINT(SkipList_UpperBound_CheckCorrectPair)
+	PRINT(SkipList_Range_CheckCount)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int IntLess(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t InsertEvenKeys(SkipList* _list, int* _keys, size_t _nElements)
+{
+	size_t* order;
+	size_t i;
+	size_t j;
+	size_t temp;
+	size_t counter = 0;
+
+	order = (size_t*)malloc(_nElements * sizeof(size_t));
+	if( NULL == order )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		_keys[i] = (int)(2 * i);
+		order[i] = i;
+	}
+
+	/* Insert in random order, the keys array stay sorted by index */
+	srand((unsigned)time(NULL));
+	for(i = _nElements; 0 < i; --i)
+	{
+		j = (size_t)rand() % i;
+		temp = order[i - 1];
+		order[i - 1] = order[j];
+		order[j] = temp;
+	}
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( SKIPLIST_SUCCESS == SkipList_Insert(_list, &_keys[order[i]], &_keys[order[i]]) )
+		{
+			++counter;
+		}
+	}
+
+	free(order);
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
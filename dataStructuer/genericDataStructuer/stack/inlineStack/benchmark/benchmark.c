@@ -0,0 +1,237 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic Inline Stack against the Vector based Generic Stack
+ *
+ *  @details 	Measure the time to push all items and pop all of them with the Vector
+ *  			based stack of pointers, and with the inline stack of ints by the
+ *  			checked functions, by the unchecked macros and by the block functions.
+ *  			Last a DFS like loop, pop one and push up to two, for both stacks.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "inlineStack.h"	/* header file */
+#include "stack.h"			/* stack header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & atol & malloc */
+#include <time.h> 			/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of items in each run, can be changed from the command line */
+#define INITIAL_CAPACITY (16)
+#define STACK_BLOCK_SIZE (1024) /* The Vector grows by a fixed block */
+#define CHUNK_SIZE (256) /* Num of items in each PopMany */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push all items to the Vector based stack and pop all, then the DFS loop
+ */
+static void RunStack(int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push all items to the inline stack and pop all, in the 3 ways, then the DFS loop
+ */
+static void RunInlineStack(int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	int* array;
+
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+
+	array = (int*)malloc(nElements * sizeof(int));
+	if( NULL == array )
+	{
+		return 1;
+	}
+
+	for(i = 0; i < nElements; ++i)
+	{
+		array[i] = (int)i;
+	}
+
+	printf("Inline stack benchmark, %lu items:\n", (unsigned long)nElements);
+	RunStack(array, nElements);
+	RunInlineStack(array, nElements);
+
+	free(array);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void RunStack(int* _array, size_t _nElements)
+{
+	Stack* stack;
+	void* value = _array;
+	clock_t start;
+	clock_t pushEnd;
+	clock_t popEnd;
+	clock_t dfsEnd;
+	size_t i;
+	size_t node;
+	size_t nVisited = 0;
+
+	stack = StackCreate(INITIAL_CAPACITY, STACK_BLOCK_SIZE);
+	if( NULL == stack )
+	{
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		StackPush(stack, &_array[i]);
+	}
+	pushEnd = clock();
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		StackPop(stack, &value);
+	}
+	popEnd = clock();
+
+	/* DFS of the implicit binary tree of _nElements nodes, children of n are 2n+1 and 2n+2 */
+	StackPush(stack, &_array[0]);
+	while( STACK_SUCCESS == StackPop(stack, &value) )
+	{
+		node = (size_t)*(int*)value;
+		++nVisited;
+		if( 2 * node + 2 < _nElements )
+		{
+			StackPush(stack, &_array[2 * node + 2]);
+		}
+		if( 2 * node + 1 < _nElements )
+		{
+			StackPush(stack, &_array[2 * node + 1]);
+		}
+	}
+	dfsEnd = clock();
+
+	StackDestroy(&stack, NULL);
+
+	printf("Vector Stack           push: %8.1f ms   pop all: %8.1f ms   DFS %lu: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd), (unsigned long)nVisited, TO_MSEC(popEnd, dfsEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunInlineStack(int* _array, size_t _nElements)
+{
+	InlineStack* stack;
+	int chunk[CHUNK_SIZE];
+	int value;
+	clock_t start;
+	clock_t pushEnd;
+	clock_t popEnd;
+	clock_t dfsEnd;
+	size_t i;
+	size_t node;
+	size_t nVisited = 0;
+
+	stack = InlineStackCreate(sizeof(int), INITIAL_CAPACITY);
+	if( NULL == stack )
+	{
+		return;
+	}
+
+	/* Checked functions */
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		InlineStackPush(stack, &_array[i]);
+	}
+	pushEnd = clock();
+	while( INLINE_STACK_SUCCESS == InlineStackPop(stack, &value) )
+	{
+	}
+	popEnd = clock();
+	printf("Inline Stack functions push: %8.1f ms   pop all: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd));
+
+	/* Unchecked macros, room is reserved once */
+	start = clock();
+	if( INLINE_STACK_SUCCESS == InlineStackReserve(stack, _nElements) )
+	{
+		for(i = 0; i < _nElements; ++i)
+		{
+			INLINE_STACK_PUSH(stack, int, _array[i]);
+		}
+	}
+	pushEnd = clock();
+	while( !INLINE_STACK_IS_EMPTY(stack) )
+	{
+		value = INLINE_STACK_POP(stack, int);
+	}
+	popEnd = clock();
+	printf("Inline Stack macros    push: %8.1f ms   pop all: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd));
+
+	/* Blocks */
+	start = clock();
+	InlineStackPushMany(stack, _array, _nElements);
+	pushEnd = clock();
+	while( 0 < InlineStackPopMany(stack, chunk, CHUNK_SIZE) )
+	{
+	}
+	popEnd = clock();
+
+	/* Same DFS, with the macros, the depth of the stack is at most log(n) + 1 */
+	INLINE_STACK_PUSH(stack, int, 0);
+	while( !INLINE_STACK_IS_EMPTY(stack) && INLINE_STACK_SUCCESS == InlineStackReserve(stack, 2) )
+	{
+		node = (size_t)INLINE_STACK_POP(stack, int);
+		++nVisited;
+		if( 2 * node + 2 < _nElements )
+		{
+			INLINE_STACK_PUSH(stack, int, _array[2 * node + 2]);
+		}
+		if( 2 * node + 1 < _nElements )
+		{
+			INLINE_STACK_PUSH(stack, int, _array[2 * node + 1]);
+		}
+	}
+	dfsEnd = clock();
+
+	InlineStackDestroy(&stack);
+
+	printf("Inline Stack blocks    push: %8.1f ms   pop all: %8.1f ms   DFS %lu: %8.1f ms\n",
+			TO_MSEC(start, pushEnd), TO_MSEC(pushEnd, popEnd), (unsigned long)nVisited, TO_MSEC(popEnd, dfsEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
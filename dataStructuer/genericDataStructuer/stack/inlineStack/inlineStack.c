@@ -0,0 +1,364 @@
+/**
+ *  @file 		inlineStack.c
+ *  @brief 		src file for Generic Inline Stack data type
+ *
+ *  @details 	The elements are copied inline into one array that grows by doubling
+ *				and never shrinks. The checked functions are here, the unchecked
+ *				fast path is the macros of the header.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "inlineStack.h"	/* header file */
+#include <stdlib.h>  		/* size_t &malloc & realloc */
+#include <string.h>  		/* memcpy */
+
+#define MIN_CAPACITY (16)
+#define ELEMENT_AT(stack, index)	( (char*)(stack)->m_items + (index) * (stack)->m_elementSize )
+#define CHECK_STACK_NULL(param)		do{ if(NULL == (param) ) { return INLINE_STACK_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return INLINE_STACK_NULL_ELEMENT_ERROR;}  } while(0)
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Grow the array to fit _minCapacity elements, at least double
+ */
+static InlineStackResult Grow(InlineStack* _stack, size_t _minCapacity);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new stack of elements of _elementSize bytes
+ *
+ * @param 	elementSize				= Size of one element in bytes
+ * @param 	initialCapacity			= Number of elements that can be stored initially
+ *
+ * @return 	The stack pointer
+ * @retval	InlineStack*			= On success
+ * @retval	NULL 					= On allocation failure OR when _elementSize is 0
+ */
+InlineStack* InlineStackCreate(size_t _elementSize, size_t _initialCapacity)
+{
+	InlineStack* stack;
+
+	if( 0 == _elementSize || ((size_t)-1) / _elementSize < _initialCapacity )
+	{
+		return NULL;
+	}
+
+	if( _initialCapacity < MIN_CAPACITY )
+	{
+		_initialCapacity = MIN_CAPACITY;
+	}
+
+	stack = (InlineStack*)malloc( sizeof(InlineStack) );
+	if( NULL == stack )
+	{
+		return NULL;
+	}
+
+	stack->m_items = malloc( _initialCapacity * _elementSize );
+	if( NULL == stack->m_items )
+	{
+		free(stack);
+		return NULL;
+	}
+
+	stack->m_size = 0;
+	stack->m_capacity = _initialCapacity;
+	stack->m_elementSize = _elementSize;
+
+	return stack;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated stack
+ *
+ * @param	stack					= Stack to be deallocated, set to NULL.
+ *
+ * @return void
+ */
+void InlineStackDestroy(InlineStack** _stack)
+{
+	if( NULL == _stack || NULL == *_stack )
+	{
+		return;
+	}
+
+	free((*_stack)->m_items);
+	free(*_stack);
+	*_stack = NULL;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Make sure _nElements more elements can be pushed without a grow
+ * @details After a success INLINE_STACK_PUSH can be used _nElements times.
+ *
+ * @param	stack							= Stack to use.
+ * @param	nElements						= Number of elements to make room for
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure, the stack is not changed
+ */
+InlineStackResult InlineStackReserve(InlineStack* _stack, size_t _nElements)
+{
+	CHECK_STACK_NULL(_stack);
+
+	if( _stack->m_capacity - _stack->m_size < _nElements )
+	{
+		if( (size_t)-1 - _stack->m_size < _nElements )
+		{
+			return INLINE_STACK_ALLOCATION_ERROR;
+		}
+		return Grow(_stack, _stack->m_size + _nElements);
+	}
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push a copy of the element at _element
+ * @Complexity	O(1) amortized
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address of the element to copy
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure
+ */
+InlineStackResult InlineStackPush(InlineStack* _stack, const void* _element)
+{
+	CHECK_STACK_NULL(_stack);
+	CHECK_ELEMENT_NULL(_element);
+
+	if( _stack->m_size == _stack->m_capacity && INLINE_STACK_SUCCESS != Grow(_stack, _stack->m_size + 1) )
+	{
+		return INLINE_STACK_ALLOCATION_ERROR;
+	}
+
+	memcpy(ELEMENT_AT(_stack, _stack->m_size), _element, _stack->m_elementSize);
+	++_stack->m_size;
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop the top element and copy it to _element
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address to copy the element to (may be NULL if unnecessary)
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_UNDERFLOW_ERROR 		= When the stack is empty
+ */
+InlineStackResult InlineStackPop(InlineStack* _stack, void* _element)
+{
+	CHECK_STACK_NULL(_stack);
+	if( 0 == _stack->m_size )
+	{
+		return INLINE_STACK_UNDERFLOW_ERROR;
+	}
+
+	--_stack->m_size;
+	if( NULL != _element )
+	{
+		memcpy(_element, ELEMENT_AT(_stack, _stack->m_size), _stack->m_elementSize);
+	}
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Copy the top element to _element without removing it
+ *
+ * @param	stack							= Stack to use.
+ * @param	element							= Address to copy the element to
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	INLINE_STACK_UNDERFLOW_ERROR 		= When the stack is empty
+ */
+InlineStackResult InlineStackTop(const InlineStack* _stack, void* _element)
+{
+	CHECK_STACK_NULL(_stack);
+	CHECK_ELEMENT_NULL(_element);
+	if( 0 == _stack->m_size )
+	{
+		return INLINE_STACK_UNDERFLOW_ERROR;
+	}
+
+	memcpy(_element, ELEMENT_AT(_stack, _stack->m_size - 1), _stack->m_elementSize);
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push _nElements elements from the array _elements, _elements[0] first
+ * @details One grow (at most) and one copy for all the elements.
+ *
+ * @param	stack							= Stack to use.
+ * @param	elements						= Array of _nElements elements
+ * @param	nElements						= Number of elements to push
+ *
+ * @return	Status InlineStackResult that indicate in which state the function ended:
+ *
+ * @retval 	INLINE_STACK_SUCCESS				= On success
+ * @retval 	INLINE_STACK_UNINITIALIZED_ERROR 	= When stack is uninitialized
+ * @retval 	INLINE_STACK_NULL_ELEMENT_ERROR 	= When elements is NULL
+ * @retval 	INLINE_STACK_ALLOCATION_ERROR 		= On allocation failure, nothing is pushed
+ */
+InlineStackResult InlineStackPushMany(InlineStack* _stack, const void* _elements, size_t _nElements)
+{
+	InlineStackResult result;
+
+	CHECK_STACK_NULL(_stack);
+	CHECK_ELEMENT_NULL(_elements);
+
+	result = InlineStackReserve(_stack, _nElements);
+	if( INLINE_STACK_SUCCESS != result )
+	{
+		return result;
+	}
+
+	memcpy(ELEMENT_AT(_stack, _stack->m_size), _elements, _nElements * _stack->m_elementSize);
+	_stack->m_size += _nElements;
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop up to _maxElements elements to the array _elements
+ * @details The elements are copied in the order they were pushed, the last
+ *			popped (the deepest) is _elements[0] and the old top is the last one,
+ *			so InlineStackPushMany of the result restores the stack.
+ *
+ * @param	stack			= Stack to use.
+ * @param	elements		= Array of _maxElements elements to copy to
+ * @param	maxElements		= Max number of elements to pop
+ *
+ * @returns Number of popped elements, min(_maxElements, size) (0 on NULL arguments)
+ */
+size_t InlineStackPopMany(InlineStack* _stack, void* _elements, size_t _maxElements)
+{
+	size_t nElements;
+
+	if( NULL == _stack || NULL == _elements )
+	{
+		return 0;
+	}
+
+	nElements = (_maxElements < _stack->m_size) ? _maxElements : _stack->m_size;
+	_stack->m_size -= nElements;
+	memcpy(_elements, ELEMENT_AT(_stack, _stack->m_size), nElements * _stack->m_elementSize);
+
+	return nElements;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of elements in the stack.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the stack is empty OR pointer is uninitialized
+ */
+size_t InlineStackSize(const InlineStack* _stack)
+{
+	if( NULL == _stack )
+	{
+		return 0;
+	}
+
+	return _stack->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Grow the array to fit _minCapacity elements, at least double
+ */
+static InlineStackResult Grow(InlineStack* _stack, size_t _minCapacity)
+{
+	void* newItems;
+	size_t newCapacity = _stack->m_capacity * 2;
+
+	if( newCapacity < _minCapacity || newCapacity < _stack->m_capacity )
+	{
+		newCapacity = _minCapacity;
+	}
+
+	/* The size in bytes must not overflow */
+	if( ((size_t)-1) / _stack->m_elementSize < newCapacity )
+	{
+		return INLINE_STACK_ALLOCATION_ERROR;
+	}
+
+	newItems = realloc(_stack->m_items, newCapacity * _stack->m_elementSize);
+	if( NULL == newItems )
+	{
+		return INLINE_STACK_ALLOCATION_ERROR;
+	}
+
+	_stack->m_items = newItems;
+	_stack->m_capacity = newCapacity;
+
+	return INLINE_STACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
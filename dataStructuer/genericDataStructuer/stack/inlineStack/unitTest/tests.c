@@ -0,0 +1,230 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic Inline Stack data structure
+ *
+ *  @details 	The stack stores copies of fixed size elements, checked by the
+ * 				functions and unchecked by the macros.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "inlineStack.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t */
+
+#define SIZE (1000) /* SIZE = Num of elements in each test, more then the initial capacity */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+/* Element bigger then a pointer, like a DFS frame */
+typedef struct Frame
+{
+	size_t m_node;
+	size_t m_nextEdge;
+	double m_cost;
+} Frame;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*----------------------------- InlineStackCreate ----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackCreate_CheckNull)
+    InlineStack* stack;
+
+    ASSERT_THAT( NULL == InlineStackCreate(0, 10) );
+    ASSERT_THAT( NULL == InlineStackCreate(sizeof(Frame), (size_t)-1) );
+
+    stack = InlineStackCreate(sizeof(int), 0);
+    ASSERT_THAT( NULL != stack && 0 == InlineStackSize(stack) && INLINE_STACK_IS_EMPTY(stack) );
+    InlineStackDestroy(&stack);
+    ASSERT_THAT( NULL == stack );
+    InlineStackDestroy(&stack);
+    InlineStackDestroy(NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ InlineStackPush -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackPush_CheckNull)
+    InlineStack* stack;
+    int item = 1;
+
+    stack = InlineStackCreate(sizeof(int), 1);
+    ASSERT_THAT( INLINE_STACK_UNINITIALIZED_ERROR == InlineStackPush(NULL, &item) );
+    ASSERT_THAT( INLINE_STACK_NULL_ELEMENT_ERROR == InlineStackPush(stack, NULL) );
+    ASSERT_THAT( INLINE_STACK_UNINITIALIZED_ERROR == InlineStackReserve(NULL, 1) );
+    ASSERT_THAT( INLINE_STACK_ALLOCATION_ERROR == InlineStackReserve(stack, (size_t)-1) );
+    ASSERT_THAT( 0 == InlineStackSize(stack) && 0 == InlineStackSize(NULL) );
+    InlineStackDestroy(&stack);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackPush_CheckCase_FramesCopied)
+    InlineStack* stack;
+    Frame frame;
+    size_t i;
+    int result = 1;
+
+    stack = InlineStackCreate(sizeof(Frame), 1);
+
+    /* The stack keeps copies, the local frame is changed after every push */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	frame.m_node = i;
+    	frame.m_nextEdge = i * 2;
+    	frame.m_cost = (double)i / 2;
+    	result = result && ( INLINE_STACK_SUCCESS == InlineStackPush(stack, &frame) );
+    }
+
+    result = result && ( SIZE == InlineStackSize(stack) );
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackTop(stack, &frame) && SIZE - 1 == frame.m_node );
+
+    for(i = SIZE; 0 < i; --i)
+    {
+    	result = result && ( INLINE_STACK_SUCCESS == InlineStackPop(stack, &frame) );
+    	result = result && ( i - 1 == frame.m_node && (i - 1) * 2 == frame.m_nextEdge && (double)(i - 1) / 2 == frame.m_cost );
+    }
+
+    InlineStackDestroy(&stack);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ InlineStackPop ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackPop_CheckUnderflow)
+    InlineStack* stack;
+    int item = 5;
+
+    stack = InlineStackCreate(sizeof(int), 1);
+    ASSERT_THAT( INLINE_STACK_UNDERFLOW_ERROR == InlineStackPop(stack, &item) );
+    ASSERT_THAT( INLINE_STACK_UNDERFLOW_ERROR == InlineStackTop(stack, &item) );
+    ASSERT_THAT( INLINE_STACK_UNINITIALIZED_ERROR == InlineStackPop(NULL, &item) );
+
+    InlineStackPush(stack, &item);
+    ASSERT_THAT( INLINE_STACK_NULL_ELEMENT_ERROR == InlineStackTop(stack, NULL) );
+    ASSERT_THAT( INLINE_STACK_SUCCESS == InlineStackPop(stack, NULL) && 0 == InlineStackSize(stack) );
+    InlineStackDestroy(&stack);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- The macros --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackMacros_CheckCase_ReserveThenPush)
+    InlineStack* stack;
+    int i;
+    int sum = 0;
+    int result;
+
+    stack = InlineStackCreate(sizeof(int), 1);
+    result = ( INLINE_STACK_SUCCESS == InlineStackReserve(stack, SIZE) );
+    result = result && ( SIZE <= stack->m_capacity );
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	INLINE_STACK_PUSH(stack, int, i);
+    }
+
+    /* The top is an lvalue */
+    result = result && ( SIZE - 1 == INLINE_STACK_TOP(stack, int) );
+    INLINE_STACK_TOP(stack, int) = 0;
+    result = result && ( INLINE_STACK_HAS_ROOM(stack) == (SIZE < stack->m_capacity) );
+
+    while( !INLINE_STACK_IS_EMPTY(stack) )
+    {
+    	sum += INLINE_STACK_POP(stack, int);
+    }
+
+    /* 0 + 1 + ... + (SIZE - 2), the last one was set to 0 */
+    result = result && ( (SIZE - 1) * (SIZE - 2) / 2 == sum );
+    InlineStackDestroy(&stack);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- InlineStackPushMany ---------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(InlineStackPushMany_CheckCase_RoundTrip)
+    InlineStack* stack;
+    int array[SIZE];
+    int popped[SIZE];
+    int item = 0;
+    size_t i;
+    int result;
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	array[i] = (int)i;
+    }
+
+    stack = InlineStackCreate(sizeof(int), 1);
+    result = ( INLINE_STACK_NULL_ELEMENT_ERROR == InlineStackPushMany(stack, NULL, 1) );
+    result = result && ( INLINE_STACK_UNINITIALIZED_ERROR == InlineStackPushMany(NULL, array, 1) );
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackPushMany(stack, array, 0) );
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackPushMany(stack, array, SIZE / 2) );
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackPushMany(stack, array + SIZE / 2, SIZE - SIZE / 2) );
+
+    /* Same as push one by one */
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackTop(stack, &item) && SIZE - 1 == item );
+
+    /* Pop the top 10 and push them back */
+    result = result && ( 10 == InlineStackPopMany(stack, popped, 10) && SIZE - 10 == InlineStackSize(stack) );
+    for(i = 0; i < 10; ++i)
+    {
+    	result = result && ( array[SIZE - 10 + i] == popped[i] );
+    }
+    result = result && ( INLINE_STACK_SUCCESS == InlineStackPushMany(stack, popped, 10) );
+
+    /* Pop more then there are */
+    result = result && ( SIZE == InlineStackPopMany(stack, popped, SIZE + 1) ) ;
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( array[i] == popped[i] );
+    }
+
+    result = result && ( 0 == InlineStackPopMany(stack, popped, 1) && 0 == InlineStackPopMany(NULL, popped, 1) );
+    InlineStackDestroy(&stack);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Inline Stack Module)
+	PRINT(InlineStackCreate_CheckNull)
+
+	PRINT(InlineStackPush_CheckNull)
+	PRINT(InlineStackPush_CheckCase_FramesCopied)
+
+	PRINT(InlineStackPop_CheckUnderflow)
+
+	PRINT(InlineStackMacros_CheckCase_ReserveThenPush)
+
+	PRINT(InlineStackPushMany_CheckCase_RoundTrip)
+END_SET
+/*----------------------------------------------------------------------------*/
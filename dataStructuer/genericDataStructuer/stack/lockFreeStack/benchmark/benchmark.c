@@ -0,0 +1,286 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Contention benchmark for Generic lock free stack against the Vector
+ *  			based Generic Stack guarded by a mutex
+ *
+ *  @details 	For 1, 2, 4 ... threads, every thread pushes an element and pops one
+ *  			OPS_PER_THREAD times on the same stack (the way a shared free list is used),
+ *  			a few elements are in the stack from the start.
+ *  			Once in POP_ALL_EVERY rounds a thread drains the stack with pop all and
+ *  			pushes the elements back.
+ *  			The total push and pop pairs per second of all threads is printed for both stacks.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "lockFreeStack.h"	/* lock free stack header */
+#include "stack.h"			/* stack header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & atol & malloc */
+#include <time.h> 			/* for clock_gettime */
+#include <pthread.h> 		/* for pthread API */
+
+#define DEFAULT_MAX_THREADS (32)	/* Most threads, can be changed from the command line */
+#define OPS_PER_THREAD (1000000)	/* Num of push and pop pairs each thread does */
+#define N_PREFILLED (16)			/* Num of elements in the stack from the start */
+#define POP_ALL_EVERY (4096)		/* A thread pops all once in POP_ALL_EVERY rounds */
+#define MAX_POPPED (4096)			/* More then all the elements that can be in the stack */
+#define STACK_BLOCK_SIZE (1024) 	/* The Vector grows by a fixed block */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Shared
+{
+	LFStack* m_lfStack;
+	Stack* m_stack;
+	pthread_mutex_t m_lock;		/* Guards m_stack */
+	int* m_items;				/* One item for every thread and the prefilled items */
+} Shared;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct ThreadArgs
+{
+	Shared* m_shared;
+	size_t m_id;
+	void** m_popped;			/* Thread own buffer for the drained elements */
+	size_t m_nPopped;
+} ThreadArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Save the element in the thread buffer (the context), action of LFStack_PopAll
+ */
+static void SaveAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Thread of the lock free stack, OPS_PER_THREAD push and pop pairs
+ */
+static void* LFStackWorker(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Thread of the Vector based stack, OPS_PER_THREAD push and pop pairs under the mutex
+ */
+static void* StackWorker(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Run _nThreads workers, return the push and pop pairs per second in millions
+ */
+static double RunThreads(Shared* _shared, size_t _nThreads, void* (*_worker)(void*));
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	Shared shared;
+	size_t maxThreads = DEFAULT_MAX_THREADS;
+	size_t nThreads;
+	size_t i;
+
+	if( 1 < argc )
+	{
+		maxThreads = (size_t)atol(argv[1]);
+	}
+
+	shared.m_items = (int*)malloc((maxThreads + N_PREFILLED) * sizeof(int));
+	shared.m_lfStack = LFStack_Create(maxThreads + N_PREFILLED);
+	shared.m_stack = StackCreate(maxThreads + N_PREFILLED, STACK_BLOCK_SIZE);
+	if( NULL == shared.m_items || NULL == shared.m_lfStack || NULL == shared.m_stack ||
+		MAX_POPPED < maxThreads + N_PREFILLED || 0 != pthread_mutex_init(&shared.m_lock, NULL) )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	for(i = 0; i < N_PREFILLED; ++i)
+	{
+		shared.m_items[maxThreads + i] = (int)i;
+		LFStack_Push(shared.m_lfStack, &shared.m_items[maxThreads + i]);
+		StackPush(shared.m_stack, &shared.m_items[maxThreads + i]);
+	}
+
+	printf("%d push and pop pairs per thread, pop all every %d\n", OPS_PER_THREAD, POP_ALL_EVERY);
+	printf("threads    lock free stack (M pairs/sec)    stack + mutex (M pairs/sec)\n");
+
+	for(nThreads = 1; nThreads <= maxThreads; nThreads *= 2)
+	{
+		printf("%7lu    %29.2f    %27.2f\n", (unsigned long)nThreads,
+				RunThreads(&shared, nThreads, LFStackWorker),
+				RunThreads(&shared, nThreads, StackWorker));
+	}
+
+	LFStack_Destroy(&shared.m_lfStack, NULL);
+	StackDestroy(&shared.m_stack, NULL);
+	pthread_mutex_destroy(&shared.m_lock);
+	free(shared.m_items);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void SaveAction(void* _element, void* _context)
+{
+	ThreadArgs* args = (ThreadArgs*)_context;
+
+	args->m_popped[args->m_nPopped++] = _element;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* LFStackWorker(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	LFStack* stack = args->m_shared->m_lfStack;
+	void* value = &args->m_shared->m_items[args->m_id];
+	size_t i;
+	size_t j;
+
+	for(i = 1; i <= OPS_PER_THREAD; ++i)
+	{
+		LFStack_Push(stack, value);
+		LFStack_Pop(stack, &value);
+
+		if( 0 == i % POP_ALL_EVERY )
+		{
+			args->m_nPopped = 0;
+			LFStack_PopAll(stack, SaveAction, args);
+			for(j = 0; j < args->m_nPopped; ++j)
+			{
+				LFStack_Push(stack, args->m_popped[j]);
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* StackWorker(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	Shared* shared = args->m_shared;
+	void* value = &shared->m_items[args->m_id];
+	size_t i;
+	size_t j;
+
+	for(i = 1; i <= OPS_PER_THREAD; ++i)
+	{
+		pthread_mutex_lock(&shared->m_lock);
+		StackPush(shared->m_stack, value);
+		pthread_mutex_unlock(&shared->m_lock);
+
+		pthread_mutex_lock(&shared->m_lock);
+		StackPop(shared->m_stack, &value);
+		pthread_mutex_unlock(&shared->m_lock);
+
+		if( 0 == i % POP_ALL_EVERY )
+		{
+			args->m_nPopped = 0;
+			pthread_mutex_lock(&shared->m_lock);
+			while( STACK_SUCCESS == StackPop(shared->m_stack, &args->m_popped[args->m_nPopped]) )
+			{
+				++args->m_nPopped;
+			}
+			pthread_mutex_unlock(&shared->m_lock);
+
+			for(j = 0; j < args->m_nPopped; ++j)
+			{
+				pthread_mutex_lock(&shared->m_lock);
+				StackPush(shared->m_stack, args->m_popped[j]);
+				pthread_mutex_unlock(&shared->m_lock);
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static double RunThreads(Shared* _shared, size_t _nThreads, void* (*_worker)(void*))
+{
+	pthread_t* threads;
+	ThreadArgs* args;
+	void** popped;
+	struct timespec start;
+	struct timespec end;
+	double seconds;
+	size_t i;
+
+	threads = (pthread_t*)malloc(_nThreads * sizeof(pthread_t));
+	args = (ThreadArgs*)malloc(_nThreads * sizeof(ThreadArgs));
+	popped = (void**)malloc(_nThreads * MAX_POPPED * sizeof(void*));
+	if( NULL == threads || NULL == args || NULL == popped )
+	{
+		free(threads);
+		free(args);
+		free(popped);
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i = 0; i < _nThreads; ++i)
+	{
+		args[i].m_shared = _shared;
+		args[i].m_id = i;
+		args[i].m_popped = popped + i * MAX_POPPED;
+		args[i].m_nPopped = 0;
+		pthread_create(&threads[i], NULL, _worker, &args[i]);
+	}
+	for(i = 0; i < _nThreads; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	free(threads);
+	free(args);
+	free(popped);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	return (double)_nThreads * OPS_PER_THREAD / seconds / 1e6;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,386 @@
+/**
+ *  @file 		lockFreeStack.c
+ *  @brief 		src file for Generic lock free stack data type
+ *
+ *  @details 	Treiber stack over an array of nodes that is allocated on create.
+ *  			Two lists are kept in the array: the stack and the list of the free nodes,
+ *  			both are changed by the same lock free push and pop.
+ *  			A list head is one size_t word, the low half is the index of the first node
+ *  			(NIL for an empty list) and the high half is a tag that is incremented on
+ *  			every change, so one compare and swap of a word replaces the
+ *  			{pointer, counter} pair of the classic solution to ABA.
+ *  			The two heads are on different cache lines.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "lockFreeStack.h"	/* header file */
+#include <stdlib.h> 		/* for size_t, NULL, malloc, free */
+#include <limits.h> 		/* for CHAR_BIT */
+
+#define MAGIC_NUMBER (0xDEAFBEEF)
+#define CACHE_LINE (64)
+#define HALF_BITS 		( sizeof(size_t) * CHAR_BIT / 2 )
+#define INDEX_MASK 		( ((size_t)1 << HALF_BITS) - 1 )
+#define NIL 			INDEX_MASK			/* Index of no node, so capacity is less then NIL */
+#define TAG_ONE 		( (size_t)1 << HALF_BITS )
+#define INDEX(head)		( (head) & INDEX_MASK )
+#define MAKE_HEAD(old, index)	( (((old) & ~INDEX_MASK) + TAG_ONE) | (index) )
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_STACK_NULL(param)		do{ if(NULL == (param) ) { return LFSTACK_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ELEMENT_NULL(param)	do{ if(NULL == (param) ) { return LFSTACK_NULL_ELEMENT_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Node Node;
+typedef struct Head Head;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Node
+{
+	void* m_element;	/* Written only by the thread that owns the node */
+	size_t m_next;		/* Index of the next node, read by threads that may lose the race */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* One cache line for every list head, pushers and poppers hammer it */
+struct Head
+{
+	size_t m_head;		/* Tag in the high half, index of the first node in the low half */
+	char m_pad[CACHE_LINE - sizeof(size_t)];
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct LFStack
+{
+	Head m_top;				/* The stack */
+	Head m_free;			/* The free nodes */
+	Node* m_nodes;			/* m_capacity nodes */
+	size_t m_capacity;
+	size_t m_magicNumber;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Pop the first node of the list at _head
+ * @return 	Index of the popped node OR NIL if the list is empty
+ */
+static size_t PopNode(Node* _nodes, size_t* _head);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push the chain of nodes _first ... _last (linked by m_next) to the list at _head
+ */
+static void PushChain(Node* _nodes, size_t* _head, size_t _first, size_t _last);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new lock free stack of fixed capacity
+ *
+ * @param 	capacity				= Max number of elements in the stack
+ *
+ * @return 	The stack pointer
+ * @retval	LFStack*				= On success
+ * @retval	NULL 					= On allocation failure OR when _capacity is 0 OR too big
+ */
+LFStack* LFStack_Create(size_t _capacity)
+{
+	LFStack* stack;
+	size_t i;
+
+	if( 0 == _capacity || NIL <= _capacity || (size_t)-1 / sizeof(Node) < _capacity )
+	{
+		return NULL;
+	}
+
+	stack = (LFStack*)malloc(sizeof(LFStack));
+	CHECK_NULL(stack);
+
+	stack->m_nodes = (Node*)malloc(_capacity * sizeof(Node));
+	if( NULL == stack->m_nodes )
+	{
+		free(stack);
+		return NULL;
+	}
+
+	/* All the nodes are free, linked in order */
+	for(i = 0; i < _capacity; ++i)
+	{
+		stack->m_nodes[i].m_element = NULL;
+		stack->m_nodes[i].m_next = i + 1;
+	}
+	stack->m_nodes[_capacity - 1].m_next = NIL;
+
+	stack->m_top.m_head = NIL;
+	stack->m_free.m_head = 0;
+	stack->m_capacity = _capacity;
+	stack->m_magicNumber = MAGIC_NUMBER;
+
+	return stack;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated stack
+ *
+ * @param	stack					= Stack to be deallocated, set to NULL.
+ * @params	elementDestroy 			= A function pointer to be used to destroy all
+ * 									elements in the stack OR a null if no such destroy is required
+ *
+ * @return void
+ *
+ * @warning No other thread may use the stack while it is destroyed
+ */
+void LFStack_Destroy(LFStack** _stack, void (*_elementDestroy)(void* _element))
+{
+	size_t index;
+
+	if( NULL == _stack || NULL == *_stack || MAGIC_NUMBER != (*_stack)->m_magicNumber )
+	{
+		return;
+	}
+
+	if( NULL != _elementDestroy )
+	{
+		for(index = INDEX((*_stack)->m_top.m_head); NIL != index; index = (*_stack)->m_nodes[index].m_next)
+		{
+			_elementDestroy((*_stack)->m_nodes[index].m_element);
+		}
+	}
+
+	(*_stack)->m_magicNumber = 0;
+	free((*_stack)->m_nodes);
+	free(*_stack);
+	*_stack = NULL;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Push an element to the top of the stack, thread safe and lock free
+ * @Complexity	O(1), retried on every lost race
+ *
+ * @param	stack						= Stack to use.
+ * @param	element						= Element to push.
+ *
+ * @return	Status LFStackResult that indicate in which state the function ended:
+ *
+ * @retval 	LFSTACK_SUCCESS				= On success
+ * @retval 	LFSTACK_UNINITIALIZED_ERROR = When stack is uninitialized
+ * @retval 	LFSTACK_NULL_ELEMENT_ERROR 	= When element is NULL
+ * @retval 	LFSTACK_OVERFLOW_ERROR 		= When the stack holds capacity elements
+ */
+LFStackResult LFStack_Push(LFStack* _stack, void* _element)
+{
+	size_t index;
+
+	CHECK_STACK_NULL(_stack);
+	CHECK_ELEMENT_NULL(_element);
+
+	index = PopNode(_stack->m_nodes, &_stack->m_free.m_head);
+	if( NIL == index )
+	{
+		return LFSTACK_OVERFLOW_ERROR;
+	}
+
+	/* The node is ours until the push below publishes it */
+	_stack->m_nodes[index].m_element = _element;
+	PushChain(_stack->m_nodes, &_stack->m_top.m_head, index, index);
+
+	return LFSTACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop the element at the top of the stack, thread safe and lock free
+ * @Complexity	O(1), retried on every lost race
+ *
+ * @param	stack						= Stack to use.
+ * @param	pElement					= Pointer to variable that will receive the popped element
+ *
+ * @return	Status LFStackResult that indicate in which state the function ended:
+ *
+ * @retval 	LFSTACK_SUCCESS				= On success
+ * @retval 	LFSTACK_UNINITIALIZED_ERROR = When stack is uninitialized
+ * @retval 	LFSTACK_NULL_ELEMENT_ERROR 	= When pElement is NULL
+ * @retval 	LFSTACK_UNDERFLOW_ERROR 	= When the stack is empty
+ */
+LFStackResult LFStack_Pop(LFStack* _stack, void** _pElement)
+{
+	size_t index;
+
+	CHECK_STACK_NULL(_stack);
+	CHECK_ELEMENT_NULL(_pElement);
+
+	index = PopNode(_stack->m_nodes, &_stack->m_top.m_head);
+	if( NIL == index )
+	{
+		return LFSTACK_UNDERFLOW_ERROR;
+	}
+
+	*_pElement = _stack->m_nodes[index].m_element;
+	PushChain(_stack->m_nodes, &_stack->m_free.m_head, index, index);
+
+	return LFSTACK_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Pop all the elements of the stack at once, thread safe and lock free
+ * @details All the elements are detached with one compare and swap, then _action
+ * 			is called for every element from the top down, after that the nodes are
+ * 			returned with one more compare and swap.
+ * 			Elements pushed by other threads after the detach stay in the stack.
+ *
+ * @param	stack			= Stack to use.
+ * @param	action			= Function called for every popped element (may be NULL)
+ * @param	context			= Context passed to _action
+ *
+ * @returns Number of popped elements (0 if the stack is empty OR uninitialized)
+ */
+size_t LFStack_PopAll(LFStack* _stack, LFStackElementAction _action, void* _context)
+{
+	size_t old;
+	size_t first;
+	size_t last = NIL;
+	size_t index;
+	size_t count = 0;
+
+	if( NULL == _stack )
+	{
+		return 0;
+	}
+
+	old = __atomic_load_n(&_stack->m_top.m_head, __ATOMIC_ACQUIRE);
+	do
+	{
+		if( NIL == INDEX(old) )
+		{
+			return 0;
+		}
+	}
+	while( !__atomic_compare_exchange_n(&_stack->m_top.m_head, &old, MAKE_HEAD(old, NIL), 1,
+										__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) );
+
+	/* The detached chain is ours now */
+	first = INDEX(old);
+	for(index = first; NIL != index; index = __atomic_load_n(&_stack->m_nodes[index].m_next, __ATOMIC_RELAXED))
+	{
+		if( NULL != _action )
+		{
+			_action(_stack->m_nodes[index].m_element, _context);
+		}
+		last = index;
+		++count;
+	}
+
+	PushChain(_stack->m_nodes, &_stack->m_free.m_head, first, last);
+
+	return count;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Check if the stack is empty, a snapshot that other threads may change
+ *
+ * @retval	1 				= If the stack is empty OR pointer is uninitialized
+ * @retval	0 				= Otherwise
+ */
+int LFStack_IsEmpty(const LFStack* _stack)
+{
+	if( NULL == _stack )
+	{
+		return 1;
+	}
+
+	return NIL == INDEX(__atomic_load_n(&_stack->m_top.m_head, __ATOMIC_ACQUIRE));
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static size_t PopNode(Node* _nodes, size_t* _head)
+{
+	size_t old;
+	size_t next;
+
+	old = __atomic_load_n(_head, __ATOMIC_ACQUIRE);
+	do
+	{
+		if( NIL == INDEX(old) )
+		{
+			return NIL;
+		}
+
+		/* The node may be popped and pushed again by now, then next is stale but the tag
+		 * changed too and the swap fails. The node is never freed, so the read is safe */
+		next = __atomic_load_n(&_nodes[INDEX(old)].m_next, __ATOMIC_RELAXED);
+	}
+	while( !__atomic_compare_exchange_n(_head, &old, MAKE_HEAD(old, next), 1,
+										__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) );
+
+	return INDEX(old);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void PushChain(Node* _nodes, size_t* _head, size_t _first, size_t _last)
+{
+	size_t old;
+
+	old = __atomic_load_n(_head, __ATOMIC_RELAXED);
+	do
+	{
+		__atomic_store_n(&_nodes[_last].m_next, INDEX(old), __ATOMIC_RELAXED);
+	}
+	while( !__atomic_compare_exchange_n(_head, &old, MAKE_HEAD(old, _first), 1,
+										__ATOMIC_RELEASE, __ATOMIC_RELAXED) );
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,385 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic lock free stack data structure
+ *
+ *  @details 	The API stores pointers to user elements, many threads push and pop
+ *  			at the same time without locks.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "lockFreeStack.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h> 			/* for printf */
+#include <stdlib.h> 		/* for size_t */
+#include <pthread.h> 		/* for pthread API */
+
+#define SIZE (1000) 		/* SIZE = Num of elements in each test */
+#define N_THREADS (8) 		/* Num of threads in the concurrent tests */
+#define N_ROUNDS (50000) 	/* Num of pop and push back each thread does */
+#define N_SHARED (4) 		/* Num of elements the threads fight over, few to make ABA likely */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct ThreadArgs
+{
+	LFStack* m_stack;
+	int* m_items;			/* The pushers push SIZE / N_THREADS items each */
+	size_t* m_counters;		/* The drainer counts every item it took */
+	size_t m_id;
+	size_t m_count;			/* Elements taken by the thread */
+	int m_failed;
+} ThreadArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Count every element in an array of SIZE counters (the context), by the item value
+*/
+static void CountAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Pop an element, change it, check it and push it back N_ROUNDS times (free list use)
+*/
+static void* PopPushBack(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Push SIZE / N_THREADS items
+*/
+static void* Pusher(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Drain the stack with pop all until all the items are taken (the count is shared)
+*/
+static void* Drainer(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------ LFStack_Create ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_Create_CheckNull)
+    LFStack* stack;
+
+    ASSERT_THAT( NULL == LFStack_Create(0) );
+    ASSERT_THAT( NULL == LFStack_Create((size_t)-1) );
+
+    stack = LFStack_Create(1);
+    ASSERT_THAT( NULL != stack && LFStack_IsEmpty(stack) && LFStack_IsEmpty(NULL) );
+    LFStack_Destroy(&stack, NULL);
+    ASSERT_THAT( NULL == stack );
+    LFStack_Destroy(&stack, NULL);
+    LFStack_Destroy(NULL, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- LFStack_Push -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_Push_CheckNullAndOverflow)
+    LFStack* stack;
+    int item = 1;
+
+    stack = LFStack_Create(2);
+    ASSERT_THAT( LFSTACK_UNINITIALIZED_ERROR == LFStack_Push(NULL, &item) );
+    ASSERT_THAT( LFSTACK_NULL_ELEMENT_ERROR == LFStack_Push(stack, NULL) );
+    ASSERT_THAT( LFSTACK_SUCCESS == LFStack_Push(stack, &item) );
+    ASSERT_THAT( LFSTACK_SUCCESS == LFStack_Push(stack, &item) );
+    ASSERT_THAT( LFSTACK_OVERFLOW_ERROR == LFStack_Push(stack, &item) );
+    ASSERT_THAT( !LFStack_IsEmpty(stack) );
+    LFStack_Destroy(&stack, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- LFStack_Pop -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_Pop_CheckLIFOAndUnderflow)
+    LFStack* stack;
+    int items[SIZE];
+    void* value = NULL;
+    size_t i;
+    int round;
+    int result = 1;
+
+    stack = LFStack_Create(SIZE);
+    ASSERT_THAT( LFSTACK_UNDERFLOW_ERROR == LFStack_Pop(stack, &value) );
+    ASSERT_THAT( LFSTACK_UNINITIALIZED_ERROR == LFStack_Pop(NULL, &value) );
+    ASSERT_THAT( LFSTACK_NULL_ELEMENT_ERROR == LFStack_Pop(stack, NULL) );
+
+    /* Twice, the second time on recycled nodes */
+    for(round = 0; round < 2; ++round)
+    {
+    	for(i = 0; i < SIZE; ++i)
+    	{
+    		result = result && ( LFSTACK_SUCCESS == LFStack_Push(stack, &items[i]) );
+    	}
+    	for(i = SIZE; 0 < i; --i)
+    	{
+    		result = result && ( LFSTACK_SUCCESS == LFStack_Pop(stack, &value) && &items[i - 1] == value );
+    	}
+    }
+
+    ASSERT_THAT( result && LFStack_IsEmpty(stack) );
+    LFStack_Destroy(&stack, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ LFStack_PopAll ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_PopAll_CheckAllAndReuse)
+    LFStack* stack;
+    int items[SIZE];
+    size_t counters[SIZE] = {0};
+    size_t i;
+    int result = 1;
+
+    stack = LFStack_Create(SIZE);
+    result = ( 0 == LFStack_PopAll(stack, CountAction, counters) && 0 == LFStack_PopAll(NULL, NULL, NULL) );
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	items[i] = (int)i;
+    	result = result && ( LFSTACK_SUCCESS == LFStack_Push(stack, &items[i]) );
+    }
+
+    result = result && ( SIZE == LFStack_PopAll(stack, CountAction, counters) && LFStack_IsEmpty(stack) );
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( 1 == counters[i] );
+    }
+
+    /* All the nodes are free again */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( LFSTACK_SUCCESS == LFStack_Push(stack, &items[i]) );
+    }
+    result = result && ( LFSTACK_OVERFLOW_ERROR == LFStack_Push(stack, &items[0]) );
+    result = result && ( SIZE == LFStack_PopAll(stack, NULL, NULL) );
+
+    ASSERT_THAT( result );
+    LFStack_Destroy(&stack, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ Concurrent use ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_Concurrent_CheckFreeListNoLoss)
+    LFStack* stack;
+    int items[N_SHARED];
+    size_t counters[N_SHARED] = {0};
+    pthread_t threads[N_THREADS];
+    ThreadArgs args[N_THREADS];
+    size_t i;
+    int result = 1;
+
+    stack = LFStack_Create(SIZE);
+    for(i = 0; i < N_SHARED; ++i)
+    {
+    	items[i] = (int)i;
+    	LFStack_Push(stack, &items[i]);
+    }
+
+    for(i = 0; i < N_THREADS; ++i)
+    {
+    	args[i].m_stack = stack;
+    	args[i].m_id = i;
+    	args[i].m_failed = 0;
+    	ASSERT_THAT( 0 == pthread_create(&threads[i], NULL, PopPushBack, &args[i]) );
+    }
+    for(i = 0; i < N_THREADS; ++i)
+    {
+    	pthread_join(threads[i], NULL);
+    	result = result && !args[i].m_failed;
+    }
+
+    /* Every item is in the stack exactly once */
+    result = result && ( N_SHARED == LFStack_PopAll(stack, CountAction, counters) );
+    for(i = 0; i < N_SHARED; ++i)
+    {
+    	result = result && ( 1 == counters[i] );
+    }
+
+    ASSERT_THAT( result );
+    LFStack_Destroy(&stack, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(LFStack_Concurrent_CheckPushWhilePopAll)
+    LFStack* stack;
+    int items[SIZE];
+    size_t counters[SIZE] = {0};
+    pthread_t pushers[N_THREADS];
+    pthread_t drainer;
+    ThreadArgs args[N_THREADS];
+    ThreadArgs drainerArgs;
+    size_t i;
+    int result = 1;
+
+    stack = LFStack_Create(SIZE);
+    for(i = 0; i < SIZE; ++i)
+    {
+    	items[i] = (int)i;
+    }
+
+    drainerArgs.m_stack = stack;
+    drainerArgs.m_counters = counters;
+    drainerArgs.m_count = 0;
+    ASSERT_THAT( 0 == pthread_create(&drainer, NULL, Drainer, &drainerArgs) );
+
+    for(i = 0; i < N_THREADS; ++i)
+    {
+    	args[i].m_stack = stack;
+    	args[i].m_items = items;
+    	args[i].m_id = i;
+    	args[i].m_failed = 0;
+    	ASSERT_THAT( 0 == pthread_create(&pushers[i], NULL, Pusher, &args[i]) );
+    }
+    for(i = 0; i < N_THREADS; ++i)
+    {
+    	pthread_join(pushers[i], NULL);
+    	result = result && !args[i].m_failed;
+    }
+    pthread_join(drainer, NULL);
+
+    /* Every pushed item was drained exactly once */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	result = result && ( (i < SIZE / N_THREADS * N_THREADS) == counters[i] );
+    }
+
+    ASSERT_THAT( result && LFStack_IsEmpty(stack) );
+    LFStack_Destroy(&stack, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Lock Free Stack Module)
+	PRINT(LFStack_Create_CheckNull)
+
+	PRINT(LFStack_Push_CheckNullAndOverflow)
+
+	PRINT(LFStack_Pop_CheckLIFOAndUnderflow)
+
+	PRINT(LFStack_PopAll_CheckAllAndReuse)
+
+	PRINT(LFStack_Concurrent_CheckFreeListNoLoss)
+	PRINT(LFStack_Concurrent_CheckPushWhilePopAll)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void CountAction(void* _element, void* _context)
+{
+	++((size_t*)_context)[*(int*)_element];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* PopPushBack(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	void* value;
+	int item;
+	size_t i;
+
+	for(i = 0; i < N_ROUNDS; ++i)
+	{
+		if( LFSTACK_SUCCESS != LFStack_Pop(args->m_stack, &value) )
+		{
+			continue;
+		}
+
+		/* The element is owned by this thread only, no one else may change it */
+		item = *(int*)value;
+		*(int*)value = -1 - (int)args->m_id;
+		if( -1 - (int)args->m_id != *(int*)value )
+		{
+			args->m_failed = 1;
+		}
+		*(int*)value = item;
+
+		if( LFSTACK_SUCCESS != LFStack_Push(args->m_stack, value) )
+		{
+			args->m_failed = 1;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Pusher(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+	size_t i;
+
+	for(i = args->m_id; i < SIZE / N_THREADS * N_THREADS; i += N_THREADS)
+	{
+		if( LFSTACK_SUCCESS != LFStack_Push(args->m_stack, &args->m_items[i]) )
+		{
+			args->m_failed = 1;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Drainer(void* _args)
+{
+	ThreadArgs* args = (ThreadArgs*)_args;
+
+	while( args->m_count < SIZE / N_THREADS * N_THREADS )
+	{
+		args->m_count += LFStack_PopAll(args->m_stack, CountAction, args->m_counters);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
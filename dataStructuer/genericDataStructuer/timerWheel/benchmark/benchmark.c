@@ -0,0 +1,205 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic hierarchical Timer Wheel against Generic indexed Priority Queue
+ *
+ *  @details 	Measure the time to add random timeouts, cancel half of them (like
+ *  			connections that answered in time) and expire the rest, for the timer
+ *  			wheel and for a priority queue of deadlines.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "timerWheel.h"		/* header file */
+#include "priorityQueue.h"	/* priority queue header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand & malloc */
+#include <time.h> 			/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of timers in each run, can be changed from the command line */
+#define MAX_DELAY (60000) /* Max timeout in ticks, e.g a minute of milliseconds */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a deadline < _b deadline
+ */
+static int CompareDeadline(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Add all the timers to the wheel, cancel every other and advance until all expired
+ */
+static void RunTimerWheel(size_t* _delays, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert all the deadlines to the queue, remove every other and pop all
+ */
+static void RunPQueue(size_t* _delays, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	size_t* delays;
+
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+
+	delays = (size_t*)malloc(nElements * sizeof(size_t));
+	if( NULL == delays )
+	{
+		return 1;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < nElements; ++i)
+	{
+		delays[i] = (size_t)(rand() % MAX_DELAY) + 1;
+	}
+
+	printf("Timer wheel benchmark, %lu random timeouts up to %d ticks:\n", (unsigned long)nElements, MAX_DELAY);
+	RunPQueue(delays, nElements);
+	RunTimerWheel(delays, nElements);
+
+	free(delays);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareDeadline(void* _a, void* _b)
+{
+	return ( *(size_t*)_a  < *(size_t*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunTimerWheel(size_t* _delays, size_t _nElements)
+{
+	TimerWheel* wheel;
+	TimerHandle* timers;
+	clock_t start;
+	clock_t addEnd;
+	clock_t cancelEnd;
+	clock_t expireEnd;
+	size_t nExpired;
+	size_t i;
+
+	wheel = TimerWheel_Create();
+	timers = (TimerHandle*)malloc(_nElements * sizeof(TimerHandle));
+	if( NULL == wheel || NULL == timers )
+	{
+		TimerWheel_Destroy(&wheel, NULL);
+		free(timers);
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		TimerWheel_Add(wheel, _delays[i], &_delays[i], &timers[i]);
+	}
+	addEnd = clock();
+
+	for(i = 0; i < _nElements; i += 2)
+	{
+		TimerWheel_Cancel(wheel, timers[i], NULL);
+	}
+	cancelEnd = clock();
+
+	nExpired = TimerWheel_Advance(wheel, MAX_DELAY, NULL, NULL);
+	expireEnd = clock();
+
+	TimerWheel_Destroy(&wheel, NULL);
+	free(timers);
+
+	printf("Timer Wheel   add: %8.1f ms   cancel n/2: %8.1f ms   expire %lu: %8.1f ms\n",
+			TO_MSEC(start, addEnd), TO_MSEC(addEnd, cancelEnd), (unsigned long)nExpired, TO_MSEC(cancelEnd, expireEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunPQueue(size_t* _delays, size_t _nElements)
+{
+	PQueue* pQueue;
+	PQueueHandle** handles;
+	void* value = NULL;
+	clock_t start;
+	clock_t addEnd;
+	clock_t cancelEnd;
+	clock_t expireEnd;
+	size_t nExpired = 0;
+	size_t i;
+
+	/* The deadlines are the delays, all added at time 0 */
+	pQueue = PQueue_Create(CompareDeadline, _nElements);
+	handles = (PQueueHandle**)malloc(_nElements * sizeof(PQueueHandle*));
+	if( NULL == pQueue || NULL == handles )
+	{
+		PQueue_Destroy(&pQueue, NULL);
+		free(handles);
+		return;
+	}
+
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		PQueue_Insert(pQueue, &_delays[i], &handles[i]);
+	}
+	addEnd = clock();
+
+	for(i = 0; i < _nElements; i += 2)
+	{
+		PQueue_Remove(pQueue, handles[i], NULL);
+	}
+	cancelEnd = clock();
+
+	while( PQUEUE_SUCCESS == PQueue_Pop(pQueue, &value) )
+	{
+		++nExpired;
+	}
+	expireEnd = clock();
+
+	PQueue_Destroy(&pQueue, NULL);
+	free(handles);
+
+	printf("4-ary PQueue  add: %8.1f ms   cancel n/2: %8.1f ms   expire %lu: %8.1f ms\n",
+			TO_MSEC(start, addEnd), TO_MSEC(addEnd, cancelEnd), (unsigned long)nExpired, TO_MSEC(cancelEnd, expireEnd));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,488 @@
+/**
+ *  @file 		timerWheel.c
+ *  @brief 		src file for Generic hierarchical Timer Wheel data type
+ *
+ *  @details 	Implemented as 4 levels of 256 slots (like the classic kernel timer wheel).
+ * 				A timer that is d ticks from the next tick is on level 0 if d < 2^8,
+ * 				on level 1 if d < 2^16, on level 2 if d < 2^24 and on level 3 otherwise,
+ * 				in the slot of the matching byte of it's deadline.
+ * 				When level 0 wraps to slot 0 the current slot of level 1 is moved down
+ * 				(cascade), and the same for the upper levels.
+ * 				Every slot is an intrusive list of timer nodes, a canceled node is
+ * 				unlinked in O(1) without knowing it's slot.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "timerWheel.h"		/* header file */
+#include "intrusiveList.h"	/* intrusive list header */
+#include <stdlib.h>  		/* size_t &malloc */
+
+#define LEVEL_BITS (8)
+#define N_SLOTS (1 << LEVEL_BITS)
+#define SLOT_MASK ((size_t)N_SLOTS - 1)
+#define N_LEVELS (4)
+#define MAX_DISTANCE ((size_t)0xFFFFFFFFUL)	/* 2^(LEVEL_BITS * N_LEVELS) - 1 */
+#define SLOT_OF(expires, level)		( ((expires) >> (LEVEL_BITS * (level))) & SLOT_MASK )
+#define CHECK_WHEEL_NULL(param)		do{ if(NULL == (param) ) { return TIMER_WHEEL_UNINITIALIZED_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+struct Timer
+{
+    ILink m_link; 				/* On a slot while pending, on the free list after */
+    size_t m_expires; 			/* The tick to expire on */
+    void* m_element;
+    TimerWheel* m_wheel; 		/* The wheel that allocated the node */
+    size_t m_generation; 		/* Bumped when the timer is released, old handles stop matching */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct TimerWheel
+{
+    IList m_slots[N_LEVELS][N_SLOTS];
+    IList m_free; 				/* Timer nodes to reuse */
+    size_t m_now; 				/* The last tick that expired */
+    size_t m_nTimers; 			/* Number of pending timers */
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Put _timer on the slot of it's deadline, a past deadline goes to the next tick
+ */
+static void Place(TimerWheel* _wheel, Timer* _timer);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Take all the timers of the slot _index of _level and place them again
+ */
+static void Cascade(TimerWheel* _wheel, int _level, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Free all the timer nodes on _list, destroy their elements if _elementDestroy is not NULL
+ */
+static void FreeTimers(IList* _list, void (*_elementDestroy)(void* _item));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Put the unlinked _timer on the free list, the handles of it stop matching
+ */
+static void Release(TimerWheel* _wheel, Timer* _timer);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically create a new timer wheel, the time starts at 0
+ *
+ * @return 	The wheel pointer
+ * @retval	TimerWheel*				= On success
+ * @retval	NULL 					= On allocation failure
+ */
+TimerWheel* TimerWheel_Create(void)
+{
+	TimerWheel* wheel;
+	int level;
+	size_t index;
+
+	wheel = (TimerWheel*)malloc( sizeof(TimerWheel) );
+	if( NULL == wheel )
+	{
+		return NULL;
+	}
+
+	for(level = 0; level < N_LEVELS; ++level)
+	{
+		for(index = 0; index < N_SLOTS; ++index)
+		{
+			IListInit(&wheel->m_slots[level][index]);
+		}
+	}
+	IListInit(&wheel->m_free);
+
+	wheel->m_now = 0;
+	wheel->m_nTimers = 0;
+
+	return wheel;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Dynamically deallocate a previously allocated wheel, pending timers do not expire
+ *
+ * @param	wheel					= Wheel to be deallocated, set to NULL.
+ * @params	elementDestroy			= A function pointer to be used to destroy all pending
+ *								  elements or a null if no such destroy is required
+ *
+ * @return void
+ */
+void TimerWheel_Destroy(TimerWheel** _wheel, void (*_elementDestroy)(void* _item))
+{
+	int level;
+	size_t index;
+
+	if( NULL == _wheel || NULL == *_wheel )
+	{
+		return;
+	}
+
+	for(level = 0; level < N_LEVELS; ++level)
+	{
+		for(index = 0; index < N_SLOTS; ++index)
+		{
+			FreeTimers(&(*_wheel)->m_slots[level][index], _elementDestroy);
+		}
+	}
+	FreeTimers(&(*_wheel)->m_free, NULL);
+
+	free(*_wheel);
+	*_wheel = NULL;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Add an element that expires _delay ticks from now
+ * @details A delay of 0 expires on the next tick, like a delay of 1.
+ *			Delays longer then 2^32 ticks are supported, they are kept on the top
+ *			level until they get closer.
+ * @Complexity	O(1) amortized
+ *
+ * @param	wheel						= Wheel to use.
+ * @param	delay						= Ticks from now to the deadline
+ * @param	element						= Element to add.
+ * @param	handle						= Set to the handle of the timer (may be NULL if unnecessary)
+ *
+ * @return	Status TimerWheelResult that indicate in which state the function ended:
+ *
+ * @retval 	TIMER_WHEEL_SUCCESS				= On success
+ * @retval 	TIMER_WHEEL_UNINITIALIZED_ERROR = When wheel is uninitialized
+ * @retval 	TIMER_WHEEL_NULL_ELEMENT_ERROR 	= When element is uninitialized
+ * @retval 	TIMER_WHEEL_ALLOCATION_ERROR 	= On allocation failure
+ */
+TimerWheelResult TimerWheel_Add(TimerWheel* _wheel, size_t _delay, void* _element, TimerHandle* _handle)
+{
+	ILink* link;
+	Timer* timer;
+
+	CHECK_WHEEL_NULL(_wheel);
+	if( NULL == _element )
+	{
+		return TIMER_WHEEL_NULL_ELEMENT_ERROR;
+	}
+
+	link = IListPopHead(&_wheel->m_free);
+	if( NULL != link )
+	{
+		timer = ILIST_ENTRY(link, Timer, m_link);
+	}
+	else
+	{
+		timer = (Timer*)malloc( sizeof(Timer) );
+		if( NULL == timer )
+		{
+			return TIMER_WHEEL_ALLOCATION_ERROR;
+		}
+		ILinkInit(&timer->m_link);
+		timer->m_wheel = _wheel;
+		timer->m_generation = 0;
+	}
+
+	timer->m_expires = _wheel->m_now + _delay;
+	timer->m_element = _element;
+	Place(_wheel, timer);
+	++_wheel->m_nTimers;
+
+	if( NULL != _handle )
+	{
+		_handle->m_timer = timer;
+		_handle->m_generation = timer->m_generation;
+	}
+
+	return TIMER_WHEEL_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Cancel a pending timer, the action is not called for it
+ * @details Canceling a timer that already expired OR was canceled is safe, the
+ *			handle does not match the node any more and nothing is changed.
+ * @Complexity	O(1)
+ *
+ * @param	wheel						= Wheel to use.
+ * @param	handle						= Handle set by TimerWheel_Add
+ * @param	pElement					= Set to the element of the timer (may be NULL if unnecessary)
+ *
+ * @return	Status TimerWheelResult that indicate in which state the function ended:
+ *
+ * @retval 	TIMER_WHEEL_SUCCESS				= On success
+ * @retval 	TIMER_WHEEL_UNINITIALIZED_ERROR = When wheel is uninitialized
+ * @retval 	TIMER_WHEEL_HANDLE_ERROR 		= When the handle is NULL, expired, canceled OR of another wheel
+ */
+TimerWheelResult TimerWheel_Cancel(TimerWheel* _wheel, TimerHandle _handle, void** _pElement)
+{
+	Timer* timer = _handle.m_timer;
+
+	CHECK_WHEEL_NULL(_wheel);
+	if( NULL == timer || _wheel != timer->m_wheel || _handle.m_generation != timer->m_generation )
+	{
+		return TIMER_WHEEL_HANDLE_ERROR;
+	}
+
+	if( NULL != _pElement )
+	{
+		*_pElement = timer->m_element;
+	}
+
+	IListRemove(&timer->m_link);
+	Release(_wheel, timer);
+
+	return TIMER_WHEEL_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Move the time _ticks forward and expire the due timers
+ * @details The timers of each tick are taken from the wheel together in one list
+ *			and then _action is called for each of them, ticks are expired in order.
+ *			_action may add and cancel timers, a timer added with delay 0 expires
+ *			on the next tick.
+ * @Complexity	O(_ticks + expired) amortized, O(1) if the wheel is empty
+ *
+ * @param	wheel			= Wheel to use.
+ * @param	ticks			= Number of ticks to move
+ * @param	action			= Function to call for every expired element (may be NULL)
+ * @param	context			= User provided context, will be sent to _action
+ *
+ * @returns Number of expired timers
+ */
+size_t TimerWheel_Advance(TimerWheel* _wheel, size_t _ticks, TimerExpireFunction _action, void* _context)
+{
+	IList expired;
+	IList* slot;
+	ILink* link;
+	Timer* timer;
+	size_t tick;
+	size_t index;
+	size_t counter = 0;
+	int level;
+
+	if( NULL == _wheel )
+	{
+		return 0;
+	}
+
+	IListInit(&expired);
+
+	for(; 0 < _ticks; --_ticks)
+	{
+		/* Nothing to expire OR cascade, the slots are the same for any time */
+		if( 0 == _wheel->m_nTimers )
+		{
+			_wheel->m_now += _ticks;
+			break;
+		}
+
+		tick = _wheel->m_now + 1;
+		index = tick & SLOT_MASK;
+
+		/* On a wrap move the current slot of the level above down, up to the first level that did not wrap */
+		for(level = 1; 0 == index && level < N_LEVELS; ++level)
+		{
+			index = SLOT_OF(tick, level);
+			Cascade(_wheel, level, index);
+		}
+
+		slot = &_wheel->m_slots[0][tick & SLOT_MASK];
+		IList_Splice(IListEnd(&expired), IListBegin(slot), IListEnd(slot));
+		_wheel->m_now = tick;
+
+		while( NULL != (link = IListPopHead(&expired)) )
+		{
+			timer = ILIST_ENTRY(link, Timer, m_link);
+			Release(_wheel, timer);
+			++counter;
+
+			if( NULL != _action )
+			{
+				_action(timer->m_element, _context);
+			}
+		}
+	}
+
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the number of pending timers.
+ *
+ * @retval	number			= On success
+ * @retval	0 				= If the wheel is empty OR pointer is uninitialized
+ */
+size_t TimerWheel_Size(const TimerWheel* _wheel)
+{
+	if( NULL == _wheel )
+	{
+		return 0;
+	}
+
+	return _wheel->m_nTimers;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Get the current time of the wheel, in ticks.
+ *
+ * @retval	now				= On success
+ * @retval	0 				= If pointer is uninitialized
+ */
+size_t TimerWheel_Now(const TimerWheel* _wheel)
+{
+	if( NULL == _wheel )
+	{
+		return 0;
+	}
+
+	return _wheel->m_now;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/* Put _timer on the slot of it's deadline, a past deadline goes to the next tick
+ */
+static void Place(TimerWheel* _wheel, Timer* _timer)
+{
+	size_t next = _wheel->m_now + 1;
+	size_t distance;
+	size_t expires;
+	int level;
+
+	if( _timer->m_expires < next )
+	{
+		_timer->m_expires = next;
+	}
+
+	/* A far deadline is placed as if it is MAX_DISTANCE away, the cascade places it again */
+	distance = _timer->m_expires - next;
+	if( MAX_DISTANCE < distance )
+	{
+		distance = MAX_DISTANCE;
+	}
+	expires = next + distance;
+
+	for(level = 0; level < N_LEVELS - 1; ++level)
+	{
+		if( distance < ((size_t)1 << (LEVEL_BITS * (level + 1))) )
+		{
+			break;
+		}
+	}
+
+	IListPushTail(&_wheel->m_slots[level][SLOT_OF(expires, level)], &_timer->m_link);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Take all the timers of the slot _index of _level and place them again
+ */
+static void Cascade(TimerWheel* _wheel, int _level, size_t _index)
+{
+	IList moved;
+	IList* slot = &_wheel->m_slots[_level][_index];
+	ILink* link;
+
+	IListInit(&moved);
+	IList_Splice(IListEnd(&moved), IListBegin(slot), IListEnd(slot));
+
+	while( NULL != (link = IListPopHead(&moved)) )
+	{
+		Place(_wheel, ILIST_ENTRY(link, Timer, m_link));
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Free all the timer nodes on _list, destroy their elements if _elementDestroy is not NULL
+ */
+static void FreeTimers(IList* _list, void (*_elementDestroy)(void* _item))
+{
+	ILink* link;
+	Timer* timer;
+
+	while( NULL != (link = IListPopHead(_list)) )
+	{
+		timer = ILIST_ENTRY(link, Timer, m_link);
+		if( NULL != _elementDestroy )
+		{
+			_elementDestroy(timer->m_element);
+		}
+		free(timer);
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Put the unlinked _timer on the free list, the handles of it stop matching
+ */
+static void Release(TimerWheel* _wheel, Timer* _timer)
+{
+	++_timer->m_generation;
+	IListPushHead(&_wheel->m_free, &_timer->m_link);
+	--_wheel->m_nTimers;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
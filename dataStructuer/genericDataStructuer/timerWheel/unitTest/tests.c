@@ -0,0 +1,427 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic hierarchical Timer Wheel data structure
+ *
+ *  @details 	The API stores pointer to user provided elements of generic type,
+ * 				every element expires after it's delay, OR it can be canceled with it's handle.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+
+#include "timerWheel.h"		/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+
+#define SIZE (1000) /* SIZE = Num of elements in each test */
+#define MAX_RAND_DELAY (100000) /* MAX_RAND_DELAY = The max delay of the random timers, over 2 levels */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+/* Element of the tests, remember the tick it must expire on and the tick it did */
+typedef struct Item
+{
+	size_t m_deadline;
+	size_t m_expired;
+} Item;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Context of the re-add action */
+typedef struct ReAdd
+{
+	TimerWheel* m_wheel;
+	size_t m_nTimes; 			/* Number of adds left */
+} ReAdd;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Set the expire time of the Item _element to the time of the wheel _context
+ */
+static void MarkExpired(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Add the Item _element again with delay 0, while there are adds left in the ReAdd _context
+ */
+static void AddAgain(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Add a timer for every item with _delays[i], set the deadline of the item
+ *
+ * @return	1 if all the adds succeeded, 0 otherwise
+ */
+static int AddItems(TimerWheel* _wheel, Item* _items, const size_t* _delays, TimerHandle* _timers, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check every item expired on it's deadline
+ *
+ * @return	1 if all items are right, 0 otherwise
+ */
+static int CheckExpired(const Item* _items, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*----------------------------- TimerWheel_Create ----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Create_CheckNull)
+    TimerWheel* wheel;
+
+    wheel = TimerWheel_Create();
+    ASSERT_THAT( NULL != wheel && 0 == TimerWheel_Size(wheel) && 0 == TimerWheel_Now(wheel) );
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( NULL == wheel );
+    TimerWheel_Destroy(&wheel, NULL);
+    TimerWheel_Destroy(NULL, NULL);
+    ASSERT_THAT( 0 == TimerWheel_Size(NULL) && 0 == TimerWheel_Advance(NULL, 1, NULL, NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ TimerWheel_Add ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Add_CheckNull)
+    TimerWheel* wheel;
+    Item item;
+
+    wheel = TimerWheel_Create();
+    ASSERT_THAT( TIMER_WHEEL_UNINITIALIZED_ERROR == TimerWheel_Add(NULL, 1, &item, NULL) );
+    ASSERT_THAT( TIMER_WHEEL_NULL_ELEMENT_ERROR == TimerWheel_Add(wheel, 1, NULL, NULL) );
+    ASSERT_THAT( TIMER_WHEEL_SUCCESS == TimerWheel_Add(wheel, 1, &item, NULL) && 1 == TimerWheel_Size(wheel) );
+    TimerWheel_Destroy(&wheel, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Add_CheckCase_ExactTick)
+    TimerWheel* wheel;
+    Item items[3];
+    size_t delays[3] = {0, 1, 10};
+    int result;
+
+    wheel = TimerWheel_Create();
+    result = AddItems(wheel, items, delays, NULL, 3);
+    items[0].m_deadline = 1; /* delay 0 is the next tick */
+
+    /* Nothing before the deadline, then exactly on it */
+    result = result && ( 2 == TimerWheel_Advance(wheel, 1, MarkExpired, wheel) );
+    result = result && ( 0 == TimerWheel_Advance(wheel, 8, MarkExpired, wheel) );
+    result = result && ( 1 == TimerWheel_Advance(wheel, 1, MarkExpired, wheel) );
+    result = result && ( 0 == TimerWheel_Size(wheel) && 10 == TimerWheel_Now(wheel) );
+    result = result && CheckExpired(items, 3);
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Add_CheckCase_AllLevels)
+    TimerWheel* wheel;
+    Item items[6];
+    size_t delays[6] = {255, 256, 300, 65536 + 7, 70000, (1UL << 24) + 5};
+    int result;
+
+    wheel = TimerWheel_Create();
+
+    /* Start from a time that is not on a slot border */
+    TimerWheel_Advance(wheel, 1000, NULL, NULL);
+    result = AddItems(wheel, items, delays, NULL, 6);
+    result = result && ( 6 == TimerWheel_Advance(wheel, (1UL << 24) + 5, MarkExpired, wheel) );
+    result = result && CheckExpired(items, 6);
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Add_CheckCase_RandDelays)
+    TimerWheel* wheel;
+    Item items[SIZE];
+    size_t delays[SIZE];
+    size_t i;
+    int result;
+
+    srand((unsigned)time(NULL));
+    for(i = 0; i < SIZE; ++i)
+    {
+    	delays[i] = (size_t)(rand() % MAX_RAND_DELAY);
+    }
+
+    wheel = TimerWheel_Create();
+    result = AddItems(wheel, items, delays, NULL, SIZE);
+
+    /* Advance in uneven steps */
+    while( 0 < TimerWheel_Size(wheel) )
+    {
+    	TimerWheel_Advance(wheel, (size_t)(rand() % 1000), MarkExpired, wheel);
+    }
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	if( 0 == delays[i] )
+    	{
+    		++items[i].m_deadline;
+    	}
+    }
+    result = result && CheckExpired(items, SIZE);
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------- TimerWheel_Cancel ----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Cancel_CheckHandleError)
+    TimerWheel* wheel;
+    TimerHandle timer;
+    TimerHandle nullTimer = {NULL, 0};
+    Item item;
+    void* value = NULL;
+
+    wheel = TimerWheel_Create();
+    TimerWheel_Add(wheel, 5, &item, &timer);
+    ASSERT_THAT( TIMER_WHEEL_UNINITIALIZED_ERROR == TimerWheel_Cancel(NULL, timer, &value) );
+    ASSERT_THAT( TIMER_WHEEL_HANDLE_ERROR == TimerWheel_Cancel(wheel, nullTimer, &value) );
+    ASSERT_THAT( TIMER_WHEEL_SUCCESS == TimerWheel_Cancel(wheel, timer, &value) && &item == value );
+    ASSERT_THAT( TIMER_WHEEL_HANDLE_ERROR == TimerWheel_Cancel(wheel, timer, &value) );
+    ASSERT_THAT( 0 == TimerWheel_Size(wheel) && 0 == TimerWheel_Advance(wheel, 10, NULL, NULL) );
+    TimerWheel_Destroy(&wheel, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Cancel_CheckCase_EveryThird)
+    TimerWheel* wheel;
+    Item items[SIZE];
+    size_t delays[SIZE];
+    TimerHandle timers[SIZE];
+    size_t i;
+    size_t nExpired;
+    int result;
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	delays[i] = i * 97 + 1;
+    }
+
+    wheel = TimerWheel_Create();
+    result = AddItems(wheel, items, delays, timers, SIZE);
+
+    for(i = 0; i < SIZE; i += 3)
+    {
+    	result = result && ( TIMER_WHEEL_SUCCESS == TimerWheel_Cancel(wheel, timers[i], NULL) );
+    }
+
+    nExpired = TimerWheel_Advance(wheel, SIZE * 97, MarkExpired, wheel);
+    result = result && ( SIZE - (SIZE + 2) / 3 == nExpired );
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	if( 0 == i % 3 )
+    	{
+    		result = result && ( 0 == items[i].m_expired );
+    		items[i].m_expired = items[i].m_deadline;
+    	}
+    }
+    result = result && CheckExpired(items, SIZE);
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Cancel_CheckCase_ExpiredHandleOfReusedNode)
+    TimerWheel* wheel;
+    TimerHandle expired;
+    TimerHandle pending;
+    Item first;
+    Item second;
+    void* value = NULL;
+    int result;
+
+    /* The node of the expired timer is reused by the next add */
+    wheel = TimerWheel_Create();
+    TimerWheel_Add(wheel, 1, &first, &expired);
+    result = ( 1 == TimerWheel_Advance(wheel, 1, NULL, NULL) );
+    TimerWheel_Add(wheel, 100, &second, &pending);
+    result = result && ( expired.m_timer == pending.m_timer );
+
+    /* The late cancel of the expired timer must not cancel the new one */
+    result = result && ( TIMER_WHEEL_HANDLE_ERROR == TimerWheel_Cancel(wheel, expired, &value) && NULL == value );
+    result = result && ( 1 == TimerWheel_Size(wheel) );
+    result = result && ( TIMER_WHEEL_SUCCESS == TimerWheel_Cancel(wheel, pending, &value) && &second == value );
+    result = result && ( 0 == TimerWheel_Size(wheel) );
+
+    TimerWheel_Destroy(&wheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Cancel_CheckHandleError_OtherWheel)
+    TimerWheel* wheel;
+    TimerWheel* otherWheel;
+    TimerHandle timer;
+    Item item;
+    int result;
+
+    wheel = TimerWheel_Create();
+    otherWheel = TimerWheel_Create();
+    TimerWheel_Add(wheel, 5, &item, &timer);
+    TimerWheel_Add(otherWheel, 5, &item, NULL);
+
+    result = ( TIMER_WHEEL_HANDLE_ERROR == TimerWheel_Cancel(otherWheel, timer, NULL) );
+    result = result && ( 1 == TimerWheel_Size(wheel) && 1 == TimerWheel_Size(otherWheel) );
+    result = result && ( TIMER_WHEEL_SUCCESS == TimerWheel_Cancel(wheel, timer, NULL) );
+
+    TimerWheel_Destroy(&wheel, NULL);
+    TimerWheel_Destroy(&otherWheel, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- TimerWheel_Advance ----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(TimerWheel_Advance_CheckCase_AddFromAction)
+    TimerWheel* wheel;
+    ReAdd context;
+    Item item;
+    size_t nExpired;
+
+    wheel = TimerWheel_Create();
+    context.m_wheel = wheel;
+    context.m_nTimes = 5;
+    TimerWheel_Add(wheel, 0, &item, NULL);
+
+    /* Every add from the action expires on the next tick, one per tick */
+    nExpired = TimerWheel_Advance(wheel, 3, AddAgain, &context);
+    ASSERT_THAT( 3 == nExpired && 1 == TimerWheel_Size(wheel) );
+    nExpired = TimerWheel_Advance(wheel, 10, AddAgain, &context);
+    ASSERT_THAT( 3 == nExpired && 0 == TimerWheel_Size(wheel) && 13 == TimerWheel_Now(wheel) );
+    TimerWheel_Destroy(&wheel, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Hierarchical Timer Wheel Module)
+	PRINT(TimerWheel_Create_CheckNull)
+
+	PRINT(TimerWheel_Add_CheckNull)
+	PRINT(TimerWheel_Add_CheckCase_ExactTick)
+	PRINT(TimerWheel_Add_CheckCase_AllLevels)
+	PRINT(TimerWheel_Add_CheckCase_RandDelays)
+
+	PRINT(TimerWheel_Cancel_CheckHandleError)
+	PRINT(TimerWheel_Cancel_CheckCase_EveryThird)
+	PRINT(TimerWheel_Cancel_CheckCase_ExpiredHandleOfReusedNode)
+	PRINT(TimerWheel_Cancel_CheckHandleError_OtherWheel)
+
+	PRINT(TimerWheel_Advance_CheckCase_AddFromAction)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static void MarkExpired(void* _element, void* _context)
+{
+	((Item*)_element)->m_expired = TimerWheel_Now((TimerWheel*)_context);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void AddAgain(void* _element, void* _context)
+{
+	ReAdd* context = (ReAdd*)_context;
+
+	if( 0 < context->m_nTimes )
+	{
+		--context->m_nTimes;
+		TimerWheel_Add(context->m_wheel, 0, _element, NULL);
+	}
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int AddItems(TimerWheel* _wheel, Item* _items, const size_t* _delays, TimerHandle* _timers, size_t _nElements)
+{
+	size_t i;
+	int result = 1;
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		_items[i].m_deadline = TimerWheel_Now(_wheel) + _delays[i];
+		_items[i].m_expired = 0;
+		result = result && ( TIMER_WHEEL_SUCCESS == TimerWheel_Add(_wheel, _delays[i], &_items[i],
+												(NULL == _timers) ? NULL : &_timers[i]) );
+	}
+
+	return result;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CheckExpired(const Item* _items, size_t _nElements)
+{
+	size_t i;
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( _items[i].m_deadline != _items[i].m_expired )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,1472 @@
+/**
+ *  @file 		bPlusTree.c
+ *  @brief 		src file for Generic B+ Tree data type
+ *
+ *  @details 	Implement an ordered set ADT of user items as a B+ tree.
+ *  			Every node is 512 bytes (8 cache lines) so one node holds tens of
+ *  			items, and a search touch only a few nodes instead of a node per level.
+ *  			All the items are kept in the leaves, the leaves are linked in order
+ *  			so in order walk and range scans move over contiguous arrays.
+ *  			Inner node key i is the smallest item of child i + 1.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "bPlusTree.h"	/* header file */
+#include <stdlib.h> 	/* for size_t, NULL, malloc, free */
+#include <string.h> 	/* for memcpy, memmove */
+
+#define MAGIC_NUMBER (123456789)
+#define NODE_BYTES (512)	/* Size of each node, 8 cache lines */
+#define LEAF_CAPACITY ( (NODE_BYTES - 2 * sizeof(void*)) / sizeof(void*) )			/* 62 on 64 bit */
+#define INNER_CAPACITY ( (NODE_BYTES - 2 * sizeof(void*)) / (2 * sizeof(void*)) )	/* 31 on 64 bit */
+#define LEAF_MIN (LEAF_CAPACITY / 2)		/* Least items in a leaf that is not the root */
+#define INNER_MIN (INNER_CAPACITY / 2)		/* Least keys in an inner node that is not the root */
+#define MAX_HEIGHT (20)		/* Each inner node has at least 16 children, so the height never get near it */
+#define AS_LEAF(node)		( (Leaf*)(node) )
+#define AS_INNER(node)		( (Inner*)(node) )
+#define SWAP(a, b)			do{ void** temp = (a); (a) = (b); (b) = temp; } while(0)
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_TREE_NULL(param)		do{ if(NULL == (param) ) { return BPTREE_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ITEM_NULL(param)		do{ if(NULL == (param) ) { return BPTREE_ITEM_NULL_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Leaf Leaf;
+typedef struct Inner Inner;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Leaf
+{
+    size_t m_count;							/* Number of items */
+    Leaf* m_next;							/* The next leaf in order OR NULL */
+    void* m_items[LEAF_CAPACITY];			/* Sorted items */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Inner
+{
+    size_t m_count;							/* Number of keys, the node has m_count + 1 children */
+    void* m_keys[INNER_CAPACITY];			/* m_keys[i] is the smallest item of m_children[i + 1] */
+    void* m_children[INNER_CAPACITY + 1];	/* Leaves OR inner nodes, by the level */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct BPTree
+{
+    void* m_root;			/* Leaf if m_height is 0 */
+    size_t m_height;		/* Number of inner levels */
+    size_t m_size;
+    Leaf* m_first;			/* The first leaf, never freed before destroy */
+    BPTreeLessComparator m_less;
+    size_t m_magicNumber;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Move an iterator that is one after the last item of it's leaf to the next leaf
+ *
+ * @params  _itr            =   The iterator
+ *
+ * @returns The iterator OR the end iterator if there is no next leaf
+ */
+static BPTreeItr MoveToNextLeaf(BPTreeItr _itr);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate an empty leaf
+ *
+ * @returns Leaf pointer OR NULL on allocation failure
+ */
+static Leaf* NewLeaf(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate an empty inner node
+ *
+ * @returns Inner pointer OR NULL on allocation failure
+ */
+static Inner* NewInner(void);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the first index in the leaf that its item is NOT less then _key
+ *
+ * @returns Index in [0, m_count]
+ */
+static size_t LeafLowerIndex(const BPTree* _tree, const Leaf* _leaf, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the first index in the leaf that its item is greater then _key
+ *
+ * @returns Index in [0, m_count]
+ */
+static size_t LeafUpperIndex(const BPTree* _tree, const Leaf* _leaf, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the child of the inner node that _key belong to
+ * @details m_keys[i] is the smallest item of child i + 1, so the child is the
+ *			number of keys that are NOT greater then _key
+ *
+ * @returns Child index in [0, m_count]
+ */
+static size_t InnerChildIndex(const BPTree* _tree, const Inner* _inner, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Descend from the root to the leaf that _key belong to
+ *
+ * @params  _tree           =   The tree
+ * @params  _key            =   The key to search
+ * @params  _path           =   Array of MAX_HEIGHT + 1 to save the inner nodes by level, can be NULL
+ * @params  _childIndex     =   Array of MAX_HEIGHT + 1 to save the child taken in each level, can be NULL
+ *
+ * @returns The leaf
+ */
+static Leaf* FindLeaf(const BPTree* _tree, void* _key, Inner** _path, size_t* _childIndex);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get the smallest item of a subtree
+ *
+ * @params  _node           =   The root of the subtree
+ * @params  _height         =   The height of _node, 0 for a leaf
+ *
+ * @returns The item
+ */
+static void* SubtreeMin(void* _node, size_t _height);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Insert _item to a full leaf by splitting it to 2 leaves
+ *
+ * @params  _leaf           =   The full leaf
+ * @params  _index          =   The index _item should be in
+ * @params  _item           =   The new item
+ * @params  _right          =   An empty leaf to be the right half
+ */
+static void SplitLeaf(Leaf* _leaf, size_t _index, void* _item, Leaf* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate all the nodes an insert to _leaf will need, before the tree is changed
+ * @details The leaf and every full inner node above it are split, and a new root is
+ *			needed if all of them are full.
+ *
+ * @params  _tree           =   The tree
+ * @params  _leaf           =   The leaf to insert to
+ * @params  _path           =   The inner nodes by level from FindLeaf
+ * @params  _spare          =   Array of MAX_HEIGHT + 2 to fill, [0] is a leaf and the rest are inner nodes
+ *
+ * @returns BPTREE_SUCCESS OR BPTREE_ALLOCATION_ERROR, then nothing is allocated
+ */
+static BPTreeResult AllocateSplitNodes(const BPTree* _tree, const Leaf* _leaf, Inner** _path, void** _spare);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Link a new child that was split from child _path[level] up the path
+ * @details Inner nodes on the path are split while they are full, a new root is
+ *			added if the root was split.
+ *
+ * @params  _tree           =   The tree
+ * @params  _path           =   The inner nodes by level from FindLeaf
+ * @params  _childIndex     =   The child taken in each level from FindLeaf
+ * @params  _separator      =   The smallest item of _newChild
+ * @params  _newChild       =   The new node, right after the split child
+ * @params  _spare          =   The inner nodes from AllocateSplitNodes
+ */
+static void InsertToParents(BPTree* _tree, Inner** _path, size_t* _childIndex, void* _separator, void* _newChild, void** _spare);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Fill a leaf that has less then LEAF_MIN items from a brother leaf
+ * @details Borrow an item from a brother that has more then LEAF_MIN items,
+ *			else merge with a brother and remove the right leaf of the 2 from _father.
+ *
+ * @params  _father         =   The father of the leaf
+ * @params  _index          =   The child index of the leaf in _father
+ */
+static void FixLeaf(Inner* _father, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Fill an inner node that has less then INNER_MIN keys from a brother
+ * @details Rotate a key through _father from a brother that has more then INNER_MIN keys,
+ *			else merge with a brother and remove the right node of the 2 from _father.
+ *
+ * @params  _father         =   The father of the inner node
+ * @params  _index          =   The child index of the inner node in _father
+ */
+static void FixInner(Inner* _father, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove key _index and child _index + 1 from an inner node
+ *
+ * @params  _inner          =   The inner node
+ * @params  _index          =   The key index
+ */
+static void RemoveFromInner(Inner* _inner, size_t _index);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Replace the key that point to a removed item with the smallest item of it's right child
+ * @details A key equal to _key is always on the search path of _key
+ *
+ * @params  _tree           =   The tree
+ * @params  _key            =   The key used to remove
+ * @params  _removed        =   The removed item
+ */
+static void ReplaceRemovedKey(BPTree* _tree, void* _key, void* _removed);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Free the inner nodes of a subtree, the leaves are freed by the caller
+ *
+ * @params  _node           =   The root of the subtree
+ * @params  _height         =   The height of _node, the recursion depth is at most MAX_HEIGHT
+ */
+static void DestroyInners(void* _node, size_t _height);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Build the level above _nodes, by spreading the nodes evenly between the new fathers
+ *
+ * @params  _nodes          =   The nodes of the level
+ * @params  _mins           =   The smallest item of each node
+ * @params  _nNodes         =   The number of nodes in the level
+ * @params  _fathers        =   Array to fill with the new fathers
+ * @params  _fatherMins     =   Array to fill with the smallest item of each father
+ *
+ * @returns The number of new fathers OR 0 on allocation failure, then _nodes are untouched
+ */
+static size_t BuildLevel(void** _nodes, void** _mins, size_t _nNodes, void** _fathers, void** _fatherMins);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+BPTree* BPTree_Create(BPTreeLessComparator _less)
+{
+	BPTree* newTree;
+
+	CHECK_NULL(_less);
+
+	newTree = (BPTree*)malloc(sizeof(BPTree));
+	CHECK_NULL(newTree);
+
+	newTree->m_first = NewLeaf();
+	if( NULL == newTree->m_first )
+	{
+		free(newTree);
+		return NULL;
+	}
+
+	newTree->m_root = newTree->m_first;
+	newTree->m_height = 0;
+	newTree->m_size = 0;
+	newTree->m_less = _less;
+	newTree->m_magicNumber = MAGIC_NUMBER;
+
+	return newTree;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create a B+ tree from sorted items
+ * @details The leaves are filled in one pass and the upper levels are built on top of
+ *			them, all nodes are (almost) full.
+ * @Complexity	O(n)
+ *
+ * @param   less			= A comparison function, as in BPTree_Create
+ * @param   items			= Array of _nItems items sorted by _less, with no duplicates
+ * @param   nItems			= The number of items
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ *							  OR if the items are not sorted without duplicates
+ */
+BPTree* BPTree_BuildFromSorted(BPTreeLessComparator _less, void** _items, size_t _nItems)
+{
+	BPTree* newTree;
+	Leaf* leaf;
+	void** buffer;
+	void** nodes;
+	void** mins;
+	void** fathers;
+	void** fatherMins;
+	size_t nNodes;
+	size_t nFathers;
+	size_t next = 0;
+	size_t count;
+	size_t i;
+
+	CHECK_NULL(_less);
+	CHECK_NULL(_items);
+
+	for(i = 0; i < _nItems; ++i)
+	{
+		if( NULL == _items[i] || ( 0 < i && 0 == _less(_items[i - 1], _items[i]) ) )
+		{
+			return NULL;
+		}
+	}
+
+	newTree = BPTree_Create(_less);
+	CHECK_NULL(newTree);
+
+	if( 0 == _nItems )
+	{
+		return newTree;
+	}
+
+	/* Spread the items evenly, so every leaf has at least LEAF_MIN items */
+	nNodes = (_nItems + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+	buffer = (void**)malloc(4 * nNodes * sizeof(void*));
+	if( NULL == buffer )
+	{
+		BPTree_Destroy(newTree, NULL);
+		return NULL;
+	}
+	nodes = buffer;
+	mins = buffer + nNodes;
+	fathers = buffer + 2 * nNodes;
+	fatherMins = buffer + 3 * nNodes;
+
+	leaf = newTree->m_first;
+	for(i = 0; i < nNodes; ++i)
+	{
+		if( 0 < i )
+		{
+			leaf->m_next = NewLeaf();
+			if( NULL == leaf->m_next )
+			{
+				free(buffer);
+				BPTree_Destroy(newTree, NULL);
+				return NULL;
+			}
+			leaf = leaf->m_next;
+		}
+
+		count = _nItems / nNodes + ( (i < _nItems % nNodes) ? 1 : 0 );
+		memcpy(leaf->m_items, _items + next, count * sizeof(void*));
+		leaf->m_count = count;
+		next += count;
+
+		nodes[i] = leaf;
+		mins[i] = leaf->m_items[0];
+	}
+	newTree->m_size = _nItems;
+
+	/* Build the inner levels from the bottom up, until one node is left */
+	while( 1 < nNodes )
+	{
+		nFathers = BuildLevel(nodes, mins, nNodes, fathers, fatherMins);
+		if( 0 == nFathers )
+		{
+			for(i = 0; i < nNodes; ++i)
+			{
+				DestroyInners(nodes[i], newTree->m_height);
+			}
+			newTree->m_height = 0;
+			free(buffer);
+			BPTree_Destroy(newTree, NULL);
+			return NULL;
+		}
+
+		SWAP(nodes, fathers);
+		SWAP(mins, fatherMins);
+		nNodes = nFathers;
+		++newTree->m_height;
+	}
+
+	newTree->m_root = nodes[0];
+	free(buffer);
+
+	return newTree;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy tree
+ * @details Destroys the tree, If supplied with non-NULL destroyer function,
+ *			frees the items in the tree.
+ * @Complexity	O(n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   destroyer      	= A function to destroy the items (may be NULL if unnecessary)
+ */
+void BPTree_Destroy(BPTree* _tree, void (*_destroyer)(void*))
+{
+	Leaf* leaf;
+	Leaf* next;
+	size_t i;
+
+	if( NULL == _tree || MAGIC_NUMBER != _tree->m_magicNumber )
+	{
+		return;
+	}
+
+	DestroyInners(_tree->m_root, _tree->m_height);
+
+	for(leaf = _tree->m_first; NULL != leaf; leaf = next)
+	{
+		if( NULL != _destroyer )
+		{
+			for(i = 0; i < leaf->m_count; ++i)
+			{
+				_destroyer(leaf->m_items[i]);
+			}
+		}
+
+		next = leaf->m_next;
+		free(leaf);
+	}
+
+	_tree->m_magicNumber = 0;
+	free(_tree);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add an item to the tree if it's not already there
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   item           	= An item to add to the tree
+ *
+ * @return  Success indicator
+ * @retval  BPTREE_SUCCESS				= On success
+ * @retval  BPTREE_UNINITIALIZED_ERROR	= If the tree is not initialized
+ * @retval  BPTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  BPTREE_DUPLICATE_ERROR		= If an equal item already in the tree
+ * @retval  BPTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+BPTreeResult BPTree_Insert(BPTree* _tree, void* _item)
+{
+	Inner* path[MAX_HEIGHT + 1];
+	size_t childIndex[MAX_HEIGHT + 1];
+	void* spare[MAX_HEIGHT + 2];
+	Leaf* leaf;
+	size_t index;
+
+	CHECK_TREE_NULL(_tree);
+	CHECK_ITEM_NULL(_item);
+
+	leaf = FindLeaf(_tree, _item, path, childIndex);
+	index = LeafLowerIndex(_tree, leaf, _item);
+
+	if( index < leaf->m_count && 0 == _tree->m_less(_item, leaf->m_items[index]) )
+	{
+		return BPTREE_DUPLICATE_ERROR;
+	}
+
+	if( BPTREE_SUCCESS != AllocateSplitNodes(_tree, leaf, path, spare) )
+	{
+		return BPTREE_ALLOCATION_ERROR;
+	}
+
+	if( leaf->m_count < LEAF_CAPACITY )
+	{
+		memmove(leaf->m_items + index + 1, leaf->m_items + index, (leaf->m_count - index) * sizeof(void*));
+		leaf->m_items[index] = _item;
+		++leaf->m_count;
+	}
+	else
+	{
+		SplitLeaf(leaf, index, _item, AS_LEAF(spare[0]));
+		InsertToParents(_tree, path, childIndex, AS_LEAF(spare[0])->m_items[0], spare[0], spare);
+	}
+
+	++_tree->m_size;
+
+	return BPTREE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the item equal to _key from the tree
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The removed item OR NULL if not found OR uninitialized pointer given
+ */
+void* BPTree_Remove(BPTree* _tree, void* _key)
+{
+	Inner* path[MAX_HEIGHT + 1];
+	size_t childIndex[MAX_HEIGHT + 1];
+	Leaf* leaf;
+	void* removed;
+	void* oldRoot;
+	size_t index;
+	size_t level;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
+
+	leaf = FindLeaf(_tree, _key, path, childIndex);
+	index = LeafLowerIndex(_tree, leaf, _key);
+
+	if( index == leaf->m_count || 0 != _tree->m_less(_key, leaf->m_items[index]) )
+	{
+		return NULL;
+	}
+
+	removed = leaf->m_items[index];
+	--leaf->m_count;
+	memmove(leaf->m_items + index, leaf->m_items + index + 1, (leaf->m_count - index) * sizeof(void*));
+	--_tree->m_size;
+
+	/* Fix the nodes that got below the minimum, from the leaf up */
+	if( 0 < _tree->m_height && leaf->m_count < LEAF_MIN )
+	{
+		FixLeaf(path[1], childIndex[1]);
+
+		for(level = 2; level <= _tree->m_height && path[level - 1]->m_count < INNER_MIN; ++level)
+		{
+			FixInner(path[level], childIndex[level]);
+		}
+	}
+
+	if( 0 < _tree->m_height && 0 == AS_INNER(_tree->m_root)->m_count )
+	{
+		oldRoot = _tree->m_root;
+		_tree->m_root = AS_INNER(oldRoot)->m_children[0];
+		--_tree->m_height;
+		free(oldRoot);
+	}
+
+	if( 0 == index )
+	{
+		ReplaceRemovedKey(_tree, _key, removed);
+	}
+
+	return removed;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* BPTree_Find(const BPTree* _tree, void* _key)
+{
+	Leaf* leaf;
+	size_t index;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
+
+	leaf = FindLeaf(_tree, _key, NULL, NULL);
+	index = LeafLowerIndex(_tree, leaf, _key);
+
+	if( index == leaf->m_count || 0 != _tree->m_less(_key, leaf->m_items[index]) )
+	{
+		return NULL;
+	}
+
+	return leaf->m_items[index];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the tree
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t BPTree_Size(const BPTree* _tree)
+{
+	return ( NULL == _tree ) ? 0 : _tree->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details Iteration will stop on the first item for which action returns a zero
+ *          or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Tree to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* BPTree_Range(const BPTree* _tree, void* _low, void* _high,
+				BPTreeActionFunction _action, void* _context)
+{
+	BPTreeItr itr;
+	Leaf* leaf;
+	size_t i;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_high);
+	CHECK_NULL(_action);
+
+	itr = BPTree_LowerBound(_tree, _low);
+
+	/* Scan the rest of each leaf as an array */
+	for(leaf = AS_LEAF(itr.m_leaf), i = itr.m_index; NULL != leaf; leaf = leaf->m_next, i = 0)
+	{
+		for(; i < leaf->m_count; ++i)
+		{
+			if( 0 != _tree->m_less(_high, leaf->m_items[i]) )
+			{
+				return NULL;
+			}
+
+			if( 0 == _action(leaf->m_items[i], _context) )
+			{
+				return leaf->m_items[i];
+			}
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the first item that is NOT less then _key
+ * @Complexity  O(log n)
+ *
+ * @return  Iterator to the item OR end iterator if there is no such item OR on NULL input
+ */
+BPTreeItr BPTree_LowerBound(const BPTree* _tree, void* _key)
+{
+	BPTreeItr itr = {NULL, 0};
+	Leaf* leaf;
+
+	if( NULL == _tree || NULL == _key )
+	{
+		return itr;
+	}
+
+	leaf = FindLeaf(_tree, _key, NULL, NULL);
+	itr.m_leaf = leaf;
+	itr.m_index = LeafLowerIndex(_tree, leaf, _key);
+
+	return MoveToNextLeaf(itr);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the first item that is greater then _key
+ * @Complexity  O(log n)
+ *
+ * @return  Iterator to the item OR end iterator if there is no such item OR on NULL input
+ */
+BPTreeItr BPTree_UpperBound(const BPTree* _tree, void* _key)
+{
+	BPTreeItr itr = {NULL, 0};
+	Leaf* leaf;
+
+	if( NULL == _tree || NULL == _key )
+	{
+		return itr;
+	}
+
+	leaf = FindLeaf(_tree, _key, NULL, NULL);
+	itr.m_leaf = leaf;
+	itr.m_index = LeafUpperIndex(_tree, leaf, _key);
+
+	return MoveToNextLeaf(itr);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the smallest item
+ * @Complexity  O(1)
+ *
+ * @return  Iterator to the first item OR end iterator if the tree is empty OR uninitialized
+ */
+BPTreeItr BPTreeItr_Begin(const BPTree* _tree)
+{
+	BPTreeItr itr = {NULL, 0};
+
+	if( NULL != _tree && 0 < _tree->m_size )
+	{
+		itr.m_leaf = _tree->m_first;
+	}
+
+	return itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get iterator to the end of the tree, one after the greatest item
+ * @Complexity  O(1)
+ *
+ * @return  The end iterator
+ */
+BPTreeItr BPTreeItr_End(const BPTree* _tree)
+{
+	BPTreeItr itr = {NULL, 0};
+
+	(void)_tree;
+
+	return itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Compare two iterators
+ *
+ * @retval  1 				= If iterators are the same
+ * @retval  0 				= If are not the same
+ */
+int BPTreeItr_Equals(BPTreeItr _a, BPTreeItr _b)
+{
+	return ( _a.m_leaf == _b.m_leaf && _a.m_index == _b.m_index );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get itertator to the next item in order
+ * @Complexity  O(1)
+ * @warning if _itr is end iterator it will be returned
+ */
+BPTreeItr BPTreeItr_Next(BPTreeItr _itr)
+{
+	if( NULL == _itr.m_leaf )
+	{
+		return _itr;
+	}
+
+	++_itr.m_index;
+
+	return MoveToNextLeaf(_itr);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the item the iterator is pointing to
+ *
+ * @retval  item         	=   If the iterator is pointing at item
+ * @retval  NULL         	=   If iterator pointing to the end
+ */
+void* BPTreeItr_Get(BPTreeItr _itr)
+{
+	CHECK_NULL(_itr.m_leaf);
+
+	return AS_LEAF(_itr.m_leaf)->m_items[_itr.m_index];
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Move an iterator that is one after the last item of it's leaf to the next leaf
+ *
+ * @params  _itr            =   The iterator
+ *
+ * @returns The iterator OR the end iterator if there is no next leaf
+ */
+static BPTreeItr MoveToNextLeaf(BPTreeItr _itr)
+{
+	if( _itr.m_index == AS_LEAF(_itr.m_leaf)->m_count )
+	{
+		/* Only the root leaf can be empty, so the next leaf is never empty */
+		_itr.m_leaf = AS_LEAF(_itr.m_leaf)->m_next;
+		_itr.m_index = 0;
+	}
+
+	return _itr;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate an empty leaf
+ *
+ * @returns Leaf pointer OR NULL on allocation failure
+ */
+static Leaf* NewLeaf(void)
+{
+	Leaf* leaf = (Leaf*)malloc(sizeof(Leaf));
+
+	if( NULL != leaf )
+	{
+		leaf->m_count = 0;
+		leaf->m_next = NULL;
+	}
+
+	return leaf;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate an empty inner node
+ *
+ * @returns Inner pointer OR NULL on allocation failure
+ */
+static Inner* NewInner(void)
+{
+	Inner* inner = (Inner*)malloc(sizeof(Inner));
+
+	if( NULL != inner )
+	{
+		inner->m_count = 0;
+	}
+
+	return inner;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the first index in the leaf that its item is NOT less then _key
+ *
+ * @returns Index in [0, m_count]
+ */
+static size_t LeafLowerIndex(const BPTree* _tree, const Leaf* _leaf, void* _key)
+{
+	size_t low = 0;
+	size_t high = _leaf->m_count;
+	size_t middle;
+
+	while( low < high )
+	{
+		middle = low + (high - low) / 2;
+		if( 0 != _tree->m_less(_leaf->m_items[middle], _key) )
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the first index in the leaf that its item is greater then _key
+ *
+ * @returns Index in [0, m_count]
+ */
+static size_t LeafUpperIndex(const BPTree* _tree, const Leaf* _leaf, void* _key)
+{
+	size_t low = 0;
+	size_t high = _leaf->m_count;
+	size_t middle;
+
+	while( low < high )
+	{
+		middle = low + (high - low) / 2;
+		if( 0 != _tree->m_less(_key, _leaf->m_items[middle]) )
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+
+	return low;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Binary search the child of the inner node that _key belong to
+ * @details m_keys[i] is the smallest item of child i + 1, so the child is the
+ *			number of keys that are NOT greater then _key
+ *
+ * @returns Child index in [0, m_count]
+ */
+static size_t InnerChildIndex(const BPTree* _tree, const Inner* _inner, void* _key)
+{
+	size_t low = 0;
+	size_t high = _inner->m_count;
+	size_t middle;
+
+	while( low < high )
+	{
+		middle = low + (high - low) / 2;
+		if( 0 != _tree->m_less(_key, _inner->m_keys[middle]) )
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+
+	return low;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Descend from the root to the leaf that _key belong to
+ *
+ * @params  _tree           =   The tree
+ * @params  _key            =   The key to search
+ * @params  _path           =   Array of MAX_HEIGHT + 1 to save the inner nodes by level, can be NULL
+ * @params  _childIndex     =   Array of MAX_HEIGHT + 1 to save the child taken in each level, can be NULL
+ *
+ * @returns The leaf
+ */
+static Leaf* FindLeaf(const BPTree* _tree, void* _key, Inner** _path, size_t* _childIndex)
+{
+	void* node = _tree->m_root;
+	size_t level;
+	size_t index;
+
+	for(level = _tree->m_height; 0 < level; --level)
+	{
+		index = InnerChildIndex(_tree, AS_INNER(node), _key);
+		if( NULL != _path )
+		{
+			_path[level] = AS_INNER(node);
+			_childIndex[level] = index;
+		}
+		node = AS_INNER(node)->m_children[index];
+	}
+
+	return AS_LEAF(node);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get the smallest item of a subtree
+ *
+ * @params  _node           =   The root of the subtree
+ * @params  _height         =   The height of _node, 0 for a leaf
+ *
+ * @returns The item
+ */
+static void* SubtreeMin(void* _node, size_t _height)
+{
+	for(; 0 < _height; --_height)
+	{
+		_node = AS_INNER(_node)->m_children[0];
+	}
+
+	return AS_LEAF(_node)->m_items[0];
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Insert _item to a full leaf by splitting it to 2 leaves
+ *
+ * @params  _leaf           =   The full leaf
+ * @params  _index          =   The index _item should be in
+ * @params  _item           =   The new item
+ * @params  _right          =   An empty leaf to be the right half
+ */
+static void SplitLeaf(Leaf* _leaf, size_t _index, void* _item, Leaf* _right)
+{
+	void* items[LEAF_CAPACITY + 1];
+	size_t leftCount = (LEAF_CAPACITY + 1) / 2;
+
+	memcpy(items, _leaf->m_items, _index * sizeof(void*));
+	items[_index] = _item;
+	memcpy(items + _index + 1, _leaf->m_items + _index, (LEAF_CAPACITY - _index) * sizeof(void*));
+
+	memcpy(_leaf->m_items, items, leftCount * sizeof(void*));
+	memcpy(_right->m_items, items + leftCount, (LEAF_CAPACITY + 1 - leftCount) * sizeof(void*));
+	_leaf->m_count = leftCount;
+	_right->m_count = LEAF_CAPACITY + 1 - leftCount;
+
+	_right->m_next = _leaf->m_next;
+	_leaf->m_next = _right;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate all the nodes an insert to _leaf will need, before the tree is changed
+ * @details The leaf and every full inner node above it are split, and a new root is
+ *			needed if all of them are full.
+ *
+ * @params  _tree           =   The tree
+ * @params  _leaf           =   The leaf to insert to
+ * @params  _path           =   The inner nodes by level from FindLeaf
+ * @params  _spare          =   Array of MAX_HEIGHT + 2 to fill, [0] is a leaf and the rest are inner nodes
+ *
+ * @returns BPTREE_SUCCESS OR BPTREE_ALLOCATION_ERROR, then nothing is allocated
+ */
+static BPTreeResult AllocateSplitNodes(const BPTree* _tree, const Leaf* _leaf, Inner** _path, void** _spare)
+{
+	size_t level;
+	size_t needed = 0;
+
+	if( LEAF_CAPACITY == _leaf->m_count )
+	{
+		_spare[needed++] = NewLeaf();
+
+		for(level = 1; level <= _tree->m_height && INNER_CAPACITY == _path[level]->m_count; ++level)
+		{
+			_spare[needed++] = NewInner();
+		}
+
+		/* All the path is full, a new root is needed */
+		if( level > _tree->m_height )
+		{
+			_spare[needed++] = NewInner();
+		}
+	}
+
+	for(level = 0; level < needed; ++level)
+	{
+		if( NULL == _spare[level] )
+		{
+			for(level = 0; level < needed; ++level)
+			{
+				free(_spare[level]);
+			}
+			return BPTREE_ALLOCATION_ERROR;
+		}
+	}
+
+	return BPTREE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Link a new child that was split from child _path[level] up the path
+ * @details Inner nodes on the path are split while they are full, a new root is
+ *			added if the root was split.
+ *
+ * @params  _tree           =   The tree
+ * @params  _path           =   The inner nodes by level from FindLeaf
+ * @params  _childIndex     =   The child taken in each level from FindLeaf
+ * @params  _separator      =   The smallest item of _newChild
+ * @params  _newChild       =   The new node, right after the split child
+ * @params  _spare          =   The inner nodes from AllocateSplitNodes
+ */
+static void InsertToParents(BPTree* _tree, Inner** _path, size_t* _childIndex, void* _separator, void* _newChild, void** _spare)
+{
+	void* keys[INNER_CAPACITY + 1];
+	void* children[INNER_CAPACITY + 2];
+	size_t leftCount = INNER_CAPACITY / 2;
+	size_t level;
+	size_t index;
+	Inner* inner;
+	Inner* right;
+
+	for(level = 1; level <= _tree->m_height; ++level)
+	{
+		inner = _path[level];
+		index = _childIndex[level];
+
+		if( inner->m_count < INNER_CAPACITY )
+		{
+			memmove(inner->m_keys + index + 1, inner->m_keys + index, (inner->m_count - index) * sizeof(void*));
+			memmove(inner->m_children + index + 2, inner->m_children + index + 1, (inner->m_count - index) * sizeof(void*));
+			inner->m_keys[index] = _separator;
+			inner->m_children[index + 1] = _newChild;
+			++inner->m_count;
+			return;
+		}
+
+		right = AS_INNER(_spare[level]);
+
+		memcpy(keys, inner->m_keys, index * sizeof(void*));
+		keys[index] = _separator;
+		memcpy(keys + index + 1, inner->m_keys + index, (INNER_CAPACITY - index) * sizeof(void*));
+		memcpy(children, inner->m_children, (index + 1) * sizeof(void*));
+		children[index + 1] = _newChild;
+		memcpy(children + index + 2, inner->m_children + index + 1, (INNER_CAPACITY - index) * sizeof(void*));
+
+		/* keys[leftCount] move up, the rest go to the right node */
+		memcpy(inner->m_keys, keys, leftCount * sizeof(void*));
+		memcpy(inner->m_children, children, (leftCount + 1) * sizeof(void*));
+		inner->m_count = leftCount;
+
+		right->m_count = INNER_CAPACITY - leftCount;
+		memcpy(right->m_keys, keys + leftCount + 1, right->m_count * sizeof(void*));
+		memcpy(right->m_children, children + leftCount + 1, (right->m_count + 1) * sizeof(void*));
+
+		_separator = keys[leftCount];
+		_newChild = right;
+	}
+
+	/* The root was split */
+	inner = AS_INNER(_spare[level]);
+	inner->m_count = 1;
+	inner->m_keys[0] = _separator;
+	inner->m_children[0] = _tree->m_root;
+	inner->m_children[1] = _newChild;
+	_tree->m_root = inner;
+	++_tree->m_height;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Fill a leaf that has less then LEAF_MIN items from a brother leaf
+ * @details Borrow an item from a brother that has more then LEAF_MIN items,
+ *			else merge with a brother and remove the right leaf of the 2 from _father.
+ *
+ * @params  _father         =   The father of the leaf
+ * @params  _index          =   The child index of the leaf in _father
+ */
+static void FixLeaf(Inner* _father, size_t _index)
+{
+	Leaf* leaf = AS_LEAF(_father->m_children[_index]);
+	Leaf* left = (0 < _index) ? AS_LEAF(_father->m_children[_index - 1]) : NULL;
+	Leaf* right = (_index < _father->m_count) ? AS_LEAF(_father->m_children[_index + 1]) : NULL;
+
+	if( NULL != left && LEAF_MIN < left->m_count )
+	{
+		memmove(leaf->m_items + 1, leaf->m_items, leaf->m_count * sizeof(void*));
+		leaf->m_items[0] = left->m_items[--left->m_count];
+		++leaf->m_count;
+		_father->m_keys[_index - 1] = leaf->m_items[0];
+		return;
+	}
+
+	if( NULL != right && LEAF_MIN < right->m_count )
+	{
+		leaf->m_items[leaf->m_count++] = right->m_items[0];
+		--right->m_count;
+		memmove(right->m_items, right->m_items + 1, right->m_count * sizeof(void*));
+		_father->m_keys[_index] = right->m_items[0];
+		return;
+	}
+
+	/* Merge the leaf with a brother, keep the left one of the two */
+	if( NULL != left )
+	{
+		right = leaf;
+		leaf = left;
+		--_index;
+	}
+
+	memcpy(leaf->m_items + leaf->m_count, right->m_items, right->m_count * sizeof(void*));
+	leaf->m_count += right->m_count;
+	leaf->m_next = right->m_next;
+	free(right);
+
+	RemoveFromInner(_father, _index);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Fill an inner node that has less then INNER_MIN keys from a brother
+ * @details Rotate a key through _father from a brother that has more then INNER_MIN keys,
+ *			else merge with a brother and remove the right node of the 2 from _father.
+ *
+ * @params  _father         =   The father of the inner node
+ * @params  _index          =   The child index of the inner node in _father
+ */
+static void FixInner(Inner* _father, size_t _index)
+{
+	Inner* inner = AS_INNER(_father->m_children[_index]);
+	Inner* left = (0 < _index) ? AS_INNER(_father->m_children[_index - 1]) : NULL;
+	Inner* right = (_index < _father->m_count) ? AS_INNER(_father->m_children[_index + 1]) : NULL;
+
+	if( NULL != left && INNER_MIN < left->m_count )
+	{
+		memmove(inner->m_keys + 1, inner->m_keys, inner->m_count * sizeof(void*));
+		memmove(inner->m_children + 1, inner->m_children, (inner->m_count + 1) * sizeof(void*));
+		inner->m_keys[0] = _father->m_keys[_index - 1];
+		inner->m_children[0] = left->m_children[left->m_count];
+		++inner->m_count;
+		_father->m_keys[_index - 1] = left->m_keys[--left->m_count];
+		return;
+	}
+
+	if( NULL != right && INNER_MIN < right->m_count )
+	{
+		inner->m_keys[inner->m_count] = _father->m_keys[_index];
+		inner->m_children[inner->m_count + 1] = right->m_children[0];
+		++inner->m_count;
+		_father->m_keys[_index] = right->m_keys[0];
+		--right->m_count;
+		memmove(right->m_keys, right->m_keys + 1, right->m_count * sizeof(void*));
+		memmove(right->m_children, right->m_children + 1, (right->m_count + 1) * sizeof(void*));
+		return;
+	}
+
+	/* Merge with a brother, the separator from the father come down between them */
+	if( NULL != left )
+	{
+		right = inner;
+		inner = left;
+		--_index;
+	}
+
+	inner->m_keys[inner->m_count] = _father->m_keys[_index];
+	memcpy(inner->m_keys + inner->m_count + 1, right->m_keys, right->m_count * sizeof(void*));
+	memcpy(inner->m_children + inner->m_count + 1, right->m_children, (right->m_count + 1) * sizeof(void*));
+	inner->m_count += right->m_count + 1;
+	free(right);
+
+	RemoveFromInner(_father, _index);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove key _index and child _index + 1 from an inner node
+ *
+ * @params  _inner          =   The inner node
+ * @params  _index          =   The key index
+ */
+static void RemoveFromInner(Inner* _inner, size_t _index)
+{
+	--_inner->m_count;
+	memmove(_inner->m_keys + _index, _inner->m_keys + _index + 1, (_inner->m_count - _index) * sizeof(void*));
+	memmove(_inner->m_children + _index + 1, _inner->m_children + _index + 2, (_inner->m_count - _index) * sizeof(void*));
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Replace the key that point to a removed item with the smallest item of it's right child
+ * @details A key equal to _key is always on the search path of _key
+ *
+ * @params  _tree           =   The tree
+ * @params  _key            =   The key used to remove
+ * @params  _removed        =   The removed item
+ */
+static void ReplaceRemovedKey(BPTree* _tree, void* _key, void* _removed)
+{
+	void* node = _tree->m_root;
+	size_t level;
+	size_t index;
+
+	for(level = _tree->m_height; 0 < level; --level)
+	{
+		index = InnerChildIndex(_tree, AS_INNER(node), _key);
+		if( 0 < index && _removed == AS_INNER(node)->m_keys[index - 1] )
+		{
+			AS_INNER(node)->m_keys[index - 1] = SubtreeMin(AS_INNER(node)->m_children[index], level - 1);
+			return;
+		}
+		node = AS_INNER(node)->m_children[index];
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Free the inner nodes of a subtree, the leaves are freed by the caller
+ *
+ * @params  _node           =   The root of the subtree
+ * @params  _height         =   The height of _node, the recursion depth is at most MAX_HEIGHT
+ */
+static void DestroyInners(void* _node, size_t _height)
+{
+	size_t i;
+
+	if( 0 == _height )
+	{
+		return;
+	}
+
+	if( 1 < _height )
+	{
+		for(i = 0; i <= AS_INNER(_node)->m_count; ++i)
+		{
+			DestroyInners(AS_INNER(_node)->m_children[i], _height - 1);
+		}
+	}
+
+	free(_node);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Build the level above _nodes, by spreading the nodes evenly between the new fathers
+ *
+ * @params  _nodes          =   The nodes of the level
+ * @params  _mins           =   The smallest item of each node
+ * @params  _nNodes         =   The number of nodes in the level
+ * @params  _fathers        =   Array to fill with the new fathers
+ * @params  _fatherMins     =   Array to fill with the smallest item of each father
+ *
+ * @returns The number of new fathers OR 0 on allocation failure, then _nodes are untouched
+ */
+static size_t BuildLevel(void** _nodes, void** _mins, size_t _nNodes, void** _fathers, void** _fatherMins)
+{
+	size_t nFathers = (_nNodes + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+	size_t father;
+	size_t next = 0;
+	size_t nChildren;
+	size_t i;
+	Inner* inner;
+
+	for(father = 0; father < nFathers; ++father)
+	{
+		inner = NewInner();
+		if( NULL == inner )
+		{
+			while( 0 < father )
+			{
+				free(_fathers[--father]);
+			}
+			return 0;
+		}
+
+		/* Spread evenly, so every father has at least INNER_MIN keys */
+		nChildren = _nNodes / nFathers + ( (father < _nNodes % nFathers) ? 1 : 0 );
+		inner->m_count = nChildren - 1;
+		inner->m_children[0] = _nodes[next];
+		for(i = 1; i < nChildren; ++i)
+		{
+			inner->m_children[i] = _nodes[next + i];
+			inner->m_keys[i - 1] = _mins[next + i];
+		}
+
+		_fathers[father] = inner;
+		_fatherMins[father] = _mins[next];
+		next += nChildren;
+	}
+
+	return nFathers;
+}
+/*----------------------------------------------------------------------------*/
+
+
@@ -0,0 +1,270 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic B+ Tree data type against Generic Binary Tree
+ *
+ *  @details 	Measure random insert, random find, full in order walk and range scans
+ *  			on the same random keys, for the B+ tree and for the binary tree.
+ *  			The B+ tree bulk load from sorted keys is measured too.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "bPlusTree.h"	/* B+ tree header */
+#include "binTree.h"	/* binary tree header */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand & malloc */
+#include <time.h> 		/* for clock_t & clock */
+
+#define DEFAULT_SIZE (4000000)	/* Num of keys, can be changed from the command line */
+#define RANGE_SCANS (1000)		/* Num of range scans */
+#define RANGE_WIDTH (1000)		/* Num of keys in each range scan */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that count the elements it was called on
+ */
+static int CountAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Run the benchmark on the B+ tree, print the times
+ *
+ * @param   _keys		= The keys, _keys[i] == i
+ * @param   _order		= Random order of the keys indexes
+ * @param   _nKeys  	= The number of keys
+ */
+static void RunBPTree(int* _keys, size_t* _order, size_t _nKeys);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Run the benchmark on the binary tree, print the times
+ *
+ * @param   _keys		= The keys, _keys[i] == i
+ * @param   _order		= Random order of the keys indexes
+ * @param   _nKeys  	= The number of keys
+ */
+static void RunBSTree(int* _keys, size_t* _order, size_t _nKeys);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nKeys = DEFAULT_SIZE;
+	size_t i;
+	size_t j;
+	size_t temp;
+	size_t* order;
+	int* keys;
+
+	if( 1 < argc )
+	{
+		nKeys = (size_t)atol(argv[1]);
+	}
+
+	keys = (int*)malloc(nKeys * sizeof(int));
+	order = (size_t*)malloc(nKeys * sizeof(size_t));
+	if( NULL == keys || NULL == order || nKeys < RANGE_WIDTH )
+	{
+		free(keys);
+		free(order);
+		return 1;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = 0; i < nKeys; ++i)
+	{
+		keys[i] = (int)i;
+		order[i] = i;
+	}
+	for(i = nKeys; 1 < i; --i)
+	{
+		j = ( (size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand() ) % i;
+		temp = order[i - 1];
+		order[i - 1] = order[j];
+		order[j] = temp;
+	}
+
+	printf("Ordered index benchmark, %lu random keys, %d scans of %d keys:\n",
+			(unsigned long)nKeys, RANGE_SCANS, RANGE_WIDTH);
+	RunBPTree(keys, order, nKeys);
+	RunBSTree(keys, order, nKeys);
+
+	free(keys);
+	free(order);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return ( *(int*)_a  < *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CountAction(void* _element, void* _context)
+{
+	(void)_element;
+	++*(size_t*)_context;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunBPTree(int* _keys, size_t* _order, size_t _nKeys)
+{
+	BPTree* tree;
+	BPTreeItr itr;
+	void** items;
+	clock_t times[6];
+	size_t counter = 0;
+	size_t i;
+	int high;
+
+	tree = BPTree_Create(CompareData);
+	items = (void**)malloc(_nKeys * sizeof(void*));
+	if( NULL == tree || NULL == items )
+	{
+		BPTree_Destroy(tree, NULL);
+		free(items);
+		return;
+	}
+
+	times[0] = clock();
+	for(i = 0; i < _nKeys; ++i)
+	{
+		BPTree_Insert(tree, &_keys[_order[i]]);
+	}
+
+	times[1] = clock();
+	for(i = 0; i < _nKeys; ++i)
+	{
+		counter += ( NULL != BPTree_Find(tree, &_keys[_order[i]]) );
+	}
+
+	times[2] = clock();
+	for(itr = BPTreeItr_Begin(tree); !BPTreeItr_Equals(itr, BPTreeItr_End(tree)); itr = BPTreeItr_Next(itr))
+	{
+		++counter;
+	}
+
+	times[3] = clock();
+	for(i = 0; i < RANGE_SCANS; ++i)
+	{
+		high = _keys[_order[i] % (_nKeys - RANGE_WIDTH)] + RANGE_WIDTH - 1;
+		BPTree_Range(tree, &_keys[_order[i] % (_nKeys - RANGE_WIDTH)], &high, CountAction, &counter);
+	}
+
+	times[4] = clock();
+	BPTree_Destroy(tree, NULL);
+
+	for(i = 0; i < _nKeys; ++i)
+	{
+		items[i] = &_keys[i];
+	}
+	times[5] = clock();
+	tree = BPTree_BuildFromSorted(CompareData, items, _nKeys);
+	counter += BPTree_Size(tree);
+	printf("B+ tree  insert: %9.2f ms  find: %9.2f ms  walk: %8.2f ms  ranges: %8.2f ms  bulk load: %8.2f ms  (%lu)\n",
+			TO_MSEC(times[0], times[1]), TO_MSEC(times[1], times[2]), TO_MSEC(times[2], times[3]),
+			TO_MSEC(times[3], times[4]), TO_MSEC(times[5], clock()), (unsigned long)counter);
+
+	BPTree_Destroy(tree, NULL);
+	free(items);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunBSTree(int* _keys, size_t* _order, size_t _nKeys)
+{
+	BSTree* tree;
+	BSTreeItr itr;
+	BSTreeItr endItr;
+	clock_t times[5];
+	size_t counter = 0;
+	size_t i;
+	int high;
+
+	tree = BSTree_Create(CompareData);
+	if( NULL == tree )
+	{
+		return;
+	}
+
+	times[0] = clock();
+	for(i = 0; i < _nKeys; ++i)
+	{
+		BSTree_Insert(tree, &_keys[_order[i]]);
+	}
+
+	times[1] = clock();
+	for(i = 0; i < _nKeys; ++i)
+	{
+		counter += ( NULL != BSTree_Find(tree, &_keys[_order[i]]) );
+	}
+
+	times[2] = clock();
+	endItr = BSTreeItr_End(tree);
+	for(itr = BSTreeItr_Begin(tree); itr != endItr; itr = BSTreeItr_Next(itr))
+	{
+		++counter;
+	}
+
+	times[3] = clock();
+	for(i = 0; i < RANGE_SCANS; ++i)
+	{
+		high = _keys[_order[i] % (_nKeys - RANGE_WIDTH)] + RANGE_WIDTH - 1;
+		BSTree_Range(tree, &_keys[_order[i] % (_nKeys - RANGE_WIDTH)], &high, CountAction, &counter);
+	}
+
+	times[4] = clock();
+	printf("BSTree   insert: %9.2f ms  find: %9.2f ms  walk: %8.2f ms  ranges: %8.2f ms  (%lu)\n",
+			TO_MSEC(times[0], times[1]), TO_MSEC(times[1], times[2]), TO_MSEC(times[2], times[3]),
+			TO_MSEC(times[3], times[4]), (unsigned long)counter);
+
+	BSTree_Destroy(tree, NULL);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
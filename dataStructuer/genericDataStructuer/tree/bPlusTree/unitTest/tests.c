@@ -0,0 +1,482 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Test file for Generic B+ Tree data type
+ *
+ *  @details 	Implement an ordered set ADT of user items as a B+ tree.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "bPlusTree.h"	/* header file */
+#include "matan_test.h"	/* def of unit test */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand & malloc */
+#include <time.h> 		/* for time_t */
+
+#define SIZE (5000) /* SIZE = Num of items in each test, enough for a few levels */
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Insert the values 0, 2, 4 ... (2 * _nElements - 2) in random order
+ *
+ * @param   _tree       = The tree
+ * @param   _array		= Array of _nElements to fill, _array[i] = 2 * i
+ * @param   _nElements  = The number of elements to insert
+ *
+ * @return   Amount of elements insert to tree
+ */
+static size_t InsertEvenValues(BPTree* _tree, int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that count the elements it was called on
+ *
+ * @return   1 			= Countinue loop for all elements
+ */
+static int CountAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Destroy function that count the elements it was called on
+ */
+static void CountDestroy(void* _element);
+/*----------------------------------------------------------------------------*/
+
+
+static size_t g_destroyCounter = 0;
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------- BPTree_Create ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Create_CheckNull)
+    ASSERT_THAT( NULL == BPTree_Create(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Create_CheckEmpty)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int result;
+
+	result = ( 0 == BPTree_Size(myTree) &&
+			BPTreeItr_Equals(BPTreeItr_Begin(myTree), BPTreeItr_End(myTree)) );
+
+	BPTree_Destroy(myTree, NULL);
+
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Insert ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Insert_CheckNull)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int var = 555;
+	BPTreeResult result;
+
+	result = BPTree_Insert(myTree, NULL);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( BPTREE_ITEM_NULL_ERROR == result );
+    ASSERT_THAT( BPTREE_UNINITIALIZED_ERROR == BPTree_Insert(NULL, &var) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Insert_CheckCase_NoDuplicate)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[2] = {888, 888};
+	BPTreeResult result[2];
+	size_t size;
+
+	result[0] = BPTree_Insert(myTree, &arr[0]);
+	result[1] = BPTree_Insert(myTree, &arr[1]);
+	size = BPTree_Size(myTree);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( BPTREE_SUCCESS == result[0] && BPTREE_DUPLICATE_ERROR == result[1] && 1 == size );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Insert_CheckCase_SortedIteration)
+	BPTree* myTree = BPTree_Create(CompareData);
+	BPTreeItr itr;
+	int arr[SIZE];
+	int expected = 0;
+	size_t inserted;
+
+	inserted = InsertEvenValues(myTree, arr, SIZE);
+
+	for(itr = BPTreeItr_Begin(myTree); !BPTreeItr_Equals(itr, BPTreeItr_End(myTree)); itr = BPTreeItr_Next(itr))
+	{
+		if( expected != *(int*)BPTreeItr_Get(itr) )
+		{
+			break;
+		}
+		expected += 2;
+	}
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( SIZE == inserted && 2 * SIZE == expected );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Find --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Find_CheckCase_FoundAndNotFound)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int key;
+	int result = 1;
+
+	InsertEvenValues(myTree, arr, SIZE);
+
+	for(key = 0; key < 2 * SIZE; key += 2)
+	{
+		result = result && ( &arr[key / 2] == BPTree_Find(myTree, &key) );
+		++key;
+		result = result && ( NULL == BPTree_Find(myTree, &key) );
+		--key;
+	}
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Remove ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Remove_CheckCase_NotFound)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int key = 7;
+	void* retVal;
+	size_t size;
+
+	InsertEvenValues(myTree, arr, SIZE);
+	retVal = BPTree_Remove(myTree, &key);
+	size = BPTree_Size(myTree);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( NULL == retVal && SIZE == size );
+	ASSERT_THAT( NULL == BPTree_Remove(NULL, &key) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Remove_CheckCase_All)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int key;
+	int result = 1;
+	size_t size[2];
+
+	InsertEvenValues(myTree, arr, SIZE);
+
+	/* Remove half, from both sides of the tree */
+	for(key = 0; key < SIZE; key += 2)
+	{
+		result = result && ( &arr[key / 2] == BPTree_Remove(myTree, &key) );
+		result = result && ( NULL == BPTree_Find(myTree, &key) );
+	}
+	size[0] = BPTree_Size(myTree);
+
+	for(key = 2 * SIZE - 2; key >= SIZE; key -= 2)
+	{
+		result = result && ( &arr[key / 2] == BPTree_Remove(myTree, &key) );
+	}
+	size[1] = BPTree_Size(myTree);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( result && SIZE / 2 == size[0] && 0 == size[1] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Bounds ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_LowerBound_CheckCase_SortedValues)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int between = 501;
+	int exact = 502;
+	int above = 2 * SIZE;
+	void* retVal[2];
+	BPTreeItr notFound;
+
+	InsertEvenValues(myTree, arr, SIZE);
+
+	retVal[0] = BPTreeItr_Get(BPTree_LowerBound(myTree, &between));
+	retVal[1] = BPTreeItr_Get(BPTree_LowerBound(myTree, &exact));
+	notFound = BPTree_LowerBound(myTree, &above);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( &arr[251] == retVal[0] && &arr[251] == retVal[1] );
+	ASSERT_THAT( BPTreeItr_Equals(notFound, BPTreeItr_End(NULL)) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_UpperBound_CheckCase_SortedValues)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int between = 501;
+	int exact = 502;
+	int last = 2 * SIZE - 2;
+	void* retVal[2];
+	BPTreeItr notFound;
+
+	InsertEvenValues(myTree, arr, SIZE);
+
+	retVal[0] = BPTreeItr_Get(BPTree_UpperBound(myTree, &between));
+	retVal[1] = BPTreeItr_Get(BPTree_UpperBound(myTree, &exact));
+	notFound = BPTree_UpperBound(myTree, &last);
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( &arr[251] == retVal[0] && &arr[252] == retVal[1] );
+	ASSERT_THAT( NULL == BPTreeItr_Get(notFound) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Range -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Range_CheckCase_CountInRange)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+	int low = 3;
+	int high = 2 * SIZE;
+	size_t counter[2] = {0, 0};
+	void* retVal[2];
+
+	InsertEvenValues(myTree, arr, SIZE);
+
+	retVal[0] = BPTree_Range(myTree, &low, &high, CountAction, &counter[0]);
+	high = 1000;
+	retVal[1] = BPTree_Range(myTree, &low, &high, CountAction, &counter[1]);
+
+	BPTree_Destroy(myTree, NULL);
+
+	/* [3, 2 * SIZE] hold 4 ... (2 * SIZE - 2) and [3, 1000] hold 4 ... 1000 */
+	ASSERT_THAT( NULL == retVal[0] && SIZE - 2 == counter[0] );
+	ASSERT_THAT( NULL == retVal[1] && 499 == counter[1] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*--------------------------- BPTree_BuildFromSorted -------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_BuildFromSorted_CheckNotSorted)
+	int arr[3] = {1, 3, 2};
+	void* items[3];
+
+	items[0] = &arr[0];
+	items[1] = &arr[1];
+	items[2] = &arr[2];
+
+	ASSERT_THAT( NULL == BPTree_BuildFromSorted(CompareData, items, 3) );
+	items[2] = &arr[1];
+	ASSERT_THAT( NULL == BPTree_BuildFromSorted(CompareData, items, 3) );
+	ASSERT_THAT( NULL == BPTree_BuildFromSorted(CompareData, NULL, 3) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_BuildFromSorted_CheckCase_FindAndInsert)
+	BPTree* myTree;
+	void* items[SIZE];
+	int arr[SIZE];
+	int odd = 101;
+	int key;
+	int result = 1;
+	size_t i;
+
+	for(i = 0; i < SIZE; ++i)
+	{
+		arr[i] = (int)(2 * i);
+		items[i] = &arr[i];
+	}
+
+	myTree = BPTree_BuildFromSorted(CompareData, items, SIZE);
+	ASSERT_THAT( NULL != myTree && SIZE == BPTree_Size(myTree) );
+
+	for(key = 0; key < 2 * SIZE; key += 2)
+	{
+		result = result && ( &arr[key / 2] == BPTree_Find(myTree, &key) );
+	}
+	result = result && ( BPTREE_SUCCESS == BPTree_Insert(myTree, &odd) );
+	result = result && ( &odd == BPTreeItr_Get(BPTree_UpperBound(myTree, &arr[50])) );
+
+	BPTree_Destroy(myTree, NULL);
+
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BPTree_Destroy -----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BPTree_Destroy_CheckCase_Destroyer)
+	BPTree* myTree = BPTree_Create(CompareData);
+	int arr[SIZE];
+
+	InsertEvenValues(myTree, arr, SIZE);
+	g_destroyCounter = 0;
+
+	BPTree_Destroy(myTree, CountDestroy);
+	BPTree_Destroy(NULL, CountDestroy);
+
+	ASSERT_THAT( SIZE == g_destroyCounter );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Test Suite *********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic B+ Tree)
+	PRINT(BPTree_Create_CheckNull)
+	PRINT(BPTree_Create_CheckEmpty)
+
+	PRINT(BPTree_Insert_CheckNull)
+	PRINT(BPTree_Insert_CheckCase_NoDuplicate)
+	PRINT(BPTree_Insert_CheckCase_SortedIteration)
+
+	PRINT(BPTree_Find_CheckCase_FoundAndNotFound)
+
+	PRINT(BPTree_Remove_CheckCase_NotFound)
+	PRINT(BPTree_Remove_CheckCase_All)
+
+	PRINT(BPTree_LowerBound_CheckCase_SortedValues)
+	PRINT(BPTree_UpperBound_CheckCase_SortedValues)
+
+	PRINT(BPTree_Range_CheckCase_CountInRange)
+
+	PRINT(BPTree_BuildFromSorted_CheckNotSorted)
+	PRINT(BPTree_BuildFromSorted_CheckCase_FindAndInsert)
+
+	PRINT(BPTree_Destroy_CheckCase_Destroyer)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return ( *(int*)_a  < *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t InsertEvenValues(BPTree* _tree, int* _array, size_t _nElements)
+{
+	size_t* order;
+	size_t i;
+	size_t j;
+	size_t temp;
+	size_t counter = 0;
+
+	order = (size_t*)malloc(_nElements * sizeof(size_t));
+	if( NULL == order )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		_array[i] = (int)(2 * i);
+		order[i] = i;
+	}
+
+	srand((unsigned)time(NULL));
+	for(i = _nElements; 0 < i; --i)
+	{
+		j = (size_t)rand() % i;
+		temp = order[i - 1];
+		order[i - 1] = order[j];
+		order[j] = temp;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( BPTREE_SUCCESS == BPTree_Insert(_tree, &_array[order[i]]) )
+		{
+			++counter;
+		}
+	}
+
+	free(order);
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CountAction(void* _element, void* _context)
+{
+	(void)_element;
+	++*(size_t*)_context;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void CountDestroy(void* _element)
+{
+	(void)_element;
+	++g_destroyCounter;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,158 @@
+/** 
+ *  @file 		benchmark.c
+ *  @brief 		Benchmark for Generic Binary Tree data type
+ * 
+ *  @details 	Measure the time of insert, full in order walk and remove of the tree,
+ *  			once when the items are inserted in sorted order (increasing IDs)
+ *  			and once when the items are inserted in random order.
+ * 
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01     
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "binTree.h"	/* header file */
+#include <stdio.h>  	/* for printf */
+#include <stdlib.h> 	/* for size_t & srand & rand & malloc */
+#include <time.h> 		/* for clock_t & clock */
+
+#define DEFAULT_SIZE (1000000) /* Num of items in each run, can be changed from the command line */
+#define TO_MSEC(start, end) ( (double)((end) - (start)) * 1000.0 / CLOCKS_PER_SEC )
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert all items, walk the tree in order and remove all items, print the times
+ *
+ * @param   _name       = The name of the run to print
+ * @param   _array		= The items to insert, by the insert order
+ * @param   _nElements  = The number of items
+ */
+static void RunBenchmark(const char* _name, int* _array, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	size_t nElements = DEFAULT_SIZE;
+	size_t i;
+	size_t j;
+	int* array;
+	int temp;
+	
+	if( 1 < argc )
+	{
+		nElements = (size_t)atol(argv[1]);
+	}
+	
+	array = (int*)malloc(nElements * sizeof(int));
+	if( NULL == array )
+	{
+		return 1;
+	}
+	
+	for(i = 0; i < nElements; ++i)
+	{
+		array[i] = (int)i;
+	}
+	
+	printf("Binary tree benchmark, %lu items:\n", (unsigned long)nElements);
+	RunBenchmark("sorted", array, nElements);
+	
+	srand((unsigned)time(NULL));
+	for(i = nElements; 1 < i; --i)
+	{
+		j = ( (size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand() ) % i;
+		temp = array[i - 1];
+		array[i - 1] = array[j];
+		array[j] = temp;
+	}
+	RunBenchmark("random", array, nElements);
+	
+	free(array);
+	
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return ( *(int*)_a  < *(int*)_b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void RunBenchmark(const char* _name, int* _array, size_t _nElements)
+{
+	BSTree* tree;
+	BSTreeItr itr;
+	BSTreeItr endItr;
+	clock_t start;
+	clock_t insertEnd;
+	clock_t walkEnd;
+	clock_t removeEnd;
+	size_t counter = 0;
+	size_t i;
+	
+	tree = BSTree_Create(CompareData);
+	if( NULL == tree )
+	{
+		return;
+	}
+	
+	start = clock();
+	for(i = 0; i < _nElements; ++i)
+	{
+		BSTree_Insert(tree, &_array[i]);
+	}
+	insertEnd = clock();
+	
+	endItr = BSTreeItr_End(tree);
+	for(itr = BSTreeItr_Begin(tree); itr != endItr; itr = BSTreeItr_Next(itr))
+	{
+		++counter;
+	}
+	walkEnd = clock();
+	
+	while( NULL != (itr = BSTreeItr_Begin(tree)) )
+	{
+		BSTreeItr_Remove(tree, itr);
+	}
+	removeEnd = clock();
+	
+	BSTree_Destroy(tree, NULL);
+	
+	printf("%-8s insert: %10.2f ms   walk: %10.2f ms   remove begin: %10.2f ms   (%lu walked)\n",
+			_name, TO_MSEC(start, insertEnd), TO_MSEC(insertEnd, walkEnd),
+			TO_MSEC(walkEnd, removeEnd), (unsigned long)counter + 1);
+	
+	return;
+}
+/*----------------------------------------------------------------------------*/
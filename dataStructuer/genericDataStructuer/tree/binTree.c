@@ -5,6 +5,8 @@
  *  @details 	Implement a binary search tree ADT.
  *  			The tree is implemented using a sentinel. 
  *  			The first node in the tree is the sentinel left subtree.
+ *  			The tree is kept as a red-black tree, so the height is O(log n)
+ *  			even when the items are inserted in sorted order.
  * 
  *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
  *
@@ -24,6 +26,11 @@
 #define ROOT_FATHER (-1)
 #define RIGHT_SON  	(0)
 #define LEFT_SON  	(1)
+#define RED  		(0)
+#define BLACK  		(1)
+#define IS_RED(node)	( NULL != (node) && RED == (node)->m_color )
+#define IS_BLACK(node)	( NULL == (node) || BLACK == (node)->m_color )
+#define SUBTREE_SIZE(node)	( (NULL == (node)) ? 0 : (node)->m_size )
 
 
 
@@ -41,6 +48,9 @@ struct Node
     Node* m_father;  /* Pointer to previous node parent */
     Node* m_leftSon; /* Pointer to node with data that smaller then the current node data */
     Node* m_rightSon;/* Pointer to node with data that bigger then the current node data */
+    int m_color;	 /* RED OR BLACK, NULL sons are BLACK */
+    int m_inBlock;	 /* 1 if the node is part of the tree nodes block, so it is not freed alone */
+    size_t m_size;	 /* Number of nodes in the subtree of this node */
 };
 /*----------------------------------------------------------------------------*/
 
@@ -50,6 +60,8 @@ struct BSTree
 {
     Node* m_root; 
     LessComparator m_compare;
+    size_t m_nItems;
+    Node* m_block;	 /* The nodes of BSTree_BuildFromSorted, NULL if not built from items */
     size_t m_magicNumber;
 }; 
 /*----------------------------------------------------------------------------*/
@@ -62,8 +74,7 @@ struct BSTree
 /** 
  * @brief       Add an element to tree if it's not already there
  *              Insert element to binary tree, using the tree's comparison function
- * Average time complexity O(log n).
- * Worst: O(n)
+ * Average/Worst time complexity O(log n).
  *
  * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
  * @param       _father         = A element root
@@ -81,61 +92,136 @@ static BSTreeItr CreateNewNode(BSTree* _tree, Node* _father, int _sonDirection,
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have NO children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
+ * @brief       Rotate the subtree of _node to the left, the right son become the subtree root
  * Average/Worst time complexity O(1).
  *
- * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
- * @param       _chosenNode		= A tree iterator as Node typedef
- * @param       _ptr			= The pointer to modify for the parent
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The root of the subtree, must have a right son
+ */
+static void RotateLeft(BSTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Rotate the subtree of _node to the right, the left son become the subtree root
+ * Average/Worst time complexity O(1).
  *
- * @return      removed the node data
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The root of the subtree, must have a left son
+ */
+static void RotateRight(BSTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Restore the red-black rules after a new red node was linked to the tree
+ * Average/Worst time complexity O(log n), at most 2 rotations.
+ *
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The new node
  */
-static void* RemoveNodeWithNoChild(BSTree* _tree, Node* _chosenNode, Node* _ptr);
+static void InsertFixup(BSTree* _tree, Node* _node);
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have 1 children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
+ * @brief       Put _newNode (can be NULL) in the place of _oldNode under _oldNode father
  * Average/Worst time complexity O(1).
  *
- * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _oldNode		= The node to replace
+ * @param       _newNode		= The node that take the place, can be NULL
+ */
+static void Transplant(BSTree* _tree, Node* _oldNode, Node* _newNode);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Unlink a node from the tree, free it and return it's data
+ * @details     A node with 2 children is replaced by the next node in order, the nodes
+ *				are relinked (not the data), so iterators to other elements stay valid.
+ * Average/Worst time complexity O(log n).
+ *
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
  * @param       _chosenNode     = A tree iterator as Node typedef
  *
  * @return      removed the node data
  */
-static void* RemoveNodeWithOneChild(BSTree* _tree, Node* _chosenNode);
+static void* RemoveNode(BSTree* _tree, Node* _chosenNode);
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have 2 children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
- * Average/Worst time complexity O(n).
+ * @brief       Restore the red-black rules after a black node was unlinked from the tree
+ * Average/Worst time complexity O(log n), at most 3 rotations.
  *
  * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
- * @param       _chosenNode     =       A tree iterator as Node typedef
+ * @param       _node     		= The node that took the removed place, can be NULL
+ * @param       _father     	= The father of _node
+ */
+static void RemoveFixup(BSTree* _tree, Node* _node, Node* _father);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Create a tree and link all it's nodes, taken from one allocation, to _items
+ * Average/Worst time complexity O(n).
  *
- * @return      removed the node data
+ * @param       _less         	= A comparison function
+ * @param       _items     		= Sorted items with no duplicates
+ * @param       _nItems     	= The number of items
+ *
+ * @return      The new tree OR NULL on allocation failure
+ */
+static BSTree* BuildTree(LessComparator _less, void** _items, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Link _nodes[0 .. _nItems - 1] as a balanced subtree of _items, the middle is the root
+ * @details     Nodes at the deepest level of the tree are red and all the others are black,
+ *				so every path from the root to NULL have the same number of black nodes.
+ * Average/Worst time complexity O(n), recursion depth O(log n).
+ *
+ * @param       _nodes         	= The nodes of the subtree
+ * @param       _items     		= The items of the subtree
+ * @param       _nItems     	= The number of items in the subtree
+ * @param       _father     	= The father of the subtree root
+ * @param       _redDepth     	= The depth of the subtree root to the red level, 0 if the root is red
+ *
+ * @return      The subtree root OR NULL if _nItems is 0
+ */
+static Node* BuildSubtree(Node* _nodes, void** _items, size_t _nItems, Node* _father, size_t _redDepth);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Get the next node in order OR NULL if _node is the last one
+ * Average time complexity O(1), Worst O(log n).
  */
-static void* RemoveNodeWithTwoChild(BSTree* _tree, Node* _chosenNode);
+static Node* NextOrNull(Node* _node);
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       call the right function to remove all link of a Node according to it's number of children
+ * @brief       Get the first node of _node subtree in PostOrder, the deepest node on the left side
+ * Average/Worst time complexity O(log n).
  *
- * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
- * @param       _chosenNode     = A tree iterator as Node typedef
+ * @param       _node     		= The root of the subtree, can be NULL
  *
- * @return      removed the node data
+ * @return      The first node OR NULL if _node is NULL
  */
-static void* OptNodeChild(BSTree* _tree, Node* _chosenNode);
-/*----------------------------------------------------------------------------*/                                                    
+static Node* PostOrderFirst(Node* _node);
+/*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
@@ -147,13 +233,14 @@ static void* OptNodeChild(BSTree* _tree, Node* _chosenNode);
  *			1. Check current node and preform an action
  *			2. Traverse the left subtree
  *			3. Traverse the right subtree
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachPreOrder(BSTreeItr _itr, ActionFunction _action, void* _context);
 /*----------------------------------------------------------------------------*/
@@ -168,13 +255,14 @@ static BSTreeItr ForEachPreOrder(BSTreeItr _itr, ActionFunction _action, void* _
  *			1. Traverse the left subtree
  *			2. Check current node and preform an action
  *			3. Traverse the right subtree
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachInOrder(BSTreeItr _itr, ActionFunction _action, void* _context);
 /*----------------------------------------------------------------------------*/
@@ -189,13 +277,14 @@ static BSTreeItr ForEachInOrder(BSTreeItr _itr, ActionFunction _action, void* _c
  *			1. Traverse the left subtree
  *			2. Traverse the right subtree
  *			3. Check current node and preform an action
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachPostOrder(BSTreeItr _itr, ActionFunction _action, void* _context);
 /*----------------------------------------------------------------------------*/
@@ -235,6 +324,108 @@ BSTree* BSTree_Create(LessComparator _less)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Create a balanced tree from sorted items
+ * @details All the nodes are taken from one allocation and linked in one pass.
+ *			A removed node of that allocation is released only when the tree is destroyed.
+ * @Complexity	O(n)
+ *
+ * @param   less			= A comparison function, as in BSTree_Create
+ * @param   items			= Array of _nItems items sorted by _less, with no duplicates
+ * @param   nItems			= The number of items
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ *							  OR if the items are not sorted without duplicates
+ */
+BSTree* BSTree_BuildFromSorted(LessComparator _less, void** _items, size_t _nItems)
+{
+	size_t i;
+	
+	CHECK_NULL(_less);
+	if( 0 != _nItems )
+	{
+		CHECK_NULL(_items);
+	}
+	
+	for(i = 0; i < _nItems; ++i)
+	{
+		CHECK_NULL(_items[i]);
+		if( 0 < i && 0 == _less(_items[i - 1], _items[i]) )
+		{
+			return NULL;
+		}
+	}
+	
+	return BuildTree(_less, _items, _nItems);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Create a balanced tree with the items of two trees
+ * @details The trees are walked together in order and the new tree is built as in
+ *			BSTree_BuildFromSorted. The two trees are not changed, the items are shared,
+ *			so destroy the old trees with NULL destroyer. An item of _second that is
+ *			equal to an item of _first is not taken. The new tree use _first less function.
+ * @Complexity	O(n + m)
+ *
+ * @param   first			= A previously created Tree ADT returned via BSTreeCreate
+ * @param   second			= A tree with the same less function as _first
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On allocation failure OR uninitialized pointer given
+ */
+BSTree* BSTree_Merge(const BSTree* _first, const BSTree* _second)
+{
+	BSTree* newTree;
+	void** items;
+	Node* first;
+	Node* second;
+	size_t nItems = 0;
+	
+	CHECK_NULL(_first);
+	CHECK_NULL(_second);
+	
+	items = (void**)malloc( (_first->m_nItems + _second->m_nItems + 1) * sizeof(void*) );
+	CHECK_NULL(items);
+	
+	first = (0 == _first->m_nItems) ? NULL : BSTreeItr_Begin(_first);
+	second = (0 == _second->m_nItems) ? NULL : BSTreeItr_Begin(_second);
+	
+	/* Next of the last node return it self, so it is the end of each walk */
+	while( NULL != first || NULL != second )
+	{
+		if( NULL == second || (NULL != first && 0 == _first->m_compare(second->m_data, first->m_data)) )
+		{
+			if( NULL != second && 0 == _first->m_compare(first->m_data, second->m_data) )
+			{
+				second = NextOrNull(second);
+			}
+			items[nItems++] = first->m_data;
+			first = NextOrNull(first);
+		}
+		else
+		{
+			items[nItems++] = second->m_data;
+			second = NextOrNull(second);
+		}
+	}
+	
+	newTree = BuildTree(_first->m_compare, items, nItems);
+	free(items);
+	
+	return newTree;
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief   Destroy tree
@@ -249,27 +440,56 @@ BSTree* BSTree_Create(LessComparator _less)
  */
 void BSTree_Destroy(BSTree* _tree, void (*_destroyer)(void *) )
 {
-	Node* current = BSTreeItr_Begin(_tree);
-	Node* endItr = BSTreeItr_End(_tree);
-	Node* tempItr;
+	Node* current;
+	Node* father;
 	
     if(NULL == _tree || _tree->m_magicNumber != MAGIC_NUMBER)
     {
     	return;
     }
     
-	while( endItr != current)  
+    /* Post order: a node is freed only after both of it's subtrees, so no freed node is visited again */
+    current = _tree->m_root;
+	while( NULL != current )  
 	{
+		if( NULL != current->m_leftSon )
+		{
+			current = current->m_leftSon;
+			continue;
+		}
+		
+		if( NULL != current->m_rightSon )
+		{
+			current = current->m_rightSon;
+			continue;
+		}
+		
+		father = current->m_father;
+		if( NULL != father )
+		{
+			if( father->m_leftSon == current )
+			{
+				father->m_leftSon = NULL;
+			}
+			else
+			{
+				father->m_rightSon = NULL;
+			}
+		}
+		
 		if( NULL != _destroyer )
 		{
 			_destroyer(current->m_data);
 		}
 		
-		tempItr = BSTreeItr_Next(current);
-		free(current);
-		current = tempItr;
+		if( !current->m_inBlock )
+		{
+			free(current);
+		}
+		current = father;
 	}
 	
+	free(_tree->m_block);
 	_tree->m_magicNumber = 987654321;
     free(_tree);
     
@@ -282,8 +502,7 @@ void BSTree_Destroy(BSTree* _tree, void (*_destroyer)(void *) )
 /** 
  * @brief   Add an element to tree if it's not already there
  * @details Insert element to binary tree, using the tree's comparison function
- * @Complexity 	Average O(log n).
- * 				Worst 	O(n)
+ * @Complexity 	Average/Worst O(log n).
  *
  * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
  * @param   item           	= An item to add to the tree
@@ -386,190 +605,483 @@ BSTreeItr BSTree_FindFirst(const BSTree* _tree, PredicateFunction _predicate, vo
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief   Get an in-order itertator to the tree's begin 
- * @Complexity O(log n)
+ * @brief   Search an element equal to _key, using the tree's comparison function
+ * @details Two elements are equal if none of them is less then the other
+ * @Complexity  O(log n)
  *
- * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
  *
- * @return  An iterator pointing at the tree's begin: 
+ * @return  An iterator pointing to the element found:
  *
- * @retval  NULL            = On NULL input
- * @retval  Iterator begin  = On success
- * @retval  Iterator end  	= If tree is empty
+ * @retval  NULL            = On NULL input OR when the element NOT found
+ * @retval  Iterator found  = When the element found
  */
-BSTreeItr BSTreeItr_Begin(const BSTree* _tree)
+BSTreeItr BSTree_Find(const BSTree* _tree, void* _key)
 {
 	Node* current;
 	
 	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
 	
 	current = _tree->m_root;
-	CHECK_NULL(current);
 	
-	while( NULL != current->m_leftSon )
+	while( NULL != current )
 	{
-		current = current->m_leftSon;
+		if( 0 != _tree->m_compare(_key, current->m_data) )
+		{
+			current = current->m_leftSon;
+		}
+		else if( 0 != _tree->m_compare(current->m_data, _key) )
+		{
+			current = current->m_rightSon;
+		}
+		else
+		{
+			return (BSTreeItr)current;
+		}
 	}
 	
-	return (BSTreeItr)current;
+	return NULL;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief   Get itertator to the tree's end (in order)
+ * @brief   Get iterator to the first element that is NOT less then _key
  * @Complexity  O(log n)
  *
- * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
  *
- * @return  An iterator pointing at the tree's end: 
+ * @return  An iterator pointing to the element found:
  *
- * @retval  NULL            = On NULL input
- * @retval  Iterator end   	= On success
+ * @retval  NULL            = On NULL input OR when all the elements are less then _key
+ * @retval  Iterator found  = The first element >= _key
  */
-BSTreeItr BSTreeItr_End(const BSTree* _tree)
+BSTreeItr BSTree_LowerBound(const BSTree* _tree, void* _key)
 {
 	Node* current;
+	Node* found = NULL;
 	
 	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
 	
 	current = _tree->m_root;
-	CHECK_NULL(current);
 	
-	while( NULL != current->m_rightSon )
+	/* The last node we turned left at is the smallest one that is not less then _key */
+	while( NULL != current )
 	{
-		current = current->m_rightSon;
+		if( 0 != _tree->m_compare(current->m_data, _key) )
+		{
+			current = current->m_rightSon;
+		}
+		else
+		{
+			found = current;
+			current = current->m_leftSon;
+		}
 	}
 	
-	return (BSTreeItr)current;
-}
-/*----------------------------------------------------------------------------*/
-
-
-/*----------------------------------------------------------------------------*/
-/** 
- * @brief   Compare two iterators
- *
- * @param   a          		= First iterator
- * @param   b          		= Iterator to compare to the first
- *
- * @return  Status of the compare result: 
- *  
- * @retval  0 				= If are not the same 
- * @retval  1 				= If iterators are the same
- *
- * @warning if both ListItr are uninitialized the result will be 1  
- */
-int BSTreeItr_Equals(BSTreeItr _a, BSTreeItr _b)
-{
-	return ( _a == _b );
+	return (BSTreeItr)found;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief   Get itertator to the next element from a given iterator
- * @warning if _itr is end iterator it will be returned
+ * @brief   Get iterator to the first element that is greater then _key
+ * @Complexity  O(log n)
  *
- * @param   it                            	=   Pointer to current iterator 
+ * @param   tree            = A previously created Tree ADT returned via BSTreeCreate
+ * @param   key             = An item to compare the elements to
  *
- * @return  BSTreeItr pointer:
+ * @return  An iterator pointing to the element found:
  *
- * @retval  All iterator exclude the end    =   Iterator pointing at the next tree's iterator
- * @retval  At end of the list              =   Iterator pointing at itself 
- * @retval  NULL              				=   If pointer is uninitialized     
+ * @retval  NULL            = On NULL input OR when no element is greater then _key
+ * @retval  Iterator found  = The first element > _key
  */
-BSTreeItr BSTreeItr_Next(BSTreeItr _it)
+BSTreeItr BSTree_UpperBound(const BSTree* _tree, void* _key)
 {
-	Node* currentNode = (Node*)_it;
+	Node* current;
+	Node* found = NULL;
 	
-	CHECK_NULL(_it);
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
 	
-	/* If there is no RIGHT son: then find the first father that the currentNode is his LEFT son */
-	if( NULL == currentNode->m_rightSon )
+	current = _tree->m_root;
+	
+	/* The last node we turned left at is the smallest one that is greater then _key */
+	while( NULL != current )
 	{
-		while( NULL != currentNode  && (currentNode->m_father->m_leftSon != currentNode) )
+		if( 0 != _tree->m_compare(_key, current->m_data) )
 		{
-			currentNode = currentNode->m_father; 	
+			found = current;
+			current = current->m_leftSon;
 		}
-		
-		if(NULL == currentNode) /* _it == the end */
+		else
 		{
-			return _it;
+			current = current->m_rightSon;
 		}
-		
-		return (BSTreeItr)(currentNode->m_father);
-	}
-	/* If there is a RIGHT son: then find the last LEFT son of the currentNode RIGHT son */
-	currentNode = currentNode->m_rightSon;
-	 
-	while( NULL != currentNode->m_leftSon )
-	{
-		currentNode = currentNode->m_leftSon; 	
 	}
 	
-	return (BSTreeItr)currentNode;
+	return (BSTreeItr)found;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief   Get itertator to the previous element from a given iterator
- * @warning if _itr is begin iterator it will be returned
+ * @brief   Performs an action function on every element in the range [_low, _high], in order
+ * @details Iteration will stop on the first element for which action returns a zero
+ *          or after the last element that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of elements in the range
  *
- * @param   it                            	=   Pointer to current iterator 
+ * @param   tree           	=       Tree to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each element
+ * @param   context        	=       Parameters for the function
  *
- * @return  BSTreeItr pointer:
+ * @return  Iterator to the specific element where action returned zero value
  *
- * @retval  All iterator exclude the begin  =   Iterator pointing at the previous tree's iterator
- * @retval  At begin of the list            =   Iterator pointing at itself 
- * @retval  NULL              				=   If pointer is uninitialized     
+ * @retval  iterator        =   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
  */
-BSTreeItr BSTreeItr_Prev(BSTreeItr _it)
+BSTreeItr BSTree_Range(const BSTree* _tree, void* _low, void* _high,
+                 ActionFunction _action, void* _context)
 {
-	Node* currentNode = (Node*)_it;
+	Node* current;
+	Node* next;
 	
-	CHECK_NULL(_it);
+	CHECK_NULL(_tree);
+	CHECK_NULL(_high);
+	CHECK_NULL(_action);
 	
-	/* If there is no LEFT son: then find the first father that the currentNode is his RIGHT son */
-	if( NULL == currentNode->m_leftSon )
+	current = BSTree_LowerBound(_tree, _low);
+	
+	while( NULL != current && 0 == _tree->m_compare(_high, current->m_data) )
 	{
-		while( NULL != currentNode  && (currentNode->m_father->m_rightSon != currentNode) )
+		if( 0 == _action(current->m_data, _context) )
 		{
-			currentNode = currentNode->m_father; 	
+			return (BSTreeItr)current;
 		}
 		
-		if(NULL == currentNode) /* _it == the beginning */
+		next = BSTreeItr_Next(current);
+		if( next == current ) /* current == the end */
 		{
-			return _it;
+			break;
 		}
 		
-		return (BSTreeItr)(currentNode->m_father);
-	}
-	/* If there is a LEFT son: then find the last RIGHT son of the currentNode LEFT son */
-	currentNode = currentNode->m_leftSon;
-	 
-	while( NULL != currentNode->m_rightSon )
-	{
-		currentNode = currentNode->m_rightSon; 	
+		current = next;
 	}
 	
-	return (BSTreeItr)currentNode;
+	return NULL;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief 	Removes the BSTreeItr the current iterator is pointing at
- * @details Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
- * @Complexity 	Best 	O(1) -	If the current iterator have no more the 1 child.
- * 				Worst 	O(n) -	If the current iterator and all the next have 2 children.
+ * @brief   Get the number of elements in the tree
+ * @Complexity  O(1) 
  *
- * @param   it         		=   Pointer to Tree itself- use in case of removing the root
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ *
+ * @retval  number          = Number of elements in the tree, 0 on NULL input
+ */
+size_t BSTree_Size(const BSTree* _tree)
+{
+	if( NULL == _tree )
+	{
+		return 0;
+	}
+	
+	return _tree->m_nItems;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get iterator to the element at position _index in order (0 is the smallest)
+ * @details Every node keep the size of it's subtree, so the search go down one path.
+ * @Complexity  O(log n) 
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   index           = The position of the element, 0 to (size - 1)
+ *
+ * @return  Iterator to the element at the position
+ *
+ * @retval  NULL            = On NULL input OR when _index is not less then the tree size
+ * @retval  Iterator found  = The element that have exactly _index elements before it
+ */
+BSTreeItr BSTree_Select(const BSTree* _tree, size_t _index)
+{
+	Node* current;
+	size_t leftSize;
+	
+	CHECK_NULL(_tree);
+	
+	if( _index >= _tree->m_nItems )
+	{
+		return NULL;
+	}
+	
+	current = _tree->m_root;
+	
+	while( NULL != current )
+	{
+		leftSize = SUBTREE_SIZE(current->m_leftSon);
+		
+		if( _index < leftSize )
+		{
+			current = current->m_leftSon;
+		}
+		else if( _index > leftSize )
+		{
+			_index -= leftSize + 1;
+			current = current->m_rightSon;
+		}
+		else
+		{
+			break;
+		}
+	}
+	
+	return (BSTreeItr)current;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get the number of elements in the tree that are less then _key
+ * @details If _key is in the tree this is it's position, as given to BSTree_Select.
+ * @Complexity  O(log n) 
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   key           	= An item to compare the elements to
+ *
+ * @retval  number          = Number of elements less then _key, 0 on NULL input
+ */
+size_t BSTree_Rank(const BSTree* _tree, void* _key)
+{
+	Node* current;
+	size_t rank = 0;
+	
+	if( NULL == _tree || NULL == _key )
+	{
+		return 0;
+	}
+	
+	current = _tree->m_root;
+	
+	while( NULL != current )
+	{
+		if( 0 != _tree->m_compare(current->m_data, _key) )
+		{
+			/* current and all it's left subtree are less then _key */
+			rank += SUBTREE_SIZE(current->m_leftSon) + 1;
+			current = current->m_rightSon;
+		}
+		else
+		{
+			current = current->m_leftSon;
+		}
+	}
+	
+	return rank;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get an in-order itertator to the tree's begin 
+ * @Complexity O(log n)
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ *
+ * @return  An iterator pointing at the tree's begin: 
+ *
+ * @retval  NULL            = On NULL input
+ * @retval  Iterator begin  = On success
+ * @retval  Iterator end  	= If tree is empty
+ */
+BSTreeItr BSTreeItr_Begin(const BSTree* _tree)
+{
+	Node* current;
+	
+	CHECK_NULL(_tree);
+	
+	current = _tree->m_root;
+	CHECK_NULL(current);
+	
+	while( NULL != current->m_leftSon )
+	{
+		current = current->m_leftSon;
+	}
+	
+	return (BSTreeItr)current;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get itertator to the tree's end (in order)
+ * @Complexity  O(log n)
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ *
+ * @return  An iterator pointing at the tree's end: 
+ *
+ * @retval  NULL            = On NULL input
+ * @retval  Iterator end   	= On success
+ */
+BSTreeItr BSTreeItr_End(const BSTree* _tree)
+{
+	Node* current;
+	
+	CHECK_NULL(_tree);
+	
+	current = _tree->m_root;
+	CHECK_NULL(current);
+	
+	while( NULL != current->m_rightSon )
+	{
+		current = current->m_rightSon;
+	}
+	
+	return (BSTreeItr)current;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Compare two iterators
+ *
+ * @param   a          		= First iterator
+ * @param   b          		= Iterator to compare to the first
+ *
+ * @return  Status of the compare result: 
+ *  
+ * @retval  0 				= If are not the same 
+ * @retval  1 				= If iterators are the same
+ *
+ * @warning if both ListItr are uninitialized the result will be 1  
+ */
+int BSTreeItr_Equals(BSTreeItr _a, BSTreeItr _b)
+{
+	return ( _a == _b );
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get itertator to the next element from a given iterator
+ * @warning if _itr is end iterator it will be returned
+ *
+ * @param   it                            	=   Pointer to current iterator 
+ *
+ * @return  BSTreeItr pointer:
+ *
+ * @retval  All iterator exclude the end    =   Iterator pointing at the next tree's iterator
+ * @retval  At end of the list              =   Iterator pointing at itself 
+ * @retval  NULL              				=   If pointer is uninitialized     
+ */
+BSTreeItr BSTreeItr_Next(BSTreeItr _it)
+{
+	Node* currentNode = (Node*)_it;
+	
+	CHECK_NULL(_it);
+	
+	/* If there is no RIGHT son: then find the first father that the currentNode is his LEFT son */
+	if( NULL == currentNode->m_rightSon )
+	{
+		while( NULL != currentNode->m_father && (currentNode->m_father->m_leftSon != currentNode) )
+		{
+			currentNode = currentNode->m_father; 	
+		}
+		
+		if(NULL == currentNode->m_father) /* _it == the end */
+		{
+			return _it;
+		}
+		
+		return (BSTreeItr)(currentNode->m_father);
+	}
+	/* If there is a RIGHT son: then find the last LEFT son of the currentNode RIGHT son */
+	currentNode = currentNode->m_rightSon;
+	 
+	while( NULL != currentNode->m_leftSon )
+	{
+		currentNode = currentNode->m_leftSon; 	
+	}
+	
+	return (BSTreeItr)currentNode;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Get itertator to the previous element from a given iterator
+ * @warning if _itr is begin iterator it will be returned
+ *
+ * @param   it                            	=   Pointer to current iterator 
+ *
+ * @return  BSTreeItr pointer:
+ *
+ * @retval  All iterator exclude the begin  =   Iterator pointing at the previous tree's iterator
+ * @retval  At begin of the list            =   Iterator pointing at itself 
+ * @retval  NULL              				=   If pointer is uninitialized     
+ */
+BSTreeItr BSTreeItr_Prev(BSTreeItr _it)
+{
+	Node* currentNode = (Node*)_it;
+	
+	CHECK_NULL(_it);
+	
+	/* If there is no LEFT son: then find the first father that the currentNode is his RIGHT son */
+	if( NULL == currentNode->m_leftSon )
+	{
+		while( NULL != currentNode->m_father && (currentNode->m_father->m_rightSon != currentNode) )
+		{
+			currentNode = currentNode->m_father; 	
+		}
+		
+		if(NULL == currentNode->m_father) /* _it == the beginning */
+		{
+			return _it;
+		}
+		
+		return (BSTreeItr)(currentNode->m_father);
+	}
+	/* If there is a LEFT son: then find the last RIGHT son of the currentNode LEFT son */
+	currentNode = currentNode->m_leftSon;
+	 
+	while( NULL != currentNode->m_rightSon )
+	{
+		currentNode = currentNode->m_rightSon; 	
+	}
+	
+	return (BSTreeItr)currentNode;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief 	Removes the BSTreeItr the current iterator is pointing at
+ * @details Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
+ * @Complexity 	Average/Worst O(log n).
+ *
+ * @param   it         		=   Pointer to Tree itself- use in case of removing the root
  * @param   it         		=   Pointer to current iterator to remove
  *
  * @return  Element data pointer:
@@ -584,7 +1096,7 @@ void* BSTreeItr_Remove(BSTree* _tree, BSTreeItr _it)
 	CHECK_NULL(_tree);
 	CHECK_NULL(_it);
 	
-	return OptNodeChild(_tree, current);
+	return RemoveNode(_tree, current);
 }
 /*----------------------------------------------------------------------------*/
 
@@ -612,8 +1124,9 @@ void* BSTreeItr_Get(BSTreeItr _it)
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief   Performs an action function on every element in tree, by given traversal mode
- * @details Iteration will on the first element for which action returns a zero
- *          or on reaching end of the container
+ * @details Iteration will stop on the first element for which action returns a zero
+ *          or on reaching end of the container.
+ *			The walk is not recursive and use no extra memory, so any tree depth is fine.
  * @Complexity  O(n)
  *
  * @param   tree           	=       Tree to iterate over
@@ -652,15 +1165,110 @@ BSTreeItr BSTree_ForEach(const BSTree* _tree, BSTreeTraversalMode _mode,
 			break;
 	}
 	
-	if( NULL == result )
+	if( NULL == result )
+	{
+		result = BSTreeItr_End(_tree);
+	}
+	
+	return result;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+#ifdef BSTREE_CHECK
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief   Check the tree keeps the rules of the implementation, for the unit tests
+ * @details The items are in order by less, every son points back to it's father,
+ *			every subtree size is right, no red node has a red father and every path
+ *			from the root to a NULL son has the same num of black nodes.
+ *			Compiled only when BSTREE_CHECK is defined, the tree makefile defines it.
+ * @Complexity  O(n log n)
+ *
+ * @param   tree           	= A previously created Tree ADT returned via BSTreeCreate
+ * @param   height         	= Pointer to get the num of nodes on the longest path from the root, can be NULL
+ *
+ * @return  Status of the check:
+ *
+ * @retval  1 				= If the tree keeps all the rules
+ * @retval  0 				= If a rule is broken OR tree is uninitialized
+ */
+int BSTree_CheckInvariants(const BSTree* _tree, size_t* _height)
+{
+	Node* node;
+	Node* prev = NULL;
+	Node* current;
+	size_t nNodes = 0;
+	size_t depth;
+	size_t nBlack;
+	size_t pathBlack = 0;
+	size_t maxDepth = 0;
+	
+	if( NULL == _tree || (NULL != _tree->m_root && NULL != _tree->m_root->m_father) )
+	{
+		return 0;
+	}
+	
+	for(node = (Node*)BSTreeItr_Begin(_tree); NULL != node; node = NextOrNull(node))
 	{
-		result = BSTreeItr_End(_tree);
+		++nNodes;
+		
+		if( (NULL != node->m_leftSon && node != node->m_leftSon->m_father)
+			|| (NULL != node->m_rightSon && node != node->m_rightSon->m_father) )
+		{
+			return 0;
+		}
+		
+		if( node->m_size != 1 + SUBTREE_SIZE(node->m_leftSon) + SUBTREE_SIZE(node->m_rightSon) )
+		{
+			return 0;
+		}
+		
+		if( IS_RED(node) && IS_RED(node->m_father) )
+		{
+			return 0;
+		}
+		
+		if( NULL != prev && !_tree->m_compare(prev->m_data, node->m_data) )
+		{
+			return 0;
+		}
+		prev = node;
+		
+		/* A path ends at a NULL son, count from the node up to the root */
+		if( NULL == node->m_leftSon || NULL == node->m_rightSon )
+		{
+			depth = 0;
+			nBlack = 0;
+			for(current = node; NULL != current; current = current->m_father)
+			{
+				++depth;
+				nBlack += (size_t)IS_BLACK(current);
+			}
+			
+			if( 0 == maxDepth )
+			{
+				pathBlack = nBlack;
+			}
+			else if( pathBlack != nBlack )
+			{
+				return 0;
+			}
+			
+			maxDepth = ( depth > maxDepth ) ? depth : maxDepth;
+		}
 	}
 	
-	return result;
+	if( NULL != _height )
+	{
+		*_height = maxDepth;
+	}
+	
+	return ( nNodes == _tree->m_nItems );
 }
 /*----------------------------------------------------------------------------*/
-
+#endif /* BSTREE_CHECK */
 
 
 
@@ -670,8 +1278,7 @@ BSTreeItr BSTree_ForEach(const BSTree* _tree, BSTreeTraversalMode _mode,
 /** 
  * @brief       Add an element to tree if it's not already there
  *              Insert element to binary tree, using the tree's comparison function
- * Average time complexity O(log n).
- * Worst: O(n)
+ * Average/Worst time complexity O(log n).
  *
  * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
  * @param       _father         = A element root
@@ -686,20 +1293,27 @@ BSTreeItr BSTree_ForEach(const BSTree* _tree, BSTreeTraversalMode _mode,
 static BSTreeItr CreateNewNode(BSTree* _tree, Node* _father, int _sonDirection, void* _item)
 {
 	Node* newNode;
+	Node* current;
 	
 	newNode = (Node*)calloc( 1, sizeof (Node) );
 	CHECK_NULL(newNode);
 	
 	newNode->m_data = _item;
 	newNode->m_father = _father;
+	newNode->m_color = RED;
+	newNode->m_size = 1;
+	
+	for(current = _father; NULL != current; current = current->m_father)
+	{
+		++current->m_size;
+	}
+	++_tree->m_nItems;
 	
 	if( ROOT_FATHER == _sonDirection )
 	{
 		_tree->m_root = newNode;
-		return (BSTreeItr)newNode;
 	}
-	
-	if( RIGHT_SON == _sonDirection )
+	else if( RIGHT_SON == _sonDirection )
 	{
 		_father->m_rightSon = newNode;
 	}
@@ -708,6 +1322,8 @@ static BSTreeItr CreateNewNode(BSTree* _tree, Node* _father, int _sonDirection,
 		_father->m_leftSon = newNode;
 	}
 	
+	InsertFixup(_tree, newNode);
+	
 	return (BSTreeItr)newNode;
 }
 /*----------------------------------------------------------------------------*/
@@ -715,100 +1331,265 @@ static BSTreeItr CreateNewNode(BSTree* _tree, Node* _father, int _sonDirection,
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have NO children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
+ * @brief       Rotate the subtree of _node to the left, the right son become the subtree root
  * Average/Worst time complexity O(1).
  *
- * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
- * @param       _chosenNode		= A tree iterator as Node typedef
- * @param       _ptr			= The pointer to modify for the parent
- *
- * @return      removed the node data
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The root of the subtree, must have a right son
  */
-static void* RemoveNodeWithNoChild(BSTree* _tree, Node* _chosenNode, Node* _ptr)
+static void RotateLeft(BSTree* _tree, Node* _node)
 {
-	void* tempData = _chosenNode->m_data;
-	
-	/* If this node is the root: */
-	if( NULL == _chosenNode->m_father )
+	Node* son = _node->m_rightSon;
+
+	_node->m_rightSon = son->m_leftSon;
+	if( NULL != son->m_leftSon )
 	{
-		_tree->m_root = _ptr;
-		free(_chosenNode);
-		return tempData;
+		son->m_leftSon->m_father = _node;
 	}
-	
-	if( _chosenNode->m_father->m_rightSon == _chosenNode )
+
+	Transplant(_tree, _node, son);
+
+	son->m_leftSon = _node;
+	_node->m_father = son;
+
+	son->m_size = _node->m_size;
+	_node->m_size = SUBTREE_SIZE(_node->m_leftSon) + SUBTREE_SIZE(_node->m_rightSon) + 1;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Rotate the subtree of _node to the right, the left son become the subtree root
+ * Average/Worst time complexity O(1).
+ *
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The root of the subtree, must have a left son
+ */
+static void RotateRight(BSTree* _tree, Node* _node)
+{
+	Node* son = _node->m_leftSon;
+
+	_node->m_leftSon = son->m_rightSon;
+	if( NULL != son->m_rightSon )
 	{
-		_chosenNode->m_father->m_rightSon = _ptr;
+		son->m_rightSon->m_father = _node;
 	}
-	else
+
+	Transplant(_tree, _node, son);
+
+	son->m_rightSon = _node;
+	_node->m_father = son;
+
+	son->m_size = _node->m_size;
+	_node->m_size = SUBTREE_SIZE(_node->m_leftSon) + SUBTREE_SIZE(_node->m_rightSon) + 1;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Restore the red-black rules after a new red node was linked to the tree
+ * Average/Worst time complexity O(log n), at most 2 rotations.
+ *
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _node			= The new node
+ */
+static void InsertFixup(BSTree* _tree, Node* _node)
+{
+	Node* father;
+	Node* grandFather;
+	Node* uncle;
+
+	/* A red father is never the root, so the grand father exist */
+	while( IS_RED(_node->m_father) )
 	{
-		_chosenNode->m_father->m_leftSon = _ptr;
+		father = _node->m_father;
+		grandFather = father->m_father;
+
+		if( father == grandFather->m_leftSon )
+		{
+			uncle = grandFather->m_rightSon;
+
+			if( IS_RED(uncle) )
+			{
+				/* Push the black down from the grand father and continue from it */
+				father->m_color = BLACK;
+				uncle->m_color = BLACK;
+				grandFather->m_color = RED;
+				_node = grandFather;
+				continue;
+			}
+
+			if( _node == father->m_rightSon )
+			{
+				_node = father;
+				RotateLeft(_tree, _node);
+				father = _node->m_father;
+			}
+
+			father->m_color = BLACK;
+			grandFather->m_color = RED;
+			RotateRight(_tree, grandFather);
+		}
+		else
+		{
+			uncle = grandFather->m_leftSon;
+
+			if( IS_RED(uncle) )
+			{
+				father->m_color = BLACK;
+				uncle->m_color = BLACK;
+				grandFather->m_color = RED;
+				_node = grandFather;
+				continue;
+			}
+
+			if( _node == father->m_leftSon )
+			{
+				_node = father;
+				RotateRight(_tree, _node);
+				father = _node->m_father;
+			}
+
+			father->m_color = BLACK;
+			grandFather->m_color = RED;
+			RotateLeft(_tree, grandFather);
+		}
 	}
-	
-	free(_chosenNode);
-	
-	return tempData;
+
+	_tree->m_root->m_color = BLACK;
+
+	return;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have 1 children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
+ * @brief       Put _newNode (can be NULL) in the place of _oldNode under _oldNode father
  * Average/Worst time complexity O(1).
  *
- * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate 
- * @param       _chosenNode     = A tree iterator as Node typedef
- *
- * @return      removed the node data
+ * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
+ * @param       _oldNode		= The node to replace
+ * @param       _newNode		= The node that take the place, can be NULL
  */
-static void* RemoveNodeWithOneChild(BSTree* _tree, Node* _chosenNode)
+static void Transplant(BSTree* _tree, Node* _oldNode, Node* _newNode)
 {
-	Node* child;
-	
-	/* Connect pointers in the child node: */
-	if( NULL == _chosenNode->m_rightSon )
+	/* If this node is the root: */
+	if( NULL == _oldNode->m_father )
 	{
-		_chosenNode->m_leftSon->m_father = _chosenNode->m_father;
-		child = _chosenNode->m_leftSon;
+		_tree->m_root = _newNode;
+	}
+	else if( _oldNode->m_father->m_leftSon == _oldNode )
+	{
+		_oldNode->m_father->m_leftSon = _newNode;
 	}
 	else
 	{
-		_chosenNode->m_rightSon->m_father = _chosenNode->m_father;
-		child = _chosenNode->m_rightSon;
+		_oldNode->m_father->m_rightSon = _newNode;
 	}
-	
-	return RemoveNodeWithNoChild(_tree, _chosenNode, child); /* Connect pointers in the parent node */
+
+	if( NULL != _newNode )
+	{
+		_newNode->m_father = _oldNode->m_father;
+	}
+
+	return;
 }
 /*----------------------------------------------------------------------------*/
 
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       Remove an element (that have 2 children) from tree and return it's data
- * @details     Remove element pointed to by _it and rearranges the tree so that it maintains binary search tree arrangement
- * Average/Worst time complexity O(n).
+ * @brief       Unlink a node from the tree, free it and return it's data
+ * @details     A node with 2 children is replaced by the next node in order, the nodes
+ *				are relinked (not the data), so iterators to other elements stay valid.
+ * Average/Worst time complexity O(log n).
  *
  * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
- * @param       _chosenNode     =       A tree iterator as Node typedef
+ * @param       _chosenNode     = A tree iterator as Node typedef
  *
  * @return      removed the node data
  */
-static void* RemoveNodeWithTwoChild(BSTree* _tree, Node* _chosenNode)
+static void* RemoveNode(BSTree* _tree, Node* _chosenNode)
 {
-	Node* nextNode;
-	void* tempData = _chosenNode->m_data; 
-	
-	/* found the the next element after the chosen node */
-	nextNode = (Node*)BSTreeItr_Next( (BSTreeItr)_chosenNode ); 
-	
-	/* copy the data to the current node */
-	_chosenNode->m_data = nextNode->m_data;
+	Node* nextNode = _chosenNode;
+	Node* child;
+	Node* childFather;
+	Node* current;
+	int removedColor = _chosenNode->m_color;
+	void* tempData = _chosenNode->m_data;
+
+	/* The node that is unlinked from it's place is the next node if there are 2 children */
+	if( NULL != _chosenNode->m_leftSon && NULL != _chosenNode->m_rightSon )
+	{
+		nextNode = _chosenNode->m_rightSon;
+		while( NULL != nextNode->m_leftSon )
+		{
+			nextNode = nextNode->m_leftSon;
+		}
+	}
+
+	for(current = nextNode->m_father; NULL != current; current = current->m_father)
+	{
+		--current->m_size;
+	}
+	--_tree->m_nItems;
+
+	/* Option 1: the itr have NO children OR only right child */
+	if( NULL == _chosenNode->m_leftSon )
+	{
+		child = _chosenNode->m_rightSon;
+		childFather = _chosenNode->m_father;
+		Transplant(_tree, _chosenNode, child);
+	}
+	/* Option 2: the itr have only left child */
+	else if( NULL == _chosenNode->m_rightSon )
+	{
+		child = _chosenNode->m_leftSon;
+		childFather = _chosenNode->m_father;
+		Transplant(_tree, _chosenNode, child);
+	}
+	/* Option 3: the itr have 2 children, the next node take it's place */
+	else
+	{
+		removedColor = nextNode->m_color;
+		child = nextNode->m_rightSon;
+
+		if( nextNode->m_father == _chosenNode )
+		{
+			childFather = nextNode;
+		}
+		else
+		{
+			childFather = nextNode->m_father;
+			Transplant(_tree, nextNode, child);
+			nextNode->m_rightSon = _chosenNode->m_rightSon;
+			nextNode->m_rightSon->m_father = nextNode;
+		}
+
+		Transplant(_tree, _chosenNode, nextNode);
+		nextNode->m_leftSon = _chosenNode->m_leftSon;
+		nextNode->m_leftSon->m_father = nextNode;
+		nextNode->m_color = _chosenNode->m_color;
+		nextNode->m_size = _chosenNode->m_size;
+	}
+
+	if( BLACK == removedColor )
+	{
+		RemoveFixup(_tree, child, childFather);
+	}
+
+	if( !_chosenNode->m_inBlock )
+	{
+		free(_chosenNode);
+	}
 
-	OptNodeChild(_tree, nextNode); /* Eventually the next node untill the endItr will not have 2 children */
-	
 	return tempData;
 }
 /*----------------------------------------------------------------------------*/
@@ -816,27 +1597,97 @@ static void* RemoveNodeWithTwoChild(BSTree* _tree, Node* _chosenNode)
 
 /*----------------------------------------------------------------------------*/
 /** 
- * @brief       call the right function to remove all link of a Node according to it's number of children
+ * @brief       Restore the red-black rules after a black node was unlinked from the tree
+ * Average/Worst time complexity O(log n), at most 3 rotations.
  *
  * @param       _tree         	= A previously created Tree ADT returned via BSTreeCreate
- * @param       _chosenNode     = A tree iterator as Node typedef
- *
- * @return      removed the node data
+ * @param       _node     		= The node that took the removed place, can be NULL
+ * @param       _father     	= The father of _node
  */
-static void* OptNodeChild(BSTree* _tree, Node* _chosenNode)
+static void RemoveFixup(BSTree* _tree, Node* _node, Node* _father)
 {
-	/* Option 1: the itr have NO children */
-	if( NULL == _chosenNode->m_rightSon && NULL == _chosenNode->m_leftSon )
+	Node* brother;
+
+	/* _node subtree miss one black, the brother subtree can't be empty */
+	while( _node != _tree->m_root && IS_BLACK(_node) )
 	{
-		return RemoveNodeWithNoChild(_tree, _chosenNode, NULL);
+		if( _node == _father->m_leftSon )
+		{
+			brother = _father->m_rightSon;
+
+			if( IS_RED(brother) )
+			{
+				brother->m_color = BLACK;
+				_father->m_color = RED;
+				RotateLeft(_tree, _father);
+				brother = _father->m_rightSon;
+			}
+
+			if( IS_BLACK(brother->m_leftSon) && IS_BLACK(brother->m_rightSon) )
+			{
+				/* Move the missing black up to the father */
+				brother->m_color = RED;
+				_node = _father;
+				_father = _node->m_father;
+				continue;
+			}
+
+			if( IS_BLACK(brother->m_rightSon) )
+			{
+				brother->m_leftSon->m_color = BLACK;
+				brother->m_color = RED;
+				RotateRight(_tree, brother);
+				brother = _father->m_rightSon;
+			}
+
+			brother->m_color = _father->m_color;
+			_father->m_color = BLACK;
+			brother->m_rightSon->m_color = BLACK;
+			RotateLeft(_tree, _father);
+		}
+		else
+		{
+			brother = _father->m_leftSon;
+
+			if( IS_RED(brother) )
+			{
+				brother->m_color = BLACK;
+				_father->m_color = RED;
+				RotateRight(_tree, _father);
+				brother = _father->m_leftSon;
+			}
+
+			if( IS_BLACK(brother->m_leftSon) && IS_BLACK(brother->m_rightSon) )
+			{
+				brother->m_color = RED;
+				_node = _father;
+				_father = _node->m_father;
+				continue;
+			}
+
+			if( IS_BLACK(brother->m_leftSon) )
+			{
+				brother->m_rightSon->m_color = BLACK;
+				brother->m_color = RED;
+				RotateLeft(_tree, brother);
+				brother = _father->m_leftSon;
+			}
+
+			brother->m_color = _father->m_color;
+			_father->m_color = BLACK;
+			brother->m_leftSon->m_color = BLACK;
+			RotateRight(_tree, _father);
+		}
+
+		_node = _tree->m_root;
 	}
-	/* Option 2: the itr have 1 child */
-	if( NULL == _chosenNode->m_rightSon || NULL == _chosenNode->m_leftSon )
+
+	if( NULL != _node )
 	{
-		return RemoveNodeWithOneChild(_tree, _chosenNode);	
+		_node->m_color = BLACK;
 	}
-	/* Option 3: the itr have 2 children */
-	return RemoveNodeWithTwoChild(_tree, _chosenNode);
+
+	return;
 }
 /*----------------------------------------------------------------------------*/
 
@@ -850,38 +1701,51 @@ static void* OptNodeChild(BSTree* _tree, Node* _chosenNode)
  *			1. Check current node and preform an action
  *			2. Traverse the left subtree
  *			3. Traverse the right subtree
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachPreOrder(BSTreeItr _itr, ActionFunction _action, void* _context)
 {
-	if( NULL == _itr )
-	{
-		return _itr;
-	}
-	
-	if( 0 == _action( ( (Node*)_itr )->m_data, _context) )
-	{
-		return _itr;
-	}
+	Node* current = (Node*)_itr;
+	Node* father;
 	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_leftSon, _action, _context) )
-	{
-		return _itr;
-	}
-	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_rightSon, _action, _context) )
+	while( NULL != current )
 	{
-		return _itr;
+		if( 0 == _action(current->m_data, _context) )
+		{
+			return (BSTreeItr)current;
+		}
+		
+		if( NULL != current->m_leftSon )
+		{
+			current = current->m_leftSon;
+			continue;
+		}
+		
+		if( NULL != current->m_rightSon )
+		{
+			current = current->m_rightSon;
+			continue;
+		}
+		
+		/* Go up until a father with right subtree that was not traversed yet */
+		father = current->m_father;
+		while( NULL != father && (current == father->m_rightSon || NULL == father->m_rightSon) )
+		{
+			current = father;
+			father = current->m_father;
+		}
+		
+		current = (NULL == father) ? NULL : father->m_rightSon;
 	}
 	
 	return NULL;
-
 }
 /*----------------------------------------------------------------------------*/
 
@@ -895,35 +1759,37 @@ static BSTreeItr ForEachPreOrder(BSTreeItr _itr, ActionFunction _action, void* _
  *			1. Traverse the left subtree
  *			2. Check current node and preform an action
  *			3. Traverse the right subtree
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachInOrder(BSTreeItr _itr, ActionFunction _action, void* _context)
 {
-	if( NULL == _itr )
-	{
-		return _itr;
-	}
+	Node* current = (Node*)_itr;
 	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_leftSon, _action, _context) )
+	if( NULL == current )
 	{
-		return _itr;
+		return NULL;
 	}
 	
-	if( 0 == _action( ( (Node*)_itr )->m_data, _context) )
+	while( NULL != current->m_leftSon )
 	{
-		return _itr;
+		current = current->m_leftSon;
 	}
 	
-	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_rightSon, _action, _context) )
+	while( NULL != current )
 	{
-		return _itr;
+		if( 0 == _action(current->m_data, _context) )
+		{
+			return (BSTreeItr)current;
+		}
+		
+		current = NextOrNull(current);
 	}
 	
 	return NULL;
@@ -940,36 +1806,165 @@ static BSTreeItr ForEachInOrder(BSTreeItr _itr, ActionFunction _action, void* _c
  *			1. Traverse the left subtree
  *			2. Traverse the right subtree
  *			3. Check current node and preform an action
+ *			The walk use the father links, no recursion and no extra memory.
  * @Complexity  O(n)
  *
- * @param   itr        		=   First iterate to start with
+ * @param   itr        		=   The root of the tree
  * @param   action         	=   Action function to call for each element
  * @param   context        	=   Parameters for the function
  *
- * @return  Iterator to end or an iterator to the specific element where action returned zero value
+ * @return  Iterator to the specific element where action returned zero value OR NULL
  */
 static BSTreeItr ForEachPostOrder(BSTreeItr _itr, ActionFunction _action, void* _context)
 {
-	if( NULL == _itr )
+	Node* current = PostOrderFirst( (Node*)_itr );
+	Node* father;
+	
+	while( NULL != current )
 	{
-		return _itr;
+		if( 0 == _action(current->m_data, _context) )
+		{
+			return (BSTreeItr)current;
+		}
+		
+		/* After a left subtree comes the right subtree, after a right subtree comes the father */
+		father = current->m_father;
+		if( NULL != father && current == father->m_leftSon && NULL != father->m_rightSon )
+		{
+			current = PostOrderFirst(father->m_rightSon);
+		}
+		else
+		{
+			current = father;
+		}
 	}
 	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_leftSon, _action, _context) )
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Create a tree and link all it's nodes, taken from one allocation, to _items
+ * Average/Worst time complexity O(n).
+ *
+ * @param       _less         	= A comparison function
+ * @param       _items     		= Sorted items with no duplicates
+ * @param       _nItems     	= The number of items
+ *
+ * @return      The new tree OR NULL on allocation failure
+ */
+static BSTree* BuildTree(LessComparator _less, void** _items, size_t _nItems)
+{
+	BSTree* newTree;
+	size_t height = 0;
+	size_t count;
+	
+	newTree = BSTree_Create(_less);
+	CHECK_NULL(newTree);
+	
+	if( 0 == _nItems )
 	{
-		return _itr;
+		return newTree;
 	}
 	
-	if( NULL != ForEachPreOrder( ( (Node*)_itr )->m_rightSon, _action, _context) )
+	newTree->m_block = (Node*)malloc( _nItems * sizeof (Node) );
+	if( NULL == newTree->m_block )
 	{
-		return _itr;
+		BSTree_Destroy(newTree, NULL);
+		return NULL;
 	}
 	
-	if( 0 == _action( ( (Node*)_itr )->m_data, _context) )
+	/* The depth of the deepest node, the tree of one node have a black root */
+	for(count = _nItems; 1 < count; count /= 2)
 	{
-		return _itr;
+		++height;
 	}
 	
-	return NULL;
+	newTree->m_root = BuildSubtree(newTree->m_block, _items, _nItems, NULL, (0 == height) ? 1 : height);
+	newTree->m_nItems = _nItems;
+	
+	return newTree;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Link _nodes[0 .. _nItems - 1] as a balanced subtree of _items, the middle is the root
+ * @details     Nodes at the deepest level of the tree are red and all the others are black,
+ *				so every path from the root to NULL have the same number of black nodes.
+ * Average/Worst time complexity O(n), recursion depth O(log n).
+ *
+ * @param       _nodes         	= The nodes of the subtree
+ * @param       _items     		= The items of the subtree
+ * @param       _nItems     	= The number of items in the subtree
+ * @param       _father     	= The father of the subtree root
+ * @param       _redDepth     	= The depth of the subtree root to the red level, 0 if the root is red
+ *
+ * @return      The subtree root OR NULL if _nItems is 0
+ */
+static Node* BuildSubtree(Node* _nodes, void** _items, size_t _nItems, Node* _father, size_t _redDepth)
+{
+	Node* root;
+	size_t middle = _nItems / 2;
+	
+	if( 0 == _nItems )
+	{
+		return NULL;
+	}
+	
+	/* The two halfs differ by one item at most, so all the NULL sons are on the last 2 levels */
+	root = &_nodes[middle];
+	root->m_data = _items[middle];
+	root->m_father = _father;
+	root->m_color = (0 == _redDepth) ? RED : BLACK;
+	root->m_inBlock = 1;
+	root->m_size = _nItems;
+	root->m_leftSon = BuildSubtree(_nodes, _items, middle, root, _redDepth - 1);
+	root->m_rightSon = BuildSubtree(_nodes + middle + 1, _items + middle + 1, _nItems - middle - 1, root, _redDepth - 1);
+	
+	return root;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Get the next node in order OR NULL if _node is the last one
+ * Average time complexity O(1), Worst O(log n).
+ */
+static Node* NextOrNull(Node* _node)
+{
+	Node* next = BSTreeItr_Next(_node);
+	
+	return (next == _node) ? NULL : next;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/** 
+ * @brief       Get the first node of _node subtree in PostOrder, the deepest node on the left side
+ * Average/Worst time complexity O(log n).
+ *
+ * @param       _node     		= The root of the subtree, can be NULL
+ *
+ * @return      The first node OR NULL if _node is NULL
+ */
+static Node* PostOrderFirst(Node* _node)
+{
+	if( NULL == _node )
+	{
+		return NULL;
+	}
+	
+	while( NULL != _node->m_leftSon || NULL != _node->m_rightSon )
+	{
+		_node = (NULL != _node->m_leftSon) ? _node->m_leftSon : _node->m_rightSon;
+	}
+	
+	return _node;
 }
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,333 @@
+/**
+ *  @file 		benchmark.c
+ *  @brief 		Reader scalability benchmark for Generic concurrent tree against Generic
+ *  			Binary Tree guarded by a mutex
+ *
+ *  @details 	For 1, 2, 4 ... reader threads, every reader searches random keys while
+ *  			one writer thread removes and inserts back random keys the whole time.
+ *  			The total finds per second of all readers is printed for both trees.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime */
+
+#include "concurrentTree.h"	/* concurrent tree header */
+#include "binTree.h"		/* binary tree header */
+#include <stdio.h>  		/* for printf */
+#include <stdlib.h> 		/* for size_t & rand & malloc */
+#include <time.h> 			/* for clock_gettime */
+#include <pthread.h> 		/* for pthread API */
+
+#define DEFAULT_MAX_READERS (8)	/* Most reader threads, can be changed from the command line */
+#define N_KEYS (1000000)		/* Num of keys in the tree */
+#define FINDS_PER_READER (1000000)	/* Num of finds each reader does */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Shared
+{
+	CTree* m_cTree;
+	BSTree* m_bsTree;
+	pthread_mutex_t m_bsLock;	/* Guards m_bsTree, both for readers and the writer */
+	int* m_keys;
+	int m_isReading;			/* The writer runs while readers run */
+} Shared;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct ReaderArgs
+{
+	Shared* m_shared;
+	size_t m_readerId;
+	size_t m_found;				/* Keep the finds from being optimized away */
+} ReaderArgs;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Function that check if _a data < _b data
+ */
+static int CompareData(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Reader of the concurrent tree, FINDS_PER_READER random finds
+ */
+static void* CTreeReader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Writer of the concurrent tree, remove and insert back keys until the readers are done
+ */
+static void* CTreeWriter(void* _shared);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Reader of the binary tree, FINDS_PER_READER random finds under the mutex
+ */
+static void* BSTreeReader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Writer of the binary tree, remove and insert back keys until the readers are done
+ */
+static void* BSTreeWriter(void* _shared);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Run _nReaders readers and one writer, return the finds per second in millions
+ */
+static double RunReaders(Shared* _shared, size_t _nReaders,
+						void* (*_reader)(void*), void* (*_writer)(void*));
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Simple random number, rand() is not thread safe
+ */
+static size_t NextRandom(size_t* _seed);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** Main function *******************************/
+/*----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	Shared shared;
+	size_t maxReaders = DEFAULT_MAX_READERS;
+	size_t nReaders;
+	size_t i;
+
+	if( 1 < argc )
+	{
+		maxReaders = (size_t)atol(argv[1]);
+	}
+
+	shared.m_keys = (int*)malloc(N_KEYS * sizeof(int));
+	shared.m_cTree = CTree_Create(CompareData, maxReaders);
+	shared.m_bsTree = BSTree_Create(CompareData);
+	if( NULL == shared.m_keys || NULL == shared.m_cTree || NULL == shared.m_bsTree ||
+		0 != pthread_mutex_init(&shared.m_bsLock, NULL) )
+	{
+		printf("allocation failed\n");
+		return 1;
+	}
+
+	for(i = 0; i < N_KEYS; ++i)
+	{
+		shared.m_keys[i] = (int)i;
+	}
+	for(i = 0; i < N_KEYS; ++i)
+	{
+		CTree_Insert(shared.m_cTree, &shared.m_keys[(i * 7919) % N_KEYS]);
+		BSTree_Insert(shared.m_bsTree, &shared.m_keys[(i * 7919) % N_KEYS]);
+	}
+
+	printf("%d keys, %d finds per reader, one writer\n", N_KEYS, FINDS_PER_READER);
+	printf("readers    concurrent tree (M finds/sec)    binary tree + mutex (M finds/sec)\n");
+
+	for(nReaders = 1; nReaders <= maxReaders; nReaders *= 2)
+	{
+		printf("%7lu    %31.2f    %33.2f\n", (unsigned long)nReaders,
+				RunReaders(&shared, nReaders, CTreeReader, CTreeWriter),
+				RunReaders(&shared, nReaders, BSTreeReader, BSTreeWriter));
+	}
+
+	CTree_Destroy(shared.m_cTree, NULL);
+	BSTree_Destroy(shared.m_bsTree, NULL);
+	pthread_mutex_destroy(&shared.m_bsLock);
+	free(shared.m_keys);
+
+	return 0;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int CompareData(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* CTreeReader(void* _args)
+{
+	ReaderArgs* args = (ReaderArgs*)_args;
+	size_t seed = args->m_readerId + 1;
+	size_t i;
+
+	for(i = 0; i < FINDS_PER_READER; ++i)
+	{
+		if( NULL != CTree_Find(args->m_shared->m_cTree, args->m_readerId,
+								&args->m_shared->m_keys[NextRandom(&seed) % N_KEYS]) )
+		{
+			++args->m_found;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* CTreeWriter(void* _shared)
+{
+	Shared* shared = (Shared*)_shared;
+	size_t seed = 12345;
+	int* key;
+
+	while( __atomic_load_n(&shared->m_isReading, __ATOMIC_SEQ_CST) )
+	{
+		key = &shared->m_keys[NextRandom(&seed) % N_KEYS];
+		CTree_Remove(shared->m_cTree, key);
+		CTree_Insert(shared->m_cTree, key);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BSTreeReader(void* _args)
+{
+	ReaderArgs* args = (ReaderArgs*)_args;
+	size_t seed = args->m_readerId + 1;
+	size_t i;
+	BSTreeItr found;
+
+	for(i = 0; i < FINDS_PER_READER; ++i)
+	{
+		pthread_mutex_lock(&args->m_shared->m_bsLock);
+		found = BSTree_Find(args->m_shared->m_bsTree, &args->m_shared->m_keys[NextRandom(&seed) % N_KEYS]);
+		pthread_mutex_unlock(&args->m_shared->m_bsLock);
+
+		if( NULL != found )
+		{
+			++args->m_found;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* BSTreeWriter(void* _shared)
+{
+	Shared* shared = (Shared*)_shared;
+	size_t seed = 12345;
+	int* key;
+
+	while( __atomic_load_n(&shared->m_isReading, __ATOMIC_SEQ_CST) )
+	{
+		key = &shared->m_keys[NextRandom(&seed) % N_KEYS];
+
+		pthread_mutex_lock(&shared->m_bsLock);
+		BSTreeItr_Remove(shared->m_bsTree, BSTree_Find(shared->m_bsTree, key));
+		BSTree_Insert(shared->m_bsTree, key);
+		pthread_mutex_unlock(&shared->m_bsLock);
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static double RunReaders(Shared* _shared, size_t _nReaders,
+						void* (*_reader)(void*), void* (*_writer)(void*))
+{
+	pthread_t writer;
+	pthread_t* readers;
+	ReaderArgs* args;
+	struct timespec start;
+	struct timespec end;
+	double seconds;
+	size_t i;
+
+	readers = (pthread_t*)malloc(_nReaders * sizeof(pthread_t));
+	args = (ReaderArgs*)malloc(_nReaders * sizeof(ReaderArgs));
+	if( NULL == readers || NULL == args )
+	{
+		free(readers);
+		free(args);
+		return 0;
+	}
+
+	_shared->m_isReading = 1;
+	pthread_create(&writer, NULL, _writer, _shared);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i = 0; i < _nReaders; ++i)
+	{
+		args[i].m_shared = _shared;
+		args[i].m_readerId = i;
+		args[i].m_found = 0;
+		pthread_create(&readers[i], NULL, _reader, &args[i]);
+	}
+	for(i = 0; i < _nReaders; ++i)
+	{
+		pthread_join(readers[i], NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	__atomic_store_n(&_shared->m_isReading, 0, __ATOMIC_SEQ_CST);
+	pthread_join(writer, NULL);
+
+	free(readers);
+	free(args);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	return (double)_nReaders * FINDS_PER_READER / seconds / 1e6;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t NextRandom(size_t* _seed)
+{
+	*_seed = *_seed * 1103515245 + 12345;
+
+	return (*_seed / 65536) % 32768 * 32768 + (*_seed / 65536 / 32768) % 32768;
+}
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,1002 @@
+/**
+ *  @file 		concurrentTree.c
+ *  @brief 		src file for Generic read mostly concurrent ordered tree
+ *
+ *  @details 	Implement an ordered set ADT of user items as an AVL tree that readers
+ *  			search without locks. A writer never change a node that readers can see,
+ *  			it copies the nodes on it's path (and the nodes a rotation move) and then
+ *  			publishes the new root with one atomic store.
+ *  			Epochs: the writer bumps the tree epoch after every publish, a reader store the
+ *  			epoch it saw in it's own slot while it reads. A node replaced at epoch e is freed
+ *  			only when no reader slot hold an epoch that is not greater then e.
+ *  			A node whose m_epoch is the current epoch was made by the running write and
+ *  			no reader saw it yet, so the writer change it in place.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "concurrentTree.h"	/* header file */
+#include <stdlib.h> 		/* for size_t, NULL, malloc, free */
+#include <pthread.h> 		/* for pthread mutex API */
+
+#define MAGIC_NUMBER (123456789)
+#define CACHE_LINE (64)
+#define MAX_HEIGHT (96)		/* AVL height is less then 1.45 * log2(n) + 2, so it is never reached */
+#define SPARE_MAX (1024)	/* Most free nodes the writer keeps for the next writes */
+#define NO_READ (0)			/* Reader slot value while the reader is not reading */
+#define HEIGHT(node)		( (NULL == (node)) ? 0 : (node)->m_height )
+#define IS_FRESH(tree, node)	( (node)->m_epoch == (tree)->m_epoch )
+#define ATOMIC_LOAD(ptr)		__atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define ATOMIC_STORE(ptr, val)	__atomic_store_n((ptr), (val), __ATOMIC_SEQ_CST)
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_TREE_NULL(param)		do{ if(NULL == (param) ) { return CTREE_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ITEM_NULL(param)		do{ if(NULL == (param) ) { return CTREE_ITEM_NULL_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Node Node;
+typedef struct ReaderSlot ReaderSlot;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Node
+{
+    void* m_data;		/* Pointer to node element data */
+    Node* m_left;		/* Subtree of the smaller items */
+    Node* m_right;		/* Subtree of the bigger items */
+    Node* m_next;		/* Link in the retired OR spare list, readers never read it */
+    size_t m_epoch;		/* Epoch of the write that made the node, after retire the epoch it was replaced */
+    int m_height;		/* Height of the subtree, 1 for a leaf */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* One cache line for every reader, so readers don't share lines */
+struct ReaderSlot
+{
+    size_t m_epoch;		/* The epoch the reader saw OR NO_READ */
+    char m_pad[CACHE_LINE - sizeof(size_t)];
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct CTree
+{
+    Node* m_root;				/* Published version, read by readers with atomic load */
+    size_t m_epoch;				/* Starts at 1, bumped after every publish */
+    size_t m_nItems;
+    CTreeLessComparator m_less;
+    ReaderSlot* m_readers;
+    size_t m_maxReaders;
+    pthread_mutex_t m_writeLock;
+    Node* m_spare;				/* Free nodes, the writer takes it's new nodes from here */
+    size_t m_nSpare;
+    Node* m_retiredHead;		/* Replaced nodes, oldest first */
+    Node* m_retiredTail;
+    size_t m_magicNumber;
+};
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Search the node with item equal to _key in the subtree of _node
+ *
+ * @returns The node OR NULL if not found
+ */
+static Node* FindNode(const CTree* _tree, Node* _node, void* _key);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make sure the spare list have enough nodes for one write on the current tree
+ * @details A write copies at most 3 nodes on each level, after this the write can't fail.
+ *
+ * @returns 1 on success OR 0 on allocation failure
+ */
+static int FillSpare(CTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node from the spare list and mark it as made by the running write
+ */
+static Node* TakeSpare(CTree* _tree);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Give back a node that is not in the new version of the tree
+ * @details A fresh node was never seen by readers and goes straight to the spare list,
+ *			any other node is added to the retired list with the current epoch.
+ */
+static void Retire(CTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get a node of the running write that hold the same content as _node
+ *
+ * @returns _node if it is fresh, else a fresh copy of it (and _node is retired)
+ */
+static Node* Own(CTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Rotate the subtree of the fresh _node to the left, the right son become the subtree root
+ *
+ * @returns The new subtree root
+ */
+static Node* RotateLeft(CTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Rotate the subtree of the fresh _node to the right, the left son become the subtree root
+ *
+ * @returns The new subtree root
+ */
+static Node* RotateRight(CTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Update the height of the fresh _node and fix the subtree if the sons
+ *			heights differ by 2
+ *
+ * @returns The new subtree root
+ */
+static Node* Balance(CTree* _tree, Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Insert _item to the subtree of _node, _item is not in the tree
+ *
+ * @returns The new subtree root
+ */
+static Node* InsertNode(CTree* _tree, Node* _node, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove the item equal to _key from the subtree of _node, the item is in the subtree
+ *
+ * @param   _removed       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveNode(CTree* _tree, Node* _node, void* _key, void** _removed);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove the smallest item from the subtree of _node
+ *
+ * @param   _minData       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveMin(CTree* _tree, Node* _node, void** _minData);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Publish the new root and release the retired nodes no reader can see
+ */
+static void Publish(CTree* _tree, Node* _root);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Mark reader _readerId as reading, and get the root it should read
+ */
+static Node* ReadBegin(CTree* _tree, size_t _readerId);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Mark reader _readerId as not reading
+ */
+static void ReadEnd(CTree* _tree, size_t _readerId);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Free a list of nodes linked by m_next
+ */
+static void FreeList(Node* _head);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create an empty concurrent tree
+ *
+ * @param   less			= A comparison function that returns true (none zero value)
+ *							if x < y  and false (zero) otherwise.
+ * @param   maxReaders		= The number of reader ids, the ids are 0 to (_maxReaders - 1)
+ *
+ * @return 	The Tree pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created tree.
+ * @retval  NULL          	= On failure due to allocation failure OR due to uninitialized pointer given
+ *							  OR if _maxReaders is 0
+ */
+CTree* CTree_Create(CTreeLessComparator _less, size_t _maxReaders)
+{
+	CTree* newTree;
+
+	CHECK_NULL(_less);
+	if( 0 == _maxReaders )
+	{
+		return NULL;
+	}
+
+	newTree = (CTree*)calloc( 1, sizeof (CTree) );
+	CHECK_NULL(newTree);
+
+	newTree->m_readers = (ReaderSlot*)calloc( _maxReaders, sizeof (ReaderSlot) );
+	if( NULL == newTree->m_readers )
+	{
+		free(newTree);
+		return NULL;
+	}
+
+	if( 0 != pthread_mutex_init(&newTree->m_writeLock, NULL) )
+	{
+		free(newTree->m_readers);
+		free(newTree);
+		return NULL;
+	}
+
+	newTree->m_less = _less;
+	newTree->m_maxReaders = _maxReaders;
+	newTree->m_epoch = 1;
+	newTree->m_magicNumber = MAGIC_NUMBER;
+
+	return newTree;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy tree
+ * @details Destroys the tree, If supplied with non-NULL destroyer function,
+ *			frees the items in the tree. No thread may use the tree while it is destroyed.
+ * @Complexity	O(n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   destroyer      	= A function to destroy the items (may be NULL if unnecessary)
+ */
+void CTree_Destroy(CTree* _tree, void (*_destroyer)(void*))
+{
+	Node* stack;
+	Node* current;
+
+	if( NULL == _tree || MAGIC_NUMBER != _tree->m_magicNumber )
+	{
+		return;
+	}
+
+	/* The m_next links are free to use as a stack, no recursion on the tree */
+	stack = _tree->m_root;
+	if( NULL != stack )
+	{
+		stack->m_next = NULL;
+	}
+
+	while( NULL != stack )
+	{
+		current = stack;
+		stack = stack->m_next;
+
+		if( NULL != current->m_left )
+		{
+			current->m_left->m_next = stack;
+			stack = current->m_left;
+		}
+
+		if( NULL != current->m_right )
+		{
+			current->m_right->m_next = stack;
+			stack = current->m_right;
+		}
+
+		if( NULL != _destroyer )
+		{
+			_destroyer(current->m_data);
+		}
+
+		free(current);
+	}
+
+	FreeList(_tree->m_retiredHead);
+	FreeList(_tree->m_spare);
+	pthread_mutex_destroy(&_tree->m_writeLock);
+	free(_tree->m_readers);
+
+	_tree->m_magicNumber = 987654321;
+	free(_tree);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Add an item to the tree if it's not already there
+ * @details The writers are serialized, the readers are not blocked.
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   item           	= An item to add to the tree
+ *
+ * @return  Success indicator
+ * @retval  CTREE_SUCCESS				= On success
+ * @retval  CTREE_UNINITIALIZED_ERROR	= If the tree is not initialized
+ * @retval  CTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  CTREE_DUPLICATE_ERROR		= If an equal item already in the tree
+ * @retval  CTREE_ALLOCATION_ERROR		= On failure to allocate memory, the tree is not changed
+ */
+CTreeResult CTree_Insert(CTree* _tree, void* _item)
+{
+	CTreeResult result = CTREE_SUCCESS;
+
+	CHECK_TREE_NULL(_tree);
+	CHECK_ITEM_NULL(_item);
+
+	pthread_mutex_lock(&_tree->m_writeLock);
+
+	if( NULL != FindNode(_tree, _tree->m_root, _item) )
+	{
+		result = CTREE_DUPLICATE_ERROR;
+	}
+	else if( !FillSpare(_tree) )
+	{
+		result = CTREE_ALLOCATION_ERROR;
+	}
+	else
+	{
+		Publish(_tree, InsertNode(_tree, _tree->m_root, _item));
+		ATOMIC_STORE(&_tree->m_nItems, _tree->m_nItems + 1);
+	}
+
+	pthread_mutex_unlock(&_tree->m_writeLock);
+
+	return result;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Remove the item equal to _key from the tree
+ * @details The writers are serialized, the readers are not blocked.
+ *			The tree never free the items, a reader can still hold the removed item.
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The removed item OR NULL if not found OR on allocation failure OR uninitialized pointer given
+ */
+void* CTree_Remove(CTree* _tree, void* _key)
+{
+	void* removed = NULL;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
+
+	pthread_mutex_lock(&_tree->m_writeLock);
+
+	if( NULL != FindNode(_tree, _tree->m_root, _key) && FillSpare(_tree) )
+	{
+		Publish(_tree, RemoveNode(_tree, _tree->m_root, _key, &removed));
+		ATOMIC_STORE(&_tree->m_nItems, _tree->m_nItems - 1);
+	}
+
+	pthread_mutex_unlock(&_tree->m_writeLock);
+
+	return removed;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key, without locking
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A previously created tree
+ * @param   readerId        = The id of the calling reader, less then _maxReaders
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* CTree_Find(CTree* _tree, size_t _readerId, void* _key)
+{
+	Node* found;
+	void* item = NULL;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
+	if( _readerId >= _tree->m_maxReaders )
+	{
+		return NULL;
+	}
+
+	found = FindNode(_tree, ReadBegin(_tree, _readerId), _key);
+	if( NULL != found )
+	{
+		item = found->m_data;
+	}
+
+	ReadEnd(_tree, _readerId);
+
+	return item;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details All the items are taken from the same version of the tree, updates that are
+ *			published during the iteration are not seen. Iteration will stop on the first
+ *			item for which action returns a zero or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Tree to iterate over
+ * @param   readerId        =       The id of the calling reader, less then _maxReaders
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* CTree_Range(CTree* _tree, size_t _readerId, void* _low, void* _high,
+				CTreeActionFunction _action, void* _context)
+{
+	Node* stack[MAX_HEIGHT];
+	size_t top = 0;
+	Node* current;
+	void* stopItem = NULL;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_low);
+	CHECK_NULL(_high);
+	CHECK_NULL(_action);
+	if( _readerId >= _tree->m_maxReaders )
+	{
+		return NULL;
+	}
+
+	/* Keep on the stack the nodes that are not less then _low on the path to _low */
+	current = ReadBegin(_tree, _readerId);
+	while( NULL != current )
+	{
+		if( 0 != _tree->m_less(current->m_data, _low) )
+		{
+			current = current->m_right;
+		}
+		else
+		{
+			stack[top++] = current;
+			current = current->m_left;
+		}
+	}
+
+	while( 0 < top )
+	{
+		current = stack[--top];
+		if( 0 != _tree->m_less(_high, current->m_data) )
+		{
+			break;
+		}
+
+		if( 0 == _action(current->m_data, _context) )
+		{
+			stopItem = current->m_data;
+			break;
+		}
+
+		for(current = current->m_right; NULL != current; current = current->m_left)
+		{
+			stack[top++] = current;
+		}
+	}
+
+	ReadEnd(_tree, _readerId);
+
+	return stopItem;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the tree
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t CTree_Size(const CTree* _tree)
+{
+	if( NULL == _tree )
+	{
+		return 0;
+	}
+
+	return ATOMIC_LOAD(&_tree->m_nItems);
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Search the node with item equal to _key in the subtree of _node
+ *
+ * @returns The node OR NULL if not found
+ */
+static Node* FindNode(const CTree* _tree, Node* _node, void* _key)
+{
+	while( NULL != _node )
+	{
+		if( 0 != _tree->m_less(_key, _node->m_data) )
+		{
+			_node = _node->m_left;
+		}
+		else if( 0 != _tree->m_less(_node->m_data, _key) )
+		{
+			_node = _node->m_right;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return _node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make sure the spare list have enough nodes for one write on the current tree
+ * @details A write copies at most 3 nodes on each level, after this the write can't fail.
+ *
+ * @returns 1 on success OR 0 on allocation failure
+ */
+static int FillSpare(CTree* _tree)
+{
+	size_t need = 3 * ( (size_t)HEIGHT(_tree->m_root) + 2 );
+	Node* newNode;
+
+	while( _tree->m_nSpare < need )
+	{
+		newNode = (Node*)malloc( sizeof (Node) );
+		if( NULL == newNode )
+		{
+			return 0;
+		}
+
+		newNode->m_next = _tree->m_spare;
+		_tree->m_spare = newNode;
+		++_tree->m_nSpare;
+	}
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Take a node from the spare list and mark it as made by the running write
+ */
+static Node* TakeSpare(CTree* _tree)
+{
+	Node* node = _tree->m_spare;
+
+	_tree->m_spare = node->m_next;
+	--_tree->m_nSpare;
+
+	node->m_epoch = _tree->m_epoch;
+
+	return node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Give back a node that is not in the new version of the tree
+ * @details A fresh node was never seen by readers and goes straight to the spare list,
+ *			any other node is added to the retired list with the current epoch.
+ */
+static void Retire(CTree* _tree, Node* _node)
+{
+	if( IS_FRESH(_tree, _node) )
+	{
+		_node->m_next = _tree->m_spare;
+		_tree->m_spare = _node;
+		++_tree->m_nSpare;
+		return;
+	}
+
+	_node->m_epoch = _tree->m_epoch;
+	_node->m_next = NULL;
+
+	if( NULL == _tree->m_retiredTail )
+	{
+		_tree->m_retiredHead = _node;
+	}
+	else
+	{
+		_tree->m_retiredTail->m_next = _node;
+	}
+	_tree->m_retiredTail = _node;
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Get a node of the running write that hold the same content as _node
+ *
+ * @returns _node if it is fresh, else a fresh copy of it (and _node is retired)
+ */
+static Node* Own(CTree* _tree, Node* _node)
+{
+	Node* copy;
+
+	if( IS_FRESH(_tree, _node) )
+	{
+		return _node;
+	}
+
+	copy = TakeSpare(_tree);
+	copy->m_data = _node->m_data;
+	copy->m_left = _node->m_left;
+	copy->m_right = _node->m_right;
+	copy->m_height = _node->m_height;
+
+	Retire(_tree, _node);
+
+	return copy;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Rotate the subtree of the fresh _node to the left, the right son become the subtree root
+ *
+ * @returns The new subtree root
+ */
+static Node* RotateLeft(CTree* _tree, Node* _node)
+{
+	Node* son = Own(_tree, _node->m_right);
+
+	_node->m_right = son->m_left;
+	son->m_left = _node;
+
+	_node->m_height = 1 + ( (HEIGHT(_node->m_left) > HEIGHT(_node->m_right)) ? HEIGHT(_node->m_left) : HEIGHT(_node->m_right) );
+	son->m_height = 1 + ( (HEIGHT(son->m_left) > HEIGHT(son->m_right)) ? HEIGHT(son->m_left) : HEIGHT(son->m_right) );
+
+	return son;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Rotate the subtree of the fresh _node to the right, the left son become the subtree root
+ *
+ * @returns The new subtree root
+ */
+static Node* RotateRight(CTree* _tree, Node* _node)
+{
+	Node* son = Own(_tree, _node->m_left);
+
+	_node->m_left = son->m_right;
+	son->m_right = _node;
+
+	_node->m_height = 1 + ( (HEIGHT(_node->m_left) > HEIGHT(_node->m_right)) ? HEIGHT(_node->m_left) : HEIGHT(_node->m_right) );
+	son->m_height = 1 + ( (HEIGHT(son->m_left) > HEIGHT(son->m_right)) ? HEIGHT(son->m_left) : HEIGHT(son->m_right) );
+
+	return son;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Update the height of the fresh _node and fix the subtree if the sons
+ *			heights differ by 2
+ *
+ * @returns The new subtree root
+ */
+static Node* Balance(CTree* _tree, Node* _node)
+{
+	int diff = HEIGHT(_node->m_left) - HEIGHT(_node->m_right);
+
+	if( 1 < diff )
+	{
+		if( HEIGHT(_node->m_left->m_left) < HEIGHT(_node->m_left->m_right) )
+		{
+			_node->m_left = RotateLeft(_tree, Own(_tree, _node->m_left));
+		}
+		return RotateRight(_tree, _node);
+	}
+
+	if( -1 > diff )
+	{
+		if( HEIGHT(_node->m_right->m_right) < HEIGHT(_node->m_right->m_left) )
+		{
+			_node->m_right = RotateRight(_tree, Own(_tree, _node->m_right));
+		}
+		return RotateLeft(_tree, _node);
+	}
+
+	_node->m_height = 1 + ( (0 < diff) ? HEIGHT(_node->m_left) : HEIGHT(_node->m_right) );
+
+	return _node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Insert _item to the subtree of _node, _item is not in the tree
+ *
+ * @returns The new subtree root
+ */
+static Node* InsertNode(CTree* _tree, Node* _node, void* _item)
+{
+	if( NULL == _node )
+	{
+		_node = TakeSpare(_tree);
+		_node->m_data = _item;
+		_node->m_left = NULL;
+		_node->m_right = NULL;
+		_node->m_height = 1;
+		return _node;
+	}
+
+	_node = Own(_tree, _node);
+
+	if( 0 != _tree->m_less(_item, _node->m_data) )
+	{
+		_node->m_left = InsertNode(_tree, _node->m_left, _item);
+	}
+	else
+	{
+		_node->m_right = InsertNode(_tree, _node->m_right, _item);
+	}
+
+	return Balance(_tree, _node);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove the item equal to _key from the subtree of _node, the item is in the subtree
+ *
+ * @param   _removed       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveNode(CTree* _tree, Node* _node, void* _key, void** _removed)
+{
+	Node* child;
+
+	if( 0 != _tree->m_less(_key, _node->m_data) )
+	{
+		_node = Own(_tree, _node);
+		_node->m_left = RemoveNode(_tree, _node->m_left, _key, _removed);
+		return Balance(_tree, _node);
+	}
+
+	if( 0 != _tree->m_less(_node->m_data, _key) )
+	{
+		_node = Own(_tree, _node);
+		_node->m_right = RemoveNode(_tree, _node->m_right, _key, _removed);
+		return Balance(_tree, _node);
+	}
+
+	*_removed = _node->m_data;
+
+	if( NULL == _node->m_left || NULL == _node->m_right )
+	{
+		child = (NULL == _node->m_left) ? _node->m_right : _node->m_left;
+		Retire(_tree, _node);
+		return child;
+	}
+
+	/* The next item in order takes the place of the removed item */
+	_node = Own(_tree, _node);
+	_node->m_right = RemoveMin(_tree, _node->m_right, &_node->m_data);
+
+	return Balance(_tree, _node);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove the smallest item from the subtree of _node
+ *
+ * @param   _minData       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveMin(CTree* _tree, Node* _node, void** _minData)
+{
+	Node* child;
+
+	if( NULL == _node->m_left )
+	{
+		*_minData = _node->m_data;
+		child = _node->m_right;
+		Retire(_tree, _node);
+		return child;
+	}
+
+	_node = Own(_tree, _node);
+	_node->m_left = RemoveMin(_tree, _node->m_left, _minData);
+
+	return Balance(_tree, _node);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Publish the new root and release the retired nodes no reader can see
+ */
+static void Publish(CTree* _tree, Node* _root)
+{
+	size_t minEpoch;
+	size_t readerEpoch;
+	size_t i;
+	Node* node;
+
+	/* After this store new readers see only the new version */
+	ATOMIC_STORE(&_tree->m_root, _root);
+	ATOMIC_STORE(&_tree->m_epoch, _tree->m_epoch + 1);
+
+	minEpoch = _tree->m_epoch;
+	for(i = 0; i < _tree->m_maxReaders; ++i)
+	{
+		readerEpoch = ATOMIC_LOAD(&_tree->m_readers[i].m_epoch);
+		if( NO_READ != readerEpoch && readerEpoch < minEpoch )
+		{
+			minEpoch = readerEpoch;
+		}
+	}
+
+	/* A reader that saw epoch e can hold only nodes that were retired at e OR later */
+	while( NULL != _tree->m_retiredHead && _tree->m_retiredHead->m_epoch < minEpoch )
+	{
+		node = _tree->m_retiredHead;
+		_tree->m_retiredHead = node->m_next;
+
+		if( _tree->m_nSpare < SPARE_MAX )
+		{
+			node->m_next = _tree->m_spare;
+			_tree->m_spare = node;
+			++_tree->m_nSpare;
+		}
+		else
+		{
+			free(node);
+		}
+	}
+
+	if( NULL == _tree->m_retiredHead )
+	{
+		_tree->m_retiredTail = NULL;
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Mark reader _readerId as reading, and get the root it should read
+ */
+static Node* ReadBegin(CTree* _tree, size_t _readerId)
+{
+	/* The slot is stored before the root is loaded, so a writer that missed the slot
+	   had already published, and this reader can't get it's retired nodes */
+	ATOMIC_STORE(&_tree->m_readers[_readerId].m_epoch, ATOMIC_LOAD(&_tree->m_epoch));
+
+	return ATOMIC_LOAD(&_tree->m_root);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Mark reader _readerId as not reading
+ */
+static void ReadEnd(CTree* _tree, size_t _readerId)
+{
+	__atomic_store_n(&_tree->m_readers[_readerId].m_epoch, NO_READ, __ATOMIC_RELEASE);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Free a list of nodes linked by m_next
+ */
+static void FreeList(Node* _head)
+{
+	Node* next;
+
+	while( NULL != _head )
+	{
+		next = _head->m_next;
+		free(_head);
+		_head = next;
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
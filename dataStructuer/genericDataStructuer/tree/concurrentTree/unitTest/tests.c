@@ -0,0 +1,420 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic read mostly concurrent ordered tree
+ *
+ *  @details 	The API stores user items ordered by user provided less function,
+ *				readers search without locks while one writer at a time change the tree.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "concurrentTree.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h> 			/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+#include <pthread.h> 		/* for pthread API */
+
+#define SIZE (1000) 		/* SIZE = Num of items in each test */
+#define N_READERS (4) 		/* Num of reader threads in the concurrent test */
+#define N_WRITES (20000) 	/* Num of writes the writer thread does in the concurrent test */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct ReaderArgs
+{
+	CTree* m_tree;
+	size_t m_readerId;
+	int* m_isWriting;		/* Readers read until the writer is done */
+	int m_failed;			/* Set by the reader if it saw a broken version */
+} ReaderArgs;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+typedef struct OrderContext
+{
+	int m_last;				/* The last item seen */
+	size_t m_count;
+	int m_failed;
+} OrderContext;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function for int items
+*/
+static int IntLess(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that count the items and check they come in increasing order
+ *
+ * @param   _context  	= OrderContext
+*/
+static int OrderAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that stop on the item equal to context
+*/
+static int NotEqualAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert items 0, 2, 4 ... (2 * _nElements - 2) in random order
+ *
+ * @return	Number of successful inserts
+*/
+static size_t InsertEvenItems(CTree* _tree, int* _items, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Reader thread, walks all the tree again and again while the writer runs
+ *
+ * @param   _args  	= ReaderArgs
+*/
+static void* Reader(void* _args);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------- CTree_Create -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Create_CheckNull)
+    ASSERT_THAT( NULL == CTree_Create(NULL, 1) );
+    ASSERT_THAT( NULL == CTree_Create(IntLess, 0) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Create_CheckEmpty)
+    CTree* tree;
+    int key = 1;
+    int result;
+
+    tree = CTree_Create(IntLess, 1);
+    result = ( NULL != tree && 0 == CTree_Size(tree) && NULL == CTree_Find(tree, 0, &key) );
+
+    CTree_Destroy(tree, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- CTree_Insert -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Insert_CheckNullAndDuplicate)
+    CTree* tree;
+    int item = 1;
+    int sameItem = 1;
+    CTreeResult result[3];
+
+    tree = CTree_Create(IntLess, 1);
+    result[0] = CTree_Insert(tree, NULL);
+    result[1] = CTree_Insert(tree, &item);
+    result[2] = CTree_Insert(tree, &sameItem);
+
+    ASSERT_THAT( CTREE_ITEM_NULL_ERROR == result[0] && CTREE_SUCCESS == result[1] );
+    ASSERT_THAT( CTREE_DUPLICATE_ERROR == result[2] && 1 == CTree_Size(tree) );
+    ASSERT_THAT( CTREE_UNINITIALIZED_ERROR == CTree_Insert(NULL, &item) );
+    CTree_Destroy(tree, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- CTree_Find --------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Find_CheckAll)
+    CTree* tree;
+    int items[SIZE];
+    int search;
+    int result = 1;
+
+    tree = CTree_Create(IntLess, 2);
+    ASSERT_THAT( SIZE == InsertEvenItems(tree, items, SIZE) );
+
+    for(search = 0; search < 2 * SIZE; ++search)
+    {
+    	if( 0 == search % 2 )
+    	{
+    		result = result && ( &items[search / 2] == CTree_Find(tree, 1, &search) );
+    	}
+    	else
+    	{
+    		result = result && ( NULL == CTree_Find(tree, 1, &search) );
+    	}
+    }
+
+    search = 0;
+    ASSERT_THAT( NULL == CTree_Find(tree, 2, &search) );
+    CTree_Destroy(tree, NULL);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- CTree_Remove -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Remove_CheckAllAndReinsert)
+    CTree* tree;
+    int items[SIZE];
+    int search;
+    int notFound = 7;
+    int result = 1;
+
+    tree = CTree_Create(IntLess, 1);
+    InsertEvenItems(tree, items, SIZE);
+
+    ASSERT_THAT( NULL == CTree_Remove(tree, &notFound) );
+    for(search = 0; search < 2 * SIZE; search += 4)
+    {
+    	result = result && ( &items[search / 2] == CTree_Remove(tree, &search) );
+    	result = result && ( NULL == CTree_Find(tree, 0, &search) );
+    }
+    ASSERT_THAT( result && SIZE / 2 == CTree_Size(tree) );
+
+    search = 4;
+    ASSERT_THAT( CTREE_SUCCESS == CTree_Insert(tree, &items[2]) );
+    ASSERT_THAT( &items[2] == CTree_Find(tree, 0, &search) );
+    CTree_Destroy(tree, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- CTree_Range -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Range_CheckCountAndOrder)
+    CTree* tree;
+    int items[SIZE];
+    int low = 99;
+    int high = 200;
+    OrderContext context = {-1, 0, 0};
+
+    tree = CTree_Create(IntLess, 1);
+    InsertEvenItems(tree, items, SIZE);
+
+    ASSERT_THAT( NULL == CTree_Range(tree, 0, &low, &high, OrderAction, &context) );
+    ASSERT_THAT( 51 == context.m_count && !context.m_failed );
+    CTree_Destroy(tree, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Range_CheckActionStop)
+    CTree* tree;
+    int items[SIZE];
+    int low = 0;
+    int high = 2 * SIZE;
+    int stopValue = 6;
+
+    tree = CTree_Create(IntLess, 1);
+    InsertEvenItems(tree, items, SIZE);
+
+    ASSERT_THAT( &items[3] == CTree_Range(tree, 0, &low, &high, NotEqualAction, &stopValue) );
+    CTree_Destroy(tree, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ Concurrent use ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(CTree_Concurrent_CheckReadersSeeWholeVersions)
+    CTree* tree;
+    int items[SIZE];
+    pthread_t readers[N_READERS];
+    ReaderArgs args[N_READERS];
+    int isWriting = 1;
+    size_t i;
+    size_t index;
+    int result = 1;
+
+    tree = CTree_Create(IntLess, N_READERS);
+    InsertEvenItems(tree, items, SIZE);
+
+    for(i = 0; i < N_READERS; ++i)
+    {
+    	args[i].m_tree = tree;
+    	args[i].m_readerId = i;
+    	args[i].m_isWriting = &isWriting;
+    	args[i].m_failed = 0;
+    	ASSERT_THAT( 0 == pthread_create(&readers[i], NULL, Reader, &args[i]) );
+    }
+
+    /* Remove and insert back the same item, readers see SIZE OR SIZE - 1 items */
+    for(i = 0; i < N_WRITES; ++i)
+    {
+    	index = (size_t)rand() % SIZE;
+    	result = result && ( &items[index] == CTree_Remove(tree, &items[index]) );
+    	result = result && ( CTREE_SUCCESS == CTree_Insert(tree, &items[index]) );
+    }
+    __atomic_store_n(&isWriting, 0, __ATOMIC_SEQ_CST);
+
+    for(i = 0; i < N_READERS; ++i)
+    {
+    	pthread_join(readers[i], NULL);
+    	result = result && !args[i].m_failed;
+    }
+
+    ASSERT_THAT( result && SIZE == CTree_Size(tree) );
+    CTree_Destroy(tree, NULL);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Concurrent Tree Module)
+	PRINT(CTree_Create_CheckNull)
+	PRINT(CTree_Create_CheckEmpty)
+
+	PRINT(CTree_Insert_CheckNullAndDuplicate)
+
+	PRINT(CTree_Find_CheckAll)
+
+	PRINT(CTree_Remove_CheckAllAndReinsert)
+
+	PRINT(CTree_Range_CheckCountAndOrder)
+	PRINT(CTree_Range_CheckActionStop)
+
+	PRINT(CTree_Concurrent_CheckReadersSeeWholeVersions)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int IntLess(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int OrderAction(void* _element, void* _context)
+{
+	OrderContext* context = (OrderContext*)_context;
+
+	if( *(int*)_element <= context->m_last )
+	{
+		context->m_failed = 1;
+	}
+
+	context->m_last = *(int*)_element;
+	++context->m_count;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int NotEqualAction(void* _element, void* _context)
+{
+	return *(int*)_element != *(int*)_context;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t InsertEvenItems(CTree* _tree, int* _items, size_t _nElements)
+{
+	size_t* order;
+	size_t i;
+	size_t j;
+	size_t temp;
+	size_t counter = 0;
+
+	order = (size_t*)malloc(_nElements * sizeof(size_t));
+	if( NULL == order )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		_items[i] = (int)(2 * i);
+		order[i] = i;
+	}
+
+	/* Insert in random order, the items array stay sorted by index */
+	srand((unsigned)time(NULL));
+	for(i = _nElements; 0 < i; --i)
+	{
+		j = (size_t)rand() % i;
+		temp = order[i - 1];
+		order[i - 1] = order[j];
+		order[j] = temp;
+	}
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( CTREE_SUCCESS == CTree_Insert(_tree, &_items[order[i]]) )
+		{
+			++counter;
+		}
+	}
+
+	free(order);
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void* Reader(void* _args)
+{
+	ReaderArgs* args = (ReaderArgs*)_args;
+	OrderContext context;
+	int low = 0;
+	int high = 2 * SIZE;
+
+	while( __atomic_load_n(args->m_isWriting, __ATOMIC_SEQ_CST) )
+	{
+		context.m_last = -1;
+		context.m_count = 0;
+		context.m_failed = 0;
+
+		CTree_Range(args->m_tree, args->m_readerId, &low, &high, OrderAction, &context);
+		if( context.m_failed || (SIZE != context.m_count && SIZE - 1 != context.m_count) )
+		{
+			args->m_failed = 1;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
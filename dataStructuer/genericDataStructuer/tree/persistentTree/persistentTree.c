@@ -0,0 +1,749 @@
+/**
+ *  @file 		persistentTree.c
+ *  @brief 		src file for Generic persistent (immutable) ordered tree
+ *
+ *  @details 	Implement an ordered set ADT of user items as an AVL tree with path copying.
+ *  			A node is never changed after it is made. The count of a node is the number
+ *  			of links to it, from fathers and from versions.
+ *  			Ownership: the recursive functions get borrowed subtrees of the old version
+ *  			and return an owned link to the new subtree. A new node takes the links of
+ *  			it's sons, so an old subtree that is kept is retained once for the new father.
+ *  			On allocation failure every owned link is released on the way up, so the
+ *  			old version is never touched.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "persistentTree.h"	/* header file */
+#include <stdlib.h> 		/* for size_t, NULL, malloc, free */
+
+#define MAGIC_NUMBER (123456789)
+#define MAX_HEIGHT (96)		/* AVL height is less then 1.45 * log2(n) + 2, so it is never reached */
+#define HEIGHT(node)		( (NULL == (node)) ? 0 : (node)->m_height )
+#define CHECK_NULL(param)			do{ if(NULL == (param) ) { return NULL;}  } while(0)
+#define CHECK_TREE_NULL(param)		do{ if(NULL == (param) ) { return PTREE_UNINITIALIZED_ERROR;}  } while(0)
+#define CHECK_ITEM_NULL(param)		do{ if(NULL == (param) ) { return PTREE_ITEM_NULL_ERROR;}  } while(0)
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct Node Node;
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct Node
+{
+    void* m_data;		/* Pointer to node element data */
+    Node* m_left;		/* Subtree of the smaller items */
+    Node* m_right;		/* Subtree of the bigger items */
+    size_t m_refCount;	/* Number of links to the node, changed with atomic operations */
+    int m_height;		/* Height of the subtree, 1 for a leaf */
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+struct PTree
+{
+    Node* m_root;		/* The version own one link to the root */
+    size_t m_size;
+    PTreeLessComparator m_less;
+    size_t m_magicNumber;
+};
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* State of one insert OR remove */
+typedef struct Update
+{
+    PTreeLessComparator m_less;
+    int m_failed;		/* Set on allocation failure, no new node is made after it */
+} Update;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate a version handle that own _root
+ *
+ * @returns The version OR NULL on allocation failure (_root is not released)
+ */
+static PTree* NewVersion(PTreeLessComparator _less, Node* _root, size_t _size);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Add one link to _node
+ *
+ * @returns _node, can be NULL
+ */
+static Node* Retain(Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove one link from _node, free it if it was the last link and release
+ *			it's sons the same way, without recursion
+ */
+static void Release(Node* _node);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make a node that takes the links _left and _right
+ *
+ * @returns The new node, on failure OR if the update already failed the sons are
+ *			released and NULL is returned
+ */
+static Node* NewNode(Update* _update, void* _data, Node* _left, Node* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make a balanced subtree of _data and the owned subtrees _left and _right,
+ *			their heights differ by 2 at most
+ *
+ * @returns The new subtree root OR NULL on failure
+ */
+static Node* Balance(Update* _update, void* _data, Node* _left, Node* _right);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node with _item added, _item is not in the subtree
+ *
+ * @returns The new subtree root
+ */
+static Node* InsertNode(Update* _update, Node* _node, void* _item);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node without the item equal to _key, the item is in the subtree
+ *
+ * @param   _removed       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveNode(Update* _update, Node* _node, void* _key, void** _removed);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node without the smallest item
+ *
+ * @param   _minData       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveMin(Update* _update, Node* _node, void** _minData);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/******************************** API functions *******************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Create the empty version of a persistent tree
+ *
+ * @param   less			= A comparison function that returns true (none zero value)
+ *							if x < y  and false (zero) otherwise.
+ *
+ * @return 	The version pointer:
+ *
+ * @retval 	On success    	= A pointer to the newly created version.
+ * @retval  NULL          	= On failure due to allocation failure OR due to uninitialized pointer given
+ */
+PTree* PTree_Create(PTreeLessComparator _less)
+{
+	CHECK_NULL(_less);
+
+	return NewVersion(_less, NULL, 0);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Destroy one version
+ * @details Frees the nodes that no other version use, the other versions are not changed.
+ *			The items are never freed, they can be shared by many versions.
+ * @Complexity	O(k) where k is the number of nodes that only this version use
+ *
+ * @param   tree           	= A version returned by any function of this API
+ */
+void PTree_Destroy(PTree* _tree)
+{
+	if( NULL == _tree || MAGIC_NUMBER != _tree->m_magicNumber )
+	{
+		return;
+	}
+
+	Release(_tree->m_root);
+
+	_tree->m_magicNumber = 987654321;
+	free(_tree);
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Take a snapshot of a version
+ * @details The snapshot share all the nodes with _tree, both must be destroyed.
+ * @Complexity	O(1)
+ *
+ * @param   tree           	= A version returned by any function of this API
+ *
+ * @return 	The snapshot OR NULL on allocation failure OR uninitialized pointer given
+ */
+PTree* PTree_Snapshot(const PTree* _tree)
+{
+	PTree* snapshot;
+
+	CHECK_NULL(_tree);
+
+	snapshot = NewVersion(_tree->m_less, _tree->m_root, _tree->m_size);
+	CHECK_NULL(snapshot);
+
+	Retain(_tree->m_root);
+
+	return snapshot;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Make a new version with _item added
+ * @details _tree is not changed, the new version share with it all the nodes
+ *			that are not on the path to _item.
+ * @Complexity 	O(log n) time and memory
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   item           	= An item to add
+ * @param   newTree        	= Set to the new version on success
+ *
+ * @return  Success indicator
+ * @retval  PTREE_SUCCESS				= On success
+ * @retval  PTREE_UNINITIALIZED_ERROR	= If _tree OR _newTree is not initialized
+ * @retval  PTREE_ITEM_NULL_ERROR		= If _item is NULL
+ * @retval  PTREE_DUPLICATE_ERROR		= If an equal item already in _tree
+ * @retval  PTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+PTreeResult PTree_Insert(const PTree* _tree, void* _item, PTree** _newTree)
+{
+	Update update;
+	Node* root;
+
+	CHECK_TREE_NULL(_tree);
+	CHECK_TREE_NULL(_newTree);
+	CHECK_ITEM_NULL(_item);
+
+	if( NULL != PTree_Find(_tree, _item) )
+	{
+		return PTREE_DUPLICATE_ERROR;
+	}
+
+	update.m_less = _tree->m_less;
+	update.m_failed = 0;
+
+	root = InsertNode(&update, _tree->m_root, _item);
+	if( update.m_failed )
+	{
+		return PTREE_ALLOCATION_ERROR;
+	}
+
+	*_newTree = NewVersion(_tree->m_less, root, _tree->m_size + 1);
+	if( NULL == *_newTree )
+	{
+		Release(root);
+		return PTREE_ALLOCATION_ERROR;
+	}
+
+	return PTREE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Make a new version without the item equal to _key
+ * @details _tree is not changed, the new version share with it all the nodes
+ *			that are not on the path to the removed item.
+ * @Complexity 	O(log n) time and memory
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   key           	= An item to compare the items to
+ * @param   newTree        	= Set to the new version on success
+ * @param   removed        	= Set to the removed item on success (may be NULL if unnecessary)
+ *
+ * @return  Success indicator
+ * @retval  PTREE_SUCCESS				= On success
+ * @retval  PTREE_UNINITIALIZED_ERROR	= If _tree OR _newTree is not initialized
+ * @retval  PTREE_ITEM_NULL_ERROR		= If _key is NULL
+ * @retval  PTREE_NOT_FOUND_ERROR		= If no equal item in _tree
+ * @retval  PTREE_ALLOCATION_ERROR		= On failure to allocate memory
+ */
+PTreeResult PTree_Remove(const PTree* _tree, void* _key, PTree** _newTree, void** _removed)
+{
+	Update update;
+	Node* root;
+	void* removed;
+
+	CHECK_TREE_NULL(_tree);
+	CHECK_TREE_NULL(_newTree);
+	CHECK_ITEM_NULL(_key);
+
+	if( NULL == PTree_Find(_tree, _key) )
+	{
+		return PTREE_NOT_FOUND_ERROR;
+	}
+
+	update.m_less = _tree->m_less;
+	update.m_failed = 0;
+
+	root = RemoveNode(&update, _tree->m_root, _key, &removed);
+	if( update.m_failed )
+	{
+		return PTREE_ALLOCATION_ERROR;
+	}
+
+	*_newTree = NewVersion(_tree->m_less, root, _tree->m_size - 1);
+	if( NULL == *_newTree )
+	{
+		Release(root);
+		return PTREE_ALLOCATION_ERROR;
+	}
+
+	if( NULL != _removed )
+	{
+		*_removed = removed;
+	}
+
+	return PTREE_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Search the item equal to _key
+ * @Complexity 	O(log n)
+ *
+ * @param   tree           	= A version returned by any function of this API
+ * @param   key           	= An item to compare the items to
+ *
+ * @return  The item found OR NULL if not found OR uninitialized pointer given
+ */
+void* PTree_Find(const PTree* _tree, void* _key)
+{
+	Node* current;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_key);
+
+	current = _tree->m_root;
+	while( NULL != current )
+	{
+		if( 0 != _tree->m_less(_key, current->m_data) )
+		{
+			current = current->m_left;
+		}
+		else if( 0 != _tree->m_less(current->m_data, _key) )
+		{
+			current = current->m_right;
+		}
+		else
+		{
+			return current->m_data;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Get the number of items in the version
+ * @Complexity 	O(1)
+ *
+ * @retval  number 		= Number of items, 0 if the tree is uninitialized
+ */
+size_t PTree_Size(const PTree* _tree)
+{
+	if( NULL == _tree )
+	{
+		return 0;
+	}
+
+	return _tree->m_size;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief   Performs an action function on every item in the range [_low, _high], in order
+ * @details Iteration will stop on the first item for which action returns a zero
+ *          or after the last item that is not greater then _high
+ * @Complexity  O(log n + k) where k is the number of items in the range
+ *
+ * @param   tree           	=       Version to iterate over
+ * @param   low           	=       The lowest item of the range
+ * @param   high           	=       The highest item of the range
+ * @param   action         	=       Action function to call for each item
+ * @param   context        	=       Parameters for the function
+ *
+ * @return  The item where action returned zero value
+ *
+ * @retval  item        	=   Where the loop has stopped
+ * @retval  NULL         	=   If the action ran on all the range OR pointer is uninitialized
+ */
+void* PTree_Range(const PTree* _tree, void* _low, void* _high,
+				PTreeActionFunction _action, void* _context)
+{
+	Node* stack[MAX_HEIGHT];
+	size_t top = 0;
+	Node* current;
+
+	CHECK_NULL(_tree);
+	CHECK_NULL(_low);
+	CHECK_NULL(_high);
+	CHECK_NULL(_action);
+
+	/* Keep on the stack the nodes that are not less then _low on the path to _low */
+	current = _tree->m_root;
+	while( NULL != current )
+	{
+		if( 0 != _tree->m_less(current->m_data, _low) )
+		{
+			current = current->m_right;
+		}
+		else
+		{
+			stack[top++] = current;
+			current = current->m_left;
+		}
+	}
+
+	while( 0 < top )
+	{
+		current = stack[--top];
+		if( 0 != _tree->m_less(_high, current->m_data) )
+		{
+			break;
+		}
+
+		if( 0 == _action(current->m_data, _context) )
+		{
+			return current->m_data;
+		}
+
+		for(current = current->m_right; NULL != current; current = current->m_left)
+		{
+			stack[top++] = current;
+		}
+	}
+
+	return NULL;
+}
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Allocate a version handle that own _root
+ *
+ * @returns The version OR NULL on allocation failure (_root is not released)
+ */
+static PTree* NewVersion(PTreeLessComparator _less, Node* _root, size_t _size)
+{
+	PTree* version;
+
+	version = (PTree*)malloc( sizeof (PTree) );
+	CHECK_NULL(version);
+
+	version->m_root = _root;
+	version->m_size = _size;
+	version->m_less = _less;
+	version->m_magicNumber = MAGIC_NUMBER;
+
+	return version;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Add one link to _node
+ *
+ * @returns _node, can be NULL
+ */
+static Node* Retain(Node* _node)
+{
+	if( NULL != _node )
+	{
+		__atomic_add_fetch(&_node->m_refCount, 1, __ATOMIC_RELAXED);
+	}
+
+	return _node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Remove one link from _node, free it if it was the last link and release
+ *			it's sons the same way, without recursion
+ */
+static void Release(Node* _node)
+{
+	Node* stack = NULL;
+	Node* current;
+
+	/* A node with no links belongs only to this function, it's m_data links the stack */
+	if( NULL != _node && 0 == __atomic_sub_fetch(&_node->m_refCount, 1, __ATOMIC_ACQ_REL) )
+	{
+		_node->m_data = NULL;
+		stack = _node;
+	}
+
+	while( NULL != stack )
+	{
+		current = stack;
+		stack = (Node*)current->m_data;
+
+		if( NULL != current->m_left && 0 == __atomic_sub_fetch(&current->m_left->m_refCount, 1, __ATOMIC_ACQ_REL) )
+		{
+			current->m_left->m_data = stack;
+			stack = current->m_left;
+		}
+
+		if( NULL != current->m_right && 0 == __atomic_sub_fetch(&current->m_right->m_refCount, 1, __ATOMIC_ACQ_REL) )
+		{
+			current->m_right->m_data = stack;
+			stack = current->m_right;
+		}
+
+		free(current);
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make a node that takes the links _left and _right
+ *
+ * @returns The new node, on failure OR if the update already failed the sons are
+ *			released and NULL is returned
+ */
+static Node* NewNode(Update* _update, void* _data, Node* _left, Node* _right)
+{
+	Node* node = NULL;
+
+	if( !_update->m_failed )
+	{
+		node = (Node*)malloc( sizeof (Node) );
+	}
+
+	if( NULL == node )
+	{
+		_update->m_failed = 1;
+		Release(_left);
+		Release(_right);
+		return NULL;
+	}
+
+	node->m_data = _data;
+	node->m_left = _left;
+	node->m_right = _right;
+	node->m_refCount = 1;
+	node->m_height = 1 + ( (HEIGHT(_left) > HEIGHT(_right)) ? HEIGHT(_left) : HEIGHT(_right) );
+
+	return node;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Make a balanced subtree of _data and the owned subtrees _left and _right,
+ *			their heights differ by 2 at most
+ *
+ * @returns The new subtree root OR NULL on failure
+ */
+static Node* Balance(Update* _update, void* _data, Node* _left, Node* _right)
+{
+	Node* result;
+	Node* middle;
+
+	if( HEIGHT(_left) > HEIGHT(_right) + 1 )
+	{
+		/* The parts of _left are retained for the new nodes, then _left is released */
+		if( HEIGHT(_left->m_left) >= HEIGHT(_left->m_right) )
+		{
+			result = NewNode(_update, _left->m_data, Retain(_left->m_left),
+						NewNode(_update, _data, Retain(_left->m_right), _right));
+		}
+		else
+		{
+			middle = _left->m_right;
+			result = NewNode(_update, middle->m_data,
+						NewNode(_update, _left->m_data, Retain(_left->m_left), Retain(middle->m_left)),
+						NewNode(_update, _data, Retain(middle->m_right), _right));
+		}
+		Release(_left);
+		return result;
+	}
+
+	if( HEIGHT(_right) > HEIGHT(_left) + 1 )
+	{
+		if( HEIGHT(_right->m_right) >= HEIGHT(_right->m_left) )
+		{
+			result = NewNode(_update, _right->m_data,
+						NewNode(_update, _data, _left, Retain(_right->m_left)), Retain(_right->m_right));
+		}
+		else
+		{
+			middle = _right->m_left;
+			result = NewNode(_update, middle->m_data,
+						NewNode(_update, _data, _left, Retain(middle->m_left)),
+						NewNode(_update, _right->m_data, Retain(middle->m_right), Retain(_right->m_right)));
+		}
+		Release(_right);
+		return result;
+	}
+
+	return NewNode(_update, _data, _left, _right);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node with _item added, _item is not in the subtree
+ *
+ * @returns The new subtree root
+ */
+static Node* InsertNode(Update* _update, Node* _node, void* _item)
+{
+	Node* son;
+
+	if( NULL == _node )
+	{
+		return NewNode(_update, _item, NULL, NULL);
+	}
+
+	if( 0 != _update->m_less(_item, _node->m_data) )
+	{
+		son = InsertNode(_update, _node->m_left, _item);
+		return Balance(_update, _node->m_data, son, Retain(_node->m_right));
+	}
+
+	son = InsertNode(_update, _node->m_right, _item);
+	return Balance(_update, _node->m_data, Retain(_node->m_left), son);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node without the item equal to _key, the item is in the subtree
+ *
+ * @param   _removed       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveNode(Update* _update, Node* _node, void* _key, void** _removed)
+{
+	Node* son;
+	void* minData;
+
+	if( 0 != _update->m_less(_key, _node->m_data) )
+	{
+		son = RemoveNode(_update, _node->m_left, _key, _removed);
+		return Balance(_update, _node->m_data, son, Retain(_node->m_right));
+	}
+
+	if( 0 != _update->m_less(_node->m_data, _key) )
+	{
+		son = RemoveNode(_update, _node->m_right, _key, _removed);
+		return Balance(_update, _node->m_data, Retain(_node->m_left), son);
+	}
+
+	*_removed = _node->m_data;
+
+	if( NULL == _node->m_left )
+	{
+		return Retain(_node->m_right);
+	}
+
+	if( NULL == _node->m_right )
+	{
+		return Retain(_node->m_left);
+	}
+
+	/* The next item in order takes the place of the removed item */
+	son = RemoveMin(_update, _node->m_right, &minData);
+	return Balance(_update, minData, Retain(_node->m_left), son);
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief  Copy of the subtree of _node without the smallest item
+ *
+ * @param   _minData       	= Set to the removed item
+ *
+ * @returns The new subtree root
+ */
+static Node* RemoveMin(Update* _update, Node* _node, void** _minData)
+{
+	Node* son;
+
+	if( NULL == _node->m_left )
+	{
+		*_minData = _node->m_data;
+		return Retain(_node->m_right);
+	}
+
+	son = RemoveMin(_update, _node->m_left, _minData);
+	return Balance(_update, _node->m_data, son, Retain(_node->m_right));
+}
+/*----------------------------------------------------------------------------*/
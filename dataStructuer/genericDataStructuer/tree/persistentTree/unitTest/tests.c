@@ -0,0 +1,447 @@
+/**
+ *  @file 		tests.c
+ *  @brief 		Create a set of test for Generic persistent (immutable) ordered tree
+ *
+ *  @details 	The API stores user items ordered by user provided less function,
+ *				every insert and remove make a new version and the old versions stay valid.
+ *
+ *  @author 	Author Matan Asaf (Matan.Asaf@gmail.com)
+ *
+ *  @date 		last update: 2017-01-01
+ *
+ *  @bug No known bugs.
+ *
+ *	If you found any bug in my code OR just want to send me an email for any reason,
+ *  feel free to do so, I will do my best to send you a respond as soon as possible
+ */
+
+#include "persistentTree.h"	/* header file */
+#include "matan_test.h"		/* def of unit test */
+#include <stdio.h> 			/* for printf */
+#include <stdlib.h> 		/* for size_t & srand & rand */
+#include <time.h> 			/* for time_t */
+
+#define SIZE (1000) 		/* SIZE = Num of items in each test */
+
+
+
+/****************************** Define Declaration ****************************/
+/*----------------------------------------------------------------------------*/
+typedef struct OrderContext
+{
+	int m_last;				/* The last item seen */
+	size_t m_count;
+	int m_failed;
+} OrderContext;
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Declaration of functions *************************/
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Less function for int items
+*/
+static int IntLess(void* _a, void* _b);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that count the items and check they come in increasing order
+ *
+ * @param   _context  	= OrderContext
+*/
+static int OrderAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Action that stop on the item equal to context
+*/
+static int NotEqualAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Insert items 0, 2, 4 ... (2 * _nElements - 2) in random order,
+ *			every version is kept in _versions, _versions[i] has i items
+ *
+ * @return	Number of successful inserts
+*/
+static size_t InsertEvenItems(PTree** _versions, int* _items, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Destroy _nVersions versions
+*/
+static void DestroyVersions(PTree** _versions, size_t _nVersions);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/*
+ * @brief 	Check that _tree has exactly the items of _items in [0, _nElements) that
+ *			_isIn mark, in order
+*/
+static int CheckItems(PTree* _tree, int* _items, int* _isIn, size_t _nElements);
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Tests for API functions **************************/
+/*------------------------------- PTree_Create -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Create_CheckNull)
+    ASSERT_THAT( NULL == PTree_Create(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Create_CheckEmpty)
+    PTree* tree;
+    int key = 1;
+    int result;
+
+    tree = PTree_Create(IntLess);
+    result = ( NULL != tree && 0 == PTree_Size(tree) && NULL == PTree_Find(tree, &key) );
+
+    PTree_Destroy(tree);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- PTree_Insert -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Insert_CheckNullAndDuplicate)
+    PTree* tree;
+    PTree* newTree = NULL;
+    PTree* sameTree = NULL;
+    int item = 1;
+    int sameItem = 1;
+    PTreeResult result[3];
+
+    tree = PTree_Create(IntLess);
+    result[0] = PTree_Insert(tree, NULL, &newTree);
+    result[1] = PTree_Insert(tree, &item, &newTree);
+    result[2] = PTree_Insert(newTree, &sameItem, &sameTree);
+
+    ASSERT_THAT( PTREE_ITEM_NULL_ERROR == result[0] && PTREE_SUCCESS == result[1] );
+    ASSERT_THAT( PTREE_DUPLICATE_ERROR == result[2] && NULL == sameTree );
+    ASSERT_THAT( PTREE_UNINITIALIZED_ERROR == PTree_Insert(NULL, &item, &sameTree) );
+    ASSERT_THAT( PTREE_UNINITIALIZED_ERROR == PTree_Insert(tree, &item, NULL) );
+    ASSERT_THAT( 0 == PTree_Size(tree) && 1 == PTree_Size(newTree) );
+    PTree_Destroy(tree);
+    PTree_Destroy(newTree);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Insert_CheckOldVersionsUnchanged)
+    PTree* versions[SIZE + 1];
+    int items[SIZE];
+    int isIn[SIZE] = {0};
+    int search;
+    size_t i;
+    int result = 1;
+
+    ASSERT_THAT( SIZE == InsertEvenItems(versions, items, SIZE) );
+
+    /* Every version has exactly the items that were inserted before it */
+    for(i = 0; i <= SIZE; ++i)
+    {
+    	result = result && ( i == PTree_Size(versions[i]) );
+    }
+    for(search = 0; search < 2 * SIZE; search += 2)
+    {
+    	isIn[search / 2] = 1;
+    }
+    result = result && CheckItems(versions[SIZE], items, isIn, SIZE);
+
+    DestroyVersions(versions, SIZE + 1);
+    ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- PTree_Remove -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Remove_CheckAllAndOldVersion)
+    PTree* versions[SIZE + 1];
+    PTree* tree;
+    PTree* newTree = NULL;
+    int items[SIZE];
+    int isIn[SIZE];
+    int search;
+    int notFound = 7;
+    void* removed = NULL;
+    size_t i;
+    int result = 1;
+
+    InsertEvenItems(versions, items, SIZE);
+    ASSERT_THAT( PTREE_NOT_FOUND_ERROR == PTree_Remove(versions[SIZE], &notFound, &newTree, &removed) );
+    ASSERT_THAT( NULL == newTree && NULL == removed );
+
+    tree = PTree_Snapshot(versions[SIZE]);
+    for(search = 0; search < 2 * SIZE; search += 4)
+    {
+    	result = result && ( PTREE_SUCCESS == PTree_Remove(tree, &search, &newTree, &removed) );
+    	result = result && ( &items[search / 2] == removed && NULL == PTree_Find(newTree, &search) );
+    	PTree_Destroy(tree);
+    	tree = newTree;
+    }
+
+    for(i = 0; i < SIZE; ++i)
+    {
+    	isIn[i] = ( 0 != i % 2 );
+    }
+    ASSERT_THAT( result && SIZE / 2 == PTree_Size(tree) );
+    ASSERT_THAT( CheckItems(tree, items, isIn, SIZE) );
+
+    /* The version the removes started from still has all the items */
+    for(i = 0; i < SIZE; ++i)
+    {
+    	isIn[i] = 1;
+    }
+    ASSERT_THAT( CheckItems(versions[SIZE], items, isIn, SIZE) );
+
+    PTree_Destroy(tree);
+    DestroyVersions(versions, SIZE + 1);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------ PTree_Snapshot ------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Snapshot_CheckAfterDestroy)
+    PTree* versions[SIZE + 1];
+    PTree* snapshot;
+    PTree* newTree = NULL;
+    int items[SIZE];
+    int isIn[SIZE];
+    int newItem = 1;
+    size_t i;
+
+    ASSERT_THAT( NULL == PTree_Snapshot(NULL) );
+
+    InsertEvenItems(versions, items, SIZE);
+    snapshot = PTree_Snapshot(versions[SIZE]);
+    ASSERT_THAT( NULL != snapshot && SIZE == PTree_Size(snapshot) );
+
+    /* The snapshot stays whole after all the versions it came from are destroyed */
+    DestroyVersions(versions, SIZE + 1);
+    for(i = 0; i < SIZE; ++i)
+    {
+    	isIn[i] = 1;
+    }
+    ASSERT_THAT( CheckItems(snapshot, items, isIn, SIZE) );
+
+    ASSERT_THAT( PTREE_SUCCESS == PTree_Insert(snapshot, &newItem, &newTree) );
+    ASSERT_THAT( SIZE + 1 == PTree_Size(newTree) && NULL == PTree_Find(snapshot, &newItem) );
+
+    PTree_Destroy(snapshot);
+    ASSERT_THAT( &newItem == PTree_Find(newTree, &newItem) );
+    PTree_Destroy(newTree);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*-------------------------------- PTree_Range -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Range_CheckCountAndOrder)
+    PTree* versions[SIZE + 1];
+    int items[SIZE];
+    int low = 99;
+    int high = 200;
+    OrderContext context = {-1, 0, 0};
+
+    InsertEvenItems(versions, items, SIZE);
+
+    ASSERT_THAT( NULL == PTree_Range(versions[SIZE], &low, &high, OrderAction, &context) );
+    ASSERT_THAT( 51 == context.m_count && !context.m_failed );
+    DestroyVersions(versions, SIZE + 1);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(PTree_Range_CheckActionStop)
+    PTree* versions[SIZE + 1];
+    int items[SIZE];
+    int low = 0;
+    int high = 2 * SIZE;
+    int stopValue = 6;
+
+    InsertEvenItems(versions, items, SIZE);
+
+    ASSERT_THAT( &items[3] == PTree_Range(versions[SIZE], &low, &high, NotEqualAction, &stopValue) );
+    ASSERT_THAT( NULL == PTree_Range(versions[SIZE], &low, &high, NULL, &stopValue) );
+    DestroyVersions(versions, SIZE + 1);
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/********************************* Tests SET ********************************/
+/*----------------------------------------------------------------------------*/
+TEST_SET(Test Generic Persistent Tree Module)
+	PRINT(PTree_Create_CheckNull)
+	PRINT(PTree_Create_CheckEmpty)
+
+	PRINT(PTree_Insert_CheckNullAndDuplicate)
+	PRINT(PTree_Insert_CheckOldVersionsUnchanged)
+
+	PRINT(PTree_Remove_CheckAllAndOldVersion)
+
+	PRINT(PTree_Snapshot_CheckAfterDestroy)
+
+	PRINT(PTree_Range_CheckCountAndOrder)
+	PRINT(PTree_Range_CheckActionStop)
+END_SET
+/*----------------------------------------------------------------------------*/
+
+
+
+
+
+/*************************** Implication of functions *************************/
+/*----------------------------------------------------------------------------*/
+static int IntLess(void* _a, void* _b)
+{
+	return *(int*)_a < *(int*)_b;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int OrderAction(void* _element, void* _context)
+{
+	OrderContext* context = (OrderContext*)_context;
+
+	if( *(int*)_element <= context->m_last )
+	{
+		context->m_failed = 1;
+	}
+
+	context->m_last = *(int*)_element;
+	++context->m_count;
+
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int NotEqualAction(void* _element, void* _context)
+{
+	return *(int*)_element != *(int*)_context;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static size_t InsertEvenItems(PTree** _versions, int* _items, size_t _nElements)
+{
+	size_t* order;
+	size_t i;
+	size_t j;
+	size_t temp;
+	size_t counter = 0;
+
+	_versions[0] = PTree_Create(IntLess);
+	order = (size_t*)malloc(_nElements * sizeof(size_t));
+	if( NULL == order )
+	{
+		return 0;
+	}
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		_items[i] = (int)(2 * i);
+		order[i] = i;
+	}
+
+	/* Insert in random order, the items array stay sorted by index */
+	srand((unsigned)time(NULL));
+	for(i = _nElements; 0 < i; --i)
+	{
+		j = (size_t)rand() % i;
+		temp = order[i - 1];
+		order[i - 1] = order[j];
+		order[j] = temp;
+	}
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( PTREE_SUCCESS == PTree_Insert(_versions[i], &_items[order[i]], &_versions[i + 1]) )
+		{
+			++counter;
+		}
+	}
+
+	free(order);
+	return counter;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static void DestroyVersions(PTree** _versions, size_t _nVersions)
+{
+	size_t i;
+
+	/* Not in the order they were made, so shared nodes are freed by any version */
+	for(i = 0; i < _nVersions; i += 2)
+	{
+		PTree_Destroy(_versions[i]);
+	}
+	for(i = 1; i < _nVersions; i += 2)
+	{
+		PTree_Destroy(_versions[i]);
+	}
+
+	return;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+static int CheckItems(PTree* _tree, int* _items, int* _isIn, size_t _nElements)
+{
+	OrderContext context = {-1, 0, 0};
+	int low = 0;
+	int high = (int)(2 * _nElements);
+	size_t expected = 0;
+	size_t i;
+	int result = 1;
+
+	for(i = 0; i < _nElements; ++i)
+	{
+		if( _isIn[i] )
+		{
+			result = result && ( &_items[i] == PTree_Find(_tree, &_items[i]) );
+			++expected;
+		}
+		else
+		{
+			result = result && ( NULL == PTree_Find(_tree, &_items[i]) );
+		}
+	}
+
+	PTree_Range(_tree, &low, &high, OrderAction, &context);
+
+	return result && !context.m_failed && expected == context.m_count && expected == PTree_Size(_tree);
+}
+/*----------------------------------------------------------------------------*/
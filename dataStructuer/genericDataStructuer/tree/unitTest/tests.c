@@ -25,6 +25,8 @@
 
 #define SIZE (10) /* SIZE = The size of the treetor (num of element) in each test */
 #define MAX_RAND_VALUE (500) /* MAX_RAND_VALUE = The max value the function rand() can produce */   
+#define BALANCE_SIZE (4000) /* BALANCE_SIZE = The num of elements in the red-black shape tests */
+#define SHUFFLE_STEP (1597) /* SHUFFLE_STEP = Prime step, i * step % BALANCE_SIZE visits every value once */
 
 
 
@@ -73,6 +75,45 @@ static int	ChangeValueAction(void* _element, void* _context);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that count the elements it was called on
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Pointer to int counter
+ *
+ * @return   1 			= Countinue loop for all elements
+ */
+static int	CountAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that record the elements it was called on
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Int array, [0] is the counter and the values are recorded after it
+ *
+ * @return   1 			= Countinue loop for all elements
+ */
+static int	RecordAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that stop on the element equal to context
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Pointer to the value to stop at
+ *
+ * @return   0 			= If _element == _context value
+ */
+static int	NotEqualAction(void* _element, void* _context);
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief 	Function that check if iterator a data <  iterator b data
@@ -121,6 +162,19 @@ static int CompareToValuePredicate(void* _a, void* _b);
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function that check _depth <= 2 * log2(_nItems + 1), the height limit of a red-black tree
+ *
+ * @param   _depth      = The num of nodes on the longest path from the root
+ * @param   _nItems     = The num of elements in the tree
+ *
+ * @return   1 			= If the depth is in the limit, otherwise 0
+ */
+static int IsBalancedDepth(size_t _depth, size_t _nItems);
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -145,6 +199,117 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*--------------------------- BSTree_BuildFromSorted -------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_BuildFromSorted_CheckNull_Unsorted)
+	int arr[3] = {1, 3, 2};
+	void* items[3];
+	
+	items[0] = &arr[0];
+	items[1] = &arr[1];
+	items[2] = &arr[2];
+	
+	ASSERT_THAT( NULL == BSTree_BuildFromSorted(CompareData, items, 3) );
+	ASSERT_THAT( NULL == BSTree_BuildFromSorted(NULL, items, 2) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_BuildFromSorted_CheckCase_SortedValues)
+	BSTree* myTree;
+	int arr[SIZE];
+	void* items[SIZE];
+	size_t i;
+	int result = 1;
+	
+	for(i = 0; i < SIZE; ++i)
+	{
+		arr[i] = 2 * (int)i;
+		items[i] = &arr[i];
+	}
+	
+	myTree = BSTree_BuildFromSorted(CompareData, items, SIZE);
+	
+	result = ( SIZE == BSTree_Size(myTree) );
+	for(i = 0; i < SIZE; ++i)
+	{
+		result = result && ( &arr[i] == BSTreeItr_Get(BSTree_Select(myTree, i)) );
+	}
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_BuildFromSorted_CheckCase_RemoveAndInsert)
+	BSTree* myTree;
+	int arr[SIZE];
+	void* items[SIZE];
+	int newData = 3;
+	size_t i;
+	int result;
+	
+	for(i = 0; i < SIZE; ++i)
+	{
+		arr[i] = 2 * (int)i;
+		items[i] = &arr[i];
+	}
+	
+	myTree = BSTree_BuildFromSorted(CompareData, items, SIZE);
+	
+	/* Nodes of the block and a node of it's own live together in the tree */
+	BSTreeItr_Remove(myTree, BSTree_Select(myTree, 0));
+	BSTreeItr_Remove(myTree, BSTree_Select(myTree, SIZE / 2));
+	BSTree_Insert(myTree, &newData);
+	
+	result = ( SIZE - 1 == BSTree_Size(myTree) );
+	result = result && ( 3 == *(int*)BSTreeItr_Get(BSTree_Select(myTree, 1)) );
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- BSTree_Merge -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Merge_CheckCase_CommonValues)
+	BSTree* first = BSTree_Create(CompareData);
+	BSTree* second = BSTree_Create(CompareData);
+	BSTree* merged;
+	int arr1[SIZE];
+	int arr2[SIZE];
+	size_t i;
+	int result;
+	
+	/* first hold 0, 2, 4 ... and second hold 0, 3, 6 ..., the multiples of 6 are in both */
+	InsertSortedValues(first, arr1, SIZE, 2, 0);
+	InsertSortedValues(second, arr2, SIZE, 3, 0);
+	
+	merged = BSTree_Merge(first, second);
+	
+	result = ( NULL != merged && BSTree_Size(merged) == 2 * SIZE - (1 + 2 * (SIZE - 1) / 6) );
+	result = result && ( &arr1[0] == BSTreeItr_Get(BSTree_Select(merged, 0)) );
+	for(i = 1; result && i < BSTree_Size(merged); ++i)
+	{
+		result = ( *(int*)BSTreeItr_Get(BSTree_Select(merged, i - 1)) < *(int*)BSTreeItr_Get(BSTree_Select(merged, i)) );
+	}
+	
+	BSTree_Destroy(merged, NULL);
+	BSTree_Destroy(first, NULL);
+	BSTree_Destroy(second, NULL);
+	
+	ASSERT_THAT( result );
+	ASSERT_THAT( NULL == BSTree_Merge(NULL, NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 /*------------------------------- BSTreeItr_Get ------------------------------*/
 /*----------------------------------------------------------------------------*/
 TEST(BSTreeItr_Get_CheckNull_Tree)
@@ -732,6 +897,235 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*------------------------------- BSTree_Find -------------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Find_CheckNull_Tree)
+	int key = 0;
+	
+	ASSERT_THAT( NULL == BSTree_Find(NULL, &key) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Find_CheckCase_FoundAndNotFound)
+	BSTree* myTree = BSTree_Create(CompareData);
+	void* found[2 * SIZE];
+	int arr[SIZE];
+	int key;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	for(key = 0; key < 2 * SIZE; ++key)
+	{
+		found[key] = BSTreeItr_Get(BSTree_Find(myTree, &key));
+	}
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	for(key = 0; key < 2 * SIZE; key += 2)
+	{
+		ASSERT_THAT( &arr[key / 2] == found[key] );
+		ASSERT_THAT( NULL == found[key + 1] );
+	}
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_LowerBound_CheckCase_SortedValues)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	int below = -1;
+	int between = 5;
+	int exact = 6;
+	int above = 2 * SIZE;
+	int* retVal[3];
+	BSTreeItr notFound;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	retVal[0] = BSTreeItr_Get(BSTree_LowerBound(myTree, &below));
+	retVal[1] = BSTreeItr_Get(BSTree_LowerBound(myTree, &between));
+	retVal[2] = BSTreeItr_Get(BSTree_LowerBound(myTree, &exact));
+	notFound = BSTree_LowerBound(myTree, &above);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( 0 == *retVal[0] && 6 == *retVal[1] && 6 == *retVal[2] );
+	ASSERT_THAT( NULL == notFound );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_UpperBound_CheckCase_SortedValues)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	int below = -1;
+	int between = 5;
+	int exact = 6;
+	int last = 2 * SIZE - 2;
+	int* retVal[3];
+	BSTreeItr notFound;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	retVal[0] = BSTreeItr_Get(BSTree_UpperBound(myTree, &below));
+	retVal[1] = BSTreeItr_Get(BSTree_UpperBound(myTree, &between));
+	retVal[2] = BSTreeItr_Get(BSTree_UpperBound(myTree, &exact));
+	notFound = BSTree_UpperBound(myTree, &last);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( 0 == *retVal[0] && 6 == *retVal[1] && 8 == *retVal[2] );
+	ASSERT_THAT( NULL == notFound );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Range_CheckCase_CountInRange)
+	BSTree* myTree = BSTree_Create(CompareData);
+	BSTreeItr retVal[2];
+	int arr[SIZE];
+	int low = 3;
+	int high = 2 * SIZE;
+	int counter[2] = {0, 0};
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	retVal[0] = BSTree_Range(myTree, &low, &high, CountAction, &counter[0]);
+	high = 8;
+	retVal[1] = BSTree_Range(myTree, &low, &high, CountAction, &counter[1]);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	/* [3, 2 * SIZE] hold 4, 6 ... (2 * SIZE - 2) and [3, 8] hold 4, 6, 8 */
+	ASSERT_THAT( NULL == retVal[0] && SIZE - 2 == counter[0] );
+	ASSERT_THAT( NULL == retVal[1] && 3 == counter[1] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Range_CheckCase_ActionStop)
+	BSTree* myTree = BSTree_Create(CompareData);
+	BSTreeItr retVal;
+	int arr[SIZE];
+	int low = 0;
+	int high = 2 * SIZE;
+	int stopValue = 6;
+	int* stopData;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	retVal = BSTree_Range(myTree, &low, &high, NotEqualAction, &stopValue);
+	stopData = BSTreeItr_Get(retVal);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( 6 == *stopData );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*---------------------------- BSTree order statistics -----------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Size_CheckCase_InsertAndRemove)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	size_t sizes[3];
+	
+	sizes[0] = BSTree_Size(myTree);
+	InsertSortedValues(myTree, arr, SIZE, 1, 0);
+	sizes[1] = BSTree_Size(myTree);
+	BSTreeItr_Remove(myTree, BSTreeItr_Begin(myTree));
+	sizes[2] = BSTree_Size(myTree);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( 0 == sizes[0] && SIZE == sizes[1] && SIZE - 1 == sizes[2] );
+	ASSERT_THAT( 0 == BSTree_Size(NULL) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Select_CheckCase_SortedValues)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	size_t i;
+	int result = 1;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	for(i = 0; i < SIZE; ++i)
+	{
+		result = result && ( 2 * (int)i == *(int*)BSTreeItr_Get(BSTree_Select(myTree, i)) );
+	}
+	result = result && ( NULL == BSTree_Select(myTree, SIZE) );
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( result );
+	ASSERT_THAT( NULL == BSTree_Select(NULL, 0) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Rank_CheckCase_SortedValues)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	int key;
+	int result = 1;
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	/* Both 2 * i and 2 * i - 1 have i elements before them */
+	for(key = 0; key < 2 * SIZE; ++key)
+	{
+		result = result && ( (size_t)((key + 1) / 2) == BSTree_Rank(myTree, &key) );
+	}
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Select_CheckCase_RandValuesAfterRemove)
+	BSTree* myTree = BSTree_Create(CompareData);
+	BSTreeItr itr;
+	int arr[SIZE];
+	size_t i;
+	size_t nItems;
+	int result = 1;
+	
+	nItems = InsertRandValues(myTree, arr, SIZE, MAX_RAND_VALUE);
+	BSTreeItr_Remove(myTree, BSTree_Select(myTree, nItems / 2));
+	--nItems;
+	
+	/* Select and Rank must agree with the in order walk */
+	itr = BSTreeItr_Begin(myTree);
+	for(i = 0; i < nItems; ++i)
+	{
+		result = result && ( itr == BSTree_Select(myTree, i) );
+		result = result && ( i == BSTree_Rank(myTree, BSTreeItr_Get(itr)) );
+		itr = BSTreeItr_Next(itr);
+	}
+	result = result && ( nItems == BSTree_Size(myTree) );
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 /*------------------------------- BSTreeItr_Remove ---------------------------*/
 /*----------------------------------------------------------------------------*/
 TEST(BSTreeItr_Remove_CheckNull_Tree)
@@ -854,6 +1248,127 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+TEST(BSTreeItr_Remove_CheckCase_OtherItrStayValid)
+	BSTree* myTree = BSTree_Create(CompareData);
+	BSTreeItr itr[SIZE];
+	BSTreeItr current;
+	int arr[SIZE];
+	int* retVal[SIZE];
+	int expected = 1;
+	size_t i;
+	
+	for(i = 0; i < SIZE; ++i)
+	{
+		arr[i] =  (int)i;
+		itr[i] = BSTree_Insert(myTree, &arr[i]);
+	}
+	
+	/* Remove the even values by the iterators returned from insert */
+	for(i = 0; i < SIZE; i += 2)
+	{
+		retVal[i] = BSTreeItr_Remove(myTree, itr[i]);
+		ASSERT_THAT( (int)i == *retVal[i] );
+	}
+	
+	for(i = 1; i < SIZE; i += 2)
+	{
+		ASSERT_THAT( (int)i == *(int*)BSTreeItr_Get(itr[i]) );
+	}
+	
+	current = BSTreeItr_Begin(myTree);
+	while( 1 )
+	{
+		ASSERT_THAT( expected == *(int*)BSTreeItr_Get(current) );
+		if( BSTreeItr_Equals(current, BSTreeItr_End(myTree)) )
+		{
+			break;
+		}
+		
+		current = BSTreeItr_Next(current);
+		expected += 2;
+	}
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( SIZE - 1 == expected );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*------------------------------- Red-black shape ----------------------------*/
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Insert_CheckCase_SortedValuesBalanced)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int* arr = (int*)malloc(BALANCE_SIZE * sizeof(int));
+	size_t maxDepth = 0;
+	int isRedBlack;
+	
+	ASSERT_THAT( NULL != arr );
+	
+	/* Increasing values, an unbalanced tree would be a list of BALANCE_SIZE nodes */
+	InsertSortedValues(myTree, arr, BALANCE_SIZE, 1, 0);
+	isRedBlack = BSTree_CheckInvariants(myTree, &maxDepth);
+	
+	ASSERT_THAT( BALANCE_SIZE == BSTree_Size(myTree) );
+	
+	BSTree_Destroy(myTree, NULL);
+	free(arr);
+	
+	ASSERT_THAT( isRedBlack );
+	ASSERT_THAT( IsBalancedDepth(maxDepth, BALANCE_SIZE) );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_Remove_CheckCase_MixedInsertRemoveRedBlack)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int* arr = (int*)malloc(BALANCE_SIZE * sizeof(int));
+	size_t maxDepth = 0;
+	size_t i;
+	int result = 1;
+	
+	ASSERT_THAT( NULL != arr );
+	
+	/* Every value once, in a shuffled order */
+	for(i = 0; i < BALANCE_SIZE; ++i)
+	{
+		arr[i] = (int)( (i * SHUFFLE_STEP) % BALANCE_SIZE );
+		result = result && ( NULL != BSTree_Insert(myTree, &arr[i]) );
+	}
+	result = result && BSTree_CheckInvariants(myTree, &maxDepth);
+	
+	/* Remove two of every three, then insert back every second removed one */
+	for(i = 0; i < BALANCE_SIZE; ++i)
+	{
+		if( 0 != i % 3 )
+		{
+			result = result && ( &arr[i] == BSTreeItr_Remove(myTree, BSTree_Find(myTree, &arr[i])) );
+		}
+	}
+	result = result && BSTree_CheckInvariants(myTree, &maxDepth);
+	result = result && IsBalancedDepth(maxDepth, BSTree_Size(myTree));
+	
+	for(i = 0; i < BALANCE_SIZE; i += 2)
+	{
+		if( 0 != i % 3 )
+		{
+			result = result && ( NULL != BSTree_Insert(myTree, &arr[i]) );
+		}
+	}
+	result = result && BSTree_CheckInvariants(myTree, &maxDepth);
+	result = result && IsBalancedDepth(maxDepth, BSTree_Size(myTree));
+	result = result && ( BALANCE_SIZE - BALANCE_SIZE / 3 == BSTree_Size(myTree) );
+	
+	BSTree_Destroy(myTree, NULL);
+	free(arr);
+	
+	ASSERT_THAT( result );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 /*------------------------------- BSTree_ForEach -----------------------------*/
 /*----------------------------------------------------------------------------*/
 TEST(BSTree_ForEach_CheckNull_Tree)
@@ -963,6 +1478,63 @@ END_TEST
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_ForEach_CheckCase_ModesOrder)
+	BSTree* myTree;
+	int arr[7] = {0, 1, 2, 3, 4, 5, 6};
+	void* items[7];
+	int preOrder[7] = {3, 1, 0, 2, 5, 4, 6};
+	int postOrder[7] = {0, 2, 1, 4, 6, 5, 3};
+	int record[3][8];
+	size_t i;
+	int result = 1;
+	
+	for(i = 0; i < 7; ++i)
+	{
+		items[i] = &arr[i];
+	}
+	
+	/* The built tree is full: 3 is the root, 1 and 5 are it's sons */
+	myTree = BSTree_BuildFromSorted(CompareData, items, 7);
+	record[0][0] = record[1][0] = record[2][0] = 0;
+	BSTree_ForEach(myTree, BSTREE_TRAVERSAL_PREORDER, RecordAction, record[0]);
+	BSTree_ForEach(myTree, BSTREE_TRAVERSAL_INORDER, RecordAction, record[1]);
+	BSTree_ForEach(myTree, BSTREE_TRAVERSAL_POSTORDER, RecordAction, record[2]);
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	for(i = 0; i < 7; ++i)
+	{
+		result = result && ( preOrder[i] == record[0][i + 1] );
+		result = result && ( arr[i] == record[1][i + 1] );
+		result = result && ( postOrder[i] == record[2][i + 1] );
+	}
+	
+	ASSERT_THAT( result && 7 == record[0][0] && 7 == record[1][0] && 7 == record[2][0] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+TEST(BSTree_ForEach_CheckCase_ActionStop)
+	BSTree* myTree = BSTree_Create(CompareData);
+	int arr[SIZE];
+	int stopValue = 6;
+	int* stopData[3];
+	
+	InsertSortedValues(myTree, arr, SIZE, 2, 0);
+	
+	stopData[0] = BSTreeItr_Get(BSTree_ForEach(myTree, BSTREE_TRAVERSAL_PREORDER, NotEqualAction, &stopValue));
+	stopData[1] = BSTreeItr_Get(BSTree_ForEach(myTree, BSTREE_TRAVERSAL_INORDER, NotEqualAction, &stopValue));
+	stopData[2] = BSTreeItr_Get(BSTree_ForEach(myTree, BSTREE_TRAVERSAL_POSTORDER, NotEqualAction, &stopValue));
+	
+	BSTree_Destroy(myTree, NULL);
+	
+	ASSERT_THAT( &arr[3] == stopData[0] && &arr[3] == stopData[1] && &arr[3] == stopData[2] );
+END_TEST
+/*----------------------------------------------------------------------------*/
+
+
 
 
 
@@ -972,6 +1544,11 @@ TEST_SET(Test Generic Binary Tree)
 	PRINT(BSTree_Create_CheckNull)
 	PRINT(BSTree_Create_CheckNotNull)
 	
+	PRINT(BSTree_BuildFromSorted_CheckNull_Unsorted)
+	PRINT(BSTree_BuildFromSorted_CheckCase_SortedValues)
+	PRINT(BSTree_BuildFromSorted_CheckCase_RemoveAndInsert)
+	PRINT(BSTree_Merge_CheckCase_CommonValues)
+	
 	PRINT(BSTreeItr_Get_CheckNull_Tree)
 	
 	PRINT(BSTree_Insert_CheckNull_Tree)
@@ -1010,17 +1587,35 @@ TEST_SET(Test Generic Binary Tree)
 	PRINT(BSTree_FindFirst_CheckCase_NotFound)
 	PRINT(BSTree_FindFirst_CheckCase_FoundRoot)
 	
+	PRINT(BSTree_Find_CheckNull_Tree)
+	PRINT(BSTree_Find_CheckCase_FoundAndNotFound)
+	PRINT(BSTree_LowerBound_CheckCase_SortedValues)
+	PRINT(BSTree_UpperBound_CheckCase_SortedValues)
+	PRINT(BSTree_Range_CheckCase_CountInRange)
+	PRINT(BSTree_Range_CheckCase_ActionStop)
+	
+	PRINT(BSTree_Size_CheckCase_InsertAndRemove)
+	PRINT(BSTree_Select_CheckCase_SortedValues)
+	PRINT(BSTree_Rank_CheckCase_SortedValues)
+	PRINT(BSTree_Select_CheckCase_RandValuesAfterRemove)
+	
 	PRINT(BSTreeItr_Remove_CheckNull_Tree)
 	PRINT(BSTreeItr_Remove_CheckNull_Itr)
 	PRINT(BSTreeItr_Remove_CheckCase_NoChild)
 	PRINT(BSTreeItr_Remove_CheckCase_1Child)
 	PRINT(BSTreeItr_Remove_CheckCase_2Child)
+	PRINT(BSTreeItr_Remove_CheckCase_OtherItrStayValid)
+	
+	PRINT(BSTree_Insert_CheckCase_SortedValuesBalanced)
+	PRINT(BSTree_Remove_CheckCase_MixedInsertRemoveRedBlack)
 	
 	PRINT(BSTree_ForEach_CheckNull_Tree)
 	PRINT(BSTree_ForEach_CheckNull_IlegalMode)
 	PRINT(BSTree_ForEach_CheckCase_PreOrderMode)
 	PRINT(BSTree_ForEach_CheckCase_InOrderMode)
 	PRINT(BSTree_ForEach_CheckCase_PostOrderMode)
+	PRINT(BSTree_ForEach_CheckCase_ModesOrder)
+	PRINT(BSTree_ForEach_CheckCase_ActionStop)
 END_SET
 /*----------------------------------------------------------------------------*/
 
@@ -1113,6 +1708,61 @@ static int	ChangeValueAction(void* _element, void* _context)
 /*----------------------------------------------------------------------------*/
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that count the elements it was called on
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Pointer to int counter
+ *
+ * @return   1 			= Countinue loop for all elements
+ */
+static int	CountAction(void* _element, void* _context)
+{
+	++*(int*)_context;
+	
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that record the elements it was called on
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Int array, [0] is the counter and the values are recorded after it
+ *
+ * @return   1 			= Countinue loop for all elements
+ */
+static int	RecordAction(void* _element, void* _context)
+{
+	int* record = (int*)_context;
+	
+	++record[0];
+	record[record[0]] = *(int*)_element;
+	
+	return 1;
+}
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function for API: that stop on the element equal to context
+ * 
+ * @param   _element    = Pointer to  the element 
+ * @param   _context  	= Pointer to the value to stop at
+ *
+ * @return   0 			= If _element == _context value
+ */
+static int	NotEqualAction(void* _element, void* _context)
+{
+	return ( *(int*)_element != *(int*)_context );
+}
+/*----------------------------------------------------------------------------*/
+
+
 /*----------------------------------------------------------------------------*/
 /** 
  * @brief 	Function that check if iterator a data <  iterator b data
@@ -1168,3 +1818,29 @@ static int CompareToValuePredicate(void* _a, void* _b)
 	return ( *(int*)_a == *(int*)_b );
 }
 /*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief	Function that check _depth <= 2 * log2(_nItems + 1), the height limit of a red-black tree
+ *
+ * @param   _depth      = The num of nodes on the longest path from the root
+ * @param   _nItems     = The num of elements in the tree
+ *
+ * @return   1 			= If the depth is in the limit, otherwise 0
+ */
+static int IsBalancedDepth(size_t _depth, size_t _nItems)
+{
+	double power = 1;
+	double limit = (double)(_nItems + 1) * (double)(_nItems + 1);
+	size_t i;
+	
+	/* _depth <= 2 * log2(n + 1)  <=>  2 ^ _depth <= (n + 1) ^ 2 */
+	for(i = 0; i < _depth; ++i)
+	{
+		power *= 2;
+	}
+	
+	return ( power <= limit );
+}
+/*----------------------------------------------------------------------------*/
@@ -451,7 +451,7 @@ static void** resizeVector(Vector* _vector, size_t _newSize)
 {
     void** newPtr;
     
-    newPtr = realloc( _vector->m_items, _newSize * sizeof(int) );
+    newPtr = realloc( _vector->m_items, _newSize * sizeof(void*) );
     
     return newPtr;
 }